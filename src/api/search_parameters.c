@@ -67,12 +67,14 @@
  * - VAR_RANDOM_FACTOR = 0.02
  * - CLAUSE_DECAY_FACTOR = 0.999
  * - clause caching is disabled
+ * - CHRONO_THRESHOLD = 100
  */
 #define DEFAULT_VAR_DECAY      VAR_DECAY_FACTOR
 #define DEFAULT_RANDOMNESS     VAR_RANDOM_FACTOR
 #define DEFAULT_CLAUSE_DECAY   CLAUSE_DECAY_FACTOR
 #define DEFAULT_CACHE_TCLAUSES false
 #define DEFAULT_TCLAUSE_SIZE   0
+#define DEFAULT_CHRONO_THRESHOLD CHRONO_THRESHOLD
 
 
 /*
@@ -110,10 +112,12 @@
  * - SIMPLEX_DEFAULT_CHECK_PERIOD = infinity
  * - propagation is disabled by default
  * - model adjustment is also disabled
+ * - floating-point presolve is disabled
  * - integer check is disabled too
  */
 #define DEFAULT_SIMPLEX_PROP_FLAG     false
 #define DEFAULT_SIMPLEX_ADJUST_FLAG   false
+#define DEFAULT_SIMPLEX_FLOAT_FLAG    false
 #define DEFAULT_SIMPLEX_ICHECK_FLAG   false
 
 /*
@@ -122,6 +126,12 @@
  * - MAX_EXTENSIONALITY = 1
  */
 
+/*
+ * Bitvector solver: the and-inverter graph is not used by default
+ */
+#define DEFAULT_BV_AIG_FLAG    true
+#define DEFAULT_BV_SWEEP_FLAG  true
+
 
 /*
  * All default parameters
@@ -144,6 +154,7 @@ static const param_t default_settings = {
   DEFAULT_CLAUSE_DECAY,
   DEFAULT_CACHE_TCLAUSES,
   DEFAULT_TCLAUSE_SIZE,
+  DEFAULT_CHRONO_THRESHOLD,
 
   DEFAULT_USE_DYN_ACK,
   DEFAULT_USE_BOOL_DYN_ACK,
@@ -158,6 +169,7 @@ static const param_t default_settings = {
 
   DEFAULT_SIMPLEX_PROP_FLAG,
   DEFAULT_SIMPLEX_ADJUST_FLAG,
+  DEFAULT_SIMPLEX_FLOAT_FLAG,
   DEFAULT_SIMPLEX_ICHECK_FLAG,
   SIMPLEX_DEFAULT_PROP_ROW_SIZE,
   SIMPLEX_DEFAULT_BLAND_THRESHOLD,
@@ -165,6 +177,9 @@ static const param_t default_settings = {
 
   DEFAULT_MAX_UPDATE_CONFLICTS,
   DEFAULT_MAX_EXTENSIONALITY,
+
+  DEFAULT_BV_AIG_FLAG,
+  DEFAULT_BV_SWEEP_FLAG,
 };
 
 
@@ -200,6 +215,7 @@ typedef enum param_key {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_CHRONO_THRESHOLD,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -214,6 +230,7 @@ typedef enum param_key {
   // simplex parameters
   PARAM_SIMPLEX_PROP,
   PARAM_SIMPLEX_ADJUST,
+  PARAM_SIMPLEX_FLOAT,
   PARAM_SIMPLEX_ICHECK,
   PARAM_PROP_THRESHOLD,
   PARAM_BLAND_THRESHOLD,
@@ -221,9 +238,12 @@ typedef enum param_key {
   // array solver
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver
+  PARAM_BV_AIG,
+  PARAM_BV_SWEEP,
 } param_key_t;
 
-#define NUM_PARAM_KEYS (PARAM_MAX_EXTENSIONALITY+1)
+#define NUM_PARAM_KEYS (PARAM_BV_SWEEP+1)
 
 // parameter names in lexicographic ordering
 static const char *const param_key_names[NUM_PARAM_KEYS] = {
@@ -231,9 +251,12 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "aux-eq-ratio",
   "bland-threshold",
   "branching",
+  "bv-aig",
+  "bv-sweep",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
+  "chrono-threshold",
   "clause-decay",
   "d-factor",
   "d-threshold",
@@ -257,6 +280,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "random-seed",
   "randomness",
   "simplex-adjust",
+  "simplex-float",
   "simplex-prop",
   "tclause-size",
   "var-decay",
@@ -268,9 +292,12 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
   PARAM_BRANCHING,
+  PARAM_BV_AIG,
+  PARAM_BV_SWEEP,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
+  PARAM_CHRONO_THRESHOLD,
   PARAM_CLAUSE_DECAY,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
@@ -294,6 +321,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_RANDOM_SEED,
   PARAM_RANDOMNESS,
   PARAM_SIMPLEX_ADJUST,
+  PARAM_SIMPLEX_FLOAT,
   PARAM_SIMPLEX_PROP,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
@@ -575,6 +603,13 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_CHRONO_THRESHOLD:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->chrono_threshold = (uint32_t) z;
+    }
+    break;
+
   case PARAM_DYN_ACK:
     r = set_bool_param(value, &parameters->use_dyn_ack);
     break;
@@ -649,6 +684,10 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     r = set_bool_param(value, &parameters->adjust_simplex_model);
     break;
 
+  case PARAM_SIMPLEX_FLOAT:
+    r = set_bool_param(value, &parameters->simplex_float_presolve);
+    break;
+
   case PARAM_SIMPLEX_ICHECK:
     r = set_bool_param(value, &parameters->integer_check);
     break;
@@ -685,6 +724,14 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_BV_AIG:
+    r = set_bool_param(value, &parameters->bv_aig);
+    break;
+
+  case PARAM_BV_SWEEP:
+    r = set_bool_param(value, &parameters->bv_sweep);
+    break;
+
   default:
     assert(k == -1);
     r = -1;
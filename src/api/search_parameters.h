@@ -95,6 +95,11 @@ struct param_s {
    *   in a conflict resolution
    * - parameter tclause_size controls the lemma size: only theory lemmas
    *   of size <= tclause_size are turned into learned clauses
+   *
+   * Chronological backtracking:
+   * - if a conflict would cause a backjump of more than chrono_threshold
+   *   levels, the core backtracks by one level only
+   * - 0 means that chronological backtracking is disabled
    */
   double   var_decay;       // decay factor for variable activity
   float    randomness;      // probability of a random pick in select_unassigned_literal
@@ -103,6 +108,7 @@ struct param_s {
   float    clause_decay;    // decay factor for learned-clause activity
   bool     cache_tclauses;
   uint32_t tclause_size;
+  uint32_t chrono_threshold;
 
   /*
    * EGRAPH PARAMETERS
@@ -148,6 +154,8 @@ struct param_s {
    * - simplex_prop: if true enable propagation via propagation table
    * - adjust_simplex_model: if true, enable adjustment in
    *   reconciliation of the egraph and simplex models
+   * - simplex_float_presolve: if true, search for a candidate basis
+   *   using floating-point arithmetic before exact feasibility checks
    * - integer_check: if true, periodically call the integer solver
    * - max_prop_row_size: limit on the size of the propagation rows
    * - bland_threshold: threshold that triggers switching to Bland's rule
@@ -155,6 +163,7 @@ struct param_s {
    */
   bool     use_simplex_prop;
   bool     adjust_simplex_model;
+  bool     simplex_float_presolve;
   bool     integer_check;
   uint32_t max_prop_row_size;
   uint32_t bland_threshold;
@@ -170,6 +179,15 @@ struct param_s {
   uint32_t max_update_conflicts;
   uint32_t max_extensionality;
 
+  /*
+   * BITVECTOR SOLVER PARAMETERS
+   * - bv_aig: if true, bit-blasting builds an and-inverter graph
+   *   that's converted to clauses in a single pass
+   * - bv_sweep: if true, equivalent nodes of the and-inverter graph
+   *   are merged before conversion (requires bv_aig)
+   */
+  bool     bv_aig;
+  bool     bv_sweep;
 };
 
 
@@ -70,10 +70,13 @@
 #include "api/yval.h"
 
 #include "context/context.h"
+#include "context/context_bb.h"
+#include "context/context_portfolio.h"
 
 #include "frontend/yices/yices_parser.h"
 
 #include "io/model_printer.h"
+#include "io/term_dump.h"
 #include "io/term_printer.h"
 #include "io/type_printer.h"
 #include "io/yices_pp.h"
@@ -146,6 +149,15 @@ yices_globals_t __yices_globals = {
 
 /*
  * SYNCHRONIZING ACCESS TO GLOBAL TABLE.
+ *
+ * In thread-safe mode, __yices_globals.lock is a reader/writer lock.
+ * - Entry points that only inspect terms and types (type and term
+ *   exploration, pretty printing, names) take it in shared mode
+ *   (MT_PROTECT_READ) so they can run concurrently.
+ * - Everything else, including all term and type constructors, takes
+ *   it in exclusive mode (MT_PROTECT_WRITE). Functions that use caches
+ *   attached to the tables (e.g., yices_test_subtype, yices_term_is_ground,
+ *   yices_get_term_by_name) are writers.
  */
 
 /*
@@ -157,7 +169,7 @@ yices_globals_t __yices_globals = {
  */
 int32_t yices_obtain_mutex(void){
 #ifdef THREAD_SAFE
-  return get_yices_lock(&__yices_globals.lock);
+  return get_yices_write_lock(&__yices_globals.lock);
 #else
   return 0;
 #endif
@@ -170,7 +182,7 @@ int32_t yices_obtain_mutex(void){
  */
 int32_t yices_release_mutex(void){
 #ifdef THREAD_SAFE
-  return release_yices_lock(&__yices_globals.lock);
+  return release_yices_write_lock(&__yices_globals.lock);
 #else
   return 0;
 #endif
@@ -321,6 +333,35 @@ static yices_lock_t parameter_list_lock;
 #endif
 
 
+/*
+ * Per-thread scratch buffers for the arithmetic and bitvector
+ * arithmetic constructors (yices_add, yices_bvadd, yices_bvmul, ...)
+ * - each thread that calls these constructors gets its own buffers
+ *   and monomial stores, so the constructors don't use the buffers
+ *   of the global term manager
+ * - all scratch records are in scratch_list so that yices_exit can free them
+ * - a thread's record is valid if its generation is scratch_generation.
+ *   This is incremented by every call to yices_init.
+ */
+typedef struct {
+  dl_list_t header;
+  object_store_t bvarith_store;
+  object_store_t bvarith64_store;
+  rba_buffer_t arith_buffer;
+  bvarith_buffer_t bvarith_buffer;
+  bvarith64_buffer_t bvarith64_buffer;
+} scratch_elem_t;
+
+static dl_list_t scratch_list;
+static uint32_t scratch_generation;
+#ifdef THREAD_SAFE
+static yices_lock_t scratch_list_lock;
+#endif
+
+static YICES_THREAD_LOCAL scratch_elem_t *thread_scratch;
+static YICES_THREAD_LOCAL uint32_t thread_scratch_generation;
+
+
 static inline void init_list_locks(void){
 #ifdef THREAD_SAFE
   create_yices_lock(&arith_buffer_list_lock);
@@ -331,6 +372,7 @@ static inline void init_list_locks(void){
   create_yices_lock(&model_list_lock);
   create_yices_lock(&config_list_lock);
   create_yices_lock(&parameter_list_lock);
+  create_yices_lock(&scratch_list_lock);
 #endif
 }
 
@@ -344,6 +386,7 @@ static inline void delete_list_locks(void){
   destroy_yices_lock(&model_list_lock);
   destroy_yices_lock(&config_list_lock);
   destroy_yices_lock(&parameter_list_lock);
+  destroy_yices_lock(&scratch_list_lock);
 #endif
 }
 
@@ -358,6 +401,7 @@ static inline void get_list_locks(void){
   get_yices_lock(&model_list_lock);
   get_yices_lock(&config_list_lock);
   get_yices_lock(&parameter_list_lock);
+  get_yices_lock(&scratch_list_lock);
 #endif
 }
 
@@ -372,6 +416,7 @@ static inline void release_list_locks(void){
   release_yices_lock(&model_list_lock);
   release_yices_lock(&config_list_lock);
   release_yices_lock(&parameter_list_lock);
+  release_yices_lock(&scratch_list_lock);
 #endif
 }
 
@@ -902,6 +947,71 @@ static void free_parameter_list(void) {
 
 
 
+/*******************************
+ *  PER-THREAD SCRATCH BUFFERS  *
+ ******************************/
+
+static inline scratch_elem_t *scratch_of_header(dl_list_t *l) {
+  return (scratch_elem_t *) l;
+}
+
+/*
+ * Allocate and initialize a scratch record and add it to the list
+ */
+static void _o_insert_scratch(scratch_elem_t *new_elem) {
+  list_insert_next(&scratch_list, &new_elem->header);
+}
+
+static scratch_elem_t *alloc_scratch(void) {
+  scratch_elem_t *new_elem;
+
+  new_elem = (scratch_elem_t *) safe_malloc(sizeof(scratch_elem_t));
+  init_bvmlist_store(&new_elem->bvarith_store);
+  init_bvmlist64_store(&new_elem->bvarith64_store);
+  init_rba_buffer(&new_elem->arith_buffer, __yices_globals.pprods);
+  init_bvarith_buffer(&new_elem->bvarith_buffer, __yices_globals.pprods, &new_elem->bvarith_store);
+  init_bvarith64_buffer(&new_elem->bvarith64_buffer, __yices_globals.pprods, &new_elem->bvarith64_store);
+  MT_PROTECT_VOID(scratch_list_lock, _o_insert_scratch(new_elem));
+
+  return new_elem;
+}
+
+/*
+ * Get the scratch record of the current thread (allocate it if needed)
+ */
+static scratch_elem_t *get_scratch(void) {
+  if (thread_scratch_generation != scratch_generation) {
+    thread_scratch = alloc_scratch();
+    thread_scratch_generation = scratch_generation;
+  }
+  assert(thread_scratch != NULL);
+  return thread_scratch;
+}
+
+/*
+ * Empty the scratch list: the buffers must be deleted before the stores
+ */
+static void free_scratch_list(void) {
+  dl_list_t *elem, *aux;
+  scratch_elem_t *s;
+
+  elem = scratch_list.next;
+  while (elem != &scratch_list) {
+    aux = elem->next;
+    s = scratch_of_header(elem);
+    delete_rba_buffer(&s->arith_buffer);
+    delete_bvarith_buffer(&s->bvarith_buffer);
+    delete_bvarith64_buffer(&s->bvarith64_buffer);
+    delete_bvmlist_store(&s->bvarith_store);
+    delete_bvmlist64_store(&s->bvarith64_store);
+    safe_free(elem);
+    elem = aux;
+  }
+  clear_list(&scratch_list);
+}
+
+
+
 /***********************************
  *  PARSER AND RELATED STRUCTURES  *
  **********************************/
@@ -1018,7 +1128,7 @@ static void init_globals(yices_globals_t *glob) {
   glob->fvars = NULL;
 
 #ifdef THREAD_SAFE
-  create_yices_lock(&(glob->lock));
+  create_yices_rwlock(&(glob->lock));
 #endif
 
 }
@@ -1038,7 +1148,7 @@ static void clear_globals(yices_globals_t *glob) {
   glob->manager = NULL;
 
 #ifdef THREAD_SAFE
-  destroy_yices_lock(&(glob->lock));
+  destroy_yices_rwlock(&(glob->lock));
 #endif
 
 }
@@ -1079,6 +1189,10 @@ EXPORTED void yices_init(void) {
   clear_list(&bvarith64_buffer_list);
   clear_list(&bvlogic_buffer_list);
 
+  // per-thread scratch buffers: invalidate the records of all threads
+  clear_list(&scratch_list);
+  scratch_generation ++;
+
   // other dynamic object lists
   clear_list(&context_list);
   clear_list(&model_list);
@@ -1120,6 +1234,7 @@ EXPORTED void yices_exit(void) {
   free_bvarith_buffer_list();
   free_bvarith64_buffer_list();
   free_arith_buffer_list();
+  free_scratch_list();
 
   free_context_list();
   free_model_list();
@@ -1155,7 +1270,7 @@ static void _o_enable_bvite_offset(void) {
 }
 
 void yices_enable_bvite_offset(void) {
-  MT_PROTECT_VOID(__yices_globals.lock, _o_enable_bvite_offset());
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_enable_bvite_offset());
 }
 
 
@@ -1273,7 +1388,7 @@ static void _o_yices_set_out_of_mem_callback(void (*callback)(void)) {
 }
 
 EXPORTED void yices_set_out_of_mem_callback(void (*callback)(void)) {
-  MT_PROTECT_VOID(__yices_globals.lock,_o_yices_set_out_of_mem_callback(callback));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock,_o_yices_set_out_of_mem_callback(callback));
 }
 
 
@@ -1330,16 +1445,19 @@ static inline object_store_t *get_bvarith64_store(void) {
 }
 
 
+/*
+ * Arithmetic buffers: they are in the current thread's scratch record
+ */
 static inline rba_buffer_t *get_arith_buffer(void) {
-  return term_manager_get_arith_buffer(__yices_globals.manager);
+  return &get_scratch()->arith_buffer;
 }
 
 static inline bvarith_buffer_t *get_bvarith_buffer(void) {
-  return term_manager_get_bvarith_buffer(__yices_globals.manager);
+  return &get_scratch()->bvarith_buffer;
 }
 
 static inline bvarith64_buffer_t *get_bvarith64_buffer(void) {
-  return term_manager_get_bvarith64_buffer(__yices_globals.manager);
+  return &get_scratch()->bvarith64_buffer;
 }
 
 static inline bvlogic_buffer_t *get_bvlogic_buffer(void) {
@@ -2720,7 +2838,7 @@ static bool check_child_idx(term_table_t *terms, term_t t, int32_t i) {
  **********************/
 
 EXPORTED type_t yices_bool_type(void) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_bool_type());
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_bool_type());
 }
 
 type_t _o_yices_bool_type(void) {
@@ -2728,7 +2846,7 @@ type_t _o_yices_bool_type(void) {
 }
 
 EXPORTED type_t yices_int_type(void) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_int_type());
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_int_type());
 }
 
 type_t _o_yices_int_type(void) {
@@ -2736,7 +2854,7 @@ type_t _o_yices_int_type(void) {
 }
 
 EXPORTED type_t yices_real_type(void) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_real_type());
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_real_type());
 }
 
 type_t _o_yices_real_type(void) {
@@ -2744,7 +2862,7 @@ type_t _o_yices_real_type(void) {
 }
 
 EXPORTED type_t yices_bv_type(uint32_t size) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_bv_type(size));
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_bv_type(size));
 }
 
 type_t _o_yices_bv_type(uint32_t size) {
@@ -2755,7 +2873,7 @@ type_t _o_yices_bv_type(uint32_t size) {
 }
 
 EXPORTED type_t yices_new_uninterpreted_type(void) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_new_uninterpreted_type());
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_new_uninterpreted_type());
 }
 
 type_t _o_yices_new_uninterpreted_type(void) {
@@ -2763,7 +2881,7 @@ type_t _o_yices_new_uninterpreted_type(void) {
 }
 
 EXPORTED type_t yices_new_scalar_type(uint32_t card) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_new_scalar_type(card));
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_new_scalar_type(card));
 }
 
 type_t _o_yices_new_scalar_type(uint32_t card) {
@@ -2774,7 +2892,7 @@ type_t _o_yices_new_scalar_type(uint32_t card) {
 }
 
 EXPORTED type_t yices_tuple_type(uint32_t n, const type_t elem[]) {
-  MT_PROTECT(type_t, __yices_globals.lock, _o_yices_tuple_type(n, elem));
+  MT_PROTECT_WRITE(type_t, __yices_globals.lock, _o_yices_tuple_type(n, elem));
 }
 
 type_t _o_yices_tuple_type(uint32_t n, const type_t elem[]) {
@@ -2787,7 +2905,7 @@ type_t _o_yices_tuple_type(uint32_t n, const type_t elem[]) {
 }
 
 EXPORTED type_t yices_function_type(uint32_t n, const type_t dom[], type_t range) {
-  MT_PROTECT( type_t, __yices_globals.lock, _o_yices_function_type(n, dom, range));
+  MT_PROTECT_WRITE( type_t, __yices_globals.lock, _o_yices_function_type(n, dom, range));
 }
 
 type_t _o_yices_function_type(uint32_t n, const type_t dom[], type_t range) {
@@ -2984,7 +3102,7 @@ EXPORTED term_t yices_false(void) {
 }
 
 EXPORTED term_t yices_constant(type_t tau, int32_t index) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_constant(tau, index));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_constant(tau, index));
 }
 
 term_t _o_yices_constant(type_t tau, int32_t index) {
@@ -2996,7 +3114,7 @@ term_t _o_yices_constant(type_t tau, int32_t index) {
 }
 
 EXPORTED term_t yices_new_uninterpreted_term(type_t tau) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_new_uninterpreted_term(tau));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_new_uninterpreted_term(tau));
 }
 
 term_t _o_yices_new_uninterpreted_term(type_t tau) {
@@ -3008,7 +3126,7 @@ term_t _o_yices_new_uninterpreted_term(type_t tau) {
 }
 
 EXPORTED term_t yices_new_variable(type_t tau) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_new_variable(tau));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_new_variable(tau));
 }
 
 term_t _o_yices_new_variable(type_t tau) {
@@ -3025,7 +3143,7 @@ term_t _o_yices_new_variable(type_t tau) {
  * - we apply beta-reduction eagerly here
  */
 EXPORTED term_t yices_application(term_t fun, uint32_t n, const term_t arg[]) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_application(fun, n, arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_application(fun, n, arg));
 }
 
 term_t _o_yices_application(term_t fun, uint32_t n, const term_t arg[]) {
@@ -3082,7 +3200,7 @@ EXPORTED term_t yices_application3(term_t fun, term_t arg1, term_t arg2, term_t
 
 
 EXPORTED term_t yices_ite(term_t cond, term_t then_term, term_t else_term) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_ite(cond, then_term, else_term));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_ite(cond, then_term, else_term));
 }
 
 term_t _o_yices_ite(term_t cond, term_t then_term, term_t else_term) {
@@ -3116,7 +3234,7 @@ term_t _o_yices_ite(term_t cond, term_t then_term, term_t else_term) {
 }
 
 EXPORTED term_t yices_eq(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_eq(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_eq(left, right));
 }
 
 term_t _o_yices_eq(term_t left, term_t right) {
@@ -3128,7 +3246,7 @@ term_t _o_yices_eq(term_t left, term_t right) {
 }
 
 EXPORTED term_t yices_neq(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_neq(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_neq(left, right));
 }
 
 term_t _o_yices_neq(term_t left, term_t right) {
@@ -3144,7 +3262,7 @@ term_t _o_yices_neq(term_t left, term_t right) {
  * BOOLEAN NEGATION
  */
 EXPORTED term_t yices_not(term_t arg) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_not(arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_not(arg));
 }
 
 term_t _o_yices_not(term_t arg) {
@@ -3161,7 +3279,7 @@ term_t _o_yices_not(term_t arg) {
  * OR, AND, and XOR may modify arg
  */
 EXPORTED term_t yices_or(uint32_t n, term_t arg[]) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_or(n, arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_or(n, arg));
 }
 
 term_t _o_yices_or(uint32_t n, term_t arg[]) {
@@ -3184,7 +3302,7 @@ term_t _o_yices_or(uint32_t n, term_t arg[]) {
 }
 
 EXPORTED term_t yices_and(uint32_t n, term_t arg[]) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_and(n, arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_and(n, arg));
 }
 
 term_t _o_yices_and(uint32_t n, term_t arg[]) {
@@ -3207,7 +3325,7 @@ term_t _o_yices_and(uint32_t n, term_t arg[]) {
 }
 
 EXPORTED term_t yices_xor(uint32_t n, term_t arg[]) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_xor(n, arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_xor(n, arg));
 }
 
 term_t _o_yices_xor(uint32_t n, term_t arg[]) {
@@ -3268,7 +3386,7 @@ EXPORTED term_t yices_xor3(term_t t1, term_t t2, term_t t3) {
  * BINARY VERSIONS OF OR/AND/XOR
  */
 EXPORTED term_t yices_or2(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_or2(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_or2(left, right));
 }
 
 term_t _o_yices_or2(term_t left, term_t right) {
@@ -3283,7 +3401,7 @@ term_t _o_yices_or2(term_t left, term_t right) {
 }
 
 EXPORTED term_t yices_and2(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_and2(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_and2(left, right));
 }
 
 term_t _o_yices_and2(term_t left, term_t right) {
@@ -3298,7 +3416,7 @@ term_t _o_yices_and2(term_t left, term_t right) {
 }
 
 EXPORTED term_t yices_xor2(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_xor2(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_xor2(left, right));
 }
 
 term_t _o_yices_xor2(term_t left, term_t right) {
@@ -3314,7 +3432,7 @@ term_t _o_yices_xor2(term_t left, term_t right) {
 
 
 EXPORTED term_t yices_iff(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_iff(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_iff(left, right));
 }
 
 term_t _o_yices_iff(term_t left, term_t right) {
@@ -3329,7 +3447,7 @@ term_t _o_yices_iff(term_t left, term_t right) {
 }
 
 EXPORTED term_t yices_implies(term_t left, term_t right) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_implies(left, right));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_implies(left, right));
 }
 
 term_t _o_yices_implies(term_t left, term_t right) {
@@ -3345,7 +3463,7 @@ term_t _o_yices_implies(term_t left, term_t right) {
 
 
 EXPORTED term_t yices_tuple(uint32_t n, const term_t arg[]) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_tuple(n, arg));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_tuple(n, arg));
 }
 
 term_t _o_yices_tuple(uint32_t n, const term_t arg[]) {
@@ -3365,7 +3483,7 @@ EXPORTED term_t yices_pair(term_t arg1, term_t arg2) {
   aux[0] = arg1;
   aux[1] = arg2;
 
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_tuple(2, aux));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_tuple(2, aux));
 }
 
 EXPORTED term_t yices_triple(term_t arg1, term_t arg2, term_t arg3) {
@@ -3375,13 +3493,13 @@ EXPORTED term_t yices_triple(term_t arg1, term_t arg2, term_t arg3) {
   aux[1] = arg2;
   aux[2] = arg3;
 
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_tuple(3, aux));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_tuple(3, aux));
 }
 
 
 
 EXPORTED term_t yices_select(uint32_t index, term_t tuple) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_select(index, tuple));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_select(index, tuple));
 }
 
 term_t _o_yices_select(uint32_t index, term_t tuple) {
@@ -3394,7 +3512,7 @@ term_t _o_yices_select(uint32_t index, term_t tuple) {
 }
 
 EXPORTED term_t yices_update(term_t fun, uint32_t n, const term_t arg[], term_t new_v) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_update(fun, n, arg, new_v));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_update(fun, n, arg, new_v));
 }
 
 term_t _o_yices_update(term_t fun, uint32_t n, const term_t arg[], term_t new_v) {
@@ -3430,7 +3548,7 @@ EXPORTED term_t yices_update3(term_t fun, term_t arg1, term_t arg2, term_t arg3,
 
 
 EXPORTED term_t yices_distinct(uint32_t n, term_t arg[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_distinct(n, arg));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_distinct(n, arg));
 }
 
 term_t _o_yices_distinct(uint32_t n, term_t arg[]) {
@@ -3444,7 +3562,7 @@ term_t _o_yices_distinct(uint32_t n, term_t arg[]) {
 }
 
 EXPORTED term_t yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_tuple_update(tuple, index, new_v));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_tuple_update(tuple, index, new_v));
 }
 
 term_t _o_yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
@@ -3457,7 +3575,7 @@ term_t _o_yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
 }
 
 EXPORTED term_t yices_forall(uint32_t n, term_t var[], term_t body) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_forall(n, var, body));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_forall(n, var, body));
 }
 
 term_t _o_yices_forall(uint32_t n, term_t var[], term_t body) {
@@ -3473,7 +3591,7 @@ term_t _o_yices_forall(uint32_t n, term_t var[], term_t body) {
 }
 
 EXPORTED term_t yices_exists(uint32_t n, term_t var[], term_t body) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_exists(n, var, body));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_exists(n, var, body));
 }
 
 term_t _o_yices_exists(uint32_t n, term_t var[], term_t body) {
@@ -3489,7 +3607,7 @@ term_t _o_yices_exists(uint32_t n, term_t var[], term_t body) {
 }
 
 EXPORTED term_t yices_lambda(uint32_t n, const term_t var[], term_t body) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_lambda(n, var, body));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_lambda(n, var, body));
 }
 
 term_t _o_yices_lambda(uint32_t n, const term_t var[], term_t body) {
@@ -3515,7 +3633,7 @@ EXPORTED term_t yices_zero(void) {
 }
 
 EXPORTED term_t yices_int32(int32_t val) {
-  MT_PROTECT(term_t, __yices_globals.lock, _o_yices_int32(val));
+  MT_PROTECT_WRITE(term_t, __yices_globals.lock, _o_yices_int32(val));
 }
 
 term_t _o_yices_int32(int32_t val) {
@@ -3525,7 +3643,7 @@ term_t _o_yices_int32(int32_t val) {
 
 
 EXPORTED term_t yices_int64(int64_t val) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_int64(val));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_int64(val));
 }
 
 term_t _o_yices_int64(int64_t val) {
@@ -3538,7 +3656,7 @@ term_t _o_yices_int64(int64_t val) {
  * Rational constants
  */
 EXPORTED term_t yices_rational32(int32_t num, uint32_t den) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_rational32(num, den));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_rational32(num, den));
 }
 
 term_t _o_yices_rational32(int32_t num, uint32_t den) {
@@ -3553,7 +3671,7 @@ term_t _o_yices_rational32(int32_t num, uint32_t den) {
 
 
 EXPORTED term_t yices_rational64(int64_t num, uint64_t den) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_rational64(num, den));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_rational64(num, den));
 }
 
 term_t _o_yices_rational64(int64_t num, uint64_t den) {
@@ -3571,7 +3689,7 @@ term_t _o_yices_rational64(int64_t num, uint64_t den) {
  * Constant from GMP integers or rationals
  */
 EXPORTED term_t yices_mpz(const mpz_t z) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_mpz(z));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_mpz(z));
 }
 
 term_t _o_yices_mpz(const mpz_t z) {
@@ -3585,7 +3703,7 @@ term_t _o_yices_mpz(const mpz_t z) {
 }
 
 EXPORTED term_t yices_mpq(const mpq_t q) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_mpq(q));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_mpq(q));
 }
 
 term_t _o_yices_mpq(const mpq_t q) {
@@ -3615,7 +3733,7 @@ term_t _o_yices_mpq(const mpq_t q) {
  */
 
 EXPORTED term_t yices_parse_rational(const char *s) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_parse_rational(s));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_parse_rational(s));
 }
 
 term_t _o_yices_parse_rational(const char *s) {
@@ -3655,7 +3773,7 @@ term_t _o_yices_parse_rational(const char *s) {
  * code = INVALID_FLOAT_FORMAT
  */
 EXPORTED term_t yices_parse_float(const char *s) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_parse_float(s));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_parse_float(s));
 }
 
 term_t _o_yices_parse_float(const char *s) {
@@ -3682,7 +3800,7 @@ term_t _o_yices_parse_float(const char *s) {
  * Add t1 and t2
  */
 EXPORTED term_t yices_add(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_add(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_add(t1, t2));
 }
 
 term_t _o_yices_add(term_t t1, term_t t2) {
@@ -3707,7 +3825,7 @@ term_t _o_yices_add(term_t t1, term_t t2) {
  * Subtract t2 from t1
  */
 EXPORTED term_t yices_sub(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_sub(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_sub(t1, t2));
 }
 
 term_t _o_yices_sub(term_t t1, term_t t2) {
@@ -3732,7 +3850,7 @@ term_t _o_yices_sub(term_t t1, term_t t2) {
  * Negate t1
  */
 EXPORTED term_t yices_neg(term_t t1) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_neg(t1));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_neg(t1));
 }
 
 term_t _o_yices_neg(term_t t1) {
@@ -3757,7 +3875,7 @@ term_t _o_yices_neg(term_t t1) {
  * Multiply t1 and t2
  */
 EXPORTED term_t yices_mul(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_mul(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_mul(t1, t2));
 }
 
 term_t _o_yices_mul(term_t t1, term_t t2) {
@@ -3783,7 +3901,7 @@ term_t _o_yices_mul(term_t t1, term_t t2) {
  * Compute the square of t1
  */
 EXPORTED term_t yices_square(term_t t1) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_square(t1));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_square(t1));
 }
 
 term_t _o_yices_square(term_t t1) {
@@ -3810,7 +3928,7 @@ term_t _o_yices_square(term_t t1) {
  * Compute t1 ^ d
  */
 EXPORTED term_t yices_power(term_t t1, uint32_t d) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_power(t1, d));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_power(t1, d));
 }
 
 term_t _o_yices_power(term_t t1, uint32_t d) {
@@ -3836,7 +3954,7 @@ term_t _o_yices_power(term_t t1, uint32_t d) {
  * Sum of n terms t[0] ... t[n-1]
  */
 EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_sum(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_sum(n, t));
 }
 
 term_t _o_yices_sum(uint32_t n, const term_t t[]) {
@@ -3864,7 +3982,7 @@ term_t _o_yices_sum(uint32_t n, const term_t t[]) {
  * Product of n terms t[0] ... t[n-1]
  */
 EXPORTED term_t yices_product(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_product(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_product(n, t));
 }
 
 term_t _o_yices_product(uint32_t n, const term_t t[]) {
@@ -3908,7 +4026,7 @@ term_t _o_yices_product(uint32_t n, const term_t t[]) {
  * DIVISION
  */
 EXPORTED term_t yices_division(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_division(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_division(t1, t2));
 }
 
 term_t _o_yices_division(term_t t1, term_t t2) {
@@ -3929,7 +4047,7 @@ term_t _o_yices_division(term_t t1, term_t t2) {
  **************************/
 
 EXPORTED term_t yices_idiv(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_idiv(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_idiv(t1, t2));
 }
 
 term_t _o_yices_idiv(term_t t1, term_t t2) {
@@ -3945,7 +4063,7 @@ term_t _o_yices_idiv(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_imod(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_imod(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_imod(t1, t2));
 }
 
 term_t _o_yices_imod(term_t t1, term_t t2) {
@@ -3963,7 +4081,7 @@ term_t _o_yices_imod(term_t t1, term_t t2) {
  * Divisibility test: check whether t1 divides t2
  */
 EXPORTED term_t yices_divides_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_divides_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_divides_atom(t1, t2));
 }
 
 term_t _o_yices_divides_atom(term_t t1, term_t t2) {
@@ -3981,7 +4099,7 @@ term_t _o_yices_divides_atom(term_t t1, term_t t2) {
  * Integer test
  */
 EXPORTED term_t yices_is_int_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_is_int_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_is_int_atom(t));
 }
 
 term_t _o_yices_is_int_atom(term_t t) {
@@ -3998,7 +4116,7 @@ term_t _o_yices_is_int_atom(term_t t) {
  * ABS/FLOOR/CEIL
  */
 EXPORTED term_t yices_abs(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_abs(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_abs(t));
 }
 
 term_t _o_yices_abs(term_t t) {
@@ -4011,7 +4129,7 @@ term_t _o_yices_abs(term_t t) {
 }
 
 EXPORTED term_t yices_floor(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_floor(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_floor(t));
 }
 
 term_t _o_yices_floor(term_t t) {
@@ -4024,7 +4142,7 @@ term_t _o_yices_floor(term_t t) {
 }
 
 EXPORTED term_t yices_ceil(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_ceil(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_ceil(t));
 }
 
 term_t _o_yices_ceil(term_t t) {
@@ -4045,7 +4163,7 @@ term_t _o_yices_ceil(term_t t) {
  * integer coefficients
  */
 EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_int32(n, a, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_int32(n, a, t));
 }
 
 term_t _o_yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
@@ -4070,7 +4188,7 @@ term_t _o_yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
 }
 
 EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_int64(n, a, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_int64(n, a, t));
 }
 
 term_t _o_yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
@@ -4106,7 +4224,7 @@ term_t _o_yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
  *   code = DIVISION_BY_ZERO
  */
 EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_rational32(n, num, den, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_rational32(n, num, den, t));
 }
 
 term_t _o_yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
@@ -4132,7 +4250,7 @@ term_t _o_yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t
 }
 
 EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_rational64(n, num, den, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_rational64(n, num, den, t));
 }
 
 term_t _o_yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
@@ -4162,7 +4280,7 @@ term_t _o_yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t
  * GMP integers and rationals
  */
 EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_mpz(n, z, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_mpz(n, z, t));
 }
 
 term_t _o_yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
@@ -4191,7 +4309,7 @@ term_t _o_yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
 
 
 EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_poly_mpq(n, q, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_poly_mpq(n, q, t));
 }
 
 term_t _o_yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
@@ -4227,7 +4345,7 @@ term_t _o_yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
  *********************/
 
 EXPORTED term_t yices_arith_eq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_eq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_eq_atom(t1, t2));
 }
 
 term_t _o_yices_arith_eq_atom(term_t t1, term_t t2) {
@@ -4238,7 +4356,7 @@ term_t _o_yices_arith_eq_atom(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_arith_neq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_neq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_neq_atom(t1, t2));
 }
 
 term_t _o_yices_arith_neq_atom(term_t t1, term_t t2) {
@@ -4249,7 +4367,7 @@ term_t _o_yices_arith_neq_atom(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_arith_geq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_geq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_geq_atom(t1, t2));
 }
 
 term_t _o_yices_arith_geq_atom(term_t t1, term_t t2) {
@@ -4260,7 +4378,7 @@ term_t _o_yices_arith_geq_atom(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_arith_lt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_lt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_lt_atom(t1, t2));
 }
 
 term_t _o_yices_arith_lt_atom(term_t t1, term_t t2) {
@@ -4271,7 +4389,7 @@ term_t _o_yices_arith_lt_atom(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_arith_gt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_gt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_gt_atom(t1, t2));
 }
 
 term_t _o_yices_arith_gt_atom(term_t t1, term_t t2) {
@@ -4282,7 +4400,7 @@ term_t _o_yices_arith_gt_atom(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_arith_leq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_leq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_leq_atom(t1, t2));
 }
 
 term_t _o_yices_arith_leq_atom(term_t t1, term_t t2) {
@@ -4297,7 +4415,7 @@ term_t _o_yices_arith_leq_atom(term_t t1, term_t t2) {
  * Comparison with zero
  */
 EXPORTED term_t yices_arith_eq0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_eq0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_eq0_atom(t));
 }
 
 term_t _o_yices_arith_eq0_atom(term_t t) {
@@ -4309,7 +4427,7 @@ term_t _o_yices_arith_eq0_atom(term_t t) {
 }
 
 EXPORTED term_t yices_arith_neq0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_neq0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_neq0_atom(t));
 }
 
 term_t _o_yices_arith_neq0_atom(term_t t) {
@@ -4321,7 +4439,7 @@ term_t _o_yices_arith_neq0_atom(term_t t) {
 }
 
 EXPORTED term_t yices_arith_geq0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_geq0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_geq0_atom(t));
 }
 
 term_t _o_yices_arith_geq0_atom(term_t t) {
@@ -4333,7 +4451,7 @@ term_t _o_yices_arith_geq0_atom(term_t t) {
 }
 
 EXPORTED term_t yices_arith_leq0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_leq0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_leq0_atom(t));
 }
 
 term_t _o_yices_arith_leq0_atom(term_t t) {
@@ -4345,7 +4463,7 @@ term_t _o_yices_arith_leq0_atom(term_t t) {
 }
 
 EXPORTED term_t yices_arith_gt0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_gt0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_gt0_atom(t));
 }
 
 term_t _o_yices_arith_gt0_atom(term_t t) {
@@ -4357,7 +4475,7 @@ term_t _o_yices_arith_gt0_atom(term_t t) {
 }
 
 EXPORTED term_t yices_arith_lt0_atom(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_arith_lt0_atom(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_arith_lt0_atom(t));
 }
 
 term_t _o_yices_arith_lt0_atom(term_t t) {
@@ -4375,7 +4493,7 @@ term_t _o_yices_arith_lt0_atom(term_t t) {
  *************************/
 
 EXPORTED term_t yices_bvconst_uint32(uint32_t n, uint32_t x) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_uint32(n,x));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_uint32(n,x));
 }
 
 term_t _o_yices_bvconst_uint32(uint32_t n, uint32_t x) {
@@ -4390,7 +4508,7 @@ term_t _o_yices_bvconst_uint32(uint32_t n, uint32_t x) {
 }
 
 EXPORTED term_t yices_bvconst_uint64(uint32_t n, uint64_t x) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_uint64(n,x));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_uint64(n,x));
 }
 
 term_t _o_yices_bvconst_uint64(uint32_t n, uint64_t x) {
@@ -4405,7 +4523,7 @@ term_t _o_yices_bvconst_uint64(uint32_t n, uint64_t x) {
 }
 
 EXPORTED term_t yices_bvconst_int32(uint32_t n, int32_t x) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_int32(n,x));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_int32(n,x));
 }
 
 term_t _o_yices_bvconst_int32(uint32_t n, int32_t x) {
@@ -4420,7 +4538,7 @@ term_t _o_yices_bvconst_int32(uint32_t n, int32_t x) {
 }
 
 EXPORTED term_t yices_bvconst_int64(uint32_t n, int64_t x) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_int64(n,x));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_int64(n,x));
 }
 
 term_t _o_yices_bvconst_int64(uint32_t n, int64_t x) {
@@ -4435,7 +4553,7 @@ term_t _o_yices_bvconst_int64(uint32_t n, int64_t x) {
 }
 
 EXPORTED term_t yices_bvconst_mpz(uint32_t n, const mpz_t x) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_mpz(n,x));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_mpz(n,x));
 }
 
 term_t _o_yices_bvconst_mpz(uint32_t n, const mpz_t x) {
@@ -4471,7 +4589,7 @@ term_t _o_yices_bvconst_mpz(uint32_t n, const mpz_t x) {
  * bvconst_minus_one: set all bits to 1
  */
 EXPORTED term_t yices_bvconst_zero(uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_zero(n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_zero(n));
 }
 
 term_t _o_yices_bvconst_zero(uint32_t n) {
@@ -4485,7 +4603,7 @@ term_t _o_yices_bvconst_zero(uint32_t n) {
 }
 
 EXPORTED term_t yices_bvconst_one(uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_one(n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_one(n));
 }
 
 term_t _o_yices_bvconst_one(uint32_t n) {
@@ -4500,7 +4618,7 @@ term_t _o_yices_bvconst_one(uint32_t n) {
 }
 
 EXPORTED term_t yices_bvconst_minus_one(uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_minus_one(n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_minus_one(n));
 }
 
 term_t _o_yices_bvconst_minus_one(uint32_t n) {
@@ -4520,7 +4638,7 @@ term_t _o_yices_bvconst_minus_one(uint32_t n) {
  * - a[i] != 0 --> bit i = 1
  */
 EXPORTED term_t yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconst_from_array(n,a));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconst_from_array(n,a));
 }
 
 term_t _o_yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
@@ -4543,7 +4661,7 @@ term_t _o_yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
  *   is the high-order bit.
  */
 EXPORTED term_t yices_parse_bvbin(const char *s) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_parse_bvbin(s));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_parse_bvbin(s));
 }
 
 term_t _o_yices_parse_bvbin(const char *s) {
@@ -4584,7 +4702,7 @@ term_t _o_yices_parse_bvbin(const char *s) {
  *   the four high-order bits).
  */
 EXPORTED term_t yices_parse_bvhex(const char *s) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_parse_bvhex(s));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_parse_bvhex(s));
 }
 
 term_t _o_yices_parse_bvhex(const char *s) {
@@ -4656,7 +4774,7 @@ term_t mk_bvadd(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvadd(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvadd(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvadd(t1, t2));
 }
 
 term_t _o_yices_bvadd(term_t t1, term_t t2) {
@@ -4697,7 +4815,7 @@ term_t mk_bvsub(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvsub(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsub(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsub(t1, t2));
 }
 
 term_t _o_yices_bvsub(term_t t1, term_t t2) {
@@ -4738,7 +4856,7 @@ term_t mk_bvneg(term_t t1) {
 }
 
 EXPORTED term_t yices_bvneg(term_t t1) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvneg(t1));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvneg(t1));
 }
 
 term_t _o_yices_bvneg(term_t t1) {
@@ -4780,7 +4898,7 @@ term_t mk_bvmul(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvmul(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvmul(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvmul(t1, t2));
 }
 
 term_t _o_yices_bvmul(term_t t1, term_t t2) {
@@ -4828,7 +4946,7 @@ static term_t mk_bvsquare(term_t t1) {
 }
 
 EXPORTED term_t yices_bvsquare(term_t t1) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsquare(t1));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsquare(t1));
 }
 
 term_t _o_yices_bvsquare(term_t t1) {
@@ -4881,7 +4999,7 @@ static term_t mk_bvpower(term_t t1, uint32_t d) {
 }
 
 EXPORTED term_t yices_bvpower(term_t t1, uint32_t d) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvpower(t1, d));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvpower(t1, d));
 }
 
 term_t _o_yices_bvpower(term_t t1, uint32_t d) {
@@ -4938,7 +5056,7 @@ static term_t mk_bvsum(uint32_t n, const term_t t[]) {
 }
 
 EXPORTED term_t yices_bvsum(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsum(n,t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsum(n,t));
 }
 
 term_t _o_yices_bvsum(uint32_t n, const term_t t[]) {
@@ -4988,7 +5106,7 @@ static term_t mk_bvproduct(uint32_t n, const term_t t[]) {
 }
 
 EXPORTED term_t yices_bvproduct(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvproduct(n,t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvproduct(n,t));
 }
 
 term_t _o_yices_bvproduct(uint32_t n, const term_t t[]) {
@@ -5034,7 +5152,7 @@ term_t _o_yices_bvproduct(uint32_t n, const term_t t[]) {
 
 
 EXPORTED term_t yices_bvnot(term_t t1) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvnot(t1));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvnot(t1));
 }
 
 term_t _o_yices_bvnot(term_t t1) {
@@ -5057,7 +5175,7 @@ term_t _o_yices_bvnot(term_t t1) {
 
 
 EXPORTED term_t yices_bvnand(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvnand(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvnand(t1, t2));
 }
 
 term_t _o_yices_bvnand(term_t t1, term_t t2) {
@@ -5078,7 +5196,7 @@ term_t _o_yices_bvnand(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvnor(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvnor(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvnor(t1, t2));
 }
 
 term_t _o_yices_bvnor(term_t t1, term_t t2) {
@@ -5099,7 +5217,7 @@ term_t _o_yices_bvnor(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvxnor(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvxnor(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvxnor(t1, t2));
 }
 
 term_t _o_yices_bvxnor(term_t t1, term_t t2) {
@@ -5125,7 +5243,7 @@ term_t _o_yices_bvxnor(term_t t1, term_t t2) {
  ***********************************/
 
 EXPORTED term_t yices_bvand(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvand(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvand(n, t));
 }
 
 term_t _o_yices_bvand(uint32_t n, const term_t t[]) {
@@ -5151,7 +5269,7 @@ term_t _o_yices_bvand(uint32_t n, const term_t t[]) {
 }
 
 EXPORTED term_t yices_bvor(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvor(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvor(n, t));
 }
 
 term_t _o_yices_bvor(uint32_t n, const term_t t[]) {
@@ -5177,7 +5295,7 @@ term_t _o_yices_bvor(uint32_t n, const term_t t[]) {
 }
 
 EXPORTED term_t yices_bvxor(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvxor(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvxor(n, t));
 }
 
 term_t _o_yices_bvxor(uint32_t n, const term_t t[]) {
@@ -5204,7 +5322,7 @@ term_t _o_yices_bvxor(uint32_t n, const term_t t[]) {
 
 
 EXPORTED term_t yices_bvand2(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvand2(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvand2(t1, t2));
 }
 
 term_t _o_yices_bvand2(term_t t1, term_t t2) {
@@ -5224,7 +5342,7 @@ term_t _o_yices_bvand2(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvor2(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvor2(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvor2(t1, t2));
 }
 
 term_t _o_yices_bvor2(term_t t1, term_t t2) {
@@ -5244,7 +5362,7 @@ term_t _o_yices_bvor2(term_t t1, term_t t2) {
 }
 
 EXPORTED term_t yices_bvxor2(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvxor2(t1,t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvxor2(t1,t2));
 }
 
 term_t _o_yices_bvxor2(term_t t1, term_t t2) {
@@ -5327,7 +5445,7 @@ EXPORTED term_t yices_bvxor3(term_t t1, term_t t2, term_t t3) {
  *   badval = n
  */
 EXPORTED term_t yices_shift_left0(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_shift_left0(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_shift_left0(t, n));
 }
 
 term_t _o_yices_shift_left0(term_t t, uint32_t n) {
@@ -5350,7 +5468,7 @@ term_t _o_yices_shift_left0(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_shift_left1(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_shift_left1(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_shift_left1(t, n));
 }
 
 term_t _o_yices_shift_left1(term_t t, uint32_t n) {
@@ -5373,7 +5491,7 @@ term_t _o_yices_shift_left1(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_shift_right0(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_shift_right0(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_shift_right0(t, n));
 }
 
 term_t _o_yices_shift_right0(term_t t, uint32_t n) {
@@ -5396,7 +5514,7 @@ term_t _o_yices_shift_right0(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_shift_right1(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_shift_right1(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_shift_right1(t, n));
 }
 
 term_t _o_yices_shift_right1(term_t t, uint32_t n) {
@@ -5419,7 +5537,7 @@ term_t _o_yices_shift_right1(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_ashift_right(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_ashift_right(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_ashift_right(t, n));
 }
 
 term_t _o_yices_ashift_right(term_t t, uint32_t n) {
@@ -5442,7 +5560,7 @@ term_t _o_yices_ashift_right(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_rotate_left(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_rotate_left(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_rotate_left(t, n));
 }
 
 term_t _o_yices_rotate_left(term_t t, uint32_t n) {
@@ -5467,7 +5585,7 @@ term_t _o_yices_rotate_left(term_t t, uint32_t n) {
 }
 
 EXPORTED term_t yices_rotate_right(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_rotate_right(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_rotate_right(t, n));
 }
 
 term_t _o_yices_rotate_right(term_t t, uint32_t n) {
@@ -5516,7 +5634,7 @@ term_t _o_yices_rotate_right(term_t t, uint32_t n) {
  *   code = INVALID_BVEXTRACT
  */
 EXPORTED term_t yices_bvextract(term_t t, uint32_t i, uint32_t j) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvextract(t, i, j));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvextract(t, i, j));
 }
 
 term_t _o_yices_bvextract(term_t t, uint32_t i, uint32_t j) {
@@ -5563,7 +5681,7 @@ term_t _o_yices_bvextract(term_t t, uint32_t i, uint32_t j) {
  *   badval = n1 + n2 (n1 = size of t1, n2 = size of t2)
  */
 EXPORTED term_t yices_bvconcat2(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconcat2(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconcat2(t1, t2));
 }
 
 term_t _o_yices_bvconcat2(term_t t1, term_t t2) {
@@ -5592,7 +5710,7 @@ term_t _o_yices_bvconcat2(term_t t1, term_t t2) {
  * Generic form
  */
 EXPORTED term_t yices_bvconcat(uint32_t n, const term_t t[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvconcat(n, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvconcat(n, t));
 }
 
 term_t _o_yices_bvconcat(uint32_t n, const term_t t[]) {
@@ -5652,7 +5770,7 @@ term_t _o_yices_bvconcat(uint32_t n, const term_t t[]) {
  *   badval = n * bitsize of t
  */
 EXPORTED term_t yices_bvrepeat(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvrepeat(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvrepeat(t, n));
 }
 
 term_t _o_yices_bvrepeat(term_t t, uint32_t n) {
@@ -5703,7 +5821,7 @@ term_t _o_yices_bvrepeat(term_t t, uint32_t n) {
  *   badval = n + bitsize of t
  */
 EXPORTED term_t yices_sign_extend(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock,_o_yices_sign_extend(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock,_o_yices_sign_extend(t, n));
 }
 
 term_t _o_yices_sign_extend(term_t t, uint32_t n) {
@@ -5754,7 +5872,7 @@ term_t _o_yices_sign_extend(term_t t, uint32_t n) {
  *   badval = n + bitsize of t
  */
 EXPORTED term_t yices_zero_extend(term_t t, uint32_t n) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_zero_extend(t, n));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_zero_extend(t, n));
 }
 
 term_t _o_yices_zero_extend(term_t t, uint32_t n) {
@@ -5804,7 +5922,7 @@ term_t _o_yices_zero_extend(term_t t, uint32_t n) {
  *   term1 = t
  */
 EXPORTED term_t yices_redand(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_redand(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_redand(t));
 }
 
 term_t _o_yices_redand(term_t t) {
@@ -5825,7 +5943,7 @@ term_t _o_yices_redand(term_t t) {
 }
 
 EXPORTED term_t yices_redor(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_redor(t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_redor(t));
 }
 
 term_t _o_yices_redor(term_t t) {
@@ -5868,7 +5986,7 @@ term_t _o_yices_redor(term_t t) {
  *   type2 = type of t2
  */
 EXPORTED term_t yices_redcomp(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_redcomp(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_redcomp(t1, t2));
 }
 
 term_t _o_yices_redcomp(term_t t1, term_t t2) {
@@ -5896,7 +6014,7 @@ term_t _o_yices_redcomp(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvshl(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvshl(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvshl(t1, t2));
 }
 
 term_t _o_yices_bvshl(term_t t1, term_t t2) {
@@ -5909,7 +6027,7 @@ term_t _o_yices_bvshl(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvlshr(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvlshr(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvlshr(t1, t2));
 }
 
 term_t _o_yices_bvlshr(term_t t1, term_t t2) {
@@ -5922,7 +6040,7 @@ term_t _o_yices_bvlshr(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvashr(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvashr(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvashr(t1, t2));
 }
 
 term_t _o_yices_bvashr(term_t t1, term_t t2) {
@@ -5942,7 +6060,7 @@ term_t _o_yices_bvashr(term_t t1, term_t t2) {
  *********************************/
 
 EXPORTED term_t yices_bvdiv(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvdiv(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvdiv(t1, t2));
 }
 
 term_t _o_yices_bvdiv(term_t t1, term_t t2) {
@@ -5954,7 +6072,7 @@ term_t _o_yices_bvdiv(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvrem(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvrem(t1,t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvrem(t1,t2));
 }
 
 term_t _o_yices_bvrem(term_t t1, term_t t2) {
@@ -5966,7 +6084,7 @@ term_t _o_yices_bvrem(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsdiv(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock,  _o_yices_bvsdiv(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock,  _o_yices_bvsdiv(t1, t2));
 }
 
 term_t _o_yices_bvsdiv(term_t t1, term_t t2) {
@@ -5978,7 +6096,7 @@ term_t _o_yices_bvsdiv(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsrem(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsrem(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsrem(t1, t2));
 }
 
 term_t _o_yices_bvsrem(term_t t1, term_t t2) {
@@ -5990,7 +6108,7 @@ term_t _o_yices_bvsrem(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsmod(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsmod(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsmod(t1, t2));
 }
 
 term_t _o_yices_bvsmod(term_t t1, term_t t2) {
@@ -6024,7 +6142,7 @@ term_t _o_yices_bvsmod(term_t t1, term_t t2) {
  *    index = i
  */
 EXPORTED term_t yices_bvarray(uint32_t n, const term_t arg[]) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvarray(n, arg));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvarray(n, arg));
 }
 
 term_t _o_yices_bvarray(uint32_t n, const term_t arg[]) {
@@ -6054,7 +6172,7 @@ term_t _o_yices_bvarray(uint32_t n, const term_t arg[]) {
  *    code = INVALID_BVEXTRACT
  */
 EXPORTED term_t yices_bitextract(term_t t, uint32_t i) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bitextract(t, i));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bitextract(t, i));
 }
 
 term_t _o_yices_bitextract(term_t t, uint32_t i) {
@@ -6074,7 +6192,7 @@ term_t _o_yices_bitextract(term_t t, uint32_t i) {
  ********************/
 
 EXPORTED term_t yices_bveq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bveq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bveq_atom(t1, t2));
 }
 
 term_t _o_yices_bveq_atom(term_t t1, term_t t2) {
@@ -6086,7 +6204,7 @@ term_t _o_yices_bveq_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvneq_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvneq_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvneq_atom(t1, t2));
 }
 
 term_t _o_yices_bvneq_atom(term_t t1, term_t t2) {
@@ -6098,7 +6216,7 @@ term_t _o_yices_bvneq_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvge_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvge_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvge_atom(t1, t2));
 }
 
 term_t _o_yices_bvge_atom(term_t t1, term_t t2) {
@@ -6110,7 +6228,7 @@ term_t _o_yices_bvge_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvgt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvgt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvgt_atom(t1, t2));
 }
 
 term_t _o_yices_bvgt_atom(term_t t1, term_t t2) {
@@ -6122,7 +6240,7 @@ term_t _o_yices_bvgt_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvle_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvle_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvle_atom(t1, t2));
 }
 
 term_t _o_yices_bvle_atom(term_t t1, term_t t2) {
@@ -6134,7 +6252,7 @@ term_t _o_yices_bvle_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvlt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock,  _o_yices_bvlt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock,  _o_yices_bvlt_atom(t1, t2));
 }
 
 term_t _o_yices_bvlt_atom(term_t t1, term_t t2) {
@@ -6146,7 +6264,7 @@ term_t _o_yices_bvlt_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsge_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsge_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsge_atom(t1, t2));
 }
 
 term_t _o_yices_bvsge_atom(term_t t1, term_t t2) {
@@ -6158,7 +6276,7 @@ term_t _o_yices_bvsge_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsgt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsgt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsgt_atom(t1, t2));
 }
 
 term_t _o_yices_bvsgt_atom(term_t t1, term_t t2) {
@@ -6170,7 +6288,7 @@ term_t _o_yices_bvsgt_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvsle_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvsle_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvsle_atom(t1, t2));
 }
 
 term_t _o_yices_bvsle_atom(term_t t1, term_t t2) {
@@ -6182,7 +6300,7 @@ term_t _o_yices_bvsle_atom(term_t t1, term_t t2) {
 
 
 EXPORTED term_t yices_bvslt_atom(term_t t1, term_t t2) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_bvslt_atom(t1, t2));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_bvslt_atom(t1, t2));
 }
 
 term_t _o_yices_bvslt_atom(term_t t1, term_t t2) {
@@ -6204,7 +6322,7 @@ term_t _o_yices_bvslt_atom(term_t t1, term_t t2) {
  * - width, height, offset = print area
  */
 EXPORTED int32_t yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_pp_type(f, tau, width, height, offset));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_pp_type(f, tau, width, height, offset));
 }
 
 int32_t _o_yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
@@ -6264,7 +6382,7 @@ EXPORTED int32_t yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t h
  * - width, height, offset = print area
  */
 EXPORTED int32_t yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_pp_term(f, t, width, height, offset));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_pp_term(f, t, width, height, offset));
 }
 
 int32_t _o_yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
@@ -6322,7 +6440,7 @@ EXPORTED int32_t yices_pp_term_fd(int fd, term_t t, uint32_t width, uint32_t hei
  * - width, height, offset = print area
  */
 EXPORTED int32_t yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_pp_term_array(f, n, a, width, height, offset, horiz));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_pp_term_array(f, n, a, width, height, offset, horiz));
 }
 
 int32_t _o_yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
@@ -6388,7 +6506,7 @@ EXPORTED int32_t yices_pp_term_array_fd(int fd, uint32_t n, const term_t a[], ui
  * Conversion to strings
  */
 EXPORTED char *yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(char*,  __yices_globals.lock, _o_yices_type_to_string(tau, width, height, offset));
+  MT_PROTECT_READ(char*,  __yices_globals.lock, _o_yices_type_to_string(tau, width, height, offset));
 }
 
 char *_o_yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
@@ -6421,7 +6539,7 @@ char *_o_yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint3
 }
 
 EXPORTED char *yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(char*,  __yices_globals.lock, _o_yices_term_to_string(t, width, height, offset));
+  MT_PROTECT_READ(char*,  __yices_globals.lock, _o_yices_term_to_string(t, width, height, offset));
 }
 
 char *_o_yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_t offset) {
@@ -6476,7 +6594,7 @@ EXPORTED void yices_free_string(char *s) {
  *   type1 = tau
  */
 EXPORTED int32_t yices_type_is_bool(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_bool(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_bool(tau));
 }
 
 int32_t _o_yices_type_is_bool(type_t tau) {
@@ -6484,7 +6602,7 @@ int32_t _o_yices_type_is_bool(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_int(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_int(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_int(tau));
 }
 
 int32_t _o_yices_type_is_int(type_t tau) {
@@ -6492,7 +6610,7 @@ int32_t _o_yices_type_is_int(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_real(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_real(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_real(tau));
 }
 
 int32_t _o_yices_type_is_real(type_t tau) {
@@ -6500,7 +6618,7 @@ int32_t _o_yices_type_is_real(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_arithmetic(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_arithmetic(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_arithmetic(tau));
 }
 
 int32_t _o_yices_type_is_arithmetic(type_t tau) {
@@ -6508,7 +6626,7 @@ int32_t _o_yices_type_is_arithmetic(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_bitvector(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_bitvector(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_bitvector(tau));
 }
 
 int32_t _o_yices_type_is_bitvector(type_t tau) {
@@ -6516,7 +6634,7 @@ int32_t _o_yices_type_is_bitvector(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_tuple(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_tuple(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_tuple(tau));
 }
 
 int32_t _o_yices_type_is_tuple(type_t tau) {
@@ -6524,7 +6642,7 @@ int32_t _o_yices_type_is_tuple(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_function(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_function(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_function(tau));
 }
 
 int32_t _o_yices_type_is_function(type_t tau) {
@@ -6532,7 +6650,7 @@ int32_t _o_yices_type_is_function(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_scalar(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_scalar(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_scalar(tau));
 }
 
 int32_t _o_yices_type_is_scalar(type_t tau) {
@@ -6540,7 +6658,7 @@ int32_t _o_yices_type_is_scalar(type_t tau) {
 }
 
 EXPORTED int32_t yices_type_is_uninterpreted(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_is_uninterpreted(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_is_uninterpreted(tau));
 }
 
 int32_t _o_yices_type_is_uninterpreted(type_t tau) {
@@ -6558,7 +6676,7 @@ int32_t _o_yices_type_is_uninterpreted(type_t tau) {
  *   type1 = tau or sigma
  */
 EXPORTED int32_t yices_test_subtype(type_t tau, type_t sigma) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_test_subtype(tau, sigma));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_test_subtype(tau, sigma));
 }
 
 int32_t _o_yices_test_subtype(type_t tau, type_t sigma) {
@@ -6576,7 +6694,7 @@ int32_t _o_yices_test_subtype(type_t tau, type_t sigma) {
  *   type1 = tau or sigma
  */
 EXPORTED int32_t yices_compatible_types(type_t tau, type_t sigma) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_compatible_types(tau, sigma));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_compatible_types(tau, sigma));
 }
 
 int32_t _o_yices_compatible_types(type_t tau, type_t sigma) {
@@ -6598,7 +6716,7 @@ int32_t _o_yices_compatible_types(type_t tau, type_t sigma) {
  *    type1 = tau
  */
 EXPORTED uint32_t yices_bvtype_size(type_t tau) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_bvtype_size(tau));
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_bvtype_size(tau));
 }
 
 uint32_t _o_yices_bvtype_size(type_t tau) {
@@ -6615,7 +6733,7 @@ uint32_t _o_yices_bvtype_size(type_t tau) {
  * - return 0 if there's an error
  */
 EXPORTED uint32_t yices_scalar_type_card(type_t tau) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_scalar_type_card(tau));
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_scalar_type_card(tau));
 }
 
 uint32_t _o_yices_scalar_type_card(type_t tau) {
@@ -6641,7 +6759,7 @@ uint32_t _o_yices_scalar_type_card(type_t tau) {
  *   type1 = tau
  */
 EXPORTED int32_t yices_type_num_children(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_num_children(tau));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_num_children(tau));
 }
 
 int32_t _o_yices_type_num_children(type_t tau) {
@@ -6669,7 +6787,7 @@ int32_t _o_yices_type_num_children(type_t tau) {
  * - return NULL_TYPE if there's an error
  */
 EXPORTED type_t yices_type_child(type_t tau, int32_t i) {
-  MT_PROTECT(type_t,  __yices_globals.lock, _o_yices_type_child(tau, i));
+  MT_PROTECT_READ(type_t,  __yices_globals.lock, _o_yices_type_child(tau, i));
 }
 
 type_t _o_yices_type_child(type_t tau, int32_t i) {
@@ -6708,7 +6826,7 @@ type_t _o_yices_type_child(type_t tau, int32_t i) {
  * - returns -1 for error, 0 if all fine.
  */
 EXPORTED int32_t yices_type_children(type_t tau, type_vector_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_type_children(tau, v));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_type_children(tau, v));
 }
 
 int32_t _o_yices_type_children(type_t tau, type_vector_t *v) {
@@ -6755,7 +6873,7 @@ int32_t _o_yices_type_children(type_t tau, type_vector_t *v) {
  *   index = -1
  */
 EXPORTED type_t yices_type_of_term(term_t t) {
-  MT_PROTECT(type_t,  __yices_globals.lock, _o_yices_type_of_term(t));
+  MT_PROTECT_READ(type_t,  __yices_globals.lock, _o_yices_type_of_term(t));
 }
 
 type_t _o_yices_type_of_term(term_t t) {
@@ -6775,7 +6893,7 @@ type_t _o_yices_type_of_term(term_t t) {
  * and set the error report as above.
  */
 EXPORTED int32_t yices_term_is_bool(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_bool(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_bool(t));
 }
 
 int32_t _o_yices_term_is_bool(term_t t) {
@@ -6783,7 +6901,7 @@ int32_t _o_yices_term_is_bool(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_int(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_int(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_int(t));
 }
 
 int32_t _o_yices_term_is_int(term_t t) {
@@ -6791,7 +6909,7 @@ int32_t _o_yices_term_is_int(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_real(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_real(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_real(t));
 }
 
 int32_t _o_yices_term_is_real(term_t t) {
@@ -6799,7 +6917,7 @@ int32_t _o_yices_term_is_real(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_arithmetic(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_arithmetic(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_arithmetic(t));
 }
 
 int32_t _o_yices_term_is_arithmetic(term_t t) {
@@ -6807,7 +6925,7 @@ int32_t _o_yices_term_is_arithmetic(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_bitvector(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_bitvector(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_bitvector(t));
 }
 
 int32_t _o_yices_term_is_bitvector(term_t t) {
@@ -6815,7 +6933,7 @@ int32_t _o_yices_term_is_bitvector(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_tuple(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_tuple(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_tuple(t));
 }
 
 int32_t _o_yices_term_is_tuple(term_t t) {
@@ -6823,7 +6941,7 @@ int32_t _o_yices_term_is_tuple(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_function(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_function(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_function(t));
 }
 
 int32_t _o_yices_term_is_function(term_t t) {
@@ -6831,7 +6949,7 @@ int32_t _o_yices_term_is_function(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_scalar(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_scalar(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_scalar(t));
 }
 
 int32_t _o_yices_term_is_scalar(term_t t) {
@@ -6847,7 +6965,7 @@ int32_t _o_yices_term_is_scalar(term_t t) {
  * return 0 if t is not a bitvector
  */
 EXPORTED uint32_t yices_term_bitsize(term_t t) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_term_bitsize(t));
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_term_bitsize(t));
 }
 
 uint32_t _o_yices_term_bitsize(term_t t) {
@@ -6863,7 +6981,7 @@ uint32_t _o_yices_term_bitsize(term_t t) {
  * - return false if t is not valid and set the error report
  */
 EXPORTED int32_t yices_term_is_ground(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_ground(t));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_term_is_ground(t));
 }
 
 int32_t _o_yices_term_is_ground(term_t t) {
@@ -6888,7 +7006,7 @@ harray_t *yices_free_vars_of_term(term_t t) {
  * - return false if t is not valid
  */
 EXPORTED int32_t yices_term_is_atomic(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_atomic(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_atomic(t));
 }
 
 int32_t _o_yices_term_is_atomic(term_t t) {
@@ -6896,7 +7014,7 @@ int32_t _o_yices_term_is_atomic(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_composite(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_composite(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_composite(t));
 }
 
 int32_t _o_yices_term_is_composite(term_t t) {
@@ -6904,7 +7022,7 @@ int32_t _o_yices_term_is_composite(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_projection(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_projection(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_projection(t));
 }
 
 int32_t _o_yices_term_is_projection(term_t t) {
@@ -6913,7 +7031,7 @@ int32_t _o_yices_term_is_projection(term_t t) {
 
 
 EXPORTED int32_t yices_term_is_sum(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_sum(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_sum(t));
 }
 
 int32_t _o_yices_term_is_sum(term_t t) {
@@ -6921,7 +7039,7 @@ int32_t _o_yices_term_is_sum(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_bvsum(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_bvsum(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_bvsum(t));
 }
 
 int32_t _o_yices_term_is_bvsum(term_t t) {
@@ -6929,7 +7047,7 @@ int32_t _o_yices_term_is_bvsum(term_t t) {
 }
 
 EXPORTED int32_t yices_term_is_product(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_is_product(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_is_product(t));
 }
 
 int32_t _o_yices_term_is_product(term_t t) {
@@ -6942,7 +7060,7 @@ int32_t _o_yices_term_is_product(term_t t) {
  * - the return code is defined in yices_types.h
  */
 EXPORTED term_constructor_t yices_term_constructor(term_t t) {
-  MT_PROTECT(term_constructor_t,  __yices_globals.lock, _o_yices_term_constructor(t));
+  MT_PROTECT_READ(term_constructor_t,  __yices_globals.lock, _o_yices_term_constructor(t));
 }
 
 term_constructor_t _o_yices_term_constructor(term_t t) {
@@ -6965,7 +7083,7 @@ term_constructor_t _o_yices_term_constructor(term_t t) {
  * - returns -1 if t is not a valid term
  */
 EXPORTED int32_t yices_term_num_children(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_num_children(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_term_num_children(t));
 }
 
 int32_t _o_yices_term_num_children(term_t t) {
@@ -6980,7 +7098,7 @@ int32_t _o_yices_term_num_children(term_t t) {
  * Get i-th child of a composite term
  */
 EXPORTED term_t yices_term_child(term_t t, int32_t i) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_term_child(t, i));
+  MT_PROTECT_READ(term_t,  __yices_globals.lock, _o_yices_term_child(t, i));
 }
 
 term_t _o_yices_term_child(term_t t, int32_t i) {
@@ -6997,7 +7115,7 @@ term_t _o_yices_term_child(term_t t, int32_t i) {
  * Store all children of a composite term t in vector v
  */
 EXPORTED int32_t yices_term_children(term_t t, term_vector_t *v) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_term_children(t, v));
+  MT_PROTECT_READ(int32_t, __yices_globals.lock, _o_yices_term_children(t, v));
 }
 
 int32_t _o_yices_term_children(term_t t, term_vector_t *v) {
@@ -7017,7 +7135,7 @@ int32_t _o_yices_term_children(term_t t, term_vector_t *v) {
  * Get the argument and index of a projection
  */
 EXPORTED int32_t yices_proj_index(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_proj_index(t));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_proj_index(t));
 }
 
 int32_t _o_yices_proj_index(term_t t) {
@@ -7038,7 +7156,7 @@ int32_t _o_yices_proj_index(term_t t) {
 }
 
 EXPORTED term_t yices_proj_arg(term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_proj_arg(t));
+  MT_PROTECT_READ(term_t,  __yices_globals.lock, _o_yices_proj_arg(t));
 }
 
 term_t _o_yices_proj_arg(term_t t) {
@@ -7054,7 +7172,7 @@ term_t _o_yices_proj_arg(term_t t) {
  * Value of a constant term
  */
 EXPORTED int32_t yices_bool_const_value(term_t t, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_bool_const_value(t, val));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_bool_const_value(t, val));
 }
 
 int32_t _o_yices_bool_const_value(term_t t, int32_t *val) {
@@ -7068,7 +7186,7 @@ int32_t _o_yices_bool_const_value(term_t t, int32_t *val) {
 
 
 EXPORTED int32_t yices_bv_const_value(term_t t, int32_t val[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_bv_const_value(t, val));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_bv_const_value(t, val));
 }
 
 int32_t _o_yices_bv_const_value(term_t t, int32_t val[]) {
@@ -7081,7 +7199,7 @@ int32_t _o_yices_bv_const_value(term_t t, int32_t val[]) {
 }
 
 EXPORTED int32_t yices_scalar_const_value(term_t t, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_scalar_const_value(t, val));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_scalar_const_value(t, val));
 }
 
 int32_t _o_yices_scalar_const_value(term_t t, int32_t *val) {
@@ -7094,7 +7212,7 @@ int32_t _o_yices_scalar_const_value(term_t t, int32_t *val) {
 }
 
 EXPORTED int32_t yices_rational_const_value(term_t t, mpq_t q) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_rational_const_value(t, q));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_rational_const_value(t, q));
 }
 
 int32_t _o_yices_rational_const_value(term_t t, mpq_t q) {
@@ -7115,7 +7233,7 @@ int32_t _o_yices_rational_const_value(term_t t, mpq_t q) {
  * - the number of bits in the bvconstant is the same as in t
  */
 EXPORTED int32_t yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_sum_component(t, i, coeff, term));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_sum_component(t, i, coeff, term));
 }
 
 int32_t _o_yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
@@ -7129,7 +7247,7 @@ int32_t _o_yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
 }
 
 EXPORTED int32_t yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *term) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_bvsum_component(t, i, val, term));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_bvsum_component(t, i, val, term));
 }
 
 int32_t _o_yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *term) {
@@ -7150,7 +7268,7 @@ int32_t _o_yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *ter
  *   (where exponent is a positive integer)
  */
 EXPORTED int32_t yices_product_component(term_t t, int32_t i, term_t *term, uint32_t *exp) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_product_component(t, i, term, exp));
+  MT_PROTECT_READ(int32_t,  __yices_globals.lock, _o_yices_product_component(t, i, term, exp));
 }
 
 int32_t _o_yices_product_component(term_t t, int32_t i, term_t *term, uint32_t *exp) {
@@ -7616,7 +7734,7 @@ bool yices_arith_buffer_is_int(rba_buffer_t *b) {
  * - DEGREE_OVERFLOW if the substitution causes an overflow
  */
 EXPORTED term_t yices_subst_term(uint32_t n, const term_t var[], const term_t map[], term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_subst_term(n, var, map, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_subst_term(n, var, map, t));
 }
 
 term_t _o_yices_subst_term(uint32_t n, const term_t var[], const term_t map[], term_t t) {
@@ -7653,7 +7771,7 @@ term_t _o_yices_subst_term(uint32_t n, const term_t var[], const term_t map[], t
  * Variant: apply the substitution to m terms t[0 .. m-1]
  */
 EXPORTED int32_t yices_subst_term_array(uint32_t n, const term_t var[], const term_t map[], uint32_t m, term_t t[]) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_subst_term_array(n, var, map, m, t));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_subst_term_array(n, var, map, m, t));
 }
 
 int32_t _o_yices_subst_term_array(uint32_t n, const term_t var[], const term_t map[], uint32_t m, term_t t[]) {
@@ -7702,7 +7820,7 @@ int32_t _o_yices_subst_term_array(uint32_t n, const term_t var[], const term_t m
  * Return NULL_TYPE if there's an error.
  */
 EXPORTED type_t yices_parse_type(const char *s) {
-  MT_PROTECT(type_t,  __yices_globals.lock, _o_yices_parse_type(s));
+  MT_PROTECT_WRITE(type_t,  __yices_globals.lock, _o_yices_parse_type(s));
 }
 
 type_t _o_yices_parse_type(const char *s) {
@@ -7718,7 +7836,7 @@ type_t _o_yices_parse_type(const char *s) {
  * Return NULL_TERM if there's an error.
  */
 EXPORTED term_t yices_parse_term(const char *s) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_parse_term(s));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_parse_term(s));
 }
 
 term_t _o_yices_parse_term(const char *s) {
@@ -7745,7 +7863,7 @@ term_t _o_yices_parse_term(const char *s) {
  * return 0 otherwise.
  */
 EXPORTED int32_t yices_set_type_name(type_t tau, const char *name) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_set_type_name(tau, name));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_set_type_name(tau, name));
 }
 
 int32_t _o_yices_set_type_name(type_t tau, const char *name) {
@@ -7772,7 +7890,7 @@ int32_t _o_yices_set_type_name(type_t tau, const char *name) {
  * return 0 otherwise.
  */
 EXPORTED int32_t yices_set_term_name(term_t t, const char *name) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_set_term_name(t, name));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_set_term_name(t, name));
 }
 
 int32_t _o_yices_set_term_name(term_t t, const char *name) {
@@ -7795,7 +7913,7 @@ int32_t _o_yices_set_term_name(term_t t, const char *name) {
  * - return NULL if tau has no name (or if tau is not a valid type)
  */
 EXPORTED const char *yices_get_type_name(type_t tau) {
-  MT_PROTECT(const char *,  __yices_globals.lock, _o_yices_get_type_name(tau));
+  MT_PROTECT_READ(const char *,  __yices_globals.lock, _o_yices_get_type_name(tau));
 }
 
 const char *_o_yices_get_type_name(type_t tau) {
@@ -7811,7 +7929,7 @@ const char *_o_yices_get_type_name(type_t tau) {
  * - return NULL is t has no name (or if t is not a valid term)
  */
 EXPORTED const char *yices_get_term_name(term_t t) {
-  MT_PROTECT(const char *,  __yices_globals.lock, _o_yices_get_term_name(t));
+  MT_PROTECT_READ(const char *,  __yices_globals.lock, _o_yices_get_term_name(t));
 }
 
 const char *_o_yices_get_term_name(term_t t) {
@@ -7827,7 +7945,7 @@ const char *_o_yices_get_term_name(term_t t) {
  * Remove name from the type table.
  */
 EXPORTED void yices_remove_type_name(const char *name) {
-  MT_PROTECT_VOID(__yices_globals.lock, _o_yices_remove_type_name(name));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_yices_remove_type_name(name));
 }
 
 void _o_yices_remove_type_name(const char *name) {
@@ -7839,7 +7957,7 @@ void _o_yices_remove_type_name(const char *name) {
  * Remove name from the term table.
  */
 EXPORTED void yices_remove_term_name(const char *name) {
-  MT_PROTECT_VOID(__yices_globals.lock, _o_yices_remove_term_name(name));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_yices_remove_term_name(name));
 }
 
 void _o_yices_remove_term_name(const char *name) {
@@ -7851,7 +7969,7 @@ void _o_yices_remove_term_name(const char *name) {
  * Get type of the given name or return NULL_TYPE (-1)
  */
 EXPORTED type_t yices_get_type_by_name(const char *name) {
-  MT_PROTECT(type_t,  __yices_globals.lock, _o_yices_get_type_by_name(name));
+  MT_PROTECT_WRITE(type_t,  __yices_globals.lock, _o_yices_get_type_by_name(name));
 }
 
 type_t _o_yices_get_type_by_name(const char *name) {
@@ -7863,7 +7981,7 @@ type_t _o_yices_get_type_by_name(const char *name) {
  * Get term of the given name or return NULL_TERM
  */
 EXPORTED term_t yices_get_term_by_name(const char *name) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_get_term_by_name(name));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_get_term_by_name(name));
 }
 
 term_t _o_yices_get_term_by_name(const char *name) {
@@ -7877,7 +7995,7 @@ term_t _o_yices_get_term_by_name(const char *name) {
  * Return 0 otherwise.
  */
 EXPORTED int32_t yices_clear_type_name(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_clear_type_name(tau));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_clear_type_name(tau));
 }
 
 int32_t _o_yices_clear_type_name(type_t tau) {
@@ -7897,7 +8015,7 @@ int32_t _o_yices_clear_type_name(type_t tau) {
  * Return 0 otherwise.
  */
 EXPORTED int32_t yices_clear_term_name(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_clear_term_name(t));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_clear_term_name(t));
 }
 
 int32_t _o_yices_clear_term_name(term_t t) {
@@ -8290,7 +8408,7 @@ static context_t *_o_yices_create_context(smt_logic_t logic, context_arch_t arch
 }
 
 context_t *yices_create_context(smt_logic_t logic, context_arch_t arch, context_mode_t mode, bool iflag, bool qflag) {
-  MT_PROTECT(context_t *, __yices_globals.lock, _o_yices_create_context(logic, arch, mode, iflag, qflag));
+  MT_PROTECT_WRITE(context_t *, __yices_globals.lock, _o_yices_create_context(logic, arch, mode, iflag, qflag));
 }
 
 
@@ -8301,7 +8419,7 @@ context_t *yices_create_context(smt_logic_t logic, context_arch_t arch, context_
  * - otherwise, if the configuration is not supported, the function returns NULL.
  */
 EXPORTED context_t *yices_new_context(const ctx_config_t *config) {
-  MT_PROTECT(context_t *, __yices_globals.lock, _o_yices_new_context(config));
+  MT_PROTECT_WRITE(context_t *, __yices_globals.lock, _o_yices_new_context(config));
 }
 context_t *_o_yices_new_context(const ctx_config_t *config) {
   smt_logic_t logic;
@@ -8565,7 +8683,7 @@ static inline bool _o_yices_assert_formula_checks(term_t t) {
 }
 
 static inline bool yices_assert_formula_checks(term_t t) {
-  MT_PROTECT(bool,  __yices_globals.lock, _o_yices_assert_formula_checks(t));
+  MT_PROTECT_WRITE(bool,  __yices_globals.lock, _o_yices_assert_formula_checks(t));
 }
 
 EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
@@ -8635,7 +8753,7 @@ static inline bool _o_yices_assert_formulas_checks(uint32_t n, const term_t t[])
 }
 
 static inline bool yices_assert_formulas_checks(uint32_t n, const term_t t[]) {
-  MT_PROTECT(bool,  __yices_globals.lock, _o_yices_assert_formulas_checks(n, t));
+  MT_PROTECT_WRITE(bool,  __yices_globals.lock, _o_yices_assert_formulas_checks(n, t));
 }
 
 EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t t[]) {
@@ -8692,6 +8810,47 @@ EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t
 }
 
 
+/*
+ * Clone ctx: create a new context with the same configuration and
+ * the same assertions as ctx.
+ * - return NULL if ctx's status is SEARCHING or INTERRUPTED
+ *   (error code = CTX_INVALID_OPERATION)
+ */
+EXPORTED context_t *yices_clone_context(context_t *ctx) {
+  MT_PROTECT_WRITE(context_t *, __yices_globals.lock, _o_yices_clone_context(ctx));
+}
+
+context_t *_o_yices_clone_context(context_t *ctx) {
+  context_t *clone;
+  int32_t code;
+
+  switch (context_status(ctx)) {
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    set_error_code(CTX_INVALID_OPERATION);
+    return NULL;
+
+  case STATUS_ERROR:
+    set_error_code(INTERNAL_EXCEPTION);
+    return NULL;
+
+  default:
+    break;
+  }
+
+  clone = alloc_context();
+  code = init_context_clone(clone, ctx);
+  if (code < 0) {
+    convert_internalization_error(code);
+    delete_context(clone);
+    free_context(clone);
+    return NULL;
+  }
+
+  return clone;
+}
+
+
 
 /*
  * Add a blocking clause: this is intended to support all-sat and variants.
@@ -8955,7 +9114,7 @@ static bool _o_unsat_core_check_assumptions(uint32_t n, const term_t a[]) {
 }
 
 static bool unsat_core_check_assumptions(uint32_t n, const term_t a[]) {
-  MT_PROTECT(bool,  __yices_globals.lock, _o_unsat_core_check_assumptions(n, a));
+  MT_PROTECT_WRITE(bool,  __yices_globals.lock, _o_unsat_core_check_assumptions(n, a));
 }
 
 /*
@@ -9255,6 +9414,573 @@ EXPORTED void yices_stop_search(context_t *ctx) {
 }
 
 
+/*
+ * Portfolio check: run check_context on n contexts in parallel
+ * - all contexts must contain the same assertions
+ * - if one of the contexts is already SAT, UNSAT, or UNKNOWN, it's
+ *   the winner and nothing else is done
+ * - worker i uses a variant of params (cf. context_portfolio.h)
+ * - the first context to finish wins and the others are interrupted
+ * - the index of the winner is returned in *winner
+ *
+ * Error report:
+ * - if n is zero: code = POS_INT_REQUIRED, badval = n
+ * - if n is more than MAX_PORTFOLIO_WORKERS: code = TOO_MANY_ARGUMENTS, badval = n
+ * - if one of the contexts is SEARCHING or INTERRUPTED: code = CTX_INVALID_OPERATION
+ */
+EXPORTED smt_status_t yices_check_context_portfolio(uint32_t n, context_t *ctx[], const param_t *params, uint32_t *winner) {
+  param_t default_params;
+  smt_status_t stat;
+  uint32_t i;
+
+  if (! check_positive(n)) {
+    return STATUS_ERROR;
+  }
+  if (n > MAX_PORTFOLIO_WORKERS) {
+    error_report_t *error = get_yices_error();
+    error->code = TOO_MANY_ARGUMENTS;
+    error->badval = n;
+    return STATUS_ERROR;
+  }
+
+  /*
+   * If a context is already solved, it's the winner.
+   * Otherwise, all contexts must be IDLE.
+   */
+  for (i=0; i<n; i++) {
+    stat = context_status(ctx[i]);
+    switch (stat) {
+    case STATUS_UNSAT:
+      context_clear_unsat(ctx[i]);
+      if (context_status(ctx[i]) == STATUS_IDLE) {
+        break;
+      }
+      // fall through intended
+    case STATUS_UNKNOWN:
+    case STATUS_SAT:
+      *winner = i;
+      return stat;
+
+    case STATUS_IDLE:
+      break;
+
+    case STATUS_SEARCHING:
+    case STATUS_INTERRUPTED:
+      set_error_code(CTX_INVALID_OPERATION);
+      return STATUS_ERROR;
+
+    case STATUS_ERROR:
+    default:
+      set_error_code(INTERNAL_EXCEPTION);
+      return STATUS_ERROR;
+    }
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx[0], &default_params);
+    params = &default_params;
+  }
+
+  stat = check_context_portfolio(n, ctx, params, winner);
+
+  for (i=0; i<n; i++) {
+    if (context_status(ctx[i]) == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx[i])) {
+      context_cleanup(ctx[i]);
+    }
+  }
+
+  return stat;
+}
+
+
+/*
+ * Parallel branch and bound: split the problem into cubes and check
+ * the cubes in parallel using n contexts (cf. context_bb.h)
+ * - all contexts must contain the same assertions and be IDLE
+ * - the index of the context that found the result is returned in *winner
+ *
+ * Error report:
+ * - if n is zero: code = POS_INT_REQUIRED, badval = n
+ * - if n is more than MAX_BB_WORKERS: code = TOO_MANY_ARGUMENTS, badval = n
+ * - if one of the contexts is not IDLE: code = CTX_INVALID_OPERATION
+ * - if the cubes can't be internalized: internalization error code
+ */
+EXPORTED smt_status_t yices_check_context_parallel_bb(uint32_t n, context_t *ctx[], const param_t *params, uint32_t *winner) {
+  param_t default_params;
+  bb_solver_t bb;
+  smt_status_t stat;
+  uint32_t i;
+  int32_t code;
+
+  if (! check_positive(n)) {
+    return STATUS_ERROR;
+  }
+  if (n > MAX_BB_WORKERS) {
+    error_report_t *error = get_yices_error();
+    error->code = TOO_MANY_ARGUMENTS;
+    error->badval = n;
+    return STATUS_ERROR;
+  }
+
+  for (i=0; i<n; i++) {
+    if (context_status(ctx[i]) != STATUS_IDLE) {
+      set_error_code(CTX_INVALID_OPERATION);
+      return STATUS_ERROR;
+    }
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx[0], &default_params);
+    params = &default_params;
+  }
+
+  init_bb_solver(&bb, n, ctx);
+
+  // the cubes are new terms: build and internalize them under the global lock
+  yices_obtain_mutex();
+  code = bb_solver_prepare(&bb);
+  yices_release_mutex();
+
+  if (code < 0) {
+    convert_internalization_error(code);
+    stat = STATUS_ERROR;
+  } else {
+    stat = bb_solver_check(&bb, params, winner);
+    for (i=0; i<n; i++) {
+      if (context_status(ctx[i]) == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx[i])) {
+        context_cleanup(ctx[i]);
+      }
+    }
+  }
+
+  delete_bb_solver(&bb);
+
+  return stat;
+}
+
+
+
+/******************
+ *  OPTIMIZATION  *
+ *****************/
+
+/*
+ * Value of arithmetic term t in the current model of ctx
+ * - ctx's status must be SAT
+ * - return false if the value is not a rational
+ */
+static bool opt_arith_value(context_t *ctx, term_t t, rational_t *q) {
+  model_t *mdl;
+  value_table_t *vtbl;
+  value_t v;
+  bool ok;
+
+  yices_obtain_mutex();
+  mdl = _o_yices_get_model(ctx, true);
+  assert(mdl != NULL);
+  v = model_get_term_value(mdl, t);
+  vtbl = model_get_vtbl(mdl);
+  ok = v >= 0 && object_is_rational(vtbl, v);
+  if (ok) {
+    q_set(q, vtbl_rational(vtbl, v));
+  }
+  yices_free_model(mdl);
+  yices_release_mutex();
+
+  return ok;
+}
+
+/*
+ * Value of bitvector term t in the current model of ctx
+ * - the bits are stored in val[0 ... n-1] where n = number of bits in t
+ *   (val[0] is the low-order bit)
+ * - return false if the value can't be computed
+ */
+static bool opt_bv_value(context_t *ctx, term_t t, int32_t *val) {
+  model_t *mdl;
+  value_table_t *vtbl;
+  value_bv_t *bv;
+  value_t v;
+  bool ok;
+
+  yices_obtain_mutex();
+  mdl = _o_yices_get_model(ctx, true);
+  assert(mdl != NULL);
+  v = model_get_term_value(mdl, t);
+  vtbl = model_get_vtbl(mdl);
+  ok = v >= 0 && object_is_bitvector(vtbl, v);
+  if (ok) {
+    bv = vtbl_bitvector(vtbl, v);
+    bvconst_get_array(bv->data, val, bv->nbits);
+  }
+  yices_free_model(mdl);
+  yices_release_mutex();
+
+  return ok;
+}
+
+/*
+ * Atom (t <= q) or (t < q) if strict is true
+ */
+static term_t opt_bound_atom(term_t t, rational_t *q, bool strict) {
+  term_t c, a;
+
+  yices_obtain_mutex();
+  c = mk_arith_constant(__yices_globals.manager, q);
+  if (strict) {
+    a = mk_arith_lt(__yices_globals.manager, t, c);
+  } else {
+    a = mk_arith_leq(__yices_globals.manager, t, c);
+  }
+  yices_release_mutex();
+
+  return a;
+}
+
+/*
+ * Atom (bit i of t) or its negation if polarity is false
+ */
+static term_t opt_bit_atom(term_t t, uint32_t i, bool polarity) {
+  term_t b;
+
+  yices_obtain_mutex();
+  b = mk_bitextract(__yices_globals.manager, t, i);
+  yices_release_mutex();
+
+  return polarity ? b : opposite_term(b);
+}
+
+
+/*
+ * Minimize arithmetic term t
+ * - ctx must be IDLE and use the simplex solver
+ *
+ * After every satisfiable check, the current model gives an upper bound
+ * 'best' on the minimum. The simplex solver then computes the minimum
+ * 'c' of t in the polytope defined by the model's branch:
+ * - for a real objective, the branch minimum is feasible if it's attained,
+ *   so we check (t <= c) next. If it's not attained (c has a positive delta
+ *   part) and (t <= c) is unsat, then the infimum of t is c, which is not
+ *   attained. Otherwise, we check (t < best) to move to another branch.
+ * - for an integer objective, c rounded up is only a lower bound for the
+ *   branch. We check (t <= c) if that improves on best, then we decrease
+ *   the bound by exponential steps until a check is unsat. Once we have a
+ *   lower bound lo, we do a binary search on [lo, best].
+ * Each query is done with a single assumption so that the context keeps
+ * its learned clauses and lemmas.
+ *
+ * On exit, if the status is SAT, the context contains a model where
+ * t is minimal (*optimal = 1), or the best model found if t is unbounded
+ * or its infimum is not attained (*optimal = 0).
+ */
+static smt_status_t opt_minimize_arith(context_t *ctx, const param_t *params, term_t t, int32_t *optimal) {
+  rational_t best, lo, m, step;
+  xrational_t c;
+  smt_status_t stat;
+  simplex_opt_code_t code;
+  int32_t x;
+  term_t a;
+  bool is_int, has_lo, sat, strict;
+
+  yices_obtain_mutex();
+  x = context_internalize_objective(ctx, t);
+  yices_release_mutex();
+  if (x < 0) {
+    convert_internalization_error(x);
+    return STATUS_ERROR;
+  }
+
+  stat = yices_check_context_with_assumptions(ctx, params, 0, NULL);
+  if (stat != STATUS_SAT) {
+    return stat;
+  }
+
+  q_init(&best);
+  q_init(&lo);
+  q_init(&m);
+  q_init(&step);
+  xq_init(&c);
+
+  is_int = is_integer_term(__yices_globals.terms, t);
+  has_lo = false;
+  q_set_one(&step);
+  code = SIMPLEX_OPT_UNAVAILABLE;
+  sat = true;
+
+  for (;;) {
+    if (sat) {
+      // new model: t's value is the new upper bound
+      if (! opt_arith_value(ctx, t, &best)) {
+        set_error_code(INTERNAL_EXCEPTION);
+        stat = STATUS_ERROR;
+        goto done;
+      }
+      code = context_minimize_objective(ctx, x, &c);
+      if (code == SIMPLEX_OPT_UNBOUNDED) {
+        goto done;
+      }
+    }
+
+    /*
+     * Next query: (t <= m) or (t < m) if strict
+     */
+    strict = false;
+    if (is_int) {
+      if (has_lo && q_ge(&lo, &best)) {
+        *optimal = 1;
+        break;
+      }
+      if (has_lo) {
+        // m := floor((lo + best - 1)/2)
+        q_set(&m, &lo);
+        q_add(&m, &best);
+        q_sub_one(&m);
+        q_set32(&step, 2); // step is not used once we have a lower bound
+        q_div(&m, &step);
+        q_floor(&m);
+      } else {
+        if (code == SIMPLEX_OPT_FOUND) {
+          // m := smallest integer above c
+          q_set(&m, &c.main);
+          if (q_is_pos(&c.delta)) {
+            q_floor(&m);
+            q_add_one(&m);
+          } else {
+            q_ceil(&m);
+          }
+        }
+        if (code != SIMPLEX_OPT_FOUND || q_ge(&m, &best)) {
+          // exponential step
+          q_set(&m, &best);
+          q_sub(&m, &step);
+          q_add(&step, &step);
+        }
+      }
+    } else if (code == SIMPLEX_OPT_FOUND && (q_lt(&c.main, &best) || q_is_pos(&c.delta))) {
+      // the branch minimum
+      q_set(&m, &c.main);
+    } else {
+      q_set(&m, &best);
+      strict = true;
+    }
+
+    a = opt_bound_atom(t, &m, strict);
+    stat = yices_check_context_with_assumptions(ctx, params, 1, &a);
+    sat = (stat == STATUS_SAT);
+    if (sat) continue;
+    if (stat != STATUS_UNSAT) goto done;
+
+    /*
+     * No model with (t <= m) or (t < m)
+     */
+    if (strict) {
+      // best is the minimum
+      *optimal = 1;
+      break;
+    }
+    if (is_int) {
+      q_set(&lo, &m);
+      q_add_one(&lo);
+      has_lo = true;
+    } else if (q_is_pos(&c.delta)) {
+      // the infimum is c.main and it's not attained
+      break;
+    } else {
+      // the branch minimum is not feasible: try (t < best) next
+      code = SIMPLEX_OPT_UNAVAILABLE;
+    }
+  }
+
+  if (! sat) {
+    /*
+     * The last check was unsat: restore a model where t <= best
+     */
+    a = opt_bound_atom(t, &best, false);
+    stat = yices_check_context_with_assumptions(ctx, params, 1, &a);
+    if (stat != STATUS_SAT) {
+      *optimal = 0;
+    }
+  }
+
+ done:
+  q_clear(&best);
+  q_clear(&lo);
+  q_clear(&m);
+  q_clear(&step);
+  xq_clear(&c);
+
+  return stat;
+}
+
+
+/*
+ * Minimize or maximize bitvector term t (interpreted as an unsigned integer)
+ * - ctx must be IDLE
+ *
+ * The bits are fixed one by one, from the high-order bit down, using
+ * assumptions: for minimization, we try bit i = 0 given the bits already
+ * fixed. If that's unsat, bit i must be 1. If the current model already
+ * has the preferred value for bit i, we fix it without checking.
+ */
+static smt_status_t opt_optimize_bv(context_t *ctx, const param_t *params, term_t t, bool maximize, int32_t *optimal) {
+  int32_t *val;
+  term_t *fixed;
+  smt_status_t stat;
+  uint32_t i, n, k;
+  bool sat;
+
+  stat = yices_check_context_with_assumptions(ctx, params, 0, NULL);
+  if (stat != STATUS_SAT) {
+    return stat;
+  }
+
+  n = term_bitsize(__yices_globals.terms, t);
+  val = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  fixed = (term_t *) safe_malloc(n * sizeof(term_t));
+
+  if (! opt_bv_value(ctx, t, val)) {
+    set_error_code(INTERNAL_EXCEPTION);
+    stat = STATUS_ERROR;
+    goto done;
+  }
+
+  // invariant: the current model satisfies fixed[0 ... k-1]
+  // sat is true if ctx contains this model
+  sat = true;
+  k = 0;
+  i = n;
+  while (i > 0) {
+    i --;
+    fixed[k] = opt_bit_atom(t, i, maximize);
+    if (val[i] == (int32_t) maximize) {
+      k ++;
+      continue;
+    }
+
+    stat = yices_check_context_with_assumptions(ctx, params, k+1, fixed);
+    if (stat == STATUS_SAT) {
+      k ++;
+      sat = true;
+      if (! opt_bv_value(ctx, t, val)) {
+        set_error_code(INTERNAL_EXCEPTION);
+        stat = STATUS_ERROR;
+        goto done;
+      }
+    } else if (stat == STATUS_UNSAT) {
+      // bit i is the other value, as in the current model
+      fixed[k] = opposite_term(fixed[k]);
+      k ++;
+      sat = false;
+    } else {
+      goto done;
+    }
+  }
+
+  assert(k == n);
+  stat = STATUS_SAT;
+  if (! sat) {
+    stat = yices_check_context_with_assumptions(ctx, params, n, fixed);
+  }
+  if (stat == STATUS_SAT) {
+    *optimal = 1;
+  }
+
+ done:
+  safe_free(val);
+  safe_free(fixed);
+
+  return stat;
+}
+
+
+/*
+ * Common part of yices_minimize and yices_maximize
+ */
+static smt_status_t yices_optimize(context_t *ctx, const param_t *params, term_t t, bool maximize, int32_t *optimal) {
+  smt_status_t stat;
+  bool ok, is_bv;
+
+  *optimal = 0;
+
+  yices_obtain_mutex();
+  is_bv = false;
+  ok = check_good_term(__yices_globals.manager, t);
+  if (ok) {
+    is_bv = is_bitvector_term(__yices_globals.terms, t);
+    if (! is_bv) {
+      ok = check_arith_term(__yices_globals.manager, t);
+      if (ok && maximize) {
+        t = _o_yices_neg(t);
+      }
+    }
+  }
+  yices_release_mutex();
+
+  if (! ok) {
+    return STATUS_ERROR;
+  }
+
+  if (! context_supports_multichecks(ctx)) {
+    set_error_code(CTX_OPERATION_NOT_SUPPORTED);
+    return STATUS_ERROR;
+  }
+
+  // cleanup
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    break;
+
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    if (context_status(ctx) == STATUS_UNSAT) {
+      return STATUS_UNSAT;
+    }
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    set_error_code(CTX_INVALID_OPERATION);
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    set_error_code(INTERNAL_EXCEPTION);
+    return STATUS_ERROR;
+  }
+
+  assert(context_status(ctx) == STATUS_IDLE);
+
+  if (is_bv) {
+    stat = opt_optimize_bv(ctx, params, t, maximize, optimal);
+  } else {
+    stat = opt_minimize_arith(ctx, params, t, optimal);
+  }
+
+  return stat;
+}
+
+
+/*
+ * Find a model of ctx that minimizes or maximizes t
+ * - t must be an arithmetic or bitvector term
+ * - bitvectors are compared as unsigned integers
+ * - ctx must support multiple checks
+ * - *optimal is set to 1 if the model is optimal, 0 otherwise
+ */
+EXPORTED smt_status_t yices_minimize(context_t *ctx, const param_t *params, term_t t, int32_t *optimal) {
+  return yices_optimize(ctx, params, t, false, optimal);
+}
+
+EXPORTED smt_status_t yices_maximize(context_t *ctx, const param_t *params, term_t t, int32_t *optimal) {
+  return yices_optimize(ctx, params, t, true, optimal);
+}
+
+
 
 /****************
  *  UNSAT CORE  *
@@ -9301,7 +10027,7 @@ EXPORTED term_t yices_get_model_interpolant(context_t *ctx) {
  *
  */
 EXPORTED model_t *yices_get_model(context_t *ctx, int32_t keep_subst) {
-  MT_PROTECT(model_t *,  __yices_globals.lock, _o_yices_get_model(ctx, keep_subst));
+  MT_PROTECT_WRITE(model_t *,  __yices_globals.lock, _o_yices_get_model(ctx, keep_subst));
 }
 
 model_t *_o_yices_get_model(context_t *ctx, int32_t keep_subst) {
@@ -9354,7 +10080,7 @@ EXPORTED void yices_free_model(model_t *mdl) {
  * - f must be open/writable
  */
 EXPORTED void yices_print_model(FILE *f, model_t *mdl) {
-  MT_PROTECT_VOID(__yices_globals.lock, _o_yices_print_model(f, mdl));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_yices_print_model(f, mdl));
 }
 
 void _o_yices_print_model(FILE *f, model_t *mdl) {
@@ -9362,7 +10088,7 @@ void _o_yices_print_model(FILE *f, model_t *mdl) {
 }
 
 EXPORTED int32_t yices_print_model_fd(int fd, model_t *mdl) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_print_model_fd(fd, mdl));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_print_model_fd(fd, mdl));
 }
 
 int32_t _o_yices_print_model_fd(int fd, model_t *mdl) {
@@ -9386,7 +10112,7 @@ int32_t _o_yices_print_model_fd(int fd, model_t *mdl) {
  * - width, height, offset = print area
  */
 EXPORTED int32_t yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_pp_model(f, mdl, width, height, offset));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_pp_model(f, mdl, width, height, offset));
 }
 
 int32_t _o_yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
@@ -9438,7 +10164,7 @@ EXPORTED int32_t yices_pp_model_fd(int fd, model_t *mdl, uint32_t width, uint32_
  * Convert mdl to a string
  */
 EXPORTED char *yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(char *,  __yices_globals.lock, _o_yices_model_to_string(mdl, width, height, offset));
+  MT_PROTECT_WRITE(char *,  __yices_globals.lock, _o_yices_model_to_string(mdl, width, height, offset));
 }
 
 char *_o_yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
@@ -9482,7 +10208,7 @@ char *_o_yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, ui
  *   term1 = a[i]
  */
 EXPORTED int32_t yices_print_term_values(FILE *f, model_t *mdl, uint32_t n, const term_t a[]) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_print_term_values(f, mdl, n, a));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_print_term_values(f, mdl, n, a));
 }
 
 int32_t _o_yices_print_term_values(FILE *f, model_t *mdl, uint32_t n, const term_t a[]) {
@@ -9534,7 +10260,7 @@ EXPORTED int32_t yices_print_term_values_fd(int fd, model_t *mdl, uint32_t n, co
  */
 EXPORTED int32_t yices_pp_term_values(FILE *f, model_t *mdl, uint32_t n, const term_t a[],
 				      uint32_t width, uint32_t height, uint32_t offset) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_pp_term_values(f, mdl, n, a, width, height, offset));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_pp_term_values(f, mdl, n, a, width, height, offset));
 }
 
 int32_t _o_yices_pp_term_values(FILE *f, model_t *mdl, uint32_t n, const term_t a[],
@@ -9619,7 +10345,7 @@ EXPORTED int32_t yices_pp_term_values_fd(int fd, model_t *mdl, uint32_t n, const
  * - code = MDL_CONSTRUCTION_FAILED: something else went wrong
  */
 EXPORTED model_t *yices_model_from_map(uint32_t n, const term_t var[], const term_t map[]) {
-  MT_PROTECT(model_t *,  __yices_globals.lock, _o_yices_model_from_map(n, var, map));
+  MT_PROTECT_WRITE(model_t *,  __yices_globals.lock, _o_yices_model_from_map(n, var, map));
 }
 
 model_t *_o_yices_model_from_map(uint32_t n, const term_t var[], const term_t map[]) {
@@ -9640,7 +10366,7 @@ model_t *_o_yices_model_from_map(uint32_t n, const term_t var[], const term_t ma
  * - the variables are stored in term_vector v
  */
 EXPORTED void yices_model_collect_defined_terms(model_t *mdl, term_vector_t *v) {
-  MT_PROTECT_VOID(__yices_globals.lock, model_get_relevant_vars(mdl, (ivector_t *) v));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, model_get_relevant_vars(mdl, (ivector_t *) v));
 }
 
 
@@ -9650,7 +10376,7 @@ EXPORTED void yices_model_collect_defined_terms(model_t *mdl, term_vector_t *v)
  * - the support is a set of uninterpreted returned in *v
  */
 EXPORTED int32_t yices_model_term_support(model_t *mdl, term_t t, term_vector_t *v) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_model_term_support(mdl, t, v));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_model_term_support(mdl, t, v));
 }
 
 int32_t _o_yices_model_term_support(model_t *mdl, term_t t, term_vector_t *v) {
@@ -9667,7 +10393,7 @@ int32_t _o_yices_model_term_support(model_t *mdl, term_t t, term_vector_t *v) {
  * - the support is a set of uninterpreted returned in *v
  */
 EXPORTED int32_t yices_model_term_array_support(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_yices_model_term_array_support(mdl, n, a, v));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_model_term_array_support(mdl, n, a, v));
 }
 
 int32_t _o_yices_model_term_array_support(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
@@ -9886,7 +10612,7 @@ static smt_status_t yices_do_check_formulas(const term_t f[], uint32_t n, const
  * The delegate is an optional argument used only when logic is "QF_BV".
  * If is ignored otherwise.   It must be the name of a third-party SAT solver
  * to use after bit-blasting. Currently, the delegate can be either "cadical",
- * "cryptominisat",  "y2sat", or NULL.
+ * "cryptominisat",  "y2sat", "y2sat-cubes", or NULL.
  * If delegate is NULL, the default SAT solver is used.
  *
  * Support for "cadical" and "cryptominisat" must be enabled at compilation
@@ -10097,7 +10823,7 @@ static inline error_code_t yices_eval_error(int32_t v) {
  * + the other evaluation error codes above.
  */
 EXPORTED int32_t yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_bool_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_bool_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
@@ -10211,7 +10937,7 @@ static bool arithval_is_rational(const arithval_struct_t *r) {
 
 // return the value as a 32bit integer
 EXPORTED int32_t yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_int32_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_int32_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
@@ -10232,7 +10958,7 @@ int32_t _o_yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
 
 // return the value as a 64bit integer
 EXPORTED int32_t yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_int64_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_int64_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
@@ -10253,7 +10979,7 @@ int32_t _o_yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
 
 // return the value as a pair num/den (both 32bit integers)
 EXPORTED int32_t yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint32_t *den) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_rational32_value(mdl, t, num, den));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_rational32_value(mdl, t, num, den));
 }
 
 int32_t _o_yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint32_t *den) {
@@ -10274,7 +11000,7 @@ int32_t _o_yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint
 
 // pair num/den (64bit integers)
 EXPORTED int32_t yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint64_t *den) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_rational64_value(mdl, t, num, den));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_rational64_value(mdl, t, num, den));
 }
 
 int32_t _o_yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint64_t *den) {
@@ -10295,7 +11021,7 @@ int32_t _o_yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint
 
 // convert to a floating point number
 EXPORTED int32_t yices_get_double_value(model_t *mdl, term_t t, double *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_double_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_double_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_double_value(model_t *mdl, term_t t, double *val) {
@@ -10320,7 +11046,7 @@ int32_t _o_yices_get_double_value(model_t *mdl, term_t t, double *val) {
 
 // convert to a GMP integer
 EXPORTED int32_t yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_mpz_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_mpz_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
@@ -10343,7 +11069,7 @@ int32_t _o_yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
 
 // convert to a GMP rational
 EXPORTED int32_t yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_mpq_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_mpq_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
@@ -10364,7 +11090,7 @@ int32_t _o_yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
  * Algebraic number
  */
 EXPORTED int32_t yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic_number_t *a) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_algebraic_number_value(mdl, t, a));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_algebraic_number_value(mdl, t, a));
 }
 
 int32_t _o_yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic_number_t *a) {
@@ -10407,7 +11133,7 @@ int32_t _o_yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic
  *   term1 = t
  */
 EXPORTED int32_t yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_bv_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_bv_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
@@ -10455,7 +11181,7 @@ int32_t _o_yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
  *   term1 = t
  */
 EXPORTED int32_t yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_scalar_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_scalar_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
@@ -10527,7 +11253,7 @@ EXPORTED void yices_delete_yval_vector(yval_vector_t *v) {
  *   code = EVAL_FAILED
  */
 EXPORTED int32_t yices_get_value(model_t *mdl, term_t t, yval_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_get_value(mdl, t, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_get_value(mdl, t, val));
 }
 
 int32_t _o_yices_get_value(model_t *mdl, term_t t, yval_t *val) {
@@ -10555,7 +11281,7 @@ int32_t _o_yices_get_value(model_t *mdl, term_t t, yval_t *val) {
  * Queries on the value of a rational node
  */
 EXPORTED int32_t yices_val_is_int32(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_is_int32(mdl, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_is_int32(mdl, v));
 }
 
 int32_t _o_yices_val_is_int32(model_t *mdl, const yval_t *v) {
@@ -10578,7 +11304,7 @@ int32_t _o_yices_val_is_int32(model_t *mdl, const yval_t *v) {
 }
 
 EXPORTED int32_t yices_val_is_int64(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_is_int64(mdl, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_is_int64(mdl, v));
 }
 
 int32_t _o_yices_val_is_int64(model_t *mdl, const yval_t *v) {
@@ -10601,7 +11327,7 @@ int32_t _o_yices_val_is_int64(model_t *mdl, const yval_t *v) {
 }
 
 EXPORTED int32_t yices_val_is_rational32(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_is_rational32(mdl, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_is_rational32(mdl, v));
 }
 
 int32_t _o_yices_val_is_rational32(model_t *mdl, const yval_t *v) {
@@ -10624,7 +11350,7 @@ int32_t _o_yices_val_is_rational32(model_t *mdl, const yval_t *v) {
 }
 
 EXPORTED int32_t yices_val_is_rational64(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_is_rational64(mdl, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_is_rational64(mdl, v));
 }
 
 int32_t _o_yices_val_is_rational64(model_t *mdl, const yval_t *v) {
@@ -10647,7 +11373,7 @@ int32_t _o_yices_val_is_rational64(model_t *mdl, const yval_t *v) {
 }
 
 EXPORTED int32_t yices_val_is_integer(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_is_integer(mdl, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_is_integer(mdl, v));
 }
 
 int32_t _o_yices_val_is_integer(model_t *mdl, const yval_t *v) {
@@ -10673,7 +11399,7 @@ int32_t _o_yices_val_is_integer(model_t *mdl, const yval_t *v) {
  * Number of bits in a bitvector constant
  */
 EXPORTED uint32_t yices_val_bitsize(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_val_bitsize(mdl, v));
+  MT_PROTECT_WRITE(uint32_t,  __yices_globals.lock, _o_yices_val_bitsize(mdl, v));
 }
 
 uint32_t _o_yices_val_bitsize(model_t *mdl, const yval_t *v) {
@@ -10700,7 +11426,7 @@ uint32_t _o_yices_val_bitsize(model_t *mdl, const yval_t *v) {
  * Number of components in a tuple
  */
 EXPORTED uint32_t yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_val_tuple_arity(mdl, v));
+  MT_PROTECT_WRITE(uint32_t,  __yices_globals.lock, _o_yices_val_tuple_arity(mdl, v));
 }
 
 uint32_t _o_yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
@@ -10727,7 +11453,7 @@ uint32_t _o_yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
  * Arity of a mapping object
  */
 EXPORTED uint32_t yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_val_mapping_arity(mdl, v));
+  MT_PROTECT_WRITE(uint32_t,  __yices_globals.lock, _o_yices_val_mapping_arity(mdl, v));
 }
 
 uint32_t _o_yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
@@ -10753,7 +11479,7 @@ uint32_t _o_yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
  * Arity of a function node
  */
 EXPORTED uint32_t yices_val_function_arity(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_val_function_arity(mdl, v));
+  MT_PROTECT_WRITE(uint32_t,  __yices_globals.lock, _o_yices_val_function_arity(mdl, v));
 }
 
 uint32_t _o_yices_val_function_arity(model_t *mdl, const yval_t *v) {
@@ -10781,7 +11507,7 @@ uint32_t _o_yices_val_function_arity(model_t *mdl, const yval_t *v) {
  * Type of a function node
  */
 EXPORTED type_t yices_val_function_type(model_t *mdl, const yval_t *v) {
-  MT_PROTECT(type_t,  __yices_globals.lock, _o_yices_val_function_type(mdl, v));
+  MT_PROTECT_WRITE(type_t,  __yices_globals.lock, _o_yices_val_function_type(mdl, v));
 }
 
 type_t _o_yices_val_function_type(model_t *mdl, const yval_t *v) {
@@ -10805,7 +11531,7 @@ type_t _o_yices_val_function_type(model_t *mdl, const yval_t *v) {
  * Extract value of a leaf node
  */
 EXPORTED int32_t yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_bool(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_bool(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val) {
@@ -10847,7 +11573,7 @@ static rational_t *yices_val_get_rational(model_t *mdl, const yval_t *v) {
 }
 
 EXPORTED int32_t yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_int32(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_int32(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
@@ -10867,7 +11593,7 @@ int32_t _o_yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
 }
 
 EXPORTED int32_t yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_int64(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_int64(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
@@ -10887,7 +11613,7 @@ int32_t _o_yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
 }
 
 EXPORTED int32_t yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num, uint32_t *den) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_rational32(mdl, v, num, den));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_rational32(mdl, v, num, den));
 }
 
 int32_t _o_yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num, uint32_t *den) {
@@ -10907,7 +11633,7 @@ int32_t _o_yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num,
 }
 
 EXPORTED int32_t yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num, uint64_t *den) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_rational64(mdl, v, num, den));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_rational64(mdl, v, num, den));
 }
 
 int32_t _o_yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num, uint64_t *den) {
@@ -10927,7 +11653,7 @@ int32_t _o_yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num,
 }
 
 EXPORTED int32_t yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_mpz(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_mpz(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
@@ -10947,7 +11673,7 @@ int32_t _o_yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
 }
 
 EXPORTED int32_t yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_mpq(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_mpq(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
@@ -10965,7 +11691,7 @@ int32_t _o_yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
 
 // Conversion to double
 EXPORTED int32_t yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_double(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_double(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
@@ -10999,7 +11725,7 @@ int32_t _o_yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
  * Value of a bitvector node
  */
 EXPORTED int32_t yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_bv(mdl, v, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_bv(mdl, v, val));
 }
 
 int32_t _o_yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
@@ -11025,7 +11751,7 @@ int32_t _o_yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
  * Algebraic number
  */
 EXPORTED int32_t yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_algebraic_number_t *a) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_algebraic_number(mdl, v, a));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_algebraic_number(mdl, v, a));
 }
 
 int32_t _o_yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_algebraic_number_t *a) {
@@ -11057,7 +11783,7 @@ int32_t _o_yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_alge
  * Value of a scalar/uninterpreted constant
  */
 EXPORTED int32_t yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, type_t *tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_get_scalar(mdl, v, val, tau));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_get_scalar(mdl, v, val, tau));
 }
 
 int32_t _o_yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, type_t *tau) {
@@ -11085,7 +11811,7 @@ int32_t _o_yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, typ
  * Expand a tuple node
  */
 EXPORTED int32_t yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t child[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_expand_tuple(mdl, v, child));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_expand_tuple(mdl, v, child));
 }
 
 
@@ -11111,7 +11837,7 @@ int32_t _o_yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t child[])
  * Expand a mapping node
  */
 EXPORTED int32_t yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[], yval_t *val) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_expand_mapping(mdl, v, tup, val));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_expand_mapping(mdl, v, tup, val));
 }
 
 int32_t _o_yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[], yval_t *val) {
@@ -11136,7 +11862,7 @@ int32_t _o_yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[],
  * Expand a function node
  */
 EXPORTED int32_t yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def, yval_vector_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_val_expand_function(mdl, f, def, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_val_expand_function(mdl, f, def, v));
 }
 
 int32_t _o_yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def, yval_vector_t *v) {
@@ -11171,7 +11897,7 @@ int32_t _o_yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def,
  * Value of term t converted to a constant term val.
  */
 EXPORTED term_t yices_get_value_as_term(model_t *mdl, term_t t) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_get_value_as_term(mdl, t));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_get_value_as_term(mdl, t));
 }
 
 term_t _o_yices_get_value_as_term(model_t *mdl, term_t t) {
@@ -11216,7 +11942,7 @@ term_t _o_yices_get_value_as_term(model_t *mdl, term_t t) {
  * - same as get_bool_val
  */
 EXPORTED int32_t yices_formula_true_in_model(model_t *mdl, term_t f) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_formula_true_in_model(mdl, f));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_formula_true_in_model(mdl, f));
 }
 
 int32_t _o_yices_formula_true_in_model(model_t *mdl, term_t f) {
@@ -11250,7 +11976,7 @@ int32_t _o_yices_formula_true_in_model(model_t *mdl, term_t f) {
  * - same as yices_get_bool_val
  */
 EXPORTED int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_formulas_true_in_model(mdl, n, f));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_formulas_true_in_model(mdl, n, f));
 }
 
 int32_t _o_yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]) {
@@ -11284,7 +12010,7 @@ int32_t _o_yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f
  * Values of terms a[0 ... n-1] all converted to terms
  */
 EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_term_array_value(mdl, n, a, b));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_term_array_value(mdl, n, a, b));
 }
 
 int32_t _o_yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]) {
@@ -11339,7 +12065,7 @@ int32_t _o_yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], te
  * - EVAL_FAILED          if the function fails for some other reason
  */
 EXPORTED int32_t yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_implicant_for_formula(mdl, t, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_implicant_for_formula(mdl, t, v));
 }
 
 int32_t _o_yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v) {
@@ -11365,7 +12091,7 @@ int32_t _o_yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v)
  * Same thing for an array of formulas a[0 ... n-1]
  */
 EXPORTED int32_t yices_implicant_for_formulas(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_implicant_for_formulas(mdl, n, a, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_implicant_for_formulas(mdl, n, a, v));
 }
 
 int32_t _o_yices_implicant_for_formulas(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
@@ -11440,7 +12166,7 @@ static inline error_code_t yices_gen_error(int32_t v) {
  */
 EXPORTED int32_t yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const term_t elim[],
 					yices_gen_mode_t mode, term_vector_t *v) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_generalize_model(mdl, t, nelims, elim, mode, v));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_generalize_model(mdl, t, nelims, elim, mode, v));
 }
 
 int32_t _o_yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const term_t elim[],
@@ -11482,7 +12208,7 @@ int32_t _o_yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const
  */
 EXPORTED term_t yices_generalize_model_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t nelims, const term_t elim[],
 					     yices_gen_mode_t mode, term_vector_t *v) {
-  MT_PROTECT(term_t,  __yices_globals.lock, _o_yices_generalize_model_array(mdl, n, a, nelims, elim, mode, v));
+  MT_PROTECT_WRITE(term_t,  __yices_globals.lock, _o_yices_generalize_model_array(mdl, n, a, nelims, elim, mode, v));
 }
 
 term_t _o_yices_generalize_model_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t nelims, const term_t elim[],
@@ -11550,7 +12276,7 @@ static sparse_array_t *get_root_types(void) {
  * Increment/decrement the reference counters
  */
 EXPORTED int32_t yices_incref_term(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_incref_term(t));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_incref_term(t));
 }
 
 int32_t _o_yices_incref_term(term_t t) {
@@ -11569,7 +12295,7 @@ int32_t _o_yices_incref_term(term_t t) {
 }
 
 EXPORTED int32_t yices_incref_type(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_incref_type(tau));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_incref_type(tau));
 }
 
 int32_t _o_yices_incref_type(type_t tau) {
@@ -11586,7 +12312,7 @@ int32_t _o_yices_incref_type(type_t tau) {
 }
 
 EXPORTED int32_t yices_decref_term(term_t t) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_decref_term(t));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_decref_term(t));
 }
 
 int32_t _o_yices_decref_term(term_t t) {
@@ -11607,7 +12333,7 @@ int32_t _o_yices_decref_term(term_t t) {
 }
 
 EXPORTED int32_t yices_decref_type(type_t tau) {
-  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_decref_type(tau));
+  MT_PROTECT_WRITE(int32_t,  __yices_globals.lock, _o_yices_decref_type(tau));
 }
 
 int32_t _o_yices_decref_type(type_t tau) {
@@ -11632,7 +12358,7 @@ int32_t _o_yices_decref_type(type_t tau) {
  * Number of live terms and types
  */
 EXPORTED uint32_t yices_num_terms(void) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_num_terms());
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_num_terms());
 }
 
 uint32_t _o_yices_num_terms(void) {
@@ -11640,7 +12366,7 @@ uint32_t _o_yices_num_terms(void) {
 }
 
 EXPORTED uint32_t yices_num_types(void) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_num_types());
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_num_types());
 }
 
 uint32_t _o_yices_num_types(void) {
@@ -11652,7 +12378,7 @@ uint32_t _o_yices_num_types(void) {
  * Number of terms/types with a positive reference count
  */
 EXPORTED uint32_t yices_num_posref_terms(void) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_num_posref_terms());
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_num_posref_terms());
 }
 
 uint32_t _o_yices_num_posref_terms(void) {
@@ -11666,7 +12392,7 @@ uint32_t _o_yices_num_posref_terms(void) {
 }
 
 EXPORTED uint32_t yices_num_posref_types(void) {
-  MT_PROTECT(uint32_t,  __yices_globals.lock, _o_yices_num_posref_types());
+  MT_PROTECT_READ(uint32_t,  __yices_globals.lock, _o_yices_num_posref_types());
 }
 
 uint32_t _o_yices_num_posref_types(void) {
@@ -11750,6 +12476,28 @@ static void mark_type_array(type_table_t *tbl, const type_t *a, uint32_t n) {
 }
 
 
+/*
+ * Mark the roots:
+ * - all terms and types in all live models and contexts
+ * - terms in t[0 ... nt-1] and types in tau[0 ... ntau-1] (if t/tau are non NULL)
+ * - terms and types with a positive reference count
+ */
+static void mark_gc_roots(const term_t t[], uint32_t nt, const type_t tau[], uint32_t ntau) {
+  context_list_gc_mark();
+  model_list_gc_mark();
+
+  if (t != NULL) mark_term_array(__yices_globals.terms, t, nt);
+  if (tau != NULL) mark_type_array(__yices_globals.types, tau, ntau);
+
+  if (root_terms != NULL) {
+    sparse_array_iterate(root_terms, __yices_globals.terms, term_idx_marker);
+  }
+  if (root_types != NULL) {
+    sparse_array_iterate(root_types, __yices_globals.types, type_marker);
+  }
+}
+
+
 /*
  * Call the garbage collector
  * - t = optional array of terms
@@ -11762,7 +12510,7 @@ static void mark_type_array(type_table_t *tbl, const type_t *a, uint32_t n) {
 EXPORTED void yices_garbage_collect(const term_t t[], uint32_t nt,
 				    const type_t tau[], uint32_t ntau,
 				    int32_t keep_named) {
-  MT_PROTECT_VOID(__yices_globals.lock, _o_yices_garbage_collect(t, nt, tau, ntau, keep_named));
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_yices_garbage_collect(t, nt, tau, ntau, keep_named));
 }
 
 void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
@@ -11773,27 +12521,7 @@ void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
 
   get_list_locks();
 
-  /*
-   * Default roots: all terms and types in all live models and context
-   */
-  context_list_gc_mark();
-  model_list_gc_mark();
-
-  /*
-   * Add roots from t and tau
-   */
-  if (t != NULL) mark_term_array(__yices_globals.terms, t, nt);
-  if (tau != NULL) mark_type_array(__yices_globals.types, tau, ntau);
-
-  /*
-   * Roots from the reference counting
-   */
-  if (root_terms != NULL) {
-    sparse_array_iterate(root_terms, __yices_globals.terms, term_idx_marker);
-  }
-  if (root_types != NULL) {
-    sparse_array_iterate(root_types, __yices_globals.types, type_marker);
-  }
+  mark_gc_roots(t, nt, tau, ntau);
 
   /*
    * Call the garbage collector
@@ -11811,3 +12539,111 @@ void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
   release_list_locks();
 
 }
+
+
+/*
+ * Young-generation collection: only the terms created since the
+ * last collection can be deleted.
+ * - t = optional array of terms
+ * - nt = size of t
+ * - keep_named specifies whether the named terms should all be preserved
+ */
+EXPORTED void yices_garbage_collect_young(const term_t t[], uint32_t nt, int32_t keep_named) {
+  MT_PROTECT_WRITE_VOID(__yices_globals.lock, _o_yices_garbage_collect_young(t, nt, keep_named));
+}
+
+void _o_yices_garbage_collect_young(const term_t t[], uint32_t nt, int32_t keep_named) {
+  bool keep;
+
+  get_list_locks();
+
+  mark_gc_roots(t, nt, NULL, 0);
+
+  keep = (keep_named != 0);
+  term_table_young_gc(__yices_globals.terms, keep);
+
+  if (__yices_globals.fvars != NULL) {
+    cleanup_fvar_collector(__yices_globals.fvars);
+  }
+
+  release_list_locks();
+}
+
+
+
+/*******************************
+ *  SAVING AND LOADING TERMS   *
+ ******************************/
+
+/*
+ * Save all terms and types in filename
+ * - t[0 ... nt-1] = roots
+ */
+EXPORTED int32_t yices_save_terms(const char *filename, uint32_t nt, const term_t t[]) {
+  MT_PROTECT_READ(int32_t, __yices_globals.lock, _o_yices_save_terms(filename, nt, t));
+}
+
+int32_t _o_yices_save_terms(const char *filename, uint32_t nt, const term_t t[]) {
+  FILE *f;
+  int32_t code;
+
+  if (! check_good_terms(__yices_globals.manager, nt, t)) {
+    return -1;
+  }
+
+  f = fopen(filename, "wb");
+  if (f == NULL) {
+    file_output_error();
+    return -1;
+  }
+
+  code = dump_term_table(f, __yices_globals.terms, nt, t);
+  if (fclose(f) == EOF) {
+    code = TERM_DUMP_WRITE_ERROR;
+  }
+  if (code < 0) {
+    file_output_error();
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/*
+ * Load the terms and types saved in filename
+ * - the roots are stored in v if v is non-NULL
+ */
+EXPORTED int32_t yices_load_terms(const char *filename, term_vector_t *v) {
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_yices_load_terms(filename, v));
+}
+
+int32_t _o_yices_load_terms(const char *filename, term_vector_t *v) {
+  FILE *f;
+  int32_t code;
+
+  f = fopen(filename, "rb");
+  if (f == NULL) {
+    set_error_code(INPUT_ERROR);
+    return -1;
+  }
+
+  if (v != NULL) {
+    yices_reset_term_vector(v);
+  }
+  code = load_term_table(f, __yices_globals.terms, (ivector_t *) v);
+  fclose(f);
+
+  switch (code) {
+  case 0:
+    return 0;
+
+  case TERM_DUMP_READ_ERROR:
+    set_error_code(INPUT_ERROR);
+    return -1;
+
+  default:
+    set_error_code(INVALID_TERM_DUMP);
+    return -1;
+  }
+}
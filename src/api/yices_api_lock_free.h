@@ -572,6 +572,7 @@ extern int32_t _o_yices_clear_term_name(term_t t);
  ************************/
 
 extern context_t *_o_yices_new_context(const ctx_config_t *config);
+extern context_t *_o_yices_clone_context(context_t *ctx);
 
 //iam: this one is defined in context.c
 extern int32_t _o_assert_formulas(context_t *ctx, uint32_t n, const term_t *f);
@@ -758,6 +759,12 @@ extern void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
                                      const type_t tau[], uint32_t ntau,
                                      int32_t keep_named);
 
+extern void _o_yices_garbage_collect_young(const term_t t[], uint32_t nt, int32_t keep_named);
+
+extern int32_t _o_yices_save_terms(const char *filename, uint32_t nt, const term_t t[]);
+
+extern int32_t _o_yices_load_terms(const char *filename, term_vector_t *v);
+
 
 
 #endif /* ___O_YICES_API_H */
@@ -490,6 +490,14 @@ int32_t print_error(FILE *f) {
     code = fprintf(f, "output error\n");
     break;
 
+  case INPUT_ERROR:
+    code = fprintf(f, "input error\n");
+    break;
+
+  case INVALID_TERM_DUMP:
+    code = fprintf(f, "invalid term dump\n");
+    break;
+
   case MCSAT_ERROR_UNSUPPORTED_THEORY:
     code = fprintf(f, "mcsat: unsupported theory\n");
     break;
@@ -979,6 +987,14 @@ char *error_string(void) {
     nchar = snprintf(buffer, BUFFER_SIZE, "output error");
     break;
 
+  case INPUT_ERROR:
+    nchar = snprintf(buffer, BUFFER_SIZE, "input error");
+    break;
+
+  case INVALID_TERM_DUMP:
+    nchar = snprintf(buffer, BUFFER_SIZE, "invalid term dump");
+    break;
+
   case MCSAT_ERROR_UNSUPPORTED_THEORY:
     nchar = snprintf(buffer, BUFFER_SIZE, "mcsat: unsupported theory");
     break;
@@ -24,19 +24,6 @@
 
 #include "mt/thread_macros.h"
 
-/*
- * Thread Local Errors
- *
- * THREAD_SAFE implies that we HAVE_TLS
- *
- */
-#ifdef THREAD_SAFE
-#define YICES_THREAD_LOCAL __thread
-#else
-#define YICES_THREAD_LOCAL
-#endif
-
-
 /*
  * Thread Local Errors Globals
  */
@@ -39,7 +39,7 @@
 
 typedef struct yices_globals_s {
 #ifdef THREAD_SAFE
-  yices_lock_t lock;       // a lock protecting the globals
+  yices_rwlock_t lock;     // a reader/writer lock protecting the globals
 #endif
   type_table_t *types;     // type table
   term_table_t *terms;     // term table
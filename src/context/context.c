@@ -5581,6 +5581,8 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_ivector(&ctx->top_atoms, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->top_formulas, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->top_interns, CTX_DEFAULT_VECTOR_SIZE);
+  init_ivector(&ctx->assertions, CTX_DEFAULT_VECTOR_SIZE);
+  init_ivector(&ctx->assertion_marks, 0);
 
   /*
    * Force the internalization mapping for true and false
@@ -5693,6 +5695,8 @@ void delete_context(context_t *ctx) {
   delete_ivector(&ctx->top_atoms);
   delete_ivector(&ctx->top_formulas);
   delete_ivector(&ctx->top_interns);
+  delete_ivector(&ctx->assertions);
+  delete_ivector(&ctx->assertion_marks);
 
   delete_ivector(&ctx->subst_eqs);
   delete_ivector(&ctx->aux_eqs);
@@ -5746,6 +5750,8 @@ void reset_context(context_t *ctx) {
   ivector_reset(&ctx->top_atoms);
   ivector_reset(&ctx->top_formulas);
   ivector_reset(&ctx->top_interns);
+  ivector_reset(&ctx->assertions);
+  ivector_reset(&ctx->assertion_marks);
 
   // Force the internalization mapping for true and false
   intern_tbl_map_root(&ctx->intern, true_term, bool2code(true));
@@ -5805,6 +5811,7 @@ void context_push(context_t *ctx) {
   assumption_stack_push(&ctx->assumptions);
   context_eq_cache_push(ctx);
   context_divmod_table_push(ctx);
+  ivector_push(&ctx->assertion_marks, ctx->assertions.size);
 
   ctx->base_level ++;
 }
@@ -5819,6 +5826,9 @@ void context_pop(context_t *ctx) {
   assumption_stack_pop(&ctx->assumptions);
   context_eq_cache_pop(ctx);
   context_divmod_table_pop(ctx);
+  assert(ctx->assertion_marks.size == ctx->base_level);
+  ivector_shrink(&ctx->assertions, ivector_last(&ctx->assertion_marks));
+  ivector_pop(&ctx->assertion_marks);
 
   ctx->base_level --;
 }
@@ -6127,6 +6137,9 @@ int32_t _o_assert_formulas(context_t *ctx, uint32_t n, const term_t *f) {
   assert(!context_quant_enabled(ctx));
 
   code = context_process_assertions(ctx, n, f);
+  if (code >= 0) {
+    ivector_add(&ctx->assertions, f, n);
+  }
   if (code == TRIVIALLY_UNSAT) {
     if (ctx->arch == CTX_ARCH_AUTO_IDL || ctx->arch == CTX_ARCH_AUTO_RDL) {
       // cleanup: reset arch/config to 'no theory'
@@ -6186,7 +6199,7 @@ int32_t quant_assert_formulas(context_t *ctx, uint32_t n, const term_t *f) {
 }
 
 int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f) {
-  MT_PROTECT(int32_t, __yices_globals.lock, _o_assert_formulas(ctx, n, f));
+  MT_PROTECT_WRITE(int32_t, __yices_globals.lock, _o_assert_formulas(ctx, n, f));
 }
 
 
@@ -6210,6 +6223,53 @@ int32_t assert_formula(context_t *ctx, term_t f) {
 }
 
 
+/*
+ * Initialize ctx as a clone of src
+ * - ctx gets the same logic, mode, architecture, and options as src
+ * - then all the formulas asserted in src are asserted in ctx,
+ *   with a push for each backtrack point of src.
+ */
+int32_t init_context_clone(context_t *ctx, context_t *src) {
+  uint32_t i, j, k;
+  int32_t code;
+
+  init_context(ctx, src->terms, src->logic, src->mode, src->arch, context_allows_quantifiers(src));
+  ctx->options = src->options;
+  if (splx_eager_lemmas_enabled(src)) enable_splx_eager_lemmas(ctx);
+  if (splx_periodic_icheck_enabled(src)) enable_splx_periodic_icheck(ctx);
+  if (splx_eqprop_enabled(src)) enable_splx_eqprop(ctx);
+  ctx->mcsat_options = src->mcsat_options;
+
+  if (src->arch == CTX_ARCH_NOSOLVERS && src->assertions.size > 0 &&
+      smt_status(src->core) == STATUS_UNSAT) {
+    /*
+     * src was an AUTO_IDL or AUTO_RDL context and its assertions were
+     * found trivially unsat: its solvers were removed so we can't
+     * replay the assertions.
+     */
+    add_empty_clause(ctx->core);
+    ctx->core->status = STATUS_UNSAT;
+    return TRIVIALLY_UNSAT;
+  }
+
+  code = CTX_NO_ERROR;
+  i = 0;
+  for (k=0; k<=src->base_level; k++) {
+    j = (k < src->base_level) ? src->assertion_marks.data[k] : src->assertions.size;
+    if (i < j) {
+      code = _o_assert_formulas(ctx, j - i, src->assertions.data + i);
+      if (code != CTX_NO_ERROR) break;
+    }
+    if (k < src->base_level) {
+      context_push(ctx);
+    }
+    i = j;
+  }
+
+  return code;
+}
+
+
 /*
  * Convert boolean term t to a literal l in context ctx
  * - t must be a boolean term
@@ -6280,6 +6340,53 @@ int32_t context_add_assumption(context_t *ctx, term_t t) {
 
 
 
+/*
+ * Convert arithmetic term t to an objective variable
+ * - the context must use the simplex solver
+ * - the variable is marked so that the simplex solver keeps it
+ * - return a negative code if t can't be internalized
+ * - return the variable x otherwise (where x>=0)
+ */
+int32_t context_internalize_objective(context_t *ctx, term_t t) {
+  int code;
+  thvar_t x;
+
+  assert(is_arithmetic_term(ctx->terms, t));
+
+  if (! context_has_simplex_solver(ctx)) {
+    return ARITH_NOT_SUPPORTED;
+  }
+
+  code = setjmp(ctx->env);
+  if (code == 0) {
+    internalization_start(ctx->core);
+    x = internalize_to_arith(ctx, t);
+    simplex_keep_var(ctx->arith_solver, x);
+  } else {
+    assert(code < 0);
+    ivector_reset(&ctx->aux_vector);
+    reset_istack(&ctx->istack);
+    int_queue_reset(&ctx->queue);
+    context_free_subst(ctx);
+    context_free_marks(ctx);
+    x = code;
+  }
+
+  return x;
+}
+
+
+/*
+ * Minimum of objective variable x in the current branch
+ * - ctx's status must be SAT
+ * - the result is stored in *v if the returned code is SIMPLEX_OPT_FOUND
+ */
+simplex_opt_code_t context_minimize_objective(context_t *ctx, thvar_t x, xrational_t *v) {
+  assert(context_has_simplex_solver(ctx) && smt_status(ctx->core) == STATUS_SAT);
+  return simplex_minimize_var(ctx->arith_solver, x, v);
+}
+
+
 /*
  * PROVISIONAL: FOR TESTING/DEBUGGING
  */
@@ -6573,6 +6680,8 @@ static void ctx_mark_eq(void *aux, const pmap2_rec_t *p) {
  * that they use.
  */
 void context_gc_mark(context_t *ctx) {
+  uint32_t i, n;
+
   if (ctx->egraph != NULL) {
     egraph_gc_mark(ctx->egraph);
   }
@@ -6582,6 +6691,11 @@ void context_gc_mark(context_t *ctx) {
 
   intern_tbl_gc_mark(&ctx->intern);
 
+  n = ctx->assertions.size;
+  for (i=0; i<n; i++) {
+    term_table_set_gc_mark(ctx->terms, index_of(ctx->assertions.data[i]));
+  }
+
   // empty all the term vectors to be safe
   ivector_reset(&ctx->top_eqs);
   ivector_reset(&ctx->top_atoms);
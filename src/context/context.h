@@ -25,6 +25,7 @@
 
 #include "api/search_parameters.h"
 #include "context/context_utils.h"
+#include "solvers/simplex/simplex_types.h"
 
 
 /********************************
@@ -134,6 +135,23 @@ extern int32_t assert_formula(context_t *ctx, term_t f);
 extern int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f);
 
 
+/*
+ * Initialize ctx as a copy of src:
+ * - ctx has the same logic, mode, architecture, and options as src
+ * - all formulas asserted in src (at all backtrack levels) are asserted
+ *   in ctx, and ctx has the same number of backtrack points as src.
+ *
+ * The two contexts are independent: they share the term table but
+ * nothing else. Blocking clauses and assumptions are not copied.
+ *
+ * Return code: same as assert_formulas
+ * - if the code is negative, ctx is initialized but contains only
+ *   the assertions that were processed before the error.
+ *   It must still be deleted.
+ */
+extern int32_t init_context_clone(context_t *ctx, context_t *src);
+
+
 /*
  * Assert all formulas f[0] ... f[n-1] during quantifier instantiation
  * The context status must be SEARCHING.
@@ -167,6 +185,28 @@ extern int32_t context_internalize(context_t *ctx, term_t t);
 extern int32_t context_add_assumption(context_t *ctx, term_t t);
 
 
+/*
+ * Convert arithmetic term t to a simplex variable x to be used as
+ * an optimization objective (cf. context_minimize_objective)
+ * - the context must use the simplex solver
+ * - return a negative code if t can't be internalized
+ * - return the variable x otherwise (where x>=0).
+ */
+extern int32_t context_internalize_objective(context_t *ctx, term_t t);
+
+/*
+ * Minimum of objective x in the polytope explored by the last check
+ * - ctx's status must be SAT
+ * - x must be a variable returned by context_internalize_objective
+ *   before the check
+ * - return SIMPLEX_OPT_FOUND and store the minimum in *v, or
+ *   SIMPLEX_OPT_UNBOUNDED, or SIMPLEX_OPT_UNAVAILABLE.
+ * The minimum is local to the branch of the last model (i.e., it
+ * depends on all the atoms true in that model).
+ */
+extern simplex_opt_code_t context_minimize_objective(context_t *ctx, thvar_t x, xrational_t *v);
+
+
 /*
  * Add the blocking clause to ctx
  * - ctx->status must be either SAT or UNKNOWN
@@ -335,7 +375,7 @@ extern smt_status_t precheck_context(context_t *ctx);
 /*
  * Solve using another SAT solver
  * - sat_solver = name of the external SAT solver to use
- *   sat_solver can be either "y2sat" or "cadical"
+ *   sat_solver can be "y2sat", "y2sat-cubes" (cube-and-conquer), or "cadical"
  * - verbosity = verbosity level
  *
  * This may be used only for BV or pure SAT problems
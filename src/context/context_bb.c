@@ -0,0 +1,663 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL BRANCH AND BOUND: SPLIT INTEGER DOMAINS INTO CUBES AND
+ * SOLVE THE CUBES IN PARALLEL
+ */
+
+#include <assert.h>
+
+#include "api/search_parameters.h"
+#include "context/context.h"
+#include "context/context_bb.h"
+#include "context/context_utils.h"
+#include "terms/rba_buffer_terms.h"
+#include "terms/term_manager.h"
+#include "utils/int_array_sort2.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+#include "utils/memalloc.h"
+
+#ifdef THREAD_SAFE
+#include "mt/threads.h"
+#include "mt/yices_locks.h"
+#endif
+
+
+/*
+ * INITIALIZATION/DELETION
+ */
+void init_bb_solver(bb_solver_t *bb, uint32_t n, context_t **ctx) {
+  assert(0 < n && n <= MAX_BB_WORKERS);
+
+  bb->nworkers = n;
+  bb->ctx = ctx;
+  bb->dom = NULL;
+  bb->ndoms = 0;
+  bb->ncubes = 0;
+  bb->natoms = 0;
+  bb->start = NULL;
+  bb->atom = NULL;
+  bb->lit = NULL;
+}
+
+void delete_bb_solver(bb_solver_t *bb) {
+  safe_free(bb->dom);
+  safe_free(bb->start);
+  safe_free(bb->atom);
+  safe_free(bb->lit);
+  bb->dom = NULL;
+  bb->start = NULL;
+  bb->atom = NULL;
+  bb->lit = NULL;
+}
+
+
+
+/*
+ * DOMAINS
+ */
+
+/*
+ * Check whether t is of the form a * x + c where x is an uninterpreted
+ * integer term, a is +1 or -1, and c is a 32bit integer.
+ * - if so, store x, a, c in *x, *a, *c and return true
+ */
+static bool bb_unit_linear_term(term_table_t *terms, term_t t, term_t *x, int32_t *a, int64_t *c) {
+  polynomial_t *p;
+  rational_t *q;
+  int32_t k, v;
+  uint32_t i;
+
+  switch (term_kind(terms, t)) {
+  case UNINTERPRETED_TERM:
+    if (is_integer_term(terms, t)) {
+      *x = t;
+      *a = 1;
+      *c = 0;
+      return true;
+    }
+    break;
+
+  case ARITH_POLY:
+    p = poly_term_desc(terms, t);
+    i = 0;
+    *c = 0;
+    if (p->nterms == 2 && p->mono[0].var == const_idx) {
+      q = &p->mono[0].coeff;
+      if (! q_get32(q, &v)) return false;
+      *c = v;
+      i = 1;
+    }
+    if (p->nterms != i + 1) return false;
+    k = p->mono[i].var;
+    q = &p->mono[i].coeff;
+    if (term_kind(terms, k) == UNINTERPRETED_TERM && is_integer_term(terms, k)) {
+      if (q_is_one(q)) {
+        *x = k;
+        *a = 1;
+        return true;
+      }
+      if (q_is_minus_one(q)) {
+        *x = k;
+        *a = -1;
+        return true;
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  return false;
+}
+
+
+/*
+ * Get the domain of x: create it if needed
+ */
+static bb_domain_t *bb_get_domain(int_hmap_t *map, bb_domain_t **dom, uint32_t *size, uint32_t *ndoms, term_t x) {
+  int_hmap_pair_t *r;
+  bb_domain_t *d;
+  uint32_t i;
+
+  r = int_hmap_get(map, x);
+  if (r->val < 0) {
+    i = *ndoms;
+    if (i == *size) {
+      *size = (*size == 0) ? 16 : *size + (*size >> 1);
+      *dom = (bb_domain_t *) safe_realloc(*dom, *size * sizeof(bb_domain_t));
+    }
+    d = *dom + i;
+    d->var = x;
+    d->has_lb = false;
+    d->has_ub = false;
+    d->lb = 0;
+    d->ub = 0;
+    r->val = i;
+    *ndoms = i + 1;
+  }
+  return *dom + r->val;
+}
+
+static void bb_add_lower_bound(bb_domain_t *d, int64_t b) {
+  if (! d->has_lb || b > d->lb) {
+    d->has_lb = true;
+    d->lb = b;
+  }
+}
+
+static void bb_add_upper_bound(bb_domain_t *d, int64_t b) {
+  if (! d->has_ub || b < d->ub) {
+    d->has_ub = true;
+    d->ub = b;
+  }
+}
+
+
+/*
+ * Width of a domain (both bounds must be known)
+ */
+static inline int64_t bb_width(bb_domain_t *d) {
+  assert(d->has_lb && d->has_ub);
+  return d->ub - d->lb;
+}
+
+/*
+ * Ordering for the split variables: widest domain first
+ */
+static bool bb_wider(void *data, int32_t i, int32_t j) {
+  bb_domain_t *dom;
+  int64_t wi, wj;
+
+  dom = data;
+  wi = bb_width(dom + i);
+  wj = bb_width(dom + j);
+  return wi > wj || (wi == wj && i < j);
+}
+
+
+/*
+ * Collect the domains from the assertions of ctx
+ * - top-level conjunctions are flattened
+ * - atom (a * x + c >= 0) is a lower bound on x if a = 1, an upper bound if a = -1
+ * - its negation is (a * x + c <= -1) since x is an integer
+ * - the split variables (at most BB_MAX_SPLIT_VARS with both bounds and
+ *   a non-trivial domain) are stored in bb->dom
+ */
+static void bb_collect_domains(bb_solver_t *bb, context_t *ctx) {
+  term_table_t *terms;
+  int_hmap_t map;
+  ivector_t stack;
+  ivector_t split;
+  composite_term_t *or;
+  bb_domain_t *dom, *d;
+  uint32_t i, j, size, ndoms;
+  term_t t, x;
+  int32_t a;
+  int64_t c;
+
+  terms = ctx->terms;
+  dom = NULL;
+  size = 0;
+  ndoms = 0;
+
+  init_int_hmap(&map, 0);
+  init_ivector(&stack, 10);
+  init_ivector(&split, 10);
+
+  for (i=0; i<ctx->assertions.size; i++) {
+    ivector_push(&stack, ctx->assertions.data[i]);
+    while (stack.size > 0) {
+      t = ivector_pop2(&stack);
+      switch (term_kind(terms, t)) {
+      case OR_TERM:
+        if (is_neg_term(t)) {
+          // (not (or a_1 ... a_k)) is (and (not a_1) ... (not a_k))
+          or = or_term_desc(terms, t);
+          for (j=0; j<or->arity; j++) {
+            ivector_push(&stack, opposite_term(or->arg[j]));
+          }
+        }
+        break;
+
+      case ARITH_GE_ATOM:
+        if (bb_unit_linear_term(terms, arith_atom_arg(terms, t), &x, &a, &c)) {
+          d = bb_get_domain(&map, &dom, &size, &ndoms, x);
+          if (is_pos_term(t)) {
+            // a * x + c >= 0
+            if (a > 0) {
+              bb_add_lower_bound(d, -c);
+            } else {
+              bb_add_upper_bound(d, c);
+            }
+          } else {
+            // a * x + c <= -1
+            if (a > 0) {
+              bb_add_upper_bound(d, - c - 1);
+            } else {
+              bb_add_lower_bound(d, c + 1);
+            }
+          }
+        }
+        break;
+
+      default:
+        break;
+      }
+    }
+  }
+
+  // select the split variables
+  for (i=0; i<ndoms; i++) {
+    d = dom + i;
+    if (d->has_lb && d->has_ub && d->lb < d->ub) {
+      ivector_push(&split, i);
+    }
+  }
+  int_array_sort2(split.data, split.size, dom, bb_wider);
+  if (split.size > BB_MAX_SPLIT_VARS) {
+    ivector_shrink(&split, BB_MAX_SPLIT_VARS);
+  }
+
+  bb->ndoms = split.size;
+  bb->dom = (bb_domain_t *) safe_malloc(split.size * sizeof(bb_domain_t));
+  for (i=0; i<split.size; i++) {
+    bb->dom[i] = dom[split.data[i]];
+  }
+
+  safe_free(dom);
+  delete_ivector(&split);
+  delete_ivector(&stack);
+  delete_int_hmap(&map);
+}
+
+
+
+/*
+ * CUBES
+ */
+
+/*
+ * Atoms (x >= b) and (x <= b)
+ */
+static term_t bb_bound_atom(context_t *ctx, term_t x, int64_t b, bool lower) {
+  rba_buffer_t *buffer;
+  rational_t q;
+
+  q_init(&q);
+  q_set64(&q, -b);
+  buffer = context_get_arith_buffer(ctx);
+  assert(rba_buffer_is_zero(buffer));
+  rba_buffer_add_term(buffer, ctx->terms, x);
+  rba_buffer_add_const(buffer, &q);   // buffer is x - b
+  q_clear(&q);
+
+  if (lower) {
+    return mk_direct_arith_geq0(ctx->terms, buffer, true);
+  } else {
+    return mk_direct_arith_leq0(ctx->terms, buffer, true);
+  }
+}
+
+
+/*
+ * Build the cubes:
+ * - the initial box is the product of the domains of the split variables
+ * - each round splits every box in two, by bisecting its widest domain,
+ *   until we have at least target boxes or no box can be split.
+ * - box i is stored in lo[i * k ... i * k + k-1] and hi[i * k ... i * k + k-1]
+ *   where k = number of split variables.
+ */
+static void bb_build_cubes(bb_solver_t *bb, context_t *ctx, uint32_t target) {
+  int64_t *lo, *hi, *blo, *bhi, *nlo, *nhi;
+  ivector_t atoms;
+  uint32_t i, j, k, m, nboxes, best;
+  int64_t mid;
+  bool progress;
+
+  k = bb->ndoms;
+  assert(k > 0 && target > 1);
+
+  lo = (int64_t *) safe_malloc(target * k * sizeof(int64_t));
+  hi = (int64_t *) safe_malloc(target * k * sizeof(int64_t));
+  for (j=0; j<k; j++) {
+    lo[j] = bb->dom[j].lb;
+    hi[j] = bb->dom[j].ub;
+  }
+  nboxes = 1;
+
+  do {
+    progress = false;
+    m = nboxes;
+    for (i=0; i<m && nboxes < target; i++) {
+      blo = lo + i * k;
+      bhi = hi + i * k;
+      best = 0;
+      for (j=1; j<k; j++) {
+        if (bhi[j] - blo[j] > bhi[best] - blo[best]) {
+          best = j;
+        }
+      }
+      if (bhi[best] > blo[best]) {
+        nlo = lo + nboxes * k;
+        nhi = hi + nboxes * k;
+        for (j=0; j<k; j++) {
+          nlo[j] = blo[j];
+          nhi[j] = bhi[j];
+        }
+        mid = blo[best] + (bhi[best] - blo[best])/2;
+        bhi[best] = mid;
+        nlo[best] = mid + 1;
+        nboxes ++;
+        progress = true;
+      }
+    }
+  } while (progress && nboxes < target);
+
+  init_ivector(&atoms, nboxes * 2);
+  bb->ncubes = nboxes;
+  bb->start = (uint32_t *) safe_malloc((nboxes + 1) * sizeof(uint32_t));
+  for (i=0; i<nboxes; i++) {
+    bb->start[i] = atoms.size;
+    blo = lo + i * k;
+    bhi = hi + i * k;
+    for (j=0; j<k; j++) {
+      if (blo[j] > bb->dom[j].lb) {
+        ivector_push(&atoms, bb_bound_atom(ctx, bb->dom[j].var, blo[j], true));
+      }
+      if (bhi[j] < bb->dom[j].ub) {
+        ivector_push(&atoms, bb_bound_atom(ctx, bb->dom[j].var, bhi[j], false));
+      }
+    }
+  }
+  bb->start[nboxes] = atoms.size;
+
+  bb->natoms = atoms.size;
+  bb->atom = (term_t *) safe_malloc(atoms.size * sizeof(term_t));
+  for (i=0; i<atoms.size; i++) {
+    bb->atom[i] = atoms.data[i];
+  }
+
+  delete_ivector(&atoms);
+  safe_free(lo);
+  safe_free(hi);
+}
+
+
+/*
+ * Build the cubes and internalize them
+ */
+int32_t bb_solver_prepare(bb_solver_t *bb) {
+  context_t *ctx;
+  uint32_t i, k, n;
+  int32_t l;
+
+  n = bb->nworkers;
+  ctx = bb->ctx[0];
+
+  if (n == 1 || ctx->mcsat != NULL || !context_has_arith_solver(ctx) ||
+      !context_supports_multichecks(ctx)) {
+    return 0;
+  }
+
+  bb_collect_domains(bb, ctx);
+  if (bb->ndoms == 0) {
+    return 0;
+  }
+
+  bb_build_cubes(bb, ctx, n * BB_CUBES_PER_WORKER);
+
+  bb->lit = (literal_t *) safe_malloc(n * bb->natoms * sizeof(literal_t));
+  for (i=0; i<n; i++) {
+    for (k=0; k<bb->natoms; k++) {
+      l = context_internalize(bb->ctx[i], bb->atom[k]);
+      if (l < 0) return l;
+      bb->lit[i * bb->natoms + k] = l;
+    }
+  }
+
+  return bb->ncubes;
+}
+
+
+
+
+#ifdef THREAD_SAFE
+
+/*
+ * PARALLEL SEARCH
+ */
+
+typedef struct bb_state_s bb_state_t;
+
+/*
+ * Worker:
+ * - busy is true while the worker is checking a cube
+ */
+typedef struct bb_worker_s {
+  bb_state_t *state;
+  context_t *ctx;
+  literal_t *lit;
+  uint32_t id;
+  bool busy;
+  const param_t *params;
+} bb_worker_t;
+
+/*
+ * Shared state:
+ * - lock protects all the fields
+ * - next = index of the next cube to solve
+ * - done = true once the result is known
+ * - status = result (valid if done is true)
+ * - winner = index of the worker that found the result
+ */
+struct bb_state_s {
+  yices_lock_t lock;
+  bb_solver_t *solver;
+  bb_worker_t *worker;
+  uint32_t next;
+  bool done;
+  smt_status_t status;
+  int32_t winner;
+};
+
+
+/*
+ * Interrupt worker i
+ * - if the worker is busy but its context is still IDLE, the search
+ *   has not started yet so we wait.
+ */
+static void bb_interrupt(bb_state_t *s, uint32_t i) {
+  bb_worker_t *w;
+  smt_status_t stat;
+  bool busy;
+
+  w = s->worker + i;
+  for (;;) {
+    get_yices_lock(&s->lock);
+    busy = w->busy;
+    stat = STATUS_ERROR;
+    if (busy) {
+      stat = context_status(w->ctx);
+      if (stat == STATUS_SEARCHING) {
+        context_stop_search(w->ctx);
+      }
+    }
+    release_yices_lock(&s->lock);
+    if (!busy || stat != STATUS_IDLE) break;
+  }
+}
+
+
+/*
+ * Record the result found by worker w and interrupt the others
+ */
+static void bb_set_result(bb_state_t *s, bb_worker_t *w, smt_status_t stat) {
+  uint32_t i;
+  bool first;
+
+  get_yices_lock(&s->lock);
+  first = !s->done;
+  if (first) {
+    s->done = true;
+    s->status = stat;
+    s->winner = w->id;
+  }
+  release_yices_lock(&s->lock);
+
+  if (first) {
+    for (i=0; i<s->solver->nworkers; i++) {
+      if (i != w->id) {
+        bb_interrupt(s, i);
+      }
+    }
+  }
+}
+
+
+/*
+ * Run worker w: solve cubes until all cubes are done or a result is known
+ */
+static void bb_run_worker(bb_worker_t *w) {
+  bb_state_t *s;
+  bb_solver_t *bb;
+  smt_status_t stat;
+  uint32_t i, k;
+
+  s = w->state;
+  bb = s->solver;
+
+  for (;;) {
+    get_yices_lock(&s->lock);
+    if (s->done || s->next >= bb->ncubes) {
+      release_yices_lock(&s->lock);
+      break;
+    }
+    i = s->next;
+    s->next ++;
+    w->busy = true;
+    release_yices_lock(&s->lock);
+
+    k = bb->start[i];
+    stat = check_context_with_assumptions(w->ctx, w->params, bb->start[i+1] - k, w->lit + k);
+    if (stat == STATUS_UNSAT) {
+      context_clear_unsat(w->ctx);
+      stat = context_status(w->ctx);
+    }
+
+    get_yices_lock(&s->lock);
+    w->busy = false;
+    release_yices_lock(&s->lock);
+
+    if (stat != STATUS_IDLE) {
+      // SAT, UNKNOWN, INTERRUPTED, or UNSAT without assumptions
+      bb_set_result(s, w, stat);
+      break;
+    }
+  }
+}
+
+static yices_thread_result_t YICES_THREAD_ATTR bb_worker_main(void *arg) {
+  bb_run_worker(arg);
+  return yices_thread_exit();
+}
+
+
+smt_status_t bb_solver_check(bb_solver_t *bb, const param_t *params, uint32_t *winner) {
+  bb_state_t state;
+  bb_worker_t *w;
+  yices_thread_t *tids;
+  smt_status_t stat;
+  uint32_t i, n, started;
+
+  if (params == NULL) {
+    params = get_default_params();
+  }
+
+  if (bb->ncubes == 0) {
+    *winner = 0;
+    return check_context(bb->ctx[0], params);
+  }
+
+  n = bb->nworkers;
+  w = (bb_worker_t *) safe_malloc(n * sizeof(bb_worker_t));
+  tids = (yices_thread_t *) safe_malloc(n * sizeof(yices_thread_t));
+
+  create_yices_lock(&state.lock);
+  state.solver = bb;
+  state.worker = w;
+  state.next = 0;
+  state.done = false;
+  state.status = STATUS_UNSAT;
+  state.winner = -1;
+
+  for (i=0; i<n; i++) {
+    assert(context_status(bb->ctx[i]) == STATUS_IDLE);
+    w[i].state = &state;
+    w[i].ctx = bb->ctx[i];
+    w[i].lit = bb->lit + i * bb->natoms;
+    w[i].id = i;
+    w[i].busy = false;
+    w[i].params = params;
+  }
+
+  started = 0;
+  while (started < n) {
+    if (start_yices_thread(tids + started, bb_worker_main, w + started) < 0) break;
+    started ++;
+  }
+
+  if (started == 0) {
+    // no thread: worker 0 solves all the cubes
+    bb_run_worker(w);
+  }
+
+  for (i=0; i<started; i++) {
+    join_yices_thread(tids + i);
+  }
+
+  // if the result is UNSAT (all cubes refuted), the winner is worker 0
+  *winner = (state.winner < 0) ? 0 : state.winner;
+  stat = state.status;
+
+  destroy_yices_lock(&state.lock);
+  safe_free(tids);
+  safe_free(w);
+
+  return stat;
+}
+
+
+#else
+
+/*
+ * SEQUENTIAL VERSION: check ctx[0] without splitting
+ */
+smt_status_t bb_solver_check(bb_solver_t *bb, const param_t *params, uint32_t *winner) {
+  if (params == NULL) {
+    params = get_default_params();
+  }
+
+  *winner = 0;
+  return check_context(bb->ctx[0], params);
+}
+
+#endif
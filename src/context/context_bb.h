@@ -0,0 +1,155 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL BRANCH AND BOUND
+ *
+ * This splits an integer problem into subproblems (cubes) by bisecting
+ * the domains of bounded integer variables, then solves the cubes in
+ * parallel on n contexts that contain the same assertions.
+ *
+ * The domains are found syntactically: we look for top-level assertions
+ * of the form (x >= c), (x <= c), (x > c), or (x < c) where x is an
+ * uninterpreted integer term and c is a 32bit integer constant. Each cube
+ * is a conjunction of bounds (x >= l) and (x <= u) on these variables.
+ * The cubes are disjoint and together they cover the box defined by the
+ * top-level bounds.
+ *
+ * Each worker owns a context. It takes the next cube from a shared queue
+ * and checks its context with the cube literals as assumptions. If the
+ * result is UNSAT, the assumptions are removed and the worker moves on to
+ * the next cube, keeping the clauses (and simplex lemmas) learned so far.
+ * - if one cube is SAT, then the problem is SAT and all the other
+ *   workers are interrupted.
+ * - if all cubes are UNSAT, then the problem is UNSAT.
+ * - if a worker's context becomes UNSAT independently of the
+ *   assumptions, then the problem is UNSAT.
+ * - if a check returns UNKNOWN or INTERRUPTED, the search stops and
+ *   that status is returned.
+ *
+ * The contexts must support multiple checks (i.e., their mode can't be
+ * ONECHECK) since each worker calls check once per cube.
+ *
+ * Threads are used only if Yices is compiled in THREAD_SAFE mode.
+ * Otherwise, ctx[0] is checked without splitting.
+ */
+
+#ifndef __CONTEXT_BB_H
+#define __CONTEXT_BB_H
+
+#include <stdint.h>
+
+#include "context/context_types.h"
+#include "context/context_portfolio.h"
+
+
+/*
+ * Maximal number of workers
+ */
+#define MAX_BB_WORKERS MAX_PORTFOLIO_WORKERS
+
+/*
+ * Number of split variables and of cubes:
+ * - we split on at most BB_MAX_SPLIT_VARS variables (those with
+ *   the widest domains)
+ * - we aim for BB_CUBES_PER_WORKER cubes per worker so that
+ *   easy cubes don't leave workers idle.
+ */
+#define BB_MAX_SPLIT_VARS   16
+#define BB_CUBES_PER_WORKER 4
+
+
+/*
+ * Domain of an integer variable: lb <= var <= ub
+ * - has_lb/has_ub are false if no bound was found
+ */
+typedef struct bb_domain_s {
+  term_t var;
+  bool has_lb;
+  bool has_ub;
+  int64_t lb;
+  int64_t ub;
+} bb_domain_t;
+
+
+/*
+ * Branch-and-bound solver:
+ * - ctx = array of n contexts
+ * - dom = array of ndoms domains (the split variables)
+ * - ncubes = number of cubes
+ * - cube i is formed by the atoms atom[start[i] ... start[i+1]-1]
+ * - lit = literals for the atoms in all contexts: the literal for
+ *   atom[k] in ctx[i] is lit[i * natoms + k]
+ */
+typedef struct bb_solver_s {
+  uint32_t nworkers;
+  context_t **ctx;
+  bb_domain_t *dom;
+  uint32_t ndoms;
+  uint32_t ncubes;
+  uint32_t natoms;
+  uint32_t *start;
+  term_t *atom;
+  literal_t *lit;
+} bb_solver_t;
+
+
+/*
+ * Initialize bb for n contexts ctx[0 ... n-1]
+ * - n must be positive and no more than MAX_BB_WORKERS
+ * - all contexts must contain the same assertions and be IDLE
+ */
+extern void init_bb_solver(bb_solver_t *bb, uint32_t n, context_t **ctx);
+
+/*
+ * Delete: free memory (the contexts are not deleted)
+ */
+extern void delete_bb_solver(bb_solver_t *bb);
+
+/*
+ * Build the cubes and convert them to literals in all the contexts
+ * - this creates new atoms in the term table and internalizes them
+ *   so it must be called before the search and not concurrently with
+ *   other operations on the term table.
+ * - return the number of cubes or a negative internalization code
+ *   if an atom can't be internalized.
+ * - the number of cubes is zero if no split variable was found, if
+ *   n is 1, or if the contexts don't support multiple checks.
+ */
+extern int32_t bb_solver_prepare(bb_solver_t *bb);
+
+/*
+ * Check satisfiability:
+ * - params = base search parameters (if params is NULL, the default
+ *   parameters are used)
+ * - if bb_solver_prepare found no cubes, this checks ctx[0] and sets
+ *   *winner to 0
+ * - otherwise the index of the context that found the result is stored
+ *   in *winner.
+ *
+ * The returned status can be SAT, UNSAT, UNKNOWN, or INTERRUPTED.
+ * - if it's SAT, the model is available in ctx[*winner].
+ * - if it's UNSAT because all the cubes are UNSAT, then the contexts
+ *   are left in the IDLE state.
+ * - the contexts that were interrupted are left in state STATUS_INTERRUPTED
+ *   and the caller must cleanup or delete them.
+ */
+extern smt_status_t bb_solver_check(bb_solver_t *bb, const param_t *params, uint32_t *winner);
+
+
+#endif /* __CONTEXT_BB_H */
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PORTFOLIO SOLVING: RUN CHECK_CONTEXT ON SEVERAL CONTEXTS IN PARALLEL
+ */
+
+#include <assert.h>
+
+#include "api/search_parameters.h"
+#include "context/context.h"
+#include "context/context_portfolio.h"
+#include "utils/memalloc.h"
+
+#ifdef THREAD_SAFE
+#include "mt/threads.h"
+#include "mt/yices_locks.h"
+#endif
+
+
+/*
+ * DIVERSIFICATION
+ */
+
+/*
+ * Restart strategies
+ * - c_factor = 0.0 and fast_restart = true means Luby restarts
+ *   with base period c_threshold (cf. search_parameters.h)
+ */
+typedef struct restart_config_s {
+  bool fast_restart;
+  uint32_t c_threshold;
+  uint32_t d_threshold;
+  double c_factor;
+  double d_factor;
+} restart_config_t;
+
+#define NUM_RESTART_CONFIGS 4
+
+static const restart_config_t restart_config[NUM_RESTART_CONFIGS] = {
+  { true, 64, 64, 0.0, 0.0 },        // Luby, short period
+  { false, 100, 100, 1.5, 1.0 },     // Minisat-style
+  { true, 100, 100, 1.1, 1.1 },      // Picosat-style
+  { true, 200, 200, 0.0, 0.0 },      // Luby, long period
+};
+
+/*
+ * Branching heuristics
+ */
+#define NUM_BRANCHING_CONFIGS 3
+
+static const branch_t branching_config[NUM_BRANCHING_CONFIGS] = {
+  BRANCHING_DEFAULT, BRANCHING_NEGATIVE, BRANCHING_POSITIVE,
+};
+
+
+/*
+ * Worker i uses restart_config[(i-1) % 4], branching_config[((i-1)/4) % 3]
+ * and a random seed derived from i. Odd workers also use some randomness
+ * in decisions.
+ */
+void portfolio_diversify_params(param_t *params, uint32_t i) {
+  const restart_config_t *r;
+  uint32_t k;
+
+  if (i == 0) return;
+
+  k = i - 1;
+  r = restart_config + (k % NUM_RESTART_CONFIGS);
+  params->fast_restart = r->fast_restart;
+  params->c_threshold = r->c_threshold;
+  params->d_threshold = r->d_threshold;
+  params->c_factor = r->c_factor;
+  params->d_factor = r->d_factor;
+
+  params->branching = branching_config[(k/NUM_RESTART_CONFIGS) % NUM_BRANCHING_CONFIGS];
+  params->random_seed += i * 0x9e3779b1u;
+  if ((i & 1) != 0 && params->randomness < 0.02) {
+    params->randomness = 0.02;
+  }
+}
+
+
+
+
+#ifdef THREAD_SAFE
+
+/*
+ * PARALLEL VERSION
+ */
+
+typedef struct portfolio_s portfolio_t;
+
+typedef struct portfolio_worker_s {
+  portfolio_t *portfolio;
+  context_t *ctx;
+  uint32_t id;
+  smt_status_t status;
+  param_t params;
+} portfolio_worker_t;
+
+/*
+ * Shared state:
+ * - lock protects winner
+ * - winner = index of the first worker to finish (-1 initially)
+ */
+struct portfolio_s {
+  yices_lock_t lock;
+  int32_t winner;
+  uint32_t nworkers;
+  portfolio_worker_t *worker;
+};
+
+
+/*
+ * Interrupt worker i
+ * - w->ctx is NULL if the worker's thread could not be started
+ * - the context may still be IDLE if the worker's thread has not started
+ *   the search yet. In this case, stop_search would have no effect so we
+ *   wait until the status changes.
+ * - the lock is used as a memory barrier so that we see the status updates
+ *   made by the other thread.
+ */
+static void portfolio_interrupt(portfolio_t *p, uint32_t i) {
+  context_t *ctx;
+  smt_status_t stat;
+
+  for (;;) {
+    get_yices_lock(&p->lock);
+    ctx = p->worker[i].ctx;
+    stat = STATUS_ERROR;
+    if (ctx != NULL) {
+      stat = context_status(ctx);
+      if (stat == STATUS_SEARCHING) {
+        context_stop_search(ctx);
+      }
+    }
+    release_yices_lock(&p->lock);
+    if (stat != STATUS_IDLE) break;
+  }
+}
+
+
+/*
+ * Run worker w: the first worker to finish interrupts all the others
+ */
+static void portfolio_run_worker(portfolio_worker_t *w) {
+  portfolio_t *p;
+  uint32_t i;
+  bool first;
+
+  p = w->portfolio;
+
+  w->status = check_context(w->ctx, &w->params);
+
+  get_yices_lock(&p->lock);
+  first = p->winner < 0;
+  if (first) {
+    p->winner = w->id;
+  }
+  release_yices_lock(&p->lock);
+
+  if (first) {
+    for (i=0; i<p->nworkers; i++) {
+      if (i != w->id) {
+        portfolio_interrupt(p, i);
+      }
+    }
+  }
+}
+
+static yices_thread_result_t YICES_THREAD_ATTR portfolio_worker_main(void *arg) {
+  portfolio_run_worker(arg);
+  return yices_thread_exit();
+}
+
+
+smt_status_t check_context_portfolio(uint32_t n, context_t **ctx, const param_t *params, uint32_t *winner) {
+  portfolio_t portfolio;
+  portfolio_worker_t *w;
+  yices_thread_t *tids;
+  smt_status_t stat;
+  uint32_t i, started;
+
+  assert(0 < n && n <= MAX_PORTFOLIO_WORKERS);
+
+  if (params == NULL) {
+    params = get_default_params();
+  }
+
+  if (n == 1) {
+    *winner = 0;
+    return check_context(ctx[0], params);
+  }
+
+  w = (portfolio_worker_t *) safe_malloc(n * sizeof(portfolio_worker_t));
+  tids = (yices_thread_t *) safe_malloc(n * sizeof(yices_thread_t));
+
+  create_yices_lock(&portfolio.lock);
+  portfolio.winner = -1;
+  portfolio.nworkers = n;
+  portfolio.worker = w;
+
+  for (i=0; i<n; i++) {
+    assert(context_status(ctx[i]) == STATUS_IDLE);
+    w[i].portfolio = &portfolio;
+    w[i].ctx = ctx[i];
+    w[i].id = i;
+    w[i].status = STATUS_IDLE;
+    w[i].params = *params;
+    portfolio_diversify_params(&w[i].params, i);
+  }
+
+  started = 0;
+  while (started < n) {
+    if (start_yices_thread(tids + started, portfolio_worker_main, w + started) < 0) break;
+    started ++;
+  }
+
+  if (started < n) {
+    /*
+     * Failed to create a thread: the workers that were not started
+     * are removed. If none started, we run worker 0 in this thread.
+     */
+    get_yices_lock(&portfolio.lock);
+    for (i=started; i<n; i++) {
+      w[i].ctx = NULL;
+    }
+    release_yices_lock(&portfolio.lock);
+    if (started == 0) {
+      w[0].ctx = ctx[0];
+      portfolio_run_worker(w);
+    }
+  }
+
+  for (i=0; i<started; i++) {
+    join_yices_thread(tids + i);
+  }
+
+  assert(portfolio.winner >= 0);
+  *winner = portfolio.winner;
+  stat = w[portfolio.winner].status;
+
+  destroy_yices_lock(&portfolio.lock);
+  safe_free(tids);
+  safe_free(w);
+
+  return stat;
+}
+
+
+#else
+
+/*
+ * SEQUENTIAL VERSION: run worker 0 only
+ */
+smt_status_t check_context_portfolio(uint32_t n, context_t **ctx, const param_t *params, uint32_t *winner) {
+  assert(0 < n && n <= MAX_PORTFOLIO_WORKERS);
+
+  *winner = 0;
+  return check_context(ctx[0], params);
+}
+
+#endif
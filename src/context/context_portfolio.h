@@ -0,0 +1,79 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PORTFOLIO SOLVING
+ *
+ * A portfolio runs check_context on n contexts in parallel. All the
+ * contexts must contain the same assertions. Each context (worker)
+ * uses different search parameters: worker 0 uses the parameters
+ * given by the caller, and the other workers use variants of these
+ * parameters (different random seeds, restart strategies, and
+ * branching heuristics).
+ *
+ * The first worker to finish wins: the other workers are then
+ * interrupted via context_stop_search.
+ *
+ * Threads are used only if Yices is compiled in THREAD_SAFE mode.
+ * Otherwise, only worker 0 is run.
+ */
+
+#ifndef __CONTEXT_PORTFOLIO_H
+#define __CONTEXT_PORTFOLIO_H
+
+#include <stdint.h>
+
+#include "context/context_types.h"
+
+
+/*
+ * Maximal number of workers
+ */
+#define MAX_PORTFOLIO_WORKERS 64
+
+
+/*
+ * Modify params for worker i
+ * - if i = 0, params is not changed
+ * - otherwise, the random seed, the restart strategy, and the branching
+ *   heuristic are changed based on i.
+ */
+extern void portfolio_diversify_params(param_t *params, uint32_t i);
+
+
+/*
+ * Run the portfolio:
+ * - ctx = array of n contexts, all with status IDLE
+ * - n must be positive and no more than MAX_PORTFOLIO_WORKERS
+ * - params = base search parameters (if params is NULL, the default
+ *   parameters are used)
+ * - the index of the winning context is returned in *winner
+ *
+ * The returned status is the status of ctx[*winner]. It can be STATUS_SAT,
+ * STATUS_UNSAT, STATUS_UNKNOWN, or STATUS_INTERRUPTED. It's STATUS_INTERRUPTED
+ * if the first worker to finish was interrupted by an external call
+ * to context_stop_search.
+ *
+ * All the other contexts are left in state STATUS_INTERRUPTED (or in the state
+ * they reached if they completed before being interrupted). The caller
+ * must cleanup or delete them.
+ */
+extern smt_status_t check_context_portfolio(uint32_t n, context_t **ctx, const param_t *params, uint32_t *winner);
+
+
+#endif /* __CONTEXT_PORTFOLIO_H */
@@ -32,6 +32,7 @@
 #include "context/context.h"
 #include "context/internalization_codes.h"
 #include "model/models.h"
+#include "solvers/bv/bvsolver.h"
 #include "solvers/bv/dimacs_printer.h"
 #include "solvers/cdcl/delegate.h"
 #include "solvers/funs/fun_solver.h"
@@ -487,6 +488,7 @@ static void context_set_search_parameters(context_t *ctx, const param_t *params)
   } else {
     disable_theory_cache(core);
   }
+  set_chrono_threshold(core, params->chrono_threshold);
 
   /*
    * Set egraph parameters
@@ -530,6 +532,9 @@ static void context_set_search_parameters(context_t *ctx, const param_t *params)
     if (params->adjust_simplex_model) {
       simplex_enable_adjust_model(simplex);
     }
+    if (params->simplex_float_presolve) {
+      simplex_enable_float_presolve(simplex);
+    }
     simplex_set_bland_threshold(simplex, params->bland_threshold);
     if (params->integer_check) {
       simplex_enable_periodic_icheck(simplex);
@@ -545,6 +550,13 @@ static void context_set_search_parameters(context_t *ctx, const param_t *params)
     fun_solver_set_max_update_conflicts(fsolver, params->max_update_conflicts);
     fun_solver_set_max_extensionality(fsolver, params->max_extensionality);
   }
+
+  /*
+   * Set bitvector solver parameters
+   */
+  if (context_has_bv_solver(ctx)) {
+    bv_solver_set_aig(ctx->bv_solver, params->bv_aig, params->bv_sweep);
+  }
 }
 
 static smt_status_t _o_call_mcsat_solver(context_t *ctx, const param_t *params) {
@@ -553,7 +565,7 @@ static smt_status_t _o_call_mcsat_solver(context_t *ctx, const param_t *params)
 }
 
 static smt_status_t call_mcsat_solver(context_t *ctx, const param_t *params) {
-  MT_PROTECT(smt_status_t, __yices_globals.lock, _o_call_mcsat_solver(ctx, params));
+  MT_PROTECT_WRITE(smt_status_t, __yices_globals.lock, _o_call_mcsat_solver(ctx, params));
 }
 
 /*
@@ -50,6 +50,7 @@ static void show_stats(FILE *f, dpll_stats_t *stat) {
   fprintf(f, " random decisions        : %"PRIu64"\n", stat->random_decisions);
   fprintf(f, " propagations            : %"PRIu64"\n", stat->propagations);
   fprintf(f, " conflicts               : %"PRIu64"\n", stat->conflicts);
+  fprintf(f, " chrono backtracks       : %"PRIu64"\n", stat->chrono_backtracks);
   fprintf(f, " theory propagations     : %"PRIu32"\n", stat->th_props);
   fprintf(f, " propagation-lemmas      : %"PRIu32"\n", stat->th_prop_lemmas);
   fprintf(f, " theory conflicts        : %"PRIu32"\n", stat->th_conflicts);
@@ -122,6 +123,8 @@ static void show_simplex_stats(FILE *f, simplex_stats_t *stat) {
   fprintf(f, " calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   fprintf(f, " pivots                  : %"PRIu32"\n", stat->num_pivots);
   fprintf(f, " bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  fprintf(f, " float presolve calls   : %"PRIu32"\n", stat->num_float_presolve);
+  fprintf(f, " float pivots            : %"PRIu32"\n", stat->num_float_pivots);
   fprintf(f, " simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   //  fprintf(f, " propagation lemmas      : %"PRIu32"\n", stat->num_prop_lemmas);  (it's always zero)
   fprintf(f, " prop. to core           : %"PRIu32"\n", stat->num_props);
@@ -169,6 +172,8 @@ static void show_bvsolver_stats(FILE *f, bv_solver_t *solver) {
   fprintf(f, " equiv conflicts         : %"PRIu32"\n", solver->stats.equiv_conflicts);
   fprintf(f, " semi-equiv lemmas       : %"PRIu32"\n", solver->stats.half_equiv_lemmas);
   fprintf(f, " interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  fprintf(f, " aig nodes               : %"PRIu32"\n", solver->stats.aig_nodes);
+  fprintf(f, " aig merges              : %"PRIu32"\n", solver->stats.aig_merges);
 }
 
 
@@ -675,6 +675,11 @@ struct context_s {
   ivector_t top_formulas;
   ivector_t top_interns;
 
+  // formulas asserted so far (used for cloning)
+  // assertion_marks[i] = size of assertions at the i-th push
+  ivector_t assertions;
+  ivector_t assertion_marks;
+
   // auxiliary buffers and structures for internalization
   ivector_t subst_eqs;
   ivector_t aux_eqs;
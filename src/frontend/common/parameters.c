@@ -37,10 +37,13 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "aux-eq-ratio",
   "bland-threshold",
   "branching",
+  "bv-aig",
+  "bv-sweep",
   "bvarith-elim",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
+  "chrono-threshold",
   "clause-decay",
   "d-factor",
   "d-threshold",
@@ -97,6 +100,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "random-seed",
   "randomness",
   "simplex-adjust",
+  "simplex-float",
   "simplex-prop",
   "tclause-size",
   "var-decay",
@@ -110,10 +114,13 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
   PARAM_BRANCHING,
+  PARAM_BV_AIG,
+  PARAM_BV_SWEEP,
   PARAM_BVARITH_ELIM,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
+  PARAM_CHRONO_THRESHOLD,
   PARAM_CLAUSE_DECAY,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
@@ -170,6 +177,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_RANDOM_SEED,
   PARAM_RANDOMNESS,
   PARAM_SIMPLEX_ADJUST,
+  PARAM_SIMPLEX_FLOAT,
   PARAM_SIMPLEX_PROP,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
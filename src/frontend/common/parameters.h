@@ -68,6 +68,7 @@ typedef enum yices_param {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_CHRONO_THRESHOLD,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -83,6 +84,7 @@ typedef enum yices_param {
   PARAM_EAGER_LEMMAS,
   PARAM_SIMPLEX_PROP,
   PARAM_SIMPLEX_ADJUST,
+  PARAM_SIMPLEX_FLOAT,
   PARAM_PROP_THRESHOLD,
   PARAM_BLAND_THRESHOLD,
   PARAM_ICHECK,
@@ -90,6 +92,9 @@ typedef enum yices_param {
   // array solver parameters
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver parameters
+  PARAM_BV_AIG,
+  PARAM_BV_SWEEP,
   // EF solver
   PARAM_EF_FLATTEN_IFF,
   PARAM_EF_FLATTEN_ITE,
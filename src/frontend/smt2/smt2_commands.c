@@ -41,6 +41,8 @@
 #include "api/yices_globals.h"
 #include "api/yices_mutex.h"
 #include "context/context.h"
+#include "context/context_bb.h"
+#include "context/context_portfolio.h"
 #include "frontend/common/bug_report.h"
 #include "frontend/common/parameters.h"
 #include "frontend/common/tables.h"
@@ -1123,9 +1125,14 @@ static void print_yices_error(bool full) {
     break;
 
   case OUTPUT_ERROR:
+  case INPUT_ERROR:
     print_out(" IO error");
     break;
 
+  case INVALID_TERM_DUMP:
+    print_out("invalid term dump");
+    break;
+
   default:
     print_out("BUG detected");
     if (full) close_error();
@@ -1361,6 +1368,8 @@ static const char * const opcode_string[NUM_SMT2_OPCODES] = {
   "echo",                 // SMT2_ECHO
   "reset-assertions",     // SMT2_RESET_ASSERTIONS
   "reset",                // SMT2_RESET_ALL
+  "minimize",             // SMT2_MINIMIZE
+  "maximize",             // SMT2_MAXIMIZE
   //
   "attributes",           // SMT2_MAKE_ATTR_LIST
   "term annotation",      // SMT2_ADD_ATTRIBUTES
@@ -1668,6 +1677,7 @@ static void show_core_stats(int fd, print_buffer_t *b, smt_core_t *core) {
   print_string_and_uint32(fd, b, " :clause-db-simplify ", num_simplify_calls(core));
   print_string_and_uint64(fd, b, " :decisions ", num_decisions(core));
   print_string_and_uint64(fd, b, " :conflicts ", num_conflicts(core));
+  print_string_and_uint64(fd, b, " :chrono-backtracks ", num_chrono_backtracks(core));
   print_string_and_uint32(fd, b, " :theory-conflicts ", num_theory_conflicts(core));
   print_string_and_uint64(fd, b, " :boolean-propagations ", num_propagations(core));
   print_string_and_uint32(fd, b, " :theory-propagations ", num_theory_propagations(core));
@@ -1713,6 +1723,10 @@ static void show_simplex_stats(int fd, print_buffer_t *b, simplex_solver_t *solv
   print_string_and_uint32(fd, b, " :simplex-rows ", simplex_num_rows(solver));
   print_string_and_uint32(fd, b, " :simplex-atoms ", simplex_num_atoms(solver));
   print_string_and_uint32(fd, b, " :simplex-pivots ", simplex_num_pivots(solver));
+  if (simplex_num_float_presolve(solver) > 0) {
+    print_string_and_uint32(fd, b, " :simplex-float-presolve ", simplex_num_float_presolve(solver));
+    print_string_and_uint32(fd, b, " :simplex-float-pivots ", simplex_num_float_pivots(solver));
+  }
   print_string_and_uint32(fd, b, " :simplex-conflicts ", simplex_num_conflicts(solver));
   print_string_and_uint32(fd, b, " :simplex-interface-lemmas ", simplex_num_interface_lemmas(solver));
   if (simplex_num_make_integer_feasible(solver) > 0 ||
@@ -1741,6 +1755,10 @@ static void show_bvsolver_stats(int fd, print_buffer_t *b, bv_solver_t *solver)
   print_string_and_uint32(fd, b, " :bvsolver-atoms ", bv_solver_num_atoms(solver));
   print_string_and_uint32(fd, b, " :bvsolver-equiv-lemmas ", bv_solver_equiv_lemmas(solver));
   print_string_and_uint32(fd, b, " :bvsolver-interface-lemmas ", bv_solver_interface_lemmas(solver));
+  if (bv_solver_aig_nodes(solver) > 0) {
+    print_string_and_uint32(fd, b, " :bvsolver-aig-nodes ", bv_solver_aig_nodes(solver));
+    print_string_and_uint32(fd, b, " :bvsolver-aig-merges ", bv_solver_aig_merges(solver));
+  }
 }
 
 static void show_idl_fw_stats(int fd, print_buffer_t *b, idl_solver_t *solver) {
@@ -2549,14 +2567,16 @@ static assumptions_and_core_t *collect_named_assumptions(uint32_t n, const signe
  */
 static inline bool one_check_mode(smt2_globals_t *g) {
   return g->benchmark_mode && !g->produce_unsat_cores &&
-    !g->produce_unsat_assumptions;
+    !g->produce_unsat_assumptions && g->parallel_bb <= 1 &&
+    g->objective == NULL_TERM;
 }
 
 /*
- * Allocate and initialize the context based on g->logic
+ * Allocate a new context based on g->logic
  * - make sure the logic is supported before calling this
  */
-static void init_smt2_context(smt2_globals_t *g) {
+static context_t *new_smt2_context(smt2_globals_t *g) {
+  context_t *ctx;
   smt_logic_t logic;
   context_arch_t arch;
   context_mode_t mode;
@@ -2601,20 +2621,29 @@ static void init_smt2_context(smt2_globals_t *g) {
     qflag = false;
   }
 
-  g->ctx = yices_create_context(logic, arch, mode, iflag, qflag);
-  assert(g->ctx != NULL);
-  if (g->verbosity > 0 || g->tracer != NULL) {
-    context_set_trace(g->ctx, get_tracer(g));
-  }
+  ctx = yices_create_context(logic, arch, mode, iflag, qflag);
+  assert(ctx != NULL);
 
   // Set the mcsat options
-  g->ctx->mcsat_options = g->mcsat_options;
+  ctx->mcsat_options = g->mcsat_options;
 
   /*
    * TODO: override the default context options based on
    * ctx_parameters.  I don't want to do it now (2015/07/22). If we
    * make a mistake, we could get a major performance loss.
    */
+
+  return ctx;
+}
+
+/*
+ * Allocate and initialize g->ctx
+ */
+static void init_smt2_context(smt2_globals_t *g) {
+  g->ctx = new_smt2_context(g);
+  if (g->verbosity > 0 || g->tracer != NULL) {
+    context_set_trace(g->ctx, get_tracer(g));
+  }
 }
 
 
@@ -2695,6 +2724,198 @@ static smt_status_t check_sat_with_timeout(smt2_globals_t *g, const param_t *par
 }
 
 
+/*
+ * Portfolio version of check_sat_with_timeout
+ * - g->ctx must contain all the delayed assertions
+ * - we create g->portfolio - 1 extra contexts with the same assertions
+ *   then check all of them in parallel
+ * - on exit, g->ctx is the context that finished first. The other
+ *   contexts are deleted.
+ */
+static smt_status_t check_sat_portfolio(smt2_globals_t *g, const param_t *params) {
+  context_t **workers;
+  smt_status_t stat;
+  uint32_t i, n, winner;
+
+  n = g->portfolio;
+  assert(n > 1 && n <= MAX_PORTFOLIO_WORKERS && g->benchmark_mode);
+
+  workers = (context_t **) safe_malloc(n * sizeof(context_t *));
+  workers[0] = g->ctx;
+  for (i=1; i<n; i++) {
+    workers[i] = new_smt2_context(g);
+    if (yices_assert_formulas(workers[i], g->assertions.size, g->assertions.data) < 0) {
+      // this should not happen since the assertions are already in g->ctx
+      n = i + 1;
+      stat = STATUS_ERROR;
+      goto done;
+    }
+  }
+
+  if (g->timeout > 0) {
+    if (! g->timeout_initialized) {
+      init_timeout();
+      g->timeout_initialized = true;
+    }
+    g->interrupted = false;
+    start_timeout(g->timeout, timeout_handler, g);
+  }
+
+  // the timeout handler interrupts g->ctx = workers[0],
+  // which then interrupts all the other workers
+  stat = yices_check_context_portfolio(n, workers, params, &winner);
+
+  if (g->timeout > 0) {
+    clear_timeout();
+  }
+
+  if (stat == STATUS_ERROR) {
+    goto done;
+  }
+
+  trace_printf(g->tracer, 3, "(check-sat: portfolio worker %"PRIu32" finished first)\n", winner);
+
+  // keep the winner
+  g->ctx = workers[winner];
+  workers[winner] = workers[0];
+  workers[0] = g->ctx;
+
+  if (stat == STATUS_INTERRUPTED) {
+    trace_printf(g->tracer, 2, "(check-sat: interrupted)\n");
+    g->interrupted = true;
+    stat = STATUS_UNKNOWN;
+  }
+
+ done:
+  for (i=1; i<n; i++) {
+    yices_free_context(workers[i]);
+  }
+  safe_free(workers);
+
+  return stat;
+}
+
+
+/*
+ * Parallel branch-and-bound version of check_sat_with_timeout
+ * - g->ctx must contain all the delayed assertions
+ * - we create g->parallel_bb - 1 extra contexts with the same assertions
+ *   then split the problem into cubes that are checked in parallel
+ * - on exit, g->ctx is the context that found the result. The other
+ *   contexts are deleted.
+ */
+static smt_status_t check_sat_parallel_bb(smt2_globals_t *g, const param_t *params) {
+  context_t **workers;
+  smt_status_t stat;
+  uint32_t i, n, winner;
+
+  n = g->parallel_bb;
+  assert(n > 1 && n <= MAX_BB_WORKERS && g->benchmark_mode);
+
+  workers = (context_t **) safe_malloc(n * sizeof(context_t *));
+  workers[0] = g->ctx;
+  for (i=1; i<n; i++) {
+    workers[i] = new_smt2_context(g);
+    if (yices_assert_formulas(workers[i], g->assertions.size, g->assertions.data) < 0) {
+      // this should not happen since the assertions are already in g->ctx
+      n = i + 1;
+      stat = STATUS_ERROR;
+      goto done;
+    }
+  }
+
+  if (g->timeout > 0) {
+    if (! g->timeout_initialized) {
+      init_timeout();
+      g->timeout_initialized = true;
+    }
+    g->interrupted = false;
+    start_timeout(g->timeout, timeout_handler, g);
+  }
+
+  // the timeout handler interrupts g->ctx = workers[0],
+  // which then interrupts all the other workers
+  stat = yices_check_context_parallel_bb(n, workers, params, &winner);
+
+  if (g->timeout > 0) {
+    clear_timeout();
+  }
+
+  if (stat == STATUS_ERROR) {
+    goto done;
+  }
+
+  trace_printf(g->tracer, 3, "(check-sat: branch-and-bound worker %"PRIu32" found the result)\n", winner);
+
+  // keep the winner
+  g->ctx = workers[winner];
+  workers[winner] = workers[0];
+  workers[0] = g->ctx;
+
+  if (stat == STATUS_INTERRUPTED) {
+    trace_printf(g->tracer, 2, "(check-sat: interrupted)\n");
+    g->interrupted = true;
+    stat = STATUS_UNKNOWN;
+  }
+
+ done:
+  for (i=1; i<n; i++) {
+    yices_free_context(workers[i]);
+  }
+  safe_free(workers);
+
+  return stat;
+}
+
+
+/*
+ * Optimization version of check_sat_with_timeout
+ * - search for a model where g->objective is minimal or maximal
+ * - the context must support multiple checks
+ */
+static smt_status_t check_sat_optimize(smt2_globals_t *g, const param_t *params) {
+  smt_status_t stat;
+  int32_t optimal;
+
+  assert(g->objective != NULL_TERM);
+
+  if (g->timeout > 0) {
+    if (! g->timeout_initialized) {
+      init_timeout();
+      g->timeout_initialized = true;
+    }
+    g->interrupted = false;
+    start_timeout(g->timeout, timeout_handler, g);
+  }
+
+  if (g->maximize) {
+    stat = yices_maximize(g->ctx, params, g->objective, &optimal);
+  } else {
+    stat = yices_minimize(g->ctx, params, g->objective, &optimal);
+  }
+
+  if (g->timeout > 0) {
+    clear_timeout();
+  }
+
+  if (stat == STATUS_SAT && !optimal) {
+    trace_printf(g->tracer, 2, "(check-sat: the objective is unbounded or its optimum is not attained)\n");
+  }
+
+  if (stat == STATUS_INTERRUPTED) {
+    trace_printf(g->tracer, 2, "(check-sat: interrupted)\n");
+    g->interrupted = true;
+    if (context_get_mode(g->ctx) == CTX_MODE_INTERACTIVE) {
+      context_cleanup(g->ctx);
+      assert(context_status(g->ctx) == STATUS_IDLE);
+    }
+    stat = STATUS_UNKNOWN;
+  }
+
+  return stat;
+}
+
+
 /*
  * Check with assumptions:
  * - params = search parameters
@@ -2989,7 +3210,7 @@ static bool _o_has_uf(term_t *a, uint32_t n) {
   return result;
 }
 static bool has_uf(term_t *a, uint32_t n) {
-  MT_PROTECT(bool, __yices_globals.lock, _o_has_uf(a, n));
+  MT_PROTECT_WRITE(bool, __yices_globals.lock, _o_has_uf(a, n));
 }
 
 /*
@@ -3012,6 +3233,22 @@ static void add_delayed_assertion(smt2_globals_t *g, term_t t) {
 }
 
 
+/*
+ * Save all terms with the assertions as roots in g->save_terms_file
+ * - return false and print an error if that fails
+ */
+static bool save_delayed_assertions(smt2_globals_t *g) {
+  if (yices_save_terms(g->save_terms_file, g->assertions.size, g->assertions.data) < 0) {
+    open_error();
+    print_out("can't save terms in %s: ", g->save_terms_file);
+    print_yices_error(false);
+    close_error();
+    return false;
+  }
+  return true;
+}
+
+
 /*
  * Check satisfiability of all assertions
  */
@@ -3026,7 +3263,8 @@ static void check_delayed_assertions(smt2_globals_t *g) {
   if (g->trivially_unsat) {
     trace_printf(g->tracer, 3, "(check-sat: trivially unsat)\n");
     print_out("unsat\n");
-  } else if (trivially_true_assertions(g->assertions.data, g->assertions.size, &model)) {
+  } else if (g->objective == NULL_TERM &&
+             trivially_true_assertions(g->assertions.data, g->assertions.size, &model)) {
     trace_printf(g->tracer, 3, "(check-sat: trivially true)\n");
     print_out("sat\n");
     g->trivially_sat = true;
@@ -3066,7 +3304,7 @@ static void check_delayed_assertions(smt2_globals_t *g) {
 	return;
       }
 
-      if (g->delegate != NULL && g->logic_code == QF_BV) {
+      if (g->delegate != NULL && g->logic_code == QF_BV && g->objective == NULL_TERM) {
 	/*
 	 * Special case: QF_BV with delegate
 	 */
@@ -3091,7 +3329,15 @@ static void check_delayed_assertions(smt2_globals_t *g) {
 	if (g->random_seed != 0) {
 	  g->parameters.random_seed = g->random_seed;
 	}
-	status = check_sat_with_timeout(g, &g->parameters);
+	if (g->objective != NULL_TERM) {
+	  status = check_sat_optimize(g, &g->parameters);
+	} else if (g->portfolio > 1) {
+	  status = check_sat_portfolio(g, &g->parameters);
+	} else if (g->parallel_bb > 1) {
+	  status = check_sat_parallel_bb(g, &g->parameters);
+	} else {
+	  status = check_sat_with_timeout(g, &g->parameters);
+	}
       }
 
       report_status(g, status);
@@ -3476,7 +3722,11 @@ static void ctx_check_sat(smt2_globals_t *g) {
     if (g->random_seed != 0) {
       g->parameters.random_seed = g->random_seed;
     }
-    stat = check_sat_with_timeout(g, &g->parameters);
+    if (g->objective != NULL_TERM) {
+      stat = check_sat_optimize(g, &g->parameters);
+    } else {
+      stat = check_sat_with_timeout(g, &g->parameters);
+    }
     report_status(g, stat);
     break;
 
@@ -4545,6 +4795,7 @@ static void init_smt2_globals(smt2_globals_t *g) {
   init_ef_client(&g->ef_client);
   g->export_to_dimacs = false;
   g->dimacs_file = NULL;
+  g->save_terms_file = NULL;
   g->out = stdout;
   g->err = stderr;
   g->out_name = NULL;
@@ -4566,6 +4817,10 @@ static void init_smt2_globals(smt2_globals_t *g) {
   init_ctx_params(&g->ctx_parameters);
   init_params_to_defaults(&g->parameters);
   g->nthreads = 0;
+  g->portfolio = 0;
+  g->parallel_bb = 0;
+  g->objective = NULL_TERM;
+  g->maximize = false;
   g->timeout = 0;
   g->timeout_initialized = false;
   g->interrupted = false;
@@ -4777,6 +5032,44 @@ void smt2_set_dimacs_file(const char *filename) {
 }
 
 
+/*
+ * Save terms and assertions at the first check-sat
+ */
+void smt2_set_save_terms_file(const char *filename) {
+  __smt2_globals.save_terms_file = filename;
+}
+
+
+/*
+ * Load terms and assertions
+ */
+int32_t smt2_load_terms(const char *filename) {
+  smt2_globals_t *g;
+  term_vector_t v;
+  uint32_t i;
+  int32_t code;
+
+  g = &__smt2_globals;
+  assert(g->benchmark_mode);
+
+  yices_init_term_vector(&v);
+  code = yices_load_terms(filename, &v);
+  if (code < 0) {
+    open_error();
+    print_out("can't load %s: ", filename);
+    print_yices_error(false);
+    close_error();
+  } else {
+    for (i=0; i<v.size; i++) {
+      add_delayed_assertion(g, v.data[i]);
+    }
+  }
+  yices_delete_term_vector(&v);
+
+  return code;
+}
+
+
 /*
  * Delete all structures and close output/trace files
  */
@@ -5143,6 +5436,10 @@ static bool yices_get_option(smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.tclause_size);
     break;
 
+  case PARAM_CHRONO_THRESHOLD:
+    print_uint32_value(g->parameters.chrono_threshold);
+    break;
+
   case PARAM_DYN_ACK:
     print_boolean_value(g->parameters.use_dyn_ack);
     break;
@@ -5199,6 +5496,10 @@ static bool yices_get_option(smt2_globals_t *g, yices_param_t p) {
     print_boolean_value(g->parameters.adjust_simplex_model);
     break;
 
+  case PARAM_SIMPLEX_FLOAT:
+    print_boolean_value(g->parameters.simplex_float_presolve);
+    break;
+
   case PARAM_PROP_THRESHOLD:
     print_uint32_value(g->parameters.max_prop_row_size);
     break;
@@ -5219,6 +5520,14 @@ static bool yices_get_option(smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.max_extensionality);
     break;
 
+  case PARAM_BV_AIG:
+    print_boolean_value(g->parameters.bv_aig);
+    break;
+
+  case PARAM_BV_SWEEP:
+    print_boolean_value(g->parameters.bv_sweep);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     print_boolean_value(g->ef_client.ef_parameters.flatten_iff);
     break;
@@ -5786,6 +6095,12 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_CHRONO_THRESHOLD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.chrono_threshold = n;
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->parameters.use_dyn_ack = tt;
@@ -5872,6 +6187,12 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_SIMPLEX_FLOAT:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.simplex_float_presolve = tt;
+    }
+    break;
+
   case PARAM_PROP_THRESHOLD:
     if (param_val_to_nonneg32(param, val, &n, &reason)) {
       g->parameters.max_prop_row_size = n;
@@ -5916,6 +6237,18 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_BV_AIG:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.bv_aig = tt;
+    }
+    break;
+
+  case PARAM_BV_SWEEP:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.bv_sweep = tt;
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->ef_client.ef_parameters.flatten_iff = tt;
@@ -6663,6 +6996,8 @@ void smt2_check_sat(void) {
         efsolve_cmd(&__smt2_globals);
       } else if (__smt2_globals.frozen) {
         print_error("multiple calls to (check-sat) are not allowed in non-incremental mode");
+      } else if (__smt2_globals.save_terms_file != NULL && !save_delayed_assertions(&__smt2_globals)) {
+        // error reported in save_delayed_assertions
       } else if (__smt2_globals.produce_unsat_cores) {
         delayed_assertions_unsat_core(&__smt2_globals);
       } else {
@@ -6976,6 +7311,7 @@ void smt2_reset_assertions(void) {
        * + info_table and attribute table.
        */
       g->pushes_after_unsat = 0;
+      g->objective = NULL_TERM;
 
       assert(g->ctx != NULL);
       yices_free_context(g->ctx);
@@ -7063,6 +7399,36 @@ void smt2_reset_all(void) {
 }
 
 
+/*
+ * Objective: (minimize t) or (maximize t)
+ */
+void smt2_set_objective(term_t t, bool maximize) {
+  smt2_globals_t *g;
+  const char *cmd;
+
+  g = &__smt2_globals;
+  g->stats.num_commands ++;
+  cmd = maximize ? "maximize" : "minimize";
+
+  if (check_logic()) {
+    if (! yices_term_is_arithmetic(t) && ! yices_term_is_bitvector(t)) {
+      print_error("type error in %s: arithmetic or bitvector term required", cmd);
+    } else if (g->efmode) {
+      print_error("%s is not supported by the exists/forall solver", cmd);
+    } else if (g->benchmark_mode && g->frozen) {
+      print_error("%s is not allowed after (check-sat) in non-incremental mode", cmd);
+    } else {
+      if (! g->benchmark_mode) {
+        cleanup_context(g);
+      }
+      g->objective = t;
+      g->maximize = maximize;
+      report_success();
+    }
+  }
+}
+
+
 /*
  * ATTRIBUTES
  */
@@ -7135,3 +7501,19 @@ void smt2_add_pattern(int32_t op, term_t t, term_t *p, uint32_t n) {
 void smt2_enable_mcsat(void) {
   __smt2_globals.mcsat = true;
 }
+
+/*
+ * Set the number of portfolio workers
+ */
+void smt2_set_portfolio(uint32_t n) {
+  assert(n <= MAX_PORTFOLIO_WORKERS);
+  __smt2_globals.portfolio = n;
+}
+
+/*
+ * Set the number of branch-and-bound workers
+ */
+void smt2_set_parallel_bb(uint32_t n) {
+  assert(n <= MAX_BB_WORKERS);
+  __smt2_globals.parallel_bb = n;
+}
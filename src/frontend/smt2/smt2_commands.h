@@ -160,6 +160,8 @@ typedef enum smt2_opcodes {
   SMT2_ECHO,                            // [echo <string>]
   SMT2_RESET_ASSERTIONS,                // [reset-assertions]
   SMT2_RESET_ALL,                       // [reset]
+  SMT2_MINIMIZE,                        // [minimize <term> ]
+  SMT2_MAXIMIZE,                        // [maximize <term> ]
 
   // attributes
   SMT2_MAKE_ATTR_LIST,                  // [make-attr-list <value> .... <value> ]
@@ -364,6 +366,9 @@ typedef struct smt2_globals_s {
   bool export_to_dimacs;           // true to enable
   const char *dimacs_file;         // file name to store the dimacs result
 
+  // save all terms and the assertions at the first check-sat
+  const char *save_terms_file;     // NULL means don't save
+
   // output/diagnostic channels
   FILE *out;                  // default = stdout
   FILE *err;                  // default = stderr
@@ -399,6 +404,16 @@ typedef struct smt2_globals_s {
   // nthreads
   uint32_t nthreads;           // default = 0 (single threaded)
 
+  // portfolio
+  uint32_t portfolio;          // default = 0 (no portfolio)
+
+  // parallel branch and bound
+  uint32_t parallel_bb;        // default = 0 (no splitting)
+
+  // objective set by (minimize t) or (maximize t)
+  term_t objective;           // default = NULL_TERM (no objective)
+  bool maximize;              // true for (maximize t)
+
   // timeout
   uint32_t timeout;           // default = 0 (no timeout)
   bool timeout_initialized;   // initially false. true once init_timeout is called
@@ -488,6 +503,23 @@ extern void init_mt2(bool benchmark, uint32_t timeout, uint32_t nthreads, bool p
  */
 extern void smt2_enable_mcsat(void);
 
+/*
+ * Use a portfolio of n contexts for check-sat in non-incremental mode
+ * - n = 0 or 1 means no portfolio
+ * - n must be no more than MAX_PORTFOLIO_WORKERS (cf. context_portfolio.h)
+ * - must not be called before init_smt2
+ */
+extern void smt2_set_portfolio(uint32_t n);
+
+/*
+ * Use parallel branch and bound with n contexts for check-sat in
+ * non-incremental mode (ignored if a portfolio is used)
+ * - n = 0 or 1 means no branch and bound
+ * - n must be no more than MAX_BB_WORKERS (cf. context_bb.h)
+ * - must not be called before init_smt2
+ */
+extern void smt2_set_parallel_bb(uint32_t n);
+
 /*
  * Force verbosity level to k
  * - this has the same effect as (set-option :verbosity k)
@@ -537,6 +569,25 @@ extern void smt2_set_delegate(const char *name);
  */
 extern void smt2_set_dimacs_file(const char *filename);
 
+/*
+ * Save all terms and the assertions in a binary file when (check-sat)
+ * is called (non-incremental mode only).
+ * - filename = name of the output file
+ */
+extern void smt2_set_save_terms_file(const char *filename);
+
+/*
+ * Load terms and assertions saved by a previous run
+ * - filename = name of the input file
+ * - the terms and their names are available to the script
+ * - the saved assertions are added to the current assertions
+ *   (non-incremental mode only)
+ * - return -1 and print an error if the file can't be loaded,
+ *   return 0 otherwise
+ * - must not be called before init_smt2
+ */
+extern int32_t smt2_load_terms(const char *filename);
+
 /*
  * Delete all internal structures (called after exit).
  */
@@ -779,6 +830,15 @@ extern void smt2_reset_assertions(void);
  */
 extern void smt2_reset_all(void);
 
+/*
+ * Objective for the next (check-sat): (minimize t) or (maximize t)
+ * - t must be an arithmetic or bitvector term (bitvectors are
+ *   compared as unsigned integers)
+ * - this replaces the previous objective if any
+ * - (check-sat) then searches for a model where t is optimal
+ */
+extern void smt2_set_objective(term_t t, bool maximize);
+
 
 
 /*
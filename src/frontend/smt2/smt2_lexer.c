@@ -30,6 +30,8 @@
 #include "frontend/smt2/smt2_hash_symbols.h"
 
 #include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_parallel_lexer.h"
+#include "utils/memalloc.h"
 
 
 /*
@@ -87,6 +89,8 @@ static const char * const smt2_token_string[NUM_SMT2_TOKENS] = {
   "set-option",            // SMT2_TK_SET_OPTION
   "reset",                 // SMT2_TK_RESET
   "reset-assertions",      // SMT2_TK_RESET_ASSERTIONS
+  "minimize",              // SMT2_TK_MINIMIZE
+  "maximize",              // SMT2_TK_MAXIMIZE
 
   "<bad-string>",          // SMT2_TK_INVALID_STRING
   "<invalid-numeral>",     // SMT2_TK_INVALID_NUMERAL
@@ -485,6 +489,37 @@ void init_smt2_wide_stream_lexer(lexer_t *lex, FILE *f, const char *name) {
 
 #endif
 
+/*
+ * Parallel lexer: NULL if not active
+ */
+#ifdef THREAD_SAFE
+static smt2_plexer_t *parallel_lexer = NULL;
+#endif
+
+void smt2_lexer_start_parallel(lexer_t *lex, uint32_t nthreads) {
+#ifdef THREAD_SAFE
+  smt2_plexer_t *p;
+
+  if (parallel_lexer == NULL && nthreads > 0 && reader_is_mapped(&lex->reader)) {
+    p = (smt2_plexer_t *) safe_malloc(sizeof(smt2_plexer_t));
+    // the workers check parallel_lexer so it must be set before they start
+    parallel_lexer = p;
+    init_smt2_plexer(p, lex, nthreads);
+  }
+#endif
+}
+
+void smt2_lexer_stop_parallel(void) {
+#ifdef THREAD_SAFE
+  if (parallel_lexer != NULL) {
+    delete_smt2_plexer(parallel_lexer);
+    safe_free(parallel_lexer);
+    parallel_lexer = NULL;
+  }
+#endif
+}
+
+
 /*
  * Get string for tokens/symbols/keywords
  */
@@ -969,6 +1004,133 @@ static smt2_token_t smt2_read_quoted_symbol(lexer_t *lex) {
 }
 
 
+/*
+ * Fast path for mapped files: scan the data directly
+ * - skip spaces and comments then record the start of the token
+ * - if the token is '(', ')', a numeral, a keyword, or a simple symbol,
+ *   copy its value to the buffer, move the reader to the end of the
+ *   token, store the token code in *tk, and return true
+ * - otherwise, move the reader to the start of the token and return false
+ *   (the generic code must handle the token)
+ *
+ * The line number is updated only when a newline is skipped. Columns
+ * are computed from the start of the current line (line_start).
+ */
+static bool smt2_mapped_token(lexer_t *lex, smt2_token_t *tk) {
+  reader_t *rd;
+  string_buffer_t *buffer;
+  const unsigned char *data;
+  const keyword_t *kw;
+  uint64_t i, j, n, line_start;
+  uint32_t line;
+  int c;
+
+  rd = &lex->reader;
+  buffer = lex->buffer;
+  if (reader_current_char(rd) == EOF) {
+    return false;
+  }
+
+  data = (const unsigned char *) rd->input.data;
+  n = rd->size;
+  if (rd->pos == 0) {
+    // nothing read yet: the current char is '\n' (before data[0])
+    i = 0;
+    line = 1;
+    line_start = 0;
+  } else {
+    i = rd->pos - 1;
+    line = rd->line;
+    line_start = i + 1 - rd->column;
+  }
+
+  // skip spaces and comments
+  for (;;) {
+    while (i < n && isspace(data[i])) {
+      if (data[i] == '\n') {
+        line ++;
+        line_start = i + 1;
+      }
+      i ++;
+    }
+    if (i == n || data[i] != ';') break;
+    do {
+      i ++;
+    } while (i < n && data[i] != '\n');
+  }
+
+  lex->tk_pos = i + 1;
+  lex->tk_line = line;
+  lex->tk_column = (uint32_t) (i - line_start + 1);
+
+  if (i == n) {
+    goto slow;
+  }
+
+  c = data[i];
+  j = i + 1;
+  switch (c) {
+  case '(':
+    *tk = SMT2_TK_LP;
+    break;
+
+  case ')':
+    *tk = SMT2_TK_RP;
+    break;
+
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    while (j < n && isdigit(data[j])) j ++;
+    if (j < n && data[j] == '.') {
+      goto slow; // decimal
+    }
+    string_buffer_append_chars(buffer, (const char *) data + i, (uint32_t) (j - i));
+    string_buffer_close(buffer);
+    *tk = SMT2_TK_NUMERAL;
+    break;
+
+  case ':':
+    while (j < n && issimple(data[j])) j ++;
+    if (j == i + 1) {
+      goto slow; // invalid keyword
+    }
+    string_buffer_append_chars(buffer, (const char *) data + i, (uint32_t) (j - i));
+    string_buffer_close(buffer);
+    *tk = SMT2_TK_KEYWORD;
+    break;
+
+  default:
+    if (c == '0' || !issimple(c)) {
+      goto slow;
+    }
+    while (j < n && issimple(data[j])) j ++;
+    string_buffer_append_chars(buffer, (const char *) data + i, (uint32_t) (j - i));
+    string_buffer_close(buffer);
+    *tk = SMT2_TK_SYMBOL;
+    kw = in_smt2_tk(buffer->data, buffer->index);
+    if (kw != NULL) {
+      *tk = kw->tk;
+    }
+    break;
+  }
+
+  // tokens don't contain newlines
+  mapped_reader_goto(rd, j, line, (uint32_t) (j - line_start + 1));
+  return true;
+
+ slow:
+  mapped_reader_goto(rd, i, line, (uint32_t) (i - line_start + 1));
+  return false;
+}
+
+
 /*
  * Read the next token and return its code tk
  * - set lex->token to tk
@@ -982,11 +1144,27 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
   int c;
   smt2_token_t tk;
 
+#ifdef THREAD_SAFE
+  if (parallel_lexer != NULL && parallel_lexer->lex == lex) {
+    if (smt2_plexer_next_token(parallel_lexer)) {
+      return lex->token;
+    }
+    // all chunks are consumed: continue with the sequential lexer
+    smt2_lexer_stop_parallel();
+  }
+#endif
+
   rd = &lex->reader;
-  c = reader_current_char(rd);
   buffer = lex->buffer;
   string_buffer_reset(buffer);
 
+  if (reader_is_mapped(rd) && smt2_mapped_token(lex, &tk)) {
+    lex->token = tk;
+    return tk;
+  }
+
+  c = reader_current_char(rd);
+
   // skip spaces and comments
   for (;;) {
     while (isspace(c)) c = reader_next_char(rd);
@@ -97,6 +97,8 @@ enum smt2_token {
   SMT2_TK_SET_OPTION,
   SMT2_TK_RESET,
   SMT2_TK_RESET_ASSERTIONS,
+  SMT2_TK_MINIMIZE,
+  SMT2_TK_MAXIMIZE,
 
   // Errors
   SMT2_TK_INVALID_STRING,
@@ -318,6 +320,23 @@ static inline void init_smt2_wide_stdin_lexer(lexer_t *lex) {
 
 #endif
 
+/*
+ * Parallel lexing (for large files):
+ * - lex must be a file lexer and nothing must have been read from it yet
+ * - nthreads = number of worker threads that split and scan the file
+ * - the tokens are returned by next_smt2_token in the same order and
+ *   with the same values and positions as in sequential lexing
+ * - this has no effect if the file could not be mapped in memory,
+ *   or if parallel lexing is already active, or if THREAD_SAFE is
+ *   not defined
+ *
+ * smt2_lexer_stop_parallel must be called before lex is closed.
+ * It's safe to call it if parallel lexing was not started.
+ */
+extern void smt2_lexer_start_parallel(lexer_t *lex, uint32_t nthreads);
+extern void smt2_lexer_stop_parallel(void);
+
+
 /*
  * Read next token and return its type
  * - update lex->token (set it to tk)
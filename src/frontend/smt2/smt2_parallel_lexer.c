@@ -0,0 +1,487 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL LEXING OF LARGE SMT2 FILES
+ */
+
+#ifdef THREAD_SAFE
+
+#include <assert.h>
+#include <ctype.h>
+#include <string.h>
+
+#include "frontend/smt2/smt2_parallel_lexer.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * CHUNKS
+ */
+static void init_chunk(smt2_chunk_t *c) {
+  c->start = 0;
+  c->end = 0;
+  c->line = 0;
+  c->column = 0;
+  c->ready = false;
+  c->ntokens = 0;
+  c->tsize = 0;
+  c->nchars = 0;
+  c->csize = 0;
+  c->token = NULL;
+  c->chars = NULL;
+}
+
+static void delete_chunk(smt2_chunk_t *c) {
+  safe_free(c->token);
+  safe_free(c->chars);
+  c->token = NULL;
+  c->chars = NULL;
+}
+
+
+/*
+ * Make room for one more token
+ */
+static void chunk_extend_tokens(smt2_chunk_t *c) {
+  uint32_t n;
+
+  n = c->tsize;
+  if (n == 0) {
+    n = 1024;
+  } else {
+    n += n >> 1;
+    if (n <= c->tsize || n > UINT32_MAX/sizeof(smt2_ptoken_t)) {
+      out_of_memory();
+    }
+  }
+  c->token = (smt2_ptoken_t *) safe_realloc(c->token, n * sizeof(smt2_ptoken_t));
+  c->tsize = n;
+}
+
+/*
+ * Make room for len more characters
+ */
+static void chunk_extend_chars(smt2_chunk_t *c, uint32_t len) {
+  uint32_t n, min;
+
+  min = c->nchars + len;
+  if (min < len) {
+    out_of_memory();
+  }
+  n = c->csize;
+  if (n < min) {
+    n += n >> 1;
+    if (n < min) {
+      n = min;
+    }
+    if (n < 4096) {
+      n = 4096;
+    }
+    c->chars = (char *) safe_realloc(c->chars, n);
+    c->csize = n;
+  }
+}
+
+
+/*
+ * Store the current token of lex in chunk c
+ */
+static void chunk_push_token(smt2_chunk_t *c, lexer_t *lex) {
+  smt2_ptoken_t *t;
+  uint32_t len;
+
+  if (c->ntokens == c->tsize) {
+    chunk_extend_tokens(c);
+  }
+  len = current_token_length(lex);
+  chunk_extend_chars(c, len);
+
+  t = c->token + c->ntokens;
+  t->tk = current_token(lex);
+  t->line = current_token_line(lex);
+  t->column = current_token_column(lex);
+  t->pos = current_token_pos(lex);
+  t->val = c->nchars;
+  t->len = len;
+  memcpy(c->chars + c->nchars, current_token_value(lex), len);
+  c->nchars += len;
+  c->ntokens ++;
+}
+
+
+/*
+ * Convert c into tokens
+ * - the tokens are produced by the sequential lexer, on a fragment of the input
+ */
+static void lex_chunk(smt2_plexer_t *p, smt2_chunk_t *c) {
+  lexer_t lex;
+  string_buffer_t buffer;
+
+  init_fragment_reader(&lex.reader, &p->lex->reader, c->start, c->end, c->line, c->column);
+  init_string_buffer(&buffer, 128);
+  lex.token = -1;
+  lex.tk_pos = 0;
+  lex.tk_line = 0;
+  lex.tk_column = 0;
+  lex.buffer = &buffer;
+  lex.next = NULL;
+
+  c->ntokens = 0;
+  c->nchars = 0;
+  while (next_smt2_token(&lex) != SMT2_TK_EOS) {
+    chunk_push_token(c, &lex);
+  }
+
+  delete_string_buffer(&buffer);
+}
+
+
+
+/*
+ * SPLITTER
+ */
+
+/*
+ * Check whether character x can occur in a string literal or quoted
+ * symbol without ambiguity:
+ * - '\\' is an escape character in SMT-LIB 2.0 strings but not in 2.5
+ *   (it's not allowed in quoted symbols)
+ * - control characters other than spaces are errors
+ * - characters outside the ASCII range are accepted or not in strings
+ *   depending on the version and the locale
+ */
+static inline bool safe_char(int x, int delim) {
+  if (x == '\\') return false;
+  if (x < 32) return isspace(x);
+  return delim == '|' || x < 127;
+}
+
+
+/*
+ * Find the next chunk and store its bounds in c
+ * - the chunk starts at p->split_pos and ends after a top-level ')'
+ *   once it contains at least SMT2_CHUNK_SIZE bytes, or at the end of the data
+ * - if an ambiguous string or quoted symbol is found, the chunk ends at
+ *   the last top-level boundary before it, and p->split_done is set
+ * - return false if there's no chunk left (then p->split_done is true)
+ */
+static bool split_next_chunk(smt2_plexer_t *p, smt2_chunk_t *c) {
+  const unsigned char *data;
+  uint64_t i, j, n, line_start, boundary, b_line_start;
+  uint32_t line, b_line, depth;
+  int x;
+  bool safe;
+
+  if (p->split_done) {
+    return false;
+  }
+
+  data = (const unsigned char *) p->lex->reader.input.data;
+  n = p->lex->reader.size;
+
+  i = p->split_pos;
+  line = p->split_line;
+  line_start = p->split_line_start;
+  boundary = i;
+  b_line = line;
+  b_line_start = line_start;
+  depth = 0;
+  safe = true;
+
+  while (i < n) {
+    x = data[i];
+    switch (x) {
+    case '\n':
+      line ++;
+      i ++;
+      line_start = i;
+      break;
+
+    case ';':
+      do {
+        i ++;
+      } while (i < n && data[i] != '\n');
+      break;
+
+    case '(':
+      depth ++;
+      i ++;
+      break;
+
+    case ')':
+      i ++;
+      if (depth > 0) depth --;
+      if (depth == 0) {
+        boundary = i;
+        b_line = line;
+        b_line_start = line_start;
+        if (i - p->split_pos >= SMT2_CHUNK_SIZE) goto done;
+      }
+      break;
+
+    case '"':
+    case '|':
+      for (j=i+1; j<n && data[j] != x; j++) {
+        if (! safe_char(data[j], x)) {
+          safe = false;
+          goto done;
+        }
+        if (data[j] == '\n') {
+          line ++;
+          line_start = j+1;
+        }
+      }
+      if (j == n || (x == '"' && j+1 < n && data[j+1] == '"')) {
+        // unterminated or "" inside a string
+        safe = false;
+        goto done;
+      }
+      i = j+1;
+      break;
+
+    default:
+      i ++;
+      break;
+    }
+  }
+
+  // end of the data
+  boundary = n;
+  b_line = line;
+  b_line_start = line_start;
+
+ done:
+  if (!safe || i == n) {
+    p->split_done = true;
+  }
+  if (boundary == p->split_pos) {
+    return false;
+  }
+
+  c->start = p->split_pos;
+  c->end = boundary;
+  c->line = p->split_line;
+  c->column = (uint32_t) (p->split_pos - p->split_line_start + 1);
+
+  p->split_pos = boundary;
+  p->split_line = b_line;
+  p->split_line_start = b_line_start;
+
+  return true;
+}
+
+
+
+/*
+ * WORKERS
+ */
+
+/*
+ * Each worker splits the next chunk (with the lock held) then converts
+ * it to tokens (without the lock). Workers wait if all the slots are
+ * in use.
+ */
+static void plexer_worker_run(smt2_plexer_t *p) {
+  smt2_chunk_t *c;
+
+  get_yices_lock(&p->lock);
+  for (;;) {
+    if (p->stop || p->split_done) break;
+    if (p->nchunks - p->consumed >= p->nslots) {
+      wait_yices_cond(&p->space, &p->lock);
+      continue;
+    }
+
+    c = p->chunk + (p->nchunks % p->nslots);
+    assert(! c->ready);
+    if (! split_next_chunk(p, c)) {
+      broadcast_yices_cond(&p->ready);
+      break;
+    }
+    p->nchunks ++;
+    if (p->split_done) {
+      broadcast_yices_cond(&p->ready);
+    }
+    release_yices_lock(&p->lock);
+
+    lex_chunk(p, c);
+
+    get_yices_lock(&p->lock);
+    c->ready = true;
+    broadcast_yices_cond(&p->ready);
+  }
+  release_yices_lock(&p->lock);
+}
+
+static yices_thread_result_t YICES_THREAD_ATTR plexer_worker_main(void *arg) {
+  plexer_worker_run(arg);
+  return yices_thread_exit();
+}
+
+
+
+/*
+ * Initialize and start the workers
+ */
+void init_smt2_plexer(smt2_plexer_t *p, lexer_t *lex, uint32_t nthreads) {
+  uint32_t i, n;
+
+  assert(reader_is_mapped(&lex->reader) && reader_position(&lex->reader) == 0);
+  assert(nthreads > 0 && nthreads <= UINT32_MAX/SMT2_SLOTS_PER_WORKER);
+
+  p->lex = lex;
+  create_yices_lock(&p->lock);
+  create_yices_cond(&p->ready);
+  create_yices_cond(&p->space);
+
+  n = nthreads * SMT2_SLOTS_PER_WORKER;
+  p->chunk = (smt2_chunk_t *) safe_malloc(n * sizeof(smt2_chunk_t));
+  for (i=0; i<n; i++) {
+    init_chunk(p->chunk + i);
+  }
+  p->nslots = n;
+  p->nchunks = 0;
+  p->consumed = 0;
+  p->split_done = false;
+  p->stop = false;
+  p->split_pos = 0;
+  p->split_line_start = 0;
+  p->split_line = 1;
+  p->current = NULL;
+  p->next = 0;
+
+  p->workers = (yices_thread_t *) safe_malloc(nthreads * sizeof(yices_thread_t));
+  n = 0;
+  while (n < nthreads) {
+    if (start_yices_thread(p->workers + n, plexer_worker_main, p) < 0) break;
+    n ++;
+  }
+  p->nworkers = n;
+
+  if (n == 0) {
+    // no workers: everything is done by the sequential lexer
+    p->split_done = true;
+  }
+}
+
+
+/*
+ * Stop the workers and delete everything
+ */
+void delete_smt2_plexer(smt2_plexer_t *p) {
+  uint32_t i;
+
+  get_yices_lock(&p->lock);
+  p->stop = true;
+  broadcast_yices_cond(&p->space);
+  broadcast_yices_cond(&p->ready);
+  release_yices_lock(&p->lock);
+
+  for (i=0; i<p->nworkers; i++) {
+    join_yices_thread(p->workers + i);
+  }
+  safe_free(p->workers);
+  p->workers = NULL;
+
+  for (i=0; i<p->nslots; i++) {
+    delete_chunk(p->chunk + i);
+  }
+  safe_free(p->chunk);
+  p->chunk = NULL;
+
+  destroy_yices_cond(&p->space);
+  destroy_yices_cond(&p->ready);
+  destroy_yices_lock(&p->lock);
+}
+
+
+
+/*
+ * PARSER SIDE
+ */
+
+/*
+ * Wait until the next chunk is ready
+ * - return NULL if there are no more chunks
+ */
+static smt2_chunk_t *plexer_next_chunk(smt2_plexer_t *p) {
+  smt2_chunk_t *c;
+
+  c = NULL;
+  get_yices_lock(&p->lock);
+  if (p->current != NULL) {
+    // the current chunk is consumed: free its slot
+    p->current->ready = false;
+    p->current = NULL;
+    p->consumed ++;
+    broadcast_yices_cond(&p->space);
+  }
+  while (p->consumed == p->nchunks && !p->split_done) {
+    wait_yices_cond(&p->ready, &p->lock);
+  }
+  if (p->consumed < p->nchunks) {
+    c = p->chunk + (p->consumed % p->nslots);
+    while (! c->ready) {
+      wait_yices_cond(&p->ready, &p->lock);
+    }
+  }
+  release_yices_lock(&p->lock);
+
+  return c;
+}
+
+
+/*
+ * Next token
+ */
+bool smt2_plexer_next_token(smt2_plexer_t *p) {
+  smt2_chunk_t *c;
+  smt2_ptoken_t *t;
+  lexer_t *lex;
+
+  lex = p->lex;
+  c = p->current;
+  while (c == NULL || p->next == c->ntokens) {
+    c = plexer_next_chunk(p);
+    if (c == NULL) {
+      // resume sequential lexing after the last chunk
+      mapped_reader_goto(&lex->reader, p->split_pos, p->split_line,
+                         (uint32_t) (p->split_pos - p->split_line_start + 1));
+      return false;
+    }
+    p->current = c;
+    p->next = 0;
+  }
+
+  t = c->token + p->next;
+  p->next ++;
+
+  lex->token = t->tk;
+  lex->tk_pos = t->pos;
+  lex->tk_line = t->line;
+  lex->tk_column = t->column;
+  string_buffer_reset(lex->buffer);
+  string_buffer_append_chars(lex->buffer, c->chars + t->val, t->len);
+  string_buffer_close(lex->buffer);
+
+  return true;
+}
+
+
+#endif /* THREAD_SAFE */
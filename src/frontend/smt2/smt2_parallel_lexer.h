@@ -0,0 +1,169 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL LEXING OF LARGE SMT2 FILES
+ *
+ * The input file must be mapped in memory. It's split into chunks
+ * at top-level command boundaries. Worker threads convert the chunks
+ * into token arrays, and the parser consumes these tokens in input
+ * order. Terms are still built by the parser's thread so the term
+ * table is the same as in sequential mode.
+ *
+ * The chunks must produce exactly the same tokens as the sequential
+ * lexer. The only mode-dependent part of the lexer is the syntax of
+ * string literals (SMT-LIB 2.0 vs. 2.5). If the splitter finds a
+ * string (or quoted symbol) whose meaning depends on the mode, it
+ * stops: the rest of the file is handled by the sequential lexer.
+ *
+ * This is available only in THREAD_SAFE mode.
+ */
+
+#ifndef __SMT2_PARALLEL_LEXER_H
+#define __SMT2_PARALLEL_LEXER_H
+
+#ifdef THREAD_SAFE
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "frontend/smt2/smt2_lexer.h"
+#include "mt/threads.h"
+#include "mt/yices_locks.h"
+
+
+/*
+ * Pre-lexed token:
+ * - tk = token code
+ * - pos, line, column = start of the token
+ * - the token value is stored in the chunk's character array,
+ *   at index val, and its length is len
+ */
+typedef struct smt2_ptoken_s {
+  smt2_token_t tk;
+  uint32_t line;
+  uint32_t column;
+  uint32_t val;
+  uint32_t len;
+  uint64_t pos;
+} smt2_ptoken_t;
+
+
+/*
+ * Chunk = fragment data[start ... end-1] of the input
+ * - line/column = position of data[start]
+ * - token = array of pre-lexed tokens
+ *   ntokens = number of tokens
+ *   tsize = size of the token array
+ * - chars = character array for the token values
+ *   nchars = number of characters used
+ *   csize = size of the character array
+ * - ready = true once all tokens are in the arrays
+ */
+typedef struct smt2_chunk_s {
+  uint64_t start;
+  uint64_t end;
+  uint32_t line;
+  uint32_t column;
+  bool ready;
+  uint32_t ntokens;
+  uint32_t tsize;
+  uint32_t nchars;
+  uint32_t csize;
+  smt2_ptoken_t *token;
+  char *chars;
+} smt2_chunk_t;
+
+
+/*
+ * Parallel lexer:
+ * - lex = the lexer whose input is processed in parallel
+ * - lock protects all the fields below it
+ * - ready is signaled when a chunk is ready or when splitting is done
+ * - space is signaled when a chunk is consumed (or on stop)
+ * - chunk = circular buffer of nslots chunks
+ *   chunk k (k=0, 1, ...) is stored in chunk[k % nslots]
+ * - nchunks = number of chunks created so far
+ * - consumed = number of chunks entirely consumed by the parser
+ * - split_done = true if there are no more chunks
+ * - stop = true to stop the workers
+ * - split_pos, split_line, split_line_start = where the next chunk
+ *   starts (split_line_start = index of the start of the line)
+ * - current = chunk being consumed by the parser (NULL if none)
+ * - next = index of the next token to return in the current chunk
+ * - workers: nworkers threads
+ *
+ * The parser's thread reads current and next without holding the lock.
+ */
+typedef struct smt2_plexer_s {
+  lexer_t *lex;
+  yices_lock_t lock;
+  yices_cond_t ready;
+  yices_cond_t space;
+  smt2_chunk_t *chunk;
+  uint32_t nslots;
+  uint32_t nchunks;
+  uint32_t consumed;
+  bool split_done;
+  bool stop;
+  uint64_t split_pos;
+  uint64_t split_line_start;
+  uint32_t split_line;
+  smt2_chunk_t *current;
+  uint32_t next;
+  uint32_t nworkers;
+  yices_thread_t *workers;
+} smt2_plexer_t;
+
+
+/*
+ * Chunk size: a chunk is at least this large (except the last one)
+ */
+#define SMT2_CHUNK_SIZE 262144
+
+/*
+ * Number of chunks in the circular buffer per worker
+ */
+#define SMT2_SLOTS_PER_WORKER 3
+
+
+/*
+ * Initialize p and start nthreads workers
+ * - lex must be a mapped file lexer and nothing must have been read yet
+ * - nthreads must be positive
+ */
+extern void init_smt2_plexer(smt2_plexer_t *p, lexer_t *lex, uint32_t nthreads);
+
+/*
+ * Get the next token for p->lex
+ * - if there's a token, store it in p->lex (token code, position, value)
+ *   then return true
+ * - if all the chunks have been consumed, move the reader of p->lex to
+ *   the end of the last chunk and return false
+ */
+extern bool smt2_plexer_next_token(smt2_plexer_t *p);
+
+/*
+ * Stop the workers and delete p
+ */
+extern void delete_smt2_plexer(smt2_plexer_t *p);
+
+
+#endif /* THREAD_SAFE */
+
+#endif /* __SMT2_PARALLEL_LEXER_H */
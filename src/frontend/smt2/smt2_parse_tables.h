@@ -81,6 +81,8 @@ typedef enum actions {
   reset_next_goto_r0,
   reset_assertions_next_goto_r0,
   check_sat_assuming_model_next_goto_c17,
+  minimize_next_push_r0_goto_t0,
+  maximize_next_push_r0_goto_t0,
 
   // arguments to the commands
   numeral_next_goto_r0,
@@ -235,7 +237,7 @@ typedef enum actions {
 
 // Table sizes
 #define NSTATES 84
-#define BSIZE 298
+#define BSIZE 302
 
 // Default values for each state
 static const uint8_t default_value[NSTATES] = {
@@ -327,15 +329,15 @@ static const uint8_t default_value[NSTATES] = {
 
 // Base values for each state
 static const uint8_t base[NSTATES] = {
-     0,   0,   0,   0,  42,   1,   0,   0,  44,   4,
-    53,  50,   5,   5,  57,   7,  12,  60,  13,  15,
-    15,  10,  10,  47,  20,  63,  49,  68,  59,  67,
-    86,  70,  73, 106,  78, 116, 127, 130, 120,  79,
-    82,  80, 124,  94,  99,  98, 176, 186, 103, 104,
-   161, 106, 117, 131, 134, 179, 139, 143, 131, 147,
-   149, 182, 146, 148, 211, 138, 190, 159, 164, 156,
-   231, 159, 220, 174, 213, 188, 224, 190, 222, 227,
-   193, 240, 199, 207,
+     0,   0,   0,   0,  44,   1,   0,   0,  46,   4,
+    55,  52,   5,   5,  59,   7,  12,  62,  13,  15,
+    15,  10,  10,  49,  20,  65,  51,  70,  61,  69,
+    88,  72,  75, 108,  80, 118, 129, 132, 122,  81,
+    84,  82, 126,  96, 101, 100, 178, 188, 105, 106,
+   163, 108, 119, 133, 136, 181, 141, 145, 133, 149,
+   151, 184, 148, 150, 213, 140, 192, 161, 166, 158,
+   233, 161, 222, 176, 215, 190, 226, 192, 224, 229,
+   195, 242, 201, 209,
 };
 
 // Check table
@@ -345,31 +347,32 @@ static const uint8_t check[BSIZE] = {
     24,   1,   1,   1,   1,   1,   1,   1,   1,   1,
      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
-     4,   4,   8,   8,  10,  23,  23,  26,  11,  11,
-    28,  10,  10,  25,  25,  14,  14,  29,  17,  17,
-    31,  25,  25,   4,  32,   8,  27,  27,   4,  34,
-     8,  11,  39,  40,  10,  40,  11,  30,  14,  10,
-     4,  17,   8,  14,  30,  41,  17,  43,  11,  45,
-    44,  10,  44,  48,  49,  14,  33,  51,  17,  33,
-    33,  33,  33,  33,  33,  33,  35,  52,  52,  35,
-    35,  35,  35,  35,  35,  35,  35,  36,  38,  38,
-    37,  53,  42,  42,  54,  36,  36,  33,  37,  37,
-    56,  58,  33,  57,  57,  37,  62,  35,  59,  63,
-    60,  38,  35,  65,  33,  42,  38,  59,  36,  60,
-    42,  37,  67,  36,  35,  68,  37,  68,  38,  50,
-    50,  69,  42,  69,  71,  36,  46,  73,  37,  46,
-    46,  46,  46,  46,  46,  46,  47,  55,  55,  75,
-    61,  61,  50,  77,  47,  47,  80,  50,  66,  66,
-    82,  47,  47,  47,  47,  47,  47,  46,  83,  50,
-    55,  64,  46,  61,  74,  55,  74,  47,  61,  64,
-    64,  66,  47,  78,  46,  78,  66,  55,  72,  72,
-    61,  70,  76,  76,  47,  79,  79,  84,  66,  70,
-    70,  81,  64,  81,  84,  84,  84,  64,  84,  84,
-    84,  72,  84,  84,  84,  76,  72,  84,  79,  64,
-    76,  84,  70,  79,  84,  84,  84,  70,  72,  84,
-    84,  84,  76,  84,  84,  79,  84,  84,  84,  70,
+     1,   1,   4,   4,   8,   8,  10,  23,  23,  26,
+    11,  11,  28,  10,  10,  25,  25,  14,  14,  29,
+    17,  17,  31,  25,  25,   4,  32,   8,  27,  27,
+     4,  34,   8,  11,  39,  40,  10,  40,  11,  30,
+    14,  10,   4,  17,   8,  14,  30,  41,  17,  43,
+    11,  45,  44,  10,  44,  48,  49,  14,  33,  51,
+    17,  33,  33,  33,  33,  33,  33,  33,  35,  52,
+    52,  35,  35,  35,  35,  35,  35,  35,  35,  36,
+    38,  38,  37,  53,  42,  42,  54,  36,  36,  33,
+    37,  37,  56,  58,  33,  57,  57,  37,  62,  35,
+    59,  63,  60,  38,  35,  65,  33,  42,  38,  59,
+    36,  60,  42,  37,  67,  36,  35,  68,  37,  68,
+    38,  50,  50,  69,  42,  69,  71,  36,  46,  73,
+    37,  46,  46,  46,  46,  46,  46,  46,  47,  55,
+    55,  75,  61,  61,  50,  77,  47,  47,  80,  50,
+    66,  66,  82,  47,  47,  47,  47,  47,  47,  46,
+    83,  50,  55,  64,  46,  61,  74,  55,  74,  47,
+    61,  64,  64,  66,  47,  78,  46,  78,  66,  55,
+    72,  72,  61,  70,  76,  76,  47,  79,  79,  84,
+    66,  70,  70,  81,  64,  81,  84,  84,  84,  64,
+    84,  84,  84,  72,  84,  84,  84,  76,  72,  84,
+    79,  64,  76,  84,  70,  79,  84,  84,  84,  70,
+    72,  84,  84,  84,  76,  84,  84,  79,  84,  84,
+    84,  70,  84,  84,  84,  84,  84,  84,  84,  84,
     84,  84,  84,  84,  84,  84,  84,  84,  84,  84,
-    84,  84,  84,  84,  84,  84,  84,  84,
+    84,  84,
 };
 
 // Value table
@@ -424,6 +427,8 @@ static const uint8_t value[BSIZE] = {
   set_option_next_goto_c6,
   reset_next_goto_r0,
   reset_assertions_next_goto_r0,
+  minimize_next_push_r0_goto_t0,
+  maximize_next_push_r0_goto_t0,
   symbol_next_goto_r0,
   symbol_next_goto_r0,
   symbol_next_goto_c9a,
@@ -672,7 +677,8 @@ static const uint8_t value[BSIZE] = {
   error,
   error,
   error,
+  error,
+  error,
 };
 
-
 #endif /* __SMT2_PARSE_TABLES_H */
@@ -294,6 +294,18 @@ static int32_t smt2_parse(parser_t *parser, state_t start) {
       state = r0;
       goto loop;
 
+    case minimize_next_push_r0_goto_t0:
+      tstack_push_op(tstack, SMT2_MINIMIZE, &loc);
+      parser_push_state(stack, r0);
+      state = t0;
+      goto loop;
+
+    case maximize_next_push_r0_goto_t0:
+      tstack_push_op(tstack, SMT2_MAXIMIZE, &loc);
+      parser_push_state(stack, r0);
+      state = t0;
+      goto loop;
+
     case numeral_next_goto_r0:
       tstack_push_rational(tstack, tkval(lex), &loc);
       state = r0;
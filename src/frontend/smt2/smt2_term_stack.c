@@ -1495,6 +1495,42 @@ static void eval_smt2_reset_all(tstack_t *stack, stack_elem_t *f, uint32_t n) {
 }
 
 
+/*
+ * [minimize <term> ]
+ */
+static void check_smt2_minimize(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  check_op(stack, SMT2_MINIMIZE);
+  check_size(stack, n == 1);
+}
+
+static void eval_smt2_minimize(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  term_t t;
+
+  t = get_term(stack, f);
+  smt2_set_objective(t, false);
+  tstack_pop_frame(stack);
+  no_result(stack);
+}
+
+
+/*
+ * [maximize <term> ]
+ */
+static void check_smt2_maximize(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  check_op(stack, SMT2_MAXIMIZE);
+  check_size(stack, n == 1);
+}
+
+static void eval_smt2_maximize(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  term_t t;
+
+  t = get_term(stack, f);
+  smt2_set_objective(t, true);
+  tstack_pop_frame(stack);
+  no_result(stack);
+}
+
+
 /*
  * ATTRIBUTES
  */
@@ -2662,6 +2698,8 @@ void init_smt2_tstack(tstack_t *stack) {
   tstack_add_op(stack, SMT2_ECHO, false, eval_smt2_echo, check_smt2_echo);
   tstack_add_op(stack, SMT2_RESET_ASSERTIONS, false, eval_smt2_reset_assertions, check_smt2_reset_assertions);
   tstack_add_op(stack, SMT2_RESET_ALL, false, eval_smt2_reset_all, check_smt2_reset_all);
+  tstack_add_op(stack, SMT2_MINIMIZE, false, eval_smt2_minimize, check_smt2_minimize);
+  tstack_add_op(stack, SMT2_MAXIMIZE, false, eval_smt2_maximize, check_smt2_maximize);
 
   tstack_add_op(stack, SMT2_MAKE_ATTR_LIST, false, eval_smt2_make_attr_list, check_smt2_make_attr_list);
   tstack_add_op(stack, SMT2_ADD_ATTRIBUTES, false, eval_smt2_add_attributes, check_smt2_add_attributes);
@@ -1308,6 +1308,10 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.tclause_size, n);
     break;
 
+  case PARAM_CHRONO_THRESHOLD:
+    show_pos32_param(param2string[p], parameters.chrono_threshold, n);
+    break;
+
   case PARAM_DYN_ACK:
     show_bool_param(param2string[p], parameters.use_dyn_ack, n);
     break;
@@ -1360,6 +1364,10 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_bool_param(param2string[p], parameters.adjust_simplex_model, n);
     break;
 
+  case PARAM_SIMPLEX_FLOAT:
+    show_bool_param(param2string[p], parameters.simplex_float_presolve, n);
+    break;
+
   case PARAM_PROP_THRESHOLD:
     show_pos32_param(param2string[p], parameters.max_prop_row_size, n);
     break;
@@ -1384,6 +1392,14 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.max_extensionality, n);
     break;
 
+  case PARAM_BV_AIG:
+    show_bool_param(param2string[p], parameters.bv_aig, n);
+    break;
+
+  case PARAM_BV_SWEEP:
+    show_bool_param(param2string[p], parameters.bv_sweep, n);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     show_bool_param(param2string[p], ef_client_globals.ef_parameters.flatten_iff, n);
     break;
@@ -1728,6 +1744,13 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_CHRONO_THRESHOLD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.chrono_threshold = n;
+      print_ok();
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       parameters.use_dyn_ack = tt;
@@ -1826,6 +1849,13 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_SIMPLEX_FLOAT:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.simplex_float_presolve = tt;
+      print_ok();
+    }
+    break;
+
   case PARAM_PROP_THRESHOLD:
     if (param_val_to_nonneg32(param, val, &n, &reason)) {
       parameters.max_prop_row_size = n;
@@ -1875,6 +1905,20 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_BV_AIG:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.bv_aig = tt;
+      print_ok();
+    }
+    break;
+
+  case PARAM_BV_SWEEP:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.bv_sweep = tt;
+      print_ok();
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_client_globals.ef_parameters.flatten_iff = tt;
@@ -2084,6 +2128,7 @@ static void show_stats(dpll_stats_t *stat) {
   printf(" random decisions        : %"PRIu64"\n", stat->random_decisions);
   printf(" propagations            : %"PRIu64"\n", stat->propagations);
   printf(" conflicts               : %"PRIu64"\n", stat->conflicts);
+  printf(" chrono backtracks       : %"PRIu64"\n", stat->chrono_backtracks);
   printf(" theory propagations     : %"PRIu32"\n", stat->th_props);
   printf(" propagation-lemmas      : %"PRIu32"\n", stat->th_prop_lemmas);
   printf(" theory conflicts        : %"PRIu32"\n", stat->th_conflicts);
@@ -2142,6 +2187,8 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   printf(" calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   printf(" pivots                  : %"PRIu32"\n", stat->num_pivots);
   printf(" bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  printf(" float presolve calls   : %"PRIu32"\n", stat->num_float_presolve);
+  printf(" float pivots            : %"PRIu32"\n", stat->num_float_pivots);
   printf(" simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   printf(" prop. to core           : %"PRIu32"\n", stat->num_props);
   printf(" derived bounds          : %"PRIu32"\n", stat->num_bound_props);
@@ -2182,6 +2229,8 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   printf(" sge atoms               : %"PRIu32"\n", bv_solver_num_sge_atoms(solver));
   printf(" equiv lemmas            : %"PRIu32"\n", solver->stats.equiv_lemmas);
   printf(" interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  printf(" aig nodes               : %"PRIu32"\n", solver->stats.aig_nodes);
+  printf(" aig merges              : %"PRIu32"\n", solver->stats.aig_merges);
 }
 
 
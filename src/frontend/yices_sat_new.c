@@ -37,21 +37,39 @@
 #include <math.h>
 
 #include "io/reader.h"
+#include "solvers/cdcl/clause_exchange.h"
+#include "solvers/cdcl/cube_solver.h"
 #include "solvers/cdcl/new_sat_solver.h"
 #include "utils/command_line.h"
 #include "utils/cputime.h"
 #include "utils/memalloc.h"
 #include "utils/memsize.h"
 
+#ifdef THREAD_SAFE
+#include "mt/threads.h"
+#endif
+
 #include "yices.h"
 #include "yices_exit_codes.h"
 
 
 /*
  * GLOBAL OBJECTS
+ * - workers = array of num_workers solvers (all built from the same input)
+ * - solver = the solver whose result is reported (i.e., the first
+ *   worker to finish)
+ * - exchange = for clause sharing between workers
+ * - cubes = for cube-and-conquer (then workers contains a single solver
+ *   and num_workers is the number of threads)
  */
 
-static sat_solver_t solver;
+#define MAX_WORKERS 64
+
+static sat_solver_t *workers;
+static uint32_t num_workers;
+static sat_solver_t *solver;
+static clause_exchange_t exchange;
+static cube_solver_t cubes;
 static double construction_time, search_time;
 
 
@@ -205,7 +223,7 @@ static literal_t read_literal(reader_t *reader, int32_t nv) {
 
 
 /*
- * Read DIMACS instance from filename and construct a solver
+ * Read DIMACS instance from filename and construct solver sol
  * - pp true means build the solver for preprocessing
  * - pp false means disable preprocessing (this is the default)
  * returns 0 if no error occurred.
@@ -215,7 +233,7 @@ static literal_t read_literal(reader_t *reader, int32_t nv) {
 #define OPEN_ERROR -1
 #define FORMAT_ERROR -2
 
-static int build_instance(const char *filename, bool pp) {
+static int build_instance(sat_solver_t *sol, const char *filename, bool pp) {
   int n, x, c_idx, l_idx, literal;
   reader_t reader;
   char pline[200];
@@ -252,8 +270,8 @@ static int build_instance(const char *filename, bool pp) {
   }
 
   /* initialize solver for nvars */
-  init_nsat_solver(&solver, nvars + 1, pp);
-  nsat_solver_add_vars(&solver, nvars);
+  init_nsat_solver(sol, nvars + 1, pp);
+  nsat_solver_add_vars(sol, nvars);
 
   /* now read clauses and translate them */
   c_idx = 0;
@@ -280,7 +298,7 @@ static int build_instance(const char *filename, bool pp) {
 	return FORMAT_ERROR;
       }
 
-      nsat_solver_simplify_and_add_clause(&solver, l_idx, clause);
+      nsat_solver_simplify_and_add_clause(sol, l_idx, clause);
       c_idx ++;
     }
   }
@@ -299,10 +317,10 @@ static bool clause_is_true(uint32_t n, literal_t *a) {
   uint32_t i;
 
   for (i=0; i<n; i++) {
-    if (lit_value(&solver, a[i]) == VAL_TRUE) {
+    if (lit_value(solver, a[i]) == VAL_TRUE) {
       return true;
     }
-    if (lit_value(&solver, a[i]) != VAL_FALSE) {
+    if (lit_value(solver, a[i]) != VAL_FALSE) {
       fprintf(stderr, "BUG: the model does not assign a value to literal %"PRId32"\n", a[i]);
       exit(1);
     }
@@ -401,8 +419,11 @@ static void check_model(const char *filename) {
  *   seed_value = value of the seed
  * - stats = true for printing statistics
  * - data = true for collecting data
+ * - cube_depth = depth for cube-and-conquer (-1 means no cubes)
+ * - proof_filename = file where the DRAT proof is written (NULL means no proof)
  */
 static char *input_filename = NULL;
+static char *proof_filename = NULL;
 static bool verbose;
 static bool model;
 static bool check;
@@ -411,6 +432,7 @@ static bool seed_given;
 static uint32_t seed_value;
 static bool stats;
 static bool data;
+static int32_t cube_depth;
 
 static bool var_decay_given;
 static bool clause_decay_given;
@@ -421,6 +443,9 @@ static bool reduce_fraction_given;
 static bool reduce_interval_given;
 static bool reduce_delta_given;
 static bool restart_interval_given;
+static bool luby_unit_given;
+static bool rephase_interval_given;
+static bool inprocess_interval_given;
 static bool subsume_skip_given;
 static bool var_elim_skip_given;
 static bool res_clause_limit_given;
@@ -437,6 +462,9 @@ static uint32_t reduce_fraction;
 static uint32_t reduce_interval;
 static uint32_t reduce_delta;
 static uint32_t restart_interval;
+static uint32_t luby_unit;
+static uint32_t rephase_interval;
+static uint32_t inprocess_interval;
 static uint32_t subsume_skip;
 static uint32_t var_elim_skip;
 static uint32_t res_clause_limit;
@@ -454,6 +482,9 @@ enum {
   preprocess_flag,
   seed_opt,
   stats_flag,
+  workers_opt,
+  cubes_opt,
+  proof_opt,
 
   var_decay_opt,
   clause_decay_opt,
@@ -464,6 +495,9 @@ enum {
   reduce_interval_opt,
   reduce_delta_opt,
   restart_interval_opt,
+  luby_unit_opt,
+  rephase_interval_opt,
+  inprocess_interval_opt,
   subsume_skip_opt,
   var_elim_skip_opt,
   res_clause_limit_opt,
@@ -485,6 +519,9 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "preprocess", 'p', FLAG_OPTION, preprocess_flag },
   { "seed", 's', MANDATORY_INT, seed_opt },
   { "stats", '\0', FLAG_OPTION, stats_flag },
+  { "workers", 'j', MANDATORY_INT, workers_opt },
+  { "cubes", '\0', MANDATORY_INT, cubes_opt },
+  { "proof", '\0', MANDATORY_STRING, proof_opt },
 
   { "var-decay", '\0', MANDATORY_FLOAT, var_decay_opt },
   { "clause-decay", '\0', MANDATORY_FLOAT, clause_decay_opt },
@@ -495,6 +532,9 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "reduce-interval", '\0', MANDATORY_INT, reduce_interval_opt },
   { "reduce-delta", '\0', MANDATORY_INT, reduce_delta_opt },
   { "restart-interval", '\0', MANDATORY_INT, restart_interval_opt },
+  { "luby-unit", '\0', MANDATORY_INT, luby_unit_opt },
+  { "rephase-interval", '\0', MANDATORY_INT, rephase_interval_opt },
+  { "inprocess-interval", '\0', MANDATORY_INT, inprocess_interval_opt },
   { "subsume-skip", '\0', MANDATORY_INT, subsume_skip_opt },
   { "var-elim-skip", '\0', MANDATORY_INT, var_elim_skip_opt },
   { "res-clause-limit", '\0', MANDATORY_INT, res_clause_limit_opt },
@@ -533,6 +573,13 @@ static void print_help(char *progname) {
 	 "   --preprocess, -p        Use preprocessing\n"
 	 "   --seed=<int>, -s <int>  Set the prng seed\n"
 	 "   --stats                 Print statistics at the end of the search\n"
+	 "   --workers=<int>, -j <int>\n"
+	 "                           Number of solvers to run in parallel, with clause sharing\n"
+	 "                           (requires a thread-safe build; default: 1)\n"
+	 "   --cubes=<int>           Split the problem into cubes by lookahead, up to the given\n"
+	 "                           depth, then solve the cubes using the workers\n"
+	 "   --proof=<file>          Write a proof in binary DRAT format if the problem is unsat\n"
+	 "                           (not supported with --workers or --cubes)\n"
 	 "   --data                  Store conflict data in 'xxxx.data'\n"
          "\n"
          "For bug reporting and other information, please see http://yices.csl.sri.com/\n");
@@ -552,6 +599,11 @@ static void print_parameters(char *progname) {
 	 "\n"
 	 "Restart\n"
 	 "   --restart-interval=<inteeger>  Minimal number of conflicts between restarts\n"
+	 "   --luby-unit=<integer>          Restart interval unit in stable mode (Luby sequence)\n"
+	 "   --rephase-interval=<integer>   Base number of conflicts between two rephasing\n"
+	 "\n"
+	 "Inprocessing\n"
+	 "   --inprocess-interval=<integer> Base number of conflicts between two inprocessing rounds (0 to disable)\n"
 	 "\n"
 	 "Preprocessing\n"
 	 "   --subsume-skip=<integer>       Skip clauses of that length or more in subsumption\n"
@@ -594,6 +646,9 @@ static void parse_command_line(int argc, char *argv[]) {
   verbose = false;
   seed_given = false;
   stats = false;
+  num_workers = 1;
+  cube_depth = -1;
+  proof_filename = NULL;
   preprocess = false;
   data = false;
 
@@ -606,6 +661,9 @@ static void parse_command_line(int argc, char *argv[]) {
   reduce_interval_given = false;
   reduce_delta_given = false;
   restart_interval_given = false;
+  luby_unit_given = false;
+  rephase_interval_given = false;
+  inprocess_interval_given = false;
   subsume_skip_given = false;
   var_elim_skip_given = false;
   res_clause_limit_given = false;
@@ -670,6 +728,26 @@ static void parse_command_line(int argc, char *argv[]) {
 	stats = true;
 	break;
 
+      case workers_opt:
+	if (! validate_integer_option(&parser, &elem, 1, MAX_WORKERS)) goto bad_usage;
+#ifndef THREAD_SAFE
+	if (elem.i_value > 1) {
+	  fprintf(stderr, "%s: option --workers requires a thread-safe build\n", parser.command_name);
+	  goto bad_usage;
+	}
+#endif
+	num_workers = elem.i_value;
+	break;
+
+      case cubes_opt:
+	if (! validate_integer_option(&parser, &elem, 0, MAX_CUBE_DEPTH)) goto bad_usage;
+	cube_depth = elem.i_value;
+	break;
+
+      case proof_opt:
+	proof_filename = elem.s_value;
+	break;
+
       case var_decay_opt:
 	// must be in [0.0, 1.1]
 	if (! validate_double_option(&parser, &elem, 0.0, false, 1.0, false)) goto bad_usage;
@@ -731,6 +809,24 @@ static void parse_command_line(int argc, char *argv[]) {
 	restart_interval = elem.i_value;
 	break;
 
+      case luby_unit_opt:
+	if (! validate_integer_option(&parser, &elem, 1, INT32_MAX)) goto bad_usage;
+	luby_unit_given = true;
+	luby_unit = elem.i_value;
+	break;
+
+      case rephase_interval_opt:
+	if (! validate_integer_option(&parser, &elem, 1, INT32_MAX)) goto bad_usage;
+	rephase_interval_given = true;
+	rephase_interval = elem.i_value;
+	break;
+
+      case inprocess_interval_opt:
+	if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+	inprocess_interval_given = true;
+	inprocess_interval = elem.i_value;
+	break;
+
       case subsume_skip_opt:
 	if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
 	subsume_skip_given = true;
@@ -784,6 +880,11 @@ static void parse_command_line(int argc, char *argv[]) {
     goto bad_usage;
   }
 
+  if (proof_filename != NULL && (num_workers > 1 || cube_depth >= 0)) {
+    fprintf(stderr, "%s: option --proof can't be used with --workers or --cubes\n", parser.command_name);
+    goto bad_usage;
+  }
+
   return;
 
  bad_usage:
@@ -945,6 +1046,7 @@ static void show_stats(sat_solver_t *solver) {
   write_line(2, "c Statistics");
   write_line_and_uint(2, "c  starts                  : ", stat->starts);
   write_line_and_uint(2, "c  stabilizations          : ", stat->stabilizations);
+  write_line_and_uint(2, "c  rephases                : ", stat->rephases);
   write_line_and_uint(2, "c  simplify db             : ", stat->simplify_calls);
   write_line_and_uint(2, "c  reduce db               : ", stat->reduce_calls);
   write_line_and_uint(2, "c  scc calls               : ", stat->scc_calls);
@@ -959,6 +1061,10 @@ static void show_stats(sat_solver_t *solver) {
   write_line_and_uint(2, "c  probed literals         : ", stat->probed_literals);
   write_line_and_uint(2, "c  failed literals         : ", stat->failed_literals);
   write_line_and_uint(2, "c  probing progatations    : ", stat->probing_propagations);
+  write_line_and_uint(2, "c  inprocessings           : ", stat->inprocess_calls);
+  write_line_and_uint(2, "c  vivified clauses        : ", stat->vivified_clauses);
+  write_line_and_uint(2, "c  vivified literals       : ", stat->vivified_literals);
+  write_line_and_uint(2, "c  inprocess elims         : ", stat->inprocess_elims);
   write_line_and_uint(2, "c  max_depth               : ", solver->max_depth);
   write_line_and_uint(2, "c  lits in pb. clauses     : ", solver->pool.num_prob_literals);
   write_line_and_uint(2, "c  lits in learned clauses : ", solver->pool.num_learned_literals);
@@ -975,10 +1081,10 @@ static void print_results(void) {
   double speed;
 
   search_time = get_cpu_time() - construction_time;
-  result = solver.status;
+  result = solver->status;
 
   if (verbose || stats) {
-    show_stats(&solver);
+    show_stats(solver);
     write_line_and_float(2, "c Search time              : ", search_time, 4, " s");
     mem_used = mem_size() / (1024 * 1024);
     if (mem_used > 0) {
@@ -986,7 +1092,7 @@ static void print_results(void) {
     }
     if (search_time > 0.0001) {
       // if search_time is close to 0, this speed is meaningless.
-      speed = solver.stats.propagations/search_time;
+      speed = solver->stats.propagations/search_time;
       write_line_and_float(2, "c Speed                    : ", speed, 2, " prop/s");
     }
     write_line(2, "c");
@@ -1033,13 +1139,13 @@ void print_solver_size(FILE *f, sat_solver_t *sol) {
 static void print_model(void) {
   int v, k, l;
 
-  if (nsat_status(&solver) == STAT_SAT) {
+  if (nsat_status(solver) == STAT_SAT) {
     // for formatting: 10 literals per line
     // use the prefix 'v ' after each line break
     k = 0;
     for (v=1; v<=nvars; v++) {
-      if (var_is_assigned(&solver, v)) {
-	l = var_is_true(&solver, v) ? v : -v;
+      if (var_is_assigned(solver, v)) {
+	l = var_is_true(solver, v) ? v : -v;
 	if (k == 0) printf("v");
 	printf(" %d", l);
 	k ++;
@@ -1058,7 +1164,7 @@ static void print_model(void) {
  * Check the model if any (reread the file)
  */
 static void do_check(const char* filename) {
-  if (nsat_status(&solver) == STAT_SAT) {
+  if (nsat_status(solver) == STAT_SAT) {
     alloc_buffer(200);
     check_model(filename);
     delete_buffer();
@@ -1090,14 +1196,123 @@ static void init_handler(void) {
 }
 
 
+/*
+ * Set the search parameters of worker i
+ * - all workers use the parameters given on the command line
+ * - workers other than worker 0 also use a different random seed and
+ *   some randomness (unless randomness is given on the command line)
+ */
+static void set_parameters(sat_solver_t *sol, uint32_t i) {
+  nsat_set_randomness(sol, 0);          // overwrite the default
+
+  if (seed_given) nsat_set_random_seed(sol, seed_value);
+  if (var_decay_given) nsat_set_var_decay_factor(sol, var_decay);
+  if (clause_decay_given) nsat_set_clause_decay_factor(sol, clause_decay);
+  if (randomness_given) nsat_set_randomness(sol, randomness);
+  if (stack_threshold_given) nsat_set_stack_threshold(sol, stack_threshold);
+  if (keep_lbd_given) nsat_set_keep_lbd(sol, keep_lbd);
+  if (reduce_fraction_given) nsat_set_reduce_fraction(sol, reduce_fraction);
+  if (reduce_interval_given) nsat_set_reduce_interval(sol, reduce_interval);
+  if (reduce_delta_given) nsat_set_reduce_delta(sol, reduce_delta);
+  if (restart_interval_given) nsat_set_restart_interval(sol, restart_interval);
+  if (luby_unit_given) nsat_set_luby_unit(sol, luby_unit);
+  if (rephase_interval_given) nsat_set_rephase_interval(sol, rephase_interval);
+  if (inprocess_interval_given) nsat_set_inprocess_interval(sol, inprocess_interval);
+  if (subsume_skip_given) nsat_set_subsume_skip(sol, subsume_skip);
+  if (var_elim_skip_given) nsat_set_var_elim_skip(sol, var_elim_skip);
+  if (res_clause_limit_given) nsat_set_res_clause_limit(sol, res_clause_limit);
+  if (res_extra_given) nsat_set_res_extra(sol, res_extra);
+  if (simplify_interval_given) nsat_set_simplify_interval(sol, simplify_interval);
+  if (simplify_bin_delta_given) nsat_set_simplify_bin_delta(sol, simplify_bin_delta);
+
+  if (i > 0) {
+    nsat_set_random_seed(sol, sol->params.seed + i * 0x9e3779b1u);
+    if (! randomness_given) nsat_set_randomness(sol, 0.01);
+  }
+}
+
+
+#ifdef THREAD_SAFE
+
+/*
+ * Thread for worker sol: the first worker to finish stops the others
+ */
+static yices_thread_result_t YICES_THREAD_ATTR worker_main(void *arg) {
+  sat_solver_t *sol;
+
+  sol = arg;
+  if (nsat_solve(sol) != STAT_UNKNOWN) {
+    (void) clause_exchange_set_winner(&exchange, sol->exchange_id);
+  }
+  return yices_thread_exit();
+}
+
+/*
+ * Run all workers in parallel then set solver to the winner
+ * - if a thread can't be created, we continue with the workers
+ *   already started (or run worker 0 in this thread if none started)
+ */
+static void parallel_solve(void) {
+  yices_thread_t *tids;
+  uint32_t i, started;
+
+  tids = (yices_thread_t *) safe_malloc(num_workers * sizeof(yices_thread_t));
+  started = 0;
+  while (started < num_workers) {
+    if (start_yices_thread(tids + started, worker_main, workers + started) < 0) break;
+    started ++;
+  }
+  if (started == 0) {
+    (void) worker_main(workers);
+  }
+  for (i=0; i<started; i++) {
+    join_yices_thread(tids + i);
+  }
+  safe_free(tids);
+
+  assert(exchange.winner >= 0);
+  solver = workers + exchange.winner;
+}
+
+#else
+
+static void parallel_solve(void) {
+  assert(false);
+}
+
+#endif
+
+
+/*
+ * Cube and conquer: the cubes are solved by num_workers threads
+ * - the problem is in worker 0 (constructed without preprocessing)
+ * - if the problem is sat, solver is set to the cube solver that found the model
+ */
+static void cube_solve(void) {
+  init_cube_solver(&cubes, workers, preprocess);
+  cube_solver_set_verbosity(&cubes, (verbose || stats) ? 1 : 0);
+  if (cube_solver_solve(&cubes, cube_depth, num_workers) == STAT_SAT) {
+    solver = cubes.model;
+  }
+}
+
+
 int main(int argc, char* argv[]) {
-  uint32_t verb;
+  uint32_t i, n, verb;
   int resu;
 
   parse_command_line(argc, argv);
 
+  // number of solvers to build
+  n = (cube_depth >= 0) ? 1 : num_workers;
+  workers = (sat_solver_t *) safe_malloc(n * sizeof(sat_solver_t));
+  solver = workers;
+
   alloc_buffer(200);
-  resu = build_instance(input_filename, preprocess);
+  resu = 0;
+  for (i=0; i<n && resu == 0; i++) {
+    resu = build_instance(workers + i, input_filename, preprocess && cube_depth < 0);
+  }
   delete_buffer();
 
   if (resu == OPEN_ERROR) {
@@ -1108,36 +1323,40 @@ int main(int argc, char* argv[]) {
     if (verbose || stats) {
       construction_time = get_cpu_time();
       fprintf(stderr, "c\nc Construction time     : %.4f s\n", construction_time);
-      print_solver_size(stderr, &solver);
+      print_solver_size(stderr, solver);
+    }
+
+    for (i=0; i<n; i++) {
+      set_parameters(workers + i, i);
     }
-    nsat_set_randomness(&solver, 0);          // overwrite the default
-
-    if (seed_given) nsat_set_random_seed(&solver, seed_value);
-    if (var_decay_given) nsat_set_var_decay_factor(&solver, var_decay);
-    if (clause_decay_given) nsat_set_clause_decay_factor(&solver, clause_decay);
-    if (randomness_given) nsat_set_randomness(&solver, randomness);
-    if (stack_threshold_given) nsat_set_stack_threshold(&solver, stack_threshold);
-    if (keep_lbd_given) nsat_set_keep_lbd(&solver, keep_lbd);
-    if (reduce_fraction_given) nsat_set_reduce_fraction(&solver, reduce_fraction);
-    if (reduce_interval_given) nsat_set_reduce_interval(&solver, reduce_interval);
-    if (reduce_delta_given) nsat_set_reduce_delta(&solver, reduce_delta);
-    if (restart_interval_given) nsat_set_restart_interval(&solver, restart_interval);
-    if (subsume_skip_given) nsat_set_subsume_skip(&solver, subsume_skip);
-    if (var_elim_skip_given) nsat_set_var_elim_skip(&solver, var_elim_skip);
-    if (res_clause_limit_given) nsat_set_res_clause_limit(&solver, res_clause_limit);
-    if (res_extra_given) nsat_set_res_extra(&solver, res_extra);
-    if (simplify_interval_given) nsat_set_simplify_interval(&solver, simplify_interval);
-    if (simplify_bin_delta_given) nsat_set_simplify_bin_delta(&solver, simplify_bin_delta);
 
+    // only worker 0 reports progress
     verb = verbose ? 2 : stats ? 1 : 0;
-    nsat_set_verbosity(&solver, verb);
+    nsat_set_verbosity(workers, verb);
 
     init_handler();
 
     if (data) {
-      nsat_open_datafile(&solver, "xxxx.data");
+      nsat_open_datafile(workers, "xxxx.data");
     }
-    (void) nsat_solve(&solver);
+
+    if (proof_filename != NULL && !nsat_open_proof_file(workers, proof_filename)) {
+      perror(proof_filename);
+      return YICES_EXIT_SYSTEM_ERROR;
+    }
+
+    if (cube_depth >= 0) {
+      cube_solve();
+    } else if (num_workers > 1) {
+      init_clause_exchange(&exchange, num_workers);
+      for (i=0; i<num_workers; i++) {
+        nsat_set_clause_exchange(workers + i, &exchange, i);
+      }
+      parallel_solve();
+    } else {
+      (void) nsat_solve(solver);
+    }
+
     print_results();
     if (model) {
       print_model();
@@ -1146,7 +1365,15 @@ int main(int argc, char* argv[]) {
       do_check(input_filename);
     }
 
-    delete_nsat_solver(&solver);
+    if (cube_depth >= 0) {
+      delete_cube_solver(&cubes);
+    } else if (num_workers > 1) {
+      delete_clause_exchange(&exchange);
+    }
+    for (i=0; i<n; i++) {
+      delete_nsat_solver(workers + i);
+    }
+    safe_free(workers);
 
     return YICES_EXIT_SUCCESS;
   }
@@ -1079,6 +1079,7 @@ static void show_stats(dpll_stats_t *stat) {
   printf(" random decisions        : %"PRIu64"\n", stat->random_decisions);
   printf(" propagations            : %"PRIu64"\n", stat->propagations);
   printf(" conflicts               : %"PRIu64"\n", stat->conflicts);
+  printf(" chrono backtracks       : %"PRIu64"\n", stat->chrono_backtracks);
   printf(" theory propagations     : %"PRIu32"\n", stat->th_props);
   printf(" propagation-lemmas      : %"PRIu32"\n", stat->th_prop_lemmas);
   printf(" theory conflicts        : %"PRIu32"\n", stat->th_conflicts);
@@ -1151,6 +1152,8 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   printf(" calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   printf(" pivots                  : %"PRIu32"\n", stat->num_pivots);
   printf(" bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  printf(" float presolve calls   : %"PRIu32"\n", stat->num_float_presolve);
+  printf(" float pivots            : %"PRIu32"\n", stat->num_float_pivots);
   printf(" simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   //  printf(" propagation lemmas      : %"PRIu32"\n", stat->num_prop_lemmas);  (it's always zero)
   printf(" prop. to core           : %"PRIu32"\n", stat->num_props);
@@ -1198,6 +1201,8 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   printf(" equiv conflicts         : %"PRIu32"\n", solver->stats.equiv_conflicts);
   printf(" semi-equiv lemmas       : %"PRIu32"\n", solver->stats.half_equiv_lemmas);
   printf(" interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  printf(" aig nodes               : %"PRIu32"\n", solver->stats.aig_nodes);
+  printf(" aig merges              : %"PRIu32"\n", solver->stats.aig_merges);
 }
 
 
@@ -101,9 +101,12 @@ static bool bvdecimal;
 static bool show_stats;
 static int32_t verbosity;
 static uint32_t timeout;
+static uint32_t parse_threads;
 static char *filename;
 static char *delegate;
 static char *dimacsfile;
+static char *savefile;
+static char *loadfile;
 
 // mcsat options
 static bool mcsat;
@@ -156,8 +159,11 @@ typedef enum optid {
   smt2format_opt,          // use SMT-LIB2 format for models
   bvdecimal_opt,           // use (_ bv<xxx> n) for bit-vector constants
   timeout_opt,             // give a timeout
+  parse_threads_opt,       // number of threads for lexing the input file
   delegate_opt,            // use an external sat solver
   dimacs_opt,              // bitblast then export to DIMACS
+  save_terms_opt,          // save terms and assertions at check-sat
+  load_terms_opt,          // load terms and assertions before parsing
   mcsat_opt,               // enable mcsat
   mcsat_nra_mgcd_opt,      // use the mgcd instead psc in projection
   mcsat_nra_nlsat_opt,     // use the nlsat projection instead of brown single-cell
@@ -199,12 +205,15 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "stats", 's', FLAG_OPTION, show_stats_opt },
   { "verbosity", 'v', MANDATORY_INT, verbosity_opt },
   { "timeout", 't', MANDATORY_INT, timeout_opt },
+  { "parse-threads", '\0', MANDATORY_INT, parse_threads_opt },
   { "incremental", '\0', FLAG_OPTION, incremental_opt },
   { "interactive", '\0', FLAG_OPTION, interactive_opt },
   { "smt2-model-format", '\0', FLAG_OPTION, smt2format_opt },
   { "bvconst-in-decimal", '\0', FLAG_OPTION, bvdecimal_opt },
   { "delegate", '\0', MANDATORY_STRING, delegate_opt },
   { "dimacs", '\0', MANDATORY_STRING, dimacs_opt },
+  { "save-terms", '\0', MANDATORY_STRING, save_terms_opt },
+  { "load-terms", '\0', MANDATORY_STRING, load_terms_opt },
   { "mcsat", '\0', FLAG_OPTION, mcsat_opt },
   { "mcsat-nra-mgcd", '\0', FLAG_OPTION, mcsat_nra_mgcd_opt },
   { "mcsat-nra-nlsat", '\0', FLAG_OPTION, mcsat_nra_nlsat_opt },
@@ -262,12 +271,16 @@ static void print_help(const char *progname) {
          "    --timeout=<timeout>       Set a timeout in seconds (default = no timeout)\n"
          "           -t <timeout>\n"
          "    --stats, -s               Print statistics once all commands have been processed\n"
+         "    --parse-threads=<n>       Use n threads to scan the input file (default = 0)\n"
          "    --incremental             Enable support for push/pop\n"
          "    --interactive             Run in interactive mode (ignored if a filename is given)\n"
          "    --smt2-model-format       Display models in the SMT-LIB 2 format (default = false)\n"
          "    --bvconst-in-decimal      Display bit-vector constants as decimal numbers (default = false)\n"
-         "    --delegate=<satsolver>    Use an external SAT solver (can be cadical, cryptominisat, kissat, or y2sat)\n"
+         "    --delegate=<satsolver>    Use an external SAT solver (can be cadical, cryptominisat, kissat, y2sat,\n"
+         "                              or y2sat-cubes)\n"
          "    --dimacs=<filename>       Bitblast and export to a file (in DIMACS format)\n"
+         "    --save-terms=<filename>   Save all terms and assertions in a binary file at (check-sat)\n"
+         "    --load-terms=<filename>   Load terms and assertions saved with --save-terms\n"
          "    --mcsat                   Use the MCSat solver\n"
          "    --mcsat-help              Show the MCSat options\n"
          "    --ef-help                 Show the EF options\n"
@@ -374,8 +387,11 @@ static void parse_command_line(int argc, char *argv[]) {
   show_stats = false;
   verbosity = 0;
   timeout = 0;
+  parse_threads = 0;
   delegate = NULL;
   dimacsfile = NULL;
+  savefile = NULL;
+  loadfile = NULL;
 
   mcsat = false;
   mcsat_nra_mgcd = false;
@@ -463,6 +479,15 @@ static void parse_command_line(int argc, char *argv[]) {
         timeout = v;
         break;
 
+      case parse_threads_opt:
+        v = elem.i_value;
+        if (v < 0 || v > 64) {
+          fprintf(stderr, "%s: the number of parse threads must be between 0 and 64\n", parser.command_name);
+          goto bad_usage;
+        }
+        parse_threads = v;
+        break;
+
       case incremental_opt:
         incremental = true;
         break;
@@ -477,7 +502,7 @@ static void parse_command_line(int argc, char *argv[]) {
           if (supported_delegate(elem.s_value, &unknown_delegate)) {
           delegate = copy_string(elem.s_value);
         } else if (unknown_delegate) {
-          fprintf(stderr, "%s: unknown delegate: %s (choices are 'y2sat' or 'cadical' or 'kissat' or 'cryptominisat')\n",
+          fprintf(stderr, "%s: unknown delegate: %s (choices are 'y2sat' or 'y2sat-cubes' or 'cadical' or 'kissat' or 'cryptominisat')\n",
           parser.command_name, elem.s_value);
           goto bad_usage;
         } else {
@@ -505,6 +530,34 @@ static void parse_command_line(int argc, char *argv[]) {
         }
         break;
 
+      case save_terms_opt:
+        if (savefile == NULL) {
+          savefile = copy_string(elem.s_value);
+          if (savefile == NULL) {
+            fprintf(stderr, "%s: file-name %s is too long\n", parser.command_name, elem.s_value);
+            code = YICES_EXIT_USAGE;
+            goto exit;
+          }
+        } else {
+          fprintf(stderr, "%s: can't give more than one file for --save-terms\n", parser.command_name);
+          goto bad_usage;
+        }
+        break;
+
+      case load_terms_opt:
+        if (loadfile == NULL) {
+          loadfile = copy_string(elem.s_value);
+          if (loadfile == NULL) {
+            fprintf(stderr, "%s: file-name %s is too long\n", parser.command_name, elem.s_value);
+            code = YICES_EXIT_USAGE;
+            goto exit;
+          }
+        } else {
+          fprintf(stderr, "%s: can't give more than one file for --load-terms\n", parser.command_name);
+          goto bad_usage;
+        }
+        break;
+
       case smt2format_opt:
         smt2_model_format = true;
         break;
@@ -678,6 +731,12 @@ static void parse_command_line(int argc, char *argv[]) {
     goto exit;
   }
 
+  if (incremental && (savefile != NULL || loadfile != NULL)) {
+    fprintf(stderr, "%s: saving or loading terms is not supported in incremental mode\n", parser.command_name);
+    code = YICES_EXIT_USAGE;
+    goto exit;
+  }
+
   // force interactive to false if there's a filename
   if (filename != NULL) {
     interactive = false;
@@ -1050,6 +1109,9 @@ int main(int argc, char *argv[]) {
       perror(filename);
       exit(YICES_EXIT_FILE_NOT_FOUND);
     }
+    if (parse_threads > 0) {
+      smt2_lexer_start_parallel(&lexer, parse_threads);
+    }
   } else {
     // read from stdin
     init_smt2_stdin_lexer(&lexer);
@@ -1067,6 +1129,10 @@ int main(int argc, char *argv[]) {
     smt2_set_delegate(delegate);
     if (dimacsfile != NULL) smt2_set_dimacs_file(dimacsfile);
   }
+  if (savefile != NULL) smt2_set_save_terms_file(savefile);
+  if (loadfile != NULL && smt2_load_terms(loadfile) < 0) {
+    exit(YICES_EXIT_ERROR);
+  }
 
   init_smt2_tstack(&stack);
   init_parser(&parser, &lexer, &stack);
@@ -1110,6 +1176,14 @@ int main(int argc, char *argv[]) {
     safe_free(dimacsfile);
     dimacsfile = NULL;
   }
+  if (savefile != NULL) {
+    safe_free(savefile);
+    savefile = NULL;
+  }
+  if (loadfile != NULL) {
+    safe_free(loadfile);
+    loadfile = NULL;
+  }
   if (delegate != NULL) {
     safe_free(delegate);
     delegate = NULL;
@@ -1117,6 +1191,7 @@ int main(int argc, char *argv[]) {
 
   delete_pvector(&trace_tags);
   delete_parser(&parser);
+  smt2_lexer_stop_parallel();
   close_lexer(&lexer);
   delete_tstack(&stack);
   delete_smt2();
@@ -37,6 +37,8 @@
 #include <locale.h>
 
 
+#include "context/context_bb.h"
+#include "context/context_portfolio.h"
 #include "frontend/common/parameters.h"
 #include "frontend/smt2/smt2_commands.h"
 #include "frontend/smt2/smt2_lexer.h"
@@ -75,6 +77,8 @@ static bool show_stats;
 static int32_t verbosity;
 static uint32_t timeout;
 static uint32_t nthreads;
+static uint32_t portfolio;
+static uint32_t parallel_bb;
 static char *filename;
 
 // mcsat options
@@ -101,6 +105,8 @@ typedef enum optid {
   interactive_opt,         // enable interactive mode
   timeout_opt,             // give a timeout
   nthreads_opt,            // number of threads
+  portfolio_opt,           // number of portfolio workers
+  parallel_bb_opt,         // number of branch-and-bound workers
   mcsat_opt,               // enable mcsat
   mcsat_nra_mgcd_opt,      // use the mgcd instead psc in projection
   mcsat_nra_nlsat_opt,     // use the nlsat projection instead of brown single-cell
@@ -122,6 +128,8 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "verbosity", 'v', MANDATORY_INT, verbosity_opt },
   { "timeout", 't', MANDATORY_INT, timeout_opt },
   { "nthreads", 'n', MANDATORY_INT, nthreads_opt },
+  { "portfolio", '\0', MANDATORY_INT, portfolio_opt },
+  { "parallel-bb", '\0', MANDATORY_INT, parallel_bb_opt },
   { "incremental", '\0', FLAG_OPTION, incremental_opt },
   { "interactive", '\0', FLAG_OPTION, interactive_opt },
   { "mcsat", '\0', FLAG_OPTION, mcsat_opt },
@@ -162,6 +170,8 @@ static void print_help(const char *progname) {
 	 "           -t <timeout>\n"
 	 "    --nthreads=<number of threads>  Specify the number of threads (default = 0 = main thread only)\n"
 	 "           -n <number of threads>\n"
+	 "    --portfolio=<workers>     Check satisfiability with a portfolio of parallel solvers (default = 0 = no portfolio)\n"
+	 "    --parallel-bb=<workers>   Split integer domains into cubes and check them in parallel (default = 0 = no splitting)\n"
 	 "    --stats, -s               Print statistics once all commands have been processed\n"
 	 "    --incremental             Enable support for push/pop\n"
 	 "    --interactive             Run in interactive mode (ignored if a filename is given)\n"
@@ -205,6 +215,8 @@ static void parse_command_line(int argc, char *argv[]) {
   verbosity = 0;
   timeout = 0;
   nthreads = 0;
+  portfolio = 0;
+  parallel_bb = 0;
 
   mcsat = false;
   mcsat_nra_mgcd = false;
@@ -283,7 +295,39 @@ static void parse_command_line(int argc, char *argv[]) {
 	}
 	nthreads = v;
 	break;
-	
+
+      case portfolio_opt:
+	v = elem.i_value;
+	if (v < 0 || v > MAX_PORTFOLIO_WORKERS) {
+	  fprintf(stderr, "%s: the number of portfolio workers must be between 0 and %d\n", parser.command_name, MAX_PORTFOLIO_WORKERS);
+	  print_usage(parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	if (v > 1 && !yices_is_thread_safe()) {
+	  fprintf(stderr, "portfolio is not supported: %s was not compiled with thread safety\n", parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	portfolio = v;
+	break;
+
+      case parallel_bb_opt:
+	v = elem.i_value;
+	if (v < 0 || v > MAX_BB_WORKERS) {
+	  fprintf(stderr, "%s: the number of branch-and-bound workers must be between 0 and %d\n", parser.command_name, MAX_BB_WORKERS);
+	  print_usage(parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	if (v > 1 && !yices_is_thread_safe()) {
+	  fprintf(stderr, "parallel branch and bound is not supported: %s was not compiled with thread safety\n", parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	parallel_bb = v;
+	break;
+
       case incremental_opt:
 	incremental = true;
 	break;
@@ -587,6 +631,12 @@ int main(int argc, char *argv[]) {
 
   yices_init();
   init_mt2(!incremental, timeout, nthreads, interactive);
+  if (portfolio > 1) {
+    smt2_set_portfolio(portfolio);
+  }
+  if (parallel_bb > 1) {
+    smt2_set_parallel_bb(parallel_bb);
+  }
   init_smt2_tstack(&stack);
   init_parser(&parser, &lexer, &stack);
 
@@ -641,6 +641,8 @@ static void show_simplex_stats(simplex_stats_t *stat) {
   fprintf(stderr, " calls to make_feasible  : %"PRIu32"\n", stat->num_make_feasible);
   fprintf(stderr, " pivots                  : %"PRIu32"\n", stat->num_pivots);
   fprintf(stderr, " bland-rule activations  : %"PRIu32"\n", stat->num_blands);
+  fprintf(stderr, " float presolve calls   : %"PRIu32"\n", stat->num_float_presolve);
+  fprintf(stderr, " float pivots            : %"PRIu32"\n", stat->num_float_pivots);
   fprintf(stderr, " simple lemmas           : %"PRIu32"\n", stat->num_binary_lemmas);
   fprintf(stderr, " prop. to core           : %"PRIu32"\n", stat->num_props);
   fprintf(stderr, " derived bounds          : %"PRIu32"\n", stat->num_bound_props);
@@ -687,6 +689,8 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   fprintf(stderr, " equiv conflictss        : %"PRIu32"\n", solver->stats.equiv_conflicts);
   fprintf(stderr, " semi-equiv lemmas       : %"PRIu32"\n", solver->stats.half_equiv_lemmas);
   fprintf(stderr, " interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  fprintf(stderr, " aig nodes               : %"PRIu32"\n", solver->stats.aig_nodes);
+  fprintf(stderr, " aig merges              : %"PRIu32"\n", solver->stats.aig_merges);
 }
 
 
@@ -2632,6 +2632,82 @@ __YICES_DLLSPEC__ extern void yices_garbage_collect(const term_t t[], uint32_t n
                                                     int32_t keep_named);
 
 
+/*
+ * Cheaper collection of the young terms: the young terms are the
+ * terms created since the last call to yices_garbage_collect or
+ * yices_garbage_collect_young.
+ * - t = optional array of terms
+ * - nt = size of t
+ * - keep_named specifies whether the named terms should all be preserved
+ *
+ * The roots are determined as in yices_garbage_collect (but without
+ * root types). A term created before the last collection is never
+ * deleted by this function and no type is deleted. The cost of this
+ * function depends on the number of young terms rather than on the
+ * total number of terms, so it can be called often. Old terms that
+ * become garbage are reclaimed by the next call to yices_garbage_collect.
+ */
+__YICES_DLLSPEC__ extern void yices_garbage_collect_young(const term_t t[], uint32_t nt, int32_t keep_named);
+
+
+
+/*******************************
+ *  SAVING AND LOADING TERMS   *
+ ******************************/
+
+/*
+ * Save all the terms and types currently defined, and their names,
+ * in a binary file.
+ * - filename = name of the file to write
+ * - t = optional array of terms (can be NULL if nt is zero)
+ * - nt = size of t
+ *
+ * The terms t[0 ... nt-1] are stored in the file as roots and are returned
+ * by yices_load_terms. This can be used to save assertions for example.
+ *
+ * It's a good idea to call yices_garbage_collect before this function
+ * to avoid saving terms that are no longer used.
+ *
+ * Type constructors (i.e., macros) are not saved. Types built from
+ * a type constructor are saved as uninterpreted types.
+ *
+ * Return 0 if the file was written, -1 otherwise.
+ *
+ * Error report:
+ * - if t[i] is not valid
+ *   code = INVALID_TERM
+ *   term1 = t[i]
+ * - if the file can't be opened or written
+ *   code = OUTPUT_ERROR
+ */
+__YICES_DLLSPEC__ extern int32_t yices_save_terms(const char *filename, uint32_t nt, const term_t t[]);
+
+
+/*
+ * Load a file produced by yices_save_terms.
+ * - filename = name of the file to read
+ * - v = optional term vector for the roots (may be NULL)
+ *
+ * All types and terms stored in the file are added to the current
+ * tables and all the names are restored (a name in the file masks any
+ * existing use of the same name). Uninterpreted types, scalar types,
+ * and uninterpreted terms from the file are always new: they're
+ * distinct from anything defined before the call.
+ *
+ * If v is non-NULL, it is reset then the roots stored in the file are
+ * added to v (in the same order as in yices_save_terms).
+ *
+ * Return 0 if the file was loaded, -1 otherwise.
+ *
+ * Error report:
+ * - if the file can't be opened or read
+ *   code = INPUT_ERROR
+ * - if the file is not a valid dump
+ *   code = INVALID_TERM_DUMP
+ */
+__YICES_DLLSPEC__ extern int32_t yices_load_terms(const char *filename, term_vector_t *v);
+
+
 
 
 /****************************
@@ -2949,6 +3025,27 @@ __YICES_DLLSPEC__ extern int32_t yices_default_config_for_logic(ctx_config_t *co
 __YICES_DLLSPEC__ extern context_t *yices_new_context(const ctx_config_t *config);
 
 
+/*
+ * Clone a context
+ * - this creates a new context with the same configuration as ctx
+ *   (logic, mode, solvers, and options), then asserts in the new
+ *   context all the formulas asserted in ctx so far.
+ * - if ctx has backtrack points (i.e., yices_push was called),
+ *   the clone has the same backtrack points: each formula is asserted
+ *   at the same level as in ctx.
+ * - blocking clauses and assumptions used in the last call to
+ *   check are not copied.
+ *
+ * The clone and ctx are independent: they can be modified, checked,
+ * and deleted separately. They can be used in different threads.
+ *
+ * If there's an error, the function returns NULL and sets an error code:
+ * - if ctx's status is STATUS_SEARCHING or STATUS_INTERRUPTED
+ *   code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern context_t *yices_clone_context(context_t *ctx);
+
+
 /*
  * Deletion
  */
@@ -3224,6 +3321,124 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_blocking_clause(context_t *ctx);
 __YICES_DLLSPEC__ extern void yices_stop_search(context_t *ctx);
 
 
+/*
+ * Portfolio check: check several copies of the same problem in parallel.
+ * - ctx must be an array of n contexts that contain the same assertions
+ * - n must be between 1 and 64
+ * - params is an optional structure to store heuristic parameters
+ *   (if params is NULL, default parameter settings are used)
+ * - the search on ctx[0] uses params. The search on ctx[i] for i>0
+ *   uses variants of params (different random seeds, restart strategies,
+ *   and branching heuristics).
+ *
+ * If Yices is compiled in thread-safe mode, each context is checked in a
+ * separate thread. As soon as one of the threads is done, all the others
+ * are interrupted. The index of the first context to finish is stored
+ * in *winner and the function returns its status (STATUS_SAT, STATUS_UNSAT,
+ * STATUS_UNKNOWN, or STATUS_INTERRUPTED). Models, unsat cores, etc. must be
+ * obtained from ctx[*winner]. The other contexts are left in the state they
+ * would be in after an interrupted call to yices_check_context.
+ *
+ * If one of the contexts already has status STATUS_SAT, STATUS_UNSAT, or
+ * STATUS_UNKNOWN, then that context is the winner and its status is returned.
+ *
+ * If Yices is not thread-safe, only ctx[0] is checked and *winner is set to 0.
+ *
+ * Error report:
+ * - if n is 0:
+ *    code = POS_INT_REQUIRED, badval = n
+ * - if n is more than 64:
+ *    code = TOO_MANY_ARGUMENTS, badval = n
+ * - if one of the contexts is searching or interrupted:
+ *    code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_portfolio(uint32_t n, context_t *ctx[], const param_t *params, uint32_t *winner);
+
+
+/*
+ * Parallel branch and bound for integer problems.
+ * - ctx must be an array of n contexts that contain the same assertions
+ *   and that are all idle (status = STATUS_IDLE)
+ * - the contexts must support multiple checks (i.e., they must not be
+ *   configured in mode "one-shot")
+ * - n must be between 1 and 64
+ * - params is an optional structure to store heuristic parameters
+ *   (if params is NULL, default parameter settings are used)
+ *
+ * The problem is split into subproblems (cubes) by bisecting the domains
+ * of integer variables that have a lower and an upper bound among the
+ * top-level assertions. If Yices is compiled in thread-safe mode, the
+ * cubes are distributed to n threads, each using one of the contexts.
+ * Each thread checks its context under the cube assumptions and moves on
+ * to the next cube when the result is STATUS_UNSAT.
+ *
+ * The function returns STATUS_SAT as soon as one cube is satisfiable.
+ * The index of the corresponding context is stored in *winner and the model
+ * must be obtained from ctx[*winner]. It returns STATUS_UNSAT if all cubes
+ * are unsatisfiable: in this case, the contexts may still have status
+ * STATUS_IDLE. It can also return STATUS_UNKNOWN or STATUS_INTERRUPTED.
+ *
+ * If no bounded integer variable is found, n is 1, the contexts don't
+ * support multiple checks, or Yices is not thread-safe, then ctx[0] is
+ * checked without splitting and *winner is 0.
+ *
+ * Error report:
+ * - if n is 0:
+ *    code = POS_INT_REQUIRED, badval = n
+ * - if n is more than 64:
+ *    code = TOO_MANY_ARGUMENTS, badval = n
+ * - if one of the contexts is not idle:
+ *    code = CTX_INVALID_OPERATION
+ * - other error codes are possible if the cubes can't be converted
+ *   to literals (cf. yices_check_context_with_assumptions)
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_parallel_bb(uint32_t n, context_t *ctx[], const param_t *params, uint32_t *winner);
+
+
+/*
+ * Optimization: search for a model of ctx where term t is minimal
+ * (or maximal).
+ * - t must be an arithmetic term or a bitvector term. Bitvectors are
+ *   compared as unsigned integers.
+ * - ctx must support multiple checks (i.e., it must not be configured
+ *   in mode "one-shot"). For an arithmetic objective, ctx must use the
+ *   simplex solver.
+ * - params is an optional structure to store heuristic parameters
+ *   (if params is NULL, default parameter settings are used)
+ * - optimal: pointer to an integer flag
+ *
+ * The search is done by a sequence of checks with assumptions
+ * that bound t, so the context keeps what it learns between checks.
+ * Any previous result or assumption in ctx is cleared first.
+ *
+ * The function returns STATUS_SAT if a model is found. Then the model
+ * is available in ctx (cf. yices_get_model) and *optimal is set to 1
+ * if t is optimal in this model. If t is unbounded or its optimum is
+ * not attained (e.g., minimize x subject to x > 0), then *optimal is
+ * set to 0 and the model is the last one found.
+ *
+ * Otherwise, the function returns STATUS_UNSAT, STATUS_UNKNOWN,
+ * STATUS_INTERRUPTED, or STATUS_ERROR, and *optimal is set to 0.
+ *
+ * Error report:
+ * - if t is not valid:
+ *    code = INVALID_TERM, term1 = t
+ * - if t is not an arithmetic or bitvector term:
+ *    code = ARITHTERM_REQUIRED, term1 = t
+ * - if ctx does not support multiple checks:
+ *    code = CTX_OPERATION_NOT_SUPPORTED
+ * - if t is an arithmetic term and ctx doesn't use the simplex solver:
+ *    code = CTX_ARITH_NOT_SUPPORTED
+ * - if ctx's status is STATUS_SEARCHING or STATUS_INTERRUPTED:
+ *    code = CTX_INVALID_OPERATION
+ * - other error codes are possible if t can't be internalized
+ *   (cf. yices_assert_formula)
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_minimize(context_t *ctx, const param_t *params, term_t t, int32_t *optimal);
+
+__YICES_DLLSPEC__ extern smt_status_t yices_maximize(context_t *ctx, const param_t *params, term_t t, int32_t *optimal);
+
+
 
 
 /*
@@ -3454,11 +3669,15 @@ __YICES_DLLSPEC__ extern void yices_model_collect_defined_terms(model_t *mdl, te
  * The delegate is an optional argument used only when logic is "QF_BV".
  * If is ignored otherwise. It must either be NULL or be the name of an
  * external SAT solver to use after bit-blasting. Valid delegates
- * are "cadical", "cryptominisat", and "y2sat".
+ * are "cadical", "cryptominisat", "y2sat", and "y2sat-cubes".
  * If delegate is NULL, the default SAT solver is used.
  *
+ * "y2sat-cubes" splits the problem into cubes by lookahead then solves
+ * the cubes in parallel with y2sat (cube-and-conquer). It uses one
+ * thread per processor if Yices is thread safe.
+ *
  * Support for "cadical" and "cryptominisat" must be enabled at compilation
- * time. The "y2sat" solver is always available. The function will return STATUS_ERROR
+ * time. The "y2sat" and "y2sat-cubes" solvers are always available. The function will return STATUS_ERROR
  * and store an error code if the requested delegate is not available.
  *
  * Error codes:
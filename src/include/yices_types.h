@@ -465,6 +465,8 @@ typedef enum error_code {
    * Input/output and system errors
    */
   OUTPUT_ERROR = 9000,
+  INPUT_ERROR,
+  INVALID_TERM_DUMP,
 
   /*
    * Catch-all code for anything else.
@@ -606,6 +608,8 @@ typedef enum error_code {
  * except the error code:
  *
  *  OUTPUT_ERROR
+ *  INPUT_ERROR
+ *  INVALID_TERM_DUMP
  *  INTERNAL_EXCEPTION
  */
 typedef struct error_report_s {
@@ -19,6 +19,7 @@
 /*
  * File reader: keeps track of filename, position, current character.
  * String reader: same thing but reads from a null-terminated string.
+ * Mapped reader: file reader for a file mapped in memory.
  */
 
 #if 0
@@ -29,6 +30,12 @@
 #include <stdbool.h>
 #include <assert.h>
 
+#if !defined(MINGW)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
 #include "io/reader.h"
 
 
@@ -104,6 +111,78 @@ static int string_reader_next_char(reader_t *reader) {
 }
 
 
+#if !defined(MINGW)
+
+/*
+ * Read and return the next char from a mapped file
+ * - update pos, line, column
+ * - we return the same characters as getc (i.e., '\0' is not
+ *   the end of the input and characters are unsigned)
+ */
+static int mapped_reader_next_char(reader_t *reader) {
+  assert(reader->is_mapped);
+
+  if (reader->current == EOF) {
+    return EOF;
+  }
+
+  if (reader->current == '\n') {
+    reader->line ++;
+    reader->column = 0;
+  }
+
+  if (reader->pos < reader->size) {
+    reader->current = (unsigned char) reader->input.data[reader->pos];
+  } else {
+    reader->current = EOF;
+  }
+  reader->pos ++;
+  reader->column ++;
+
+  return reader->current;
+}
+
+
+/*
+ * Attempt to map the file f in memory
+ * - f must be attached to reader (as a stream)
+ * - if f is a non-empty regular file and mmap succeeds, f is closed
+ *   and reader is converted to a mapped reader
+ * - otherwise, reader is unchanged
+ */
+static void try_map_file(reader_t *reader, FILE *f) {
+  struct stat s;
+  void *data;
+  int fd;
+
+  assert(reader->is_stream && reader->input.stream == f && reader->pos == 0);
+
+  fd = fileno(f);
+  if (fstat(fd, &s) < 0 || !S_ISREG(s.st_mode) || s.st_size <= 0 ||
+      (uint64_t) s.st_size > (uint64_t) SIZE_MAX) {
+    return;
+  }
+
+  data = mmap(NULL, (size_t) s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return;
+  }
+#if defined(MADV_SEQUENTIAL)
+  (void) madvise(data, (size_t) s.st_size, MADV_SEQUENTIAL);
+#endif
+
+  // the mapping remains valid after f is closed
+  fclose(f);
+  reader->input.data = (const char *) data;
+  reader->size = s.st_size;
+  reader->is_stream = false;
+  reader->is_mapped = true;
+  reader->read = mapped_reader_next_char;
+}
+
+#endif
+
+
 
 
 
@@ -124,6 +203,8 @@ int32_t init_file_reader(reader_t *reader, const char *filename) {
   reader->line = 0;
   reader->column = 1;
   reader->is_stream = true;
+  reader->is_mapped = false;
+  reader->size = 0;
   reader->read = file_reader_next_char;
   reader->name = filename;
 
@@ -133,6 +214,10 @@ int32_t init_file_reader(reader_t *reader, const char *filename) {
   }
 
   reader->current = '\n';
+#if !defined(MINGW)
+  try_map_file(reader, f);
+#endif
+
   return 0;
 }
 
@@ -147,6 +232,8 @@ void init_stream_reader(reader_t *reader, FILE *f, const char *name) {
   reader->line = 0;
   reader->column = 1;
   reader->is_stream = true;
+  reader->is_mapped = false;
+  reader->size = 0;
   reader->read = file_reader_next_char;
   reader->name = name;
 }
@@ -162,11 +249,30 @@ void init_string_reader(reader_t *reader, const char *data, const char *name) {
   reader->line = 0;
   reader->column = 1;
   reader->is_stream = false;
+  reader->is_mapped = false;
+  reader->size = 0;
   reader->read = string_reader_next_char;
   reader->name = name;
 }
 
 
+/*
+ * Initialize reader for a fragment of a mapped file
+ */
+void init_fragment_reader(reader_t *reader, reader_t *src, uint64_t start, uint64_t end,
+                          uint32_t line, uint32_t column) {
+  assert(src->is_mapped && start <= end && end <= src->size);
+
+  reader->input.data = src->input.data;
+  reader->size = end;
+  reader->is_stream = false;
+  reader->is_mapped = true;
+  reader->read = src->read;
+  reader->name = src->name;
+  mapped_reader_goto(reader, start, line, column);
+}
+
+
 /*
  * Reset: change the input string
  */
@@ -189,6 +295,10 @@ void reset_string_reader(reader_t *reader, const char *data) {
 int close_reader(reader_t *reader) {
   if (reader->is_stream) {
     return fclose(reader->input.stream);
+#if !defined(MINGW)
+  } else if (reader->is_mapped) {
+    return munmap((void *) reader->input.data, (size_t) reader->size) < 0 ? EOF : 0;
+#endif
   } else {
     return 0;
   }
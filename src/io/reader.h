@@ -19,11 +19,17 @@
 /*
  * File reader: keeps track of filename, position, and current character.
  * String reader: same thing but reads from a null-terminated string.
+ *
+ * If possible, a file reader maps the file in memory. Characters are
+ * then read from the mapped data rather than through getc. This
+ * also allows lexers to scan the data directly.
  */
 
 #ifndef __READER_H
 #define __READER_H
 
+#include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -33,6 +39,8 @@
  * - pos, line, column = position in input stream
  * - for file reader, stream = input
  *   for string reader, data = null terminated string.
+ *   for mapped file, data = mapped file content and size = its size
+ *   (data is not null terminated).
  * - name = filename or whatever else is given at initialization.
  * - read = read function: get next character
  *   return EOF on last character
@@ -48,10 +56,12 @@ struct reader_s {
   uint32_t column;
   read_fun_t read;
   int32_t is_stream; // true for stream, false for string readers
+  int32_t is_mapped; // true for mapped files
   union {
     FILE *stream;
     const char *data;
   } input;
+  uint64_t size;
   const char *name;
 };
 
@@ -79,6 +89,8 @@ struct reader_s {
  *   or 0 otherwise
  * - if the file was not open, any subsequent attempt
  *   to read will return EOF
+ * - if the file is a non-empty regular file, it's mapped in
+ *   memory (except on Windows). Otherwise, it's read as a stream.
  */
 extern int32_t init_file_reader(reader_t *reader, const char *filename);
 
@@ -100,6 +112,19 @@ static inline void init_stdin_reader(reader_t *reader) {
  */
 extern void init_string_reader(reader_t *reader, const char *data, const char *name);
 
+/*
+ * Initialize reader for a fragment of a mapped file
+ * - src must be a mapped reader
+ * - reader will read src's data from index start to index end-1
+ * - line and column must be the line and column of data[start]
+ * - the current character is data[start] (or EOF if start == end)
+ *
+ * The reader shares the mapped data with src. It must not be closed
+ * and it must not be used after src is closed.
+ */
+extern void init_fragment_reader(reader_t *reader, reader_t *src, uint64_t start, uint64_t end,
+                                 uint32_t line, uint32_t column);
+
 
 #if 0
 /*
@@ -127,6 +152,7 @@ extern void reset_string_reader(reader_t *reader, const char *data);
 /*
  * Close file reader:
  * - return EOF on error, 0 otherwise
+ * - unmap the file if it's mapped
  * - no effect if reader is a string reader.
  */
 extern int close_reader(reader_t *reader);
@@ -161,4 +187,29 @@ static inline int reader_next_char(reader_t *reader) {
 }
 
 
+/*
+ * Direct access to a mapped file:
+ * - the content is in reader->input.data[0 ... size-1]
+ * - if pos > 0, the current character is at index pos-1
+ *   (or it's EOF if pos-1 == size)
+ */
+static inline bool reader_is_mapped(reader_t *reader) {
+  return reader->is_mapped;
+}
+
+/*
+ * Move a mapped reader to index i
+ * - line and column must be the line and column of data[i]
+ * - i must be at most size (if i == size, the current character is EOF)
+ */
+static inline void mapped_reader_goto(reader_t *reader, uint64_t i, uint32_t line, uint32_t column) {
+  assert(reader->is_mapped && i <= reader->size);
+
+  reader->pos = i + 1;
+  reader->line = line;
+  reader->column = column;
+  reader->current = (i < reader->size) ? (unsigned char) reader->input.data[i] : EOF;
+}
+
+
 #endif /* __READER_H */
@@ -0,0 +1,1419 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY DUMP OF THE TERM AND TYPE TABLES
+ *
+ * File layout (all integers are 32bit, little-endian):
+ *
+ *   header:  magic number, version
+ *   types:   number of records, then one record per type
+ *            <kind> <descriptor> <base name>
+ *   terms:   number of records, then one record per term
+ *            <kind> <type> <descriptor>
+ *   names:   symbol table for terms:  n, then n pairs <name> <term>
+ *            base names for terms:    n, then n pairs <term> <name>
+ *            symbol table for types:  n, then n pairs <name> <type>
+ *   roots:   n, then n terms
+ *
+ * Types are identified by their rank in the dump. Ranks 0, 1, 2
+ * are the predefined types bool, int, and real. The first type
+ * record has rank 3.
+ *
+ * Terms are identified by their rank in the dump and a polarity
+ * bit (i.e., as term occurrences). Ranks 0, 1, 2 are the predefined
+ * terms (reserved index, true, and zero). The first term record has
+ * rank 3.
+ *
+ * A string is written as its length + 1 followed by its characters.
+ * Length 0 denotes a NULL string.
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <gmp.h>
+
+#include "io/term_dump.h"
+#include "terms/balanced_arith_buffers.h"
+#include "terms/bv64_constants.h"
+#include "terms/bvpoly_buffers.h"
+#include "terms/power_products.h"
+#include "utils/memalloc.h"
+#include "utils/refcount_strings.h"
+
+#include "yices_limits.h"
+
+
+#define TERM_DUMP_MAGIC   0x4c425459  // "YTBL"
+#define TERM_DUMP_VERSION 1
+
+/*
+ * Number of predefined types and terms
+ */
+#define NUM_PREDEF_TYPES 3
+#define NUM_PREDEF_TERMS 3
+
+/*
+ * Tags for rational constants
+ */
+enum {
+  RAT32_TAG = 0,
+  RATGMP_TAG = 1,
+};
+
+
+
+/**************
+ *  WRITING   *
+ *************/
+
+/*
+ * Writer:
+ * - f = output file
+ * - error = true if a write failed
+ * - tmap[i] = rank of type i in the dump (-1 if not written yet)
+ * - map[i] = rank of term index i in the dump (-1 if not written yet)
+ * - ntypes/nterms = number of types/terms written so far
+ * - stack = auxiliary stack for the topological sort: pairs <i, k>
+ *   where i = index and k = index of the next child to visit
+ */
+typedef struct dump_writer_s {
+  FILE *f;
+  bool error;
+  type_table_t *types;
+  term_table_t *terms;
+  int32_t *tmap;
+  int32_t *map;
+  uint32_t ntypes;
+  uint32_t nterms;
+  ivector_t stack;
+} dump_writer_t;
+
+
+static void write_u32(dump_writer_t *w, uint32_t x) {
+  uint8_t b[4];
+
+  b[0] = (uint8_t) x;
+  b[1] = (uint8_t) (x >> 8);
+  b[2] = (uint8_t) (x >> 16);
+  b[3] = (uint8_t) (x >> 24);
+  if (fwrite(b, 1, 4, w->f) != 4) {
+    w->error = true;
+  }
+}
+
+static void write_u64(dump_writer_t *w, uint64_t x) {
+  write_u32(w, (uint32_t) x);
+  write_u32(w, (uint32_t) (x >> 32));
+}
+
+static void write_string(dump_writer_t *w, const char *s) {
+  size_t len;
+
+  if (s == NULL) {
+    write_u32(w, 0);
+  } else {
+    len = strlen(s);
+    write_u32(w, (uint32_t) (len + 1));
+    if (fwrite(s, 1, len, w->f) != len) {
+      w->error = true;
+    }
+  }
+}
+
+/*
+ * Integer of arbitrary size as a sign + an array of bytes
+ */
+static void write_mpz(dump_writer_t *w, mpz_t z) {
+  uint8_t *bytes;
+  size_t n;
+
+  n = (mpz_sizeinbase(z, 2) + 7) >> 3;
+  bytes = (uint8_t *) safe_malloc(n);
+  mpz_export(bytes, &n, -1, 1, 0, 0, z);
+  write_u32(w, mpz_sgn(z) < 0);
+  write_u32(w, (uint32_t) n);
+  if (fwrite(bytes, 1, n, w->f) != n) {
+    w->error = true;
+  }
+  safe_free(bytes);
+}
+
+static void write_rational(dump_writer_t *w, rational_t *q) {
+  mpq_t aux;
+
+  if (is_rat32(q)) {
+    write_u32(w, RAT32_TAG);
+    write_u32(w, (uint32_t) get_num(q));
+    write_u32(w, get_den(q));
+  } else {
+    write_u32(w, RATGMP_TAG);
+    mpq_init(aux);
+    q_get_mpq(q, aux);
+    write_mpz(w, mpq_numref(aux));
+    write_mpz(w, mpq_denref(aux));
+    mpq_clear(aux);
+  }
+}
+
+static inline void write_type(dump_writer_t *w, type_t tau) {
+  assert(w->tmap[tau] >= 0);
+  write_u32(w, (uint32_t) w->tmap[tau]);
+}
+
+static inline void write_term(dump_writer_t *w, term_t t) {
+  int32_t i;
+
+  i = index_of(t);
+  assert(w->map[i] >= 0);
+  write_u32(w, (((uint32_t) w->map[i]) << 1) | polarity_of(t));
+}
+
+
+
+/*
+ * TYPES
+ */
+
+/*
+ * k-th child of type i or -1 if i has fewer than k+1 children
+ * - instance types are written as uninterpreted types so we don't
+ *   visit their parameters
+ */
+static int32_t type_child(type_table_t *types, type_t i, uint32_t k) {
+  tuple_type_t *tup;
+  function_type_t *fun;
+
+  switch (type_kind(types, i)) {
+  case TUPLE_TYPE:
+    tup = tuple_type_desc(types, i);
+    return k < tup->nelem ? tup->elem[k] : -1;
+
+  case FUNCTION_TYPE:
+    fun = function_type_desc(types, i);
+    if (k < fun->ndom) return fun->domain[k];
+    return k == fun->ndom ? fun->range : -1;
+
+  default:
+    return -1;
+  }
+}
+
+static void write_type_record(dump_writer_t *w, type_t i) {
+  type_table_t *types;
+  tuple_type_t *tup;
+  function_type_t *fun;
+  type_kind_t kind;
+  uint32_t j;
+
+  types = w->types;
+  kind = type_kind(types, i);
+  if (kind == INSTANCE_TYPE) {
+    kind = UNINTERPRETED_TYPE;
+  }
+  write_u32(w, kind);
+
+  switch (kind) {
+  case BITVECTOR_TYPE:
+    write_u32(w, bv_type_size(types, i));
+    break;
+
+  case SCALAR_TYPE:
+    write_u32(w, scalar_type_cardinal(types, i));
+    break;
+
+  case VARIABLE_TYPE:
+    write_u32(w, type_variable_id(types, i));
+    break;
+
+  case TUPLE_TYPE:
+    tup = tuple_type_desc(types, i);
+    write_u32(w, tup->nelem);
+    for (j=0; j<tup->nelem; j++) {
+      write_type(w, tup->elem[j]);
+    }
+    break;
+
+  case FUNCTION_TYPE:
+    fun = function_type_desc(types, i);
+    write_type(w, fun->range);
+    write_u32(w, fun->ndom);
+    for (j=0; j<fun->ndom; j++) {
+      write_type(w, fun->domain[j]);
+    }
+    break;
+
+  default:
+    assert(kind == UNINTERPRETED_TYPE);
+    break;
+  }
+
+  write_string(w, types->name[i]);
+
+  w->tmap[i] = w->ntypes;
+  w->ntypes ++;
+}
+
+/*
+ * Write i after all its children
+ */
+static void visit_type(dump_writer_t *w, type_t i) {
+  ivector_t *stack;
+  int32_t j, c;
+  uint32_t k;
+
+  if (w->tmap[i] >= 0) return;
+
+  stack = &w->stack;
+  assert(stack->size == 0);
+  ivector_push(stack, i);
+  ivector_push(stack, 0);
+
+  while (stack->size > 0) {
+    j = stack->data[stack->size - 2];
+    k = stack->data[stack->size - 1];
+    c = type_child(w->types, j, k);
+    if (c < 0) {
+      write_type_record(w, j);
+      ivector_shrink(stack, stack->size - 2);
+    } else {
+      stack->data[stack->size - 1] = k + 1;
+      if (w->tmap[c] < 0) {
+        ivector_push(stack, c);
+        ivector_push(stack, 0);
+      }
+    }
+  }
+}
+
+static void write_types(dump_writer_t *w) {
+  type_table_t *types;
+  uint32_t i, n, count;
+
+  types = w->types;
+  n = types->nelems;
+  count = 0;
+  for (i=NUM_PREDEF_TYPES; i<n; i++) {
+    if (type_kind(types, i) != UNUSED_TYPE) count ++;
+  }
+  write_u32(w, count);
+
+  for (i=NUM_PREDEF_TYPES; i<n; i++) {
+    if (type_kind(types, i) != UNUSED_TYPE) {
+      visit_type(w, i);
+    }
+  }
+  assert(w->ntypes == count + NUM_PREDEF_TYPES);
+}
+
+
+
+/*
+ * TERMS
+ */
+
+/*
+ * Index of the k-th child of term index i or -1 if i has fewer than
+ * k+1 children. For polynomials, the child may be const_idx.
+ */
+static int32_t term_child(term_table_t *terms, int32_t i, uint32_t k) {
+  composite_term_t *c;
+  root_atom_t *r;
+  pprod_t *p;
+  polynomial_t *q;
+  bvpoly64_t *q64;
+  bvpoly_t *qbv;
+
+  switch (kind_for_idx(terms, i)) {
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    return k == 0 ? index_of(integer_value_for_idx(terms, i)) : -1;
+
+  case ARITH_ROOT_ATOM:
+    r = root_atom_for_idx(terms, i);
+    if (k == 0) return index_of(r->x);
+    return k == 1 ? index_of(r->p) : -1;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    c = composite_for_idx(terms, i);
+    return k < c->arity ? index_of(c->arg[k]) : -1;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    return k == 0 ? index_of(select_for_idx(terms, i)->arg) : -1;
+
+  case POWER_PRODUCT:
+    p = pprod_for_idx(terms, i);
+    return k < p->len ? index_of(p->prod[k].var) : -1;
+
+  case ARITH_POLY:
+    q = polynomial_for_idx(terms, i);
+    return k < q->nterms ? index_of(q->mono[k].var) : -1;
+
+  case BV64_POLY:
+    q64 = bvpoly64_for_idx(terms, i);
+    return k < q64->nterms ? index_of(q64->mono[k].var) : -1;
+
+  case BV_POLY:
+    qbv = bvpoly_for_idx(terms, i);
+    return k < qbv->nterms ? index_of(qbv->mono[k].var) : -1;
+
+  default:
+    return -1;
+  }
+}
+
+
+static void write_term_record(dump_writer_t *w, int32_t i) {
+  term_table_t *terms;
+  composite_term_t *c;
+  select_term_t *s;
+  root_atom_t *r;
+  pprod_t *p;
+  polynomial_t *q;
+  bvconst64_term_t *b64;
+  bvconst_term_t *bv;
+  bvpoly64_t *q64;
+  bvpoly_t *qbv;
+  term_kind_t kind;
+  uint32_t j, k, nw;
+
+  terms = w->terms;
+  kind = kind_for_idx(terms, i);
+  write_u32(w, kind);
+  write_type(w, type_for_idx(terms, i));
+
+  switch (kind) {
+  case CONSTANT_TERM:
+    write_u32(w, (uint32_t) integer_value_for_idx(terms, i));
+    break;
+
+  case ARITH_CONSTANT:
+    write_rational(w, rational_for_idx(terms, i));
+    break;
+
+  case BV64_CONSTANT:
+    b64 = bvconst64_for_idx(terms, i);
+    write_u32(w, b64->bitsize);
+    write_u64(w, b64->value);
+    break;
+
+  case BV_CONSTANT:
+    bv = bvconst_for_idx(terms, i);
+    write_u32(w, bv->bitsize);
+    nw = (bv->bitsize + 31) >> 5;
+    for (j=0; j<nw; j++) {
+      write_u32(w, bv->data[j]);
+    }
+    break;
+
+  case VARIABLE:
+  case UNINTERPRETED_TERM:
+    break;
+
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    write_term(w, integer_value_for_idx(terms, i));
+    break;
+
+  case ARITH_ROOT_ATOM:
+    r = root_atom_for_idx(terms, i);
+    write_u32(w, r->k);
+    write_term(w, r->x);
+    write_term(w, r->p);
+    write_u32(w, r->r);
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    s = select_for_idx(terms, i);
+    write_u32(w, s->idx);
+    write_term(w, s->arg);
+    break;
+
+  case POWER_PRODUCT:
+    p = pprod_for_idx(terms, i);
+    write_u32(w, p->len);
+    for (j=0; j<p->len; j++) {
+      write_term(w, p->prod[j].var);
+      write_u32(w, p->prod[j].exp);
+    }
+    break;
+
+  case ARITH_POLY:
+    q = polynomial_for_idx(terms, i);
+    write_u32(w, q->nterms);
+    for (j=0; j<q->nterms; j++) {
+      write_term(w, q->mono[j].var);
+      write_rational(w, &q->mono[j].coeff);
+    }
+    break;
+
+  case BV64_POLY:
+    q64 = bvpoly64_for_idx(terms, i);
+    write_u32(w, q64->bitsize);
+    write_u32(w, q64->nterms);
+    for (j=0; j<q64->nterms; j++) {
+      write_term(w, q64->mono[j].var);
+      write_u64(w, q64->mono[j].coeff);
+    }
+    break;
+
+  case BV_POLY:
+    qbv = bvpoly_for_idx(terms, i);
+    write_u32(w, qbv->bitsize);
+    write_u32(w, qbv->nterms);
+    for (j=0; j<qbv->nterms; j++) {
+      write_term(w, qbv->mono[j].var);
+      for (k=0; k<qbv->width; k++) {
+        write_u32(w, qbv->mono[j].coeff[k]);
+      }
+    }
+    break;
+
+  default:
+    // all the other kinds are composite
+    c = composite_for_idx(terms, i);
+    write_u32(w, c->arity);
+    for (j=0; j<c->arity; j++) {
+      write_term(w, c->arg[j]);
+    }
+    break;
+  }
+
+  w->map[i] = w->nterms;
+  w->nterms ++;
+}
+
+/*
+ * Write i after all its children
+ */
+static void visit_term(dump_writer_t *w, int32_t i) {
+  ivector_t *stack;
+  int32_t j, c;
+  uint32_t k;
+
+  if (w->map[i] >= 0) return;
+
+  stack = &w->stack;
+  assert(stack->size == 0);
+  ivector_push(stack, i);
+  ivector_push(stack, 0);
+
+  while (stack->size > 0) {
+    j = stack->data[stack->size - 2];
+    k = stack->data[stack->size - 1];
+    c = term_child(w->terms, j, k);
+    if (c < 0) {
+      write_term_record(w, j);
+      ivector_shrink(stack, stack->size - 2);
+    } else {
+      stack->data[stack->size - 1] = k + 1;
+      if (w->map[c] < 0) {
+        ivector_push(stack, c);
+        ivector_push(stack, 0);
+      }
+    }
+  }
+}
+
+static void write_terms(dump_writer_t *w) {
+  term_table_t *terms;
+  uint32_t i, n, count;
+  term_kind_t kind;
+
+  terms = w->terms;
+  n = terms->nelems;
+  count = 0;
+  for (i=NUM_PREDEF_TERMS; i<n; i++) {
+    kind = kind_for_idx(terms, i);
+    if (kind != UNUSED_TERM && kind != RESERVED_TERM) count ++;
+  }
+  write_u32(w, count);
+
+  for (i=NUM_PREDEF_TERMS; i<n; i++) {
+    kind = kind_for_idx(terms, i);
+    if (kind != UNUSED_TERM && kind != RESERVED_TERM) {
+      visit_term(w, i);
+    }
+  }
+  assert(w->nterms == count + NUM_PREDEF_TERMS);
+}
+
+
+
+/*
+ * NAMES
+ */
+
+/*
+ * Collect the records of a symbol table in the order in which they
+ * must be added back: if a symbol is mapped to several values, the
+ * record that masks the others must be added last.
+ * - the records are added to v
+ * - the records of a symbol all occur in the same bucket
+ *   and the most recent one is first in the bucket
+ */
+static void collect_symbols(stbl_t *sym_table, pvector_t *v) {
+  stbl_rec_t *r;
+  uint32_t i;
+
+  for (i=0; i<sym_table->size; i++) {
+    for (r = sym_table->data[i]; r != NULL; r = r->next) {
+      pvector_push(v, r);
+    }
+  }
+}
+
+static void write_term_names(dump_writer_t *w) {
+  pvector_t v;
+  stbl_rec_t *r;
+  ptr_hmap_pair_t *p;
+  uint32_t i, count;
+
+  init_pvector(&v, 0);
+
+  // symbol table
+  collect_symbols(&w->terms->stbl, &v);
+  write_u32(w, v.size);
+  i = v.size;
+  while (i > 0) {
+    i --;
+    r = v.data[i];
+    write_string(w, r->string);
+    write_term(w, r->value);
+  }
+  pvector_reset(&v);
+
+  // base names
+  count = 0;
+  for (p = ptr_hmap_first_record(&w->terms->ntbl); p != NULL; p = ptr_hmap_next_record(&w->terms->ntbl, p)) {
+    if (p->val != NULL) count ++;
+  }
+  write_u32(w, count);
+  for (p = ptr_hmap_first_record(&w->terms->ntbl); p != NULL; p = ptr_hmap_next_record(&w->terms->ntbl, p)) {
+    if (p->val != NULL) {
+      write_term(w, p->key);
+      write_string(w, p->val);
+    }
+  }
+
+  // type symbol table
+  collect_symbols(&w->types->stbl, &v);
+  write_u32(w, v.size);
+  i = v.size;
+  while (i > 0) {
+    i --;
+    r = v.data[i];
+    write_string(w, r->string);
+    write_type(w, r->value);
+  }
+
+  delete_pvector(&v);
+}
+
+
+/*
+ * Write everything
+ */
+int32_t dump_term_table(FILE *f, term_table_t *table, uint32_t n, const term_t *roots) {
+  dump_writer_t w;
+  uint32_t i;
+
+  w.f = f;
+  w.error = false;
+  w.types = table->types;
+  w.terms = table;
+  w.tmap = (int32_t *) safe_malloc(table->types->nelems * sizeof(int32_t));
+  w.map = (int32_t *) safe_malloc(table->nelems * sizeof(int32_t));
+  for (i=0; i<table->types->nelems; i++) {
+    w.tmap[i] = (i < NUM_PREDEF_TYPES) ? i : -1;
+  }
+  for (i=0; i<table->nelems; i++) {
+    w.map[i] = (i < NUM_PREDEF_TERMS) ? i : -1;
+  }
+  w.ntypes = NUM_PREDEF_TYPES;
+  w.nterms = NUM_PREDEF_TERMS;
+  init_ivector(&w.stack, 64);
+
+  write_u32(&w, TERM_DUMP_MAGIC);
+  write_u32(&w, TERM_DUMP_VERSION);
+  write_types(&w);
+  write_terms(&w);
+  write_term_names(&w);
+
+  write_u32(&w, n);
+  for (i=0; i<n; i++) {
+    write_term(&w, roots[i]);
+  }
+
+  delete_ivector(&w.stack);
+  safe_free(w.map);
+  safe_free(w.tmap);
+
+  return w.error ? TERM_DUMP_WRITE_ERROR : 0;
+}
+
+
+
+/**************
+ *  LOADING   *
+ *************/
+
+/*
+ * Loader:
+ * - f = input file
+ * - error = error code (0 if no error)
+ * - tmap = map from type rank to types in the table
+ * - map = map from term rank to term in the table
+ * - ntypes/nterms = size of tmap/map
+ * - buffers for reading and for rebuilding terms
+ */
+typedef struct dump_loader_s {
+  FILE *f;
+  int32_t error;
+  type_table_t *types;
+  term_table_t *terms;
+  type_t *tmap;
+  term_t *map;
+  uint32_t ntypes;
+  uint32_t nterms;
+  ivector_t args;
+  ivector_t words;
+  char *sbuffer;
+  uint32_t sbuffer_size;
+  rba_buffer_t arith;
+  bvpoly_buffer_t bvpoly;
+  pp_buffer_t pp;
+  rational_t q;
+} dump_loader_t;
+
+
+static inline void set_load_error(dump_loader_t *l, int32_t code) {
+  if (l->error == 0) {
+    l->error = code;
+  }
+}
+
+static uint32_t read_u32(dump_loader_t *l) {
+  uint8_t b[4];
+
+  if (l->error != 0) return 0;
+  if (fread(b, 1, 4, l->f) != 4) {
+    set_load_error(l, TERM_DUMP_READ_ERROR);
+    return 0;
+  }
+  return ((uint32_t) b[0]) | (((uint32_t) b[1]) << 8) | (((uint32_t) b[2]) << 16) | (((uint32_t) b[3]) << 24);
+}
+
+static uint64_t read_u64(dump_loader_t *l) {
+  uint64_t x;
+
+  x = read_u32(l);
+  return x | (((uint64_t) read_u32(l)) << 32);
+}
+
+/*
+ * Read a count or size: check that it's no more than max
+ */
+static uint32_t read_size(dump_loader_t *l, uint32_t max) {
+  uint32_t n;
+
+  n = read_u32(l);
+  if (n > max) {
+    set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+    n = 0;
+  }
+  return n;
+}
+
+/*
+ * Read a string: return NULL if the string is NULL or on error.
+ * The result is stored in l->sbuffer (it's overwritten by the next call).
+ */
+static char *read_string(dump_loader_t *l) {
+  uint32_t n;
+
+  n = read_u32(l);
+  if (n == 0 || l->error != 0) return NULL;
+  if (n > l->sbuffer_size) {
+    l->sbuffer = (char *) safe_realloc(l->sbuffer, n);
+    l->sbuffer_size = n;
+  }
+  n --;
+  if (fread(l->sbuffer, 1, n, l->f) != n) {
+    set_load_error(l, TERM_DUMP_READ_ERROR);
+    return NULL;
+  }
+  l->sbuffer[n] = '\0';
+  return l->sbuffer;
+}
+
+static void read_mpz(dump_loader_t *l, mpz_t z) {
+  uint32_t sign, n;
+
+  sign = read_u32(l);
+  n = read_u32(l);
+  if (l->error != 0) return;
+  if (n > l->sbuffer_size) {
+    l->sbuffer = (char *) safe_realloc(l->sbuffer, n);
+    l->sbuffer_size = n;
+  }
+  if (fread(l->sbuffer, 1, n, l->f) != n) {
+    set_load_error(l, TERM_DUMP_READ_ERROR);
+    return;
+  }
+  mpz_import(z, n, -1, 1, 0, 0, l->sbuffer);
+  if (sign) {
+    mpz_neg(z, z);
+  }
+}
+
+/*
+ * Read a rational into l->q
+ */
+static void read_rational(dump_loader_t *l) {
+  mpq_t aux;
+  uint32_t tag, num, den;
+
+  tag = read_u32(l);
+  if (tag == RAT32_TAG) {
+    num = read_u32(l);
+    den = read_u32(l);
+    if (den == 0) {
+      set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+      return;
+    }
+    q_set_int32(&l->q, (int32_t) num, den);
+  } else if (tag == RATGMP_TAG) {
+    mpq_init(aux);
+    read_mpz(l, mpq_numref(aux));
+    read_mpz(l, mpq_denref(aux));
+    if (l->error == 0 && mpz_sgn(mpq_denref(aux)) == 0) {
+      set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+    }
+    if (l->error == 0) {
+      mpq_canonicalize(aux);
+      q_set_mpq(&l->q, aux);
+    }
+    mpq_clear(aux);
+  } else {
+    set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+  }
+}
+
+/*
+ * Read a type/term rank and convert it to a type/term in the table
+ * - i = rank of the record being read (the reference must be smaller)
+ * - return NULL_TYPE/NULL_TERM on error
+ */
+static type_t read_type(dump_loader_t *l, uint32_t i) {
+  uint32_t k;
+
+  k = read_u32(l);
+  if (l->error != 0) return NULL_TYPE;
+  if (k >= i) {
+    set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+    return NULL_TYPE;
+  }
+  return l->tmap[k];
+}
+
+static term_t read_term(dump_loader_t *l, uint32_t i) {
+  uint32_t k;
+
+  k = read_u32(l);
+  if (l->error != 0) return NULL_TERM;
+  if ((k >> 1) >= i) {
+    set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+    return NULL_TERM;
+  }
+  return l->map[k >> 1] ^ (k & 1);
+}
+
+/*
+ * Read n terms into l->args
+ */
+static void read_term_array(dump_loader_t *l, uint32_t i, uint32_t n) {
+  uint32_t j;
+
+  ivector_reset(&l->args);
+  for (j=0; j<n && l->error == 0; j++) {
+    ivector_push(&l->args, read_term(l, i));
+  }
+}
+
+
+
+/*
+ * TYPES
+ */
+
+/*
+ * Read the type record of rank i and build the type
+ */
+static type_t load_type(dump_loader_t *l, uint32_t i) {
+  type_table_t *types;
+  type_t tau, range;
+  uint32_t kind, n, j;
+  char *name;
+
+  types = l->types;
+  tau = NULL_TYPE;
+  kind = read_u32(l);
+
+  switch (kind) {
+  case BITVECTOR_TYPE:
+    n = read_size(l, YICES_MAX_BVSIZE);
+    if (l->error == 0) {
+      if (n == 0) goto bad_format;
+      tau = bv_type(types, n);
+    }
+    break;
+
+  case SCALAR_TYPE:
+    n = read_size(l, UINT32_MAX);
+    if (l->error == 0) {
+      if (n == 0) goto bad_format;
+      tau = new_scalar_type(types, n);
+    }
+    break;
+
+  case UNINTERPRETED_TYPE:
+    tau = new_uninterpreted_type(types);
+    break;
+
+  case VARIABLE_TYPE:
+    n = read_u32(l);
+    if (l->error == 0) {
+      tau = type_variable(types, n);
+    }
+    break;
+
+  case TUPLE_TYPE:
+    n = read_size(l, YICES_MAX_ARITY);
+    ivector_reset(&l->args);
+    for (j=0; j<n && l->error == 0; j++) {
+      ivector_push(&l->args, read_type(l, i));
+    }
+    if (l->error == 0) {
+      if (n == 0) goto bad_format;
+      tau = tuple_type(types, n, l->args.data);
+    }
+    break;
+
+  case FUNCTION_TYPE:
+    range = read_type(l, i);
+    n = read_size(l, YICES_MAX_ARITY);
+    ivector_reset(&l->args);
+    for (j=0; j<n && l->error == 0; j++) {
+      ivector_push(&l->args, read_type(l, i));
+    }
+    if (l->error == 0) {
+      if (n == 0) goto bad_format;
+      tau = function_type(types, range, n, l->args.data);
+    }
+    break;
+
+  default:
+    goto bad_format;
+  }
+
+  name = read_string(l);
+  if (name != NULL && tau != NULL_TYPE && types->name[tau] == NULL) {
+    types->name[tau] = clone_string(name);
+    string_incref(types->name[tau]);
+  }
+
+  return tau;
+
+ bad_format:
+  set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+  return NULL_TYPE;
+}
+
+
+
+/*
+ * TERMS
+ */
+
+/*
+ * Build a composite of the given kind from the arguments in l->args
+ */
+static term_t build_composite(dump_loader_t *l, term_kind_t kind, type_t tau) {
+  term_table_t *terms;
+  term_t *a;
+  uint32_t n;
+
+  terms = l->terms;
+  a = l->args.data;
+  n = l->args.size;
+
+  switch (kind) {
+  case ITE_TERM:
+  case ITE_SPECIAL:
+    if (n != 3) break;
+    return ite_term(terms, tau, a[0], a[1], a[2]);
+
+  case APP_TERM:
+    if (n < 2) break;
+    return app_term(terms, a[0], n-1, a+1);
+
+  case UPDATE_TERM:
+    if (n < 3) break;
+    return update_term(terms, a[0], n-2, a+1, a[n-1]);
+
+  case TUPLE_TERM:
+    if (n == 0) break;
+    return tuple_term(terms, n, a);
+
+  case EQ_TERM:
+    if (n != 2) break;
+    return eq_term(terms, a[0], a[1]);
+
+  case DISTINCT_TERM:
+    if (n < 2) break;
+    return distinct_term(terms, n, a);
+
+  case FORALL_TERM:
+    if (n < 2) break;
+    return forall_term(terms, n-1, a, a[n-1]);
+
+  case LAMBDA_TERM:
+    if (n < 2) break;
+    return lambda_term(terms, n-1, a, a[n-1]);
+
+  case OR_TERM:
+    if (n < 2) break;
+    return or_term(terms, n, a);
+
+  case XOR_TERM:
+    if (n < 2) break;
+    return xor_term(terms, n, a);
+
+  case BV_ARRAY:
+    if (n == 0) break;
+    return bvarray_term(terms, n, a);
+
+  default:
+    if (n != 2) break;
+    switch (kind) {
+    case ARITH_BINEQ_ATOM:   return arith_bineq_atom(terms, a[0], a[1]);
+    case ARITH_RDIV:         return arith_rdiv(terms, a[0], a[1]);
+    case ARITH_IDIV:         return arith_idiv(terms, a[0], a[1]);
+    case ARITH_MOD:          return arith_mod(terms, a[0], a[1]);
+    case ARITH_DIVIDES_ATOM: return arith_divides(terms, a[0], a[1]);
+    case BV_DIV:             return bvdiv_term(terms, a[0], a[1]);
+    case BV_REM:             return bvrem_term(terms, a[0], a[1]);
+    case BV_SDIV:            return bvsdiv_term(terms, a[0], a[1]);
+    case BV_SREM:            return bvsrem_term(terms, a[0], a[1]);
+    case BV_SMOD:            return bvsmod_term(terms, a[0], a[1]);
+    case BV_SHL:             return bvshl_term(terms, a[0], a[1]);
+    case BV_LSHR:            return bvlshr_term(terms, a[0], a[1]);
+    case BV_ASHR:            return bvashr_term(terms, a[0], a[1]);
+    case BV_EQ_ATOM:         return bveq_atom(terms, a[0], a[1]);
+    case BV_GE_ATOM:         return bvge_atom(terms, a[0], a[1]);
+    case BV_SGE_ATOM:        return bvsge_atom(terms, a[0], a[1]);
+    default:                 break;
+    }
+    break;
+  }
+
+  set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+  return NULL_TERM;
+}
+
+
+/*
+ * Read the term record of rank i and build the term
+ */
+static term_t load_term(dump_loader_t *l, uint32_t i) {
+  term_table_t *terms;
+  term_t t, x, p;
+  type_t tau;
+  uint32_t kind, n, j, k, idx, nw, bitsize;
+  uint64_t c;
+
+  terms = l->terms;
+  t = NULL_TERM;
+  kind = read_u32(l);
+  tau = read_type(l, l->ntypes);
+  if (l->error != 0) return NULL_TERM;
+
+  switch (kind) {
+  case CONSTANT_TERM:
+    idx = read_u32(l);
+    if (l->error == 0) {
+      if (idx > (uint32_t) INT32_MAX) goto bad_format;
+      t = constant_term(terms, tau, idx);
+    }
+    break;
+
+  case ARITH_CONSTANT:
+    read_rational(l);
+    if (l->error == 0) {
+      t = arith_constant(terms, &l->q);
+    }
+    break;
+
+  case BV64_CONSTANT:
+    bitsize = read_u32(l);
+    c = read_u64(l);
+    if (l->error == 0) {
+      if (bitsize == 0 || bitsize > 64 || c != norm64(c, bitsize)) goto bad_format;
+      t = bv64_constant(terms, bitsize, c);
+    }
+    break;
+
+  case BV_CONSTANT:
+    bitsize = read_size(l, YICES_MAX_BVSIZE);
+    nw = (bitsize + 31) >> 5;
+    ivector_reset(&l->words);
+    for (j=0; j<nw && l->error == 0; j++) {
+      ivector_push(&l->words, read_u32(l));
+    }
+    if (l->error == 0) {
+      if (bitsize <= 64) goto bad_format;
+      t = bvconst_term(terms, bitsize, (uint32_t *) l->words.data);
+    }
+    break;
+
+  case VARIABLE:
+    t = new_variable(terms, tau);
+    break;
+
+  case UNINTERPRETED_TERM:
+    t = new_uninterpreted_term(terms, tau);
+    break;
+
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    x = read_term(l, i);
+    if (l->error == 0) {
+      switch (kind) {
+      case ARITH_EQ_ATOM:     t = arith_eq_atom(terms, x); break;
+      case ARITH_GE_ATOM:     t = arith_geq_atom(terms, x); break;
+      case ARITH_IS_INT_ATOM: t = arith_is_int(terms, x); break;
+      case ARITH_FLOOR:       t = arith_floor(terms, x); break;
+      case ARITH_CEIL:        t = arith_ceil(terms, x); break;
+      default:                t = arith_abs(terms, x); break;
+      }
+    }
+    break;
+
+  case ARITH_ROOT_ATOM:
+    k = read_u32(l);
+    x = read_term(l, i);
+    p = read_term(l, i);
+    j = read_u32(l);
+    if (l->error == 0) {
+      if (j > ROOT_ATOM_GT) goto bad_format;
+      t = arith_root_atom(terms, k, x, p, (root_atom_rel_t) j);
+    }
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    idx = read_u32(l);
+    x = read_term(l, i);
+    if (l->error == 0) {
+      t = (kind == SELECT_TERM) ? select_term(terms, idx, x) : bit_term(terms, idx, x);
+    }
+    break;
+
+  case POWER_PRODUCT:
+    n = read_size(l, YICES_MAX_VARS);
+    pp_buffer_reset(&l->pp);
+    for (j=0; j<n && l->error == 0; j++) {
+      x = read_term(l, i);
+      k = read_u32(l);
+      if (l->error == 0) {
+        pp_buffer_mul_varexp(&l->pp, x, k);
+      }
+    }
+    if (l->error == 0) {
+      if (n == 0) goto bad_format;
+      pp_buffer_normalize(&l->pp);
+      t = pprod_term_from_buffer(terms, &l->pp);
+    }
+    break;
+
+  case ARITH_POLY:
+    n = read_size(l, YICES_MAX_VARS);
+    reset_rba_buffer(&l->arith);
+    for (j=0; j<n && l->error == 0; j++) {
+      x = read_term(l, i);
+      read_rational(l);
+      if (l->error == 0) {
+        if (x == const_idx) {
+          rba_buffer_add_const(&l->arith, &l->q);
+        } else {
+          rba_buffer_add_mono(&l->arith, &l->q, var_pp(x));
+        }
+      }
+    }
+    if (l->error == 0) {
+      t = arith_poly(terms, &l->arith);
+    }
+    break;
+
+  case BV64_POLY:
+    bitsize = read_u32(l);
+    n = read_size(l, YICES_MAX_VARS);
+    if (l->error == 0 && (bitsize == 0 || bitsize > 64)) goto bad_format;
+    reset_bvpoly_buffer(&l->bvpoly, bitsize == 0 ? 1 : bitsize);
+    for (j=0; j<n && l->error == 0; j++) {
+      x = read_term(l, i);
+      c = read_u64(l);
+      if (l->error == 0) {
+        bvpoly_buffer_add_mono64(&l->bvpoly, x, c);
+      }
+    }
+    if (l->error == 0) {
+      normalize_bvpoly_buffer(&l->bvpoly);
+      t = bv_poly_from_buffer(terms, &l->bvpoly);
+    }
+    break;
+
+  case BV_POLY:
+    bitsize = read_size(l, YICES_MAX_BVSIZE);
+    n = read_size(l, YICES_MAX_VARS);
+    if (l->error == 0 && bitsize <= 64) goto bad_format;
+    reset_bvpoly_buffer(&l->bvpoly, bitsize <= 64 ? 65 : bitsize);
+    nw = (bitsize + 31) >> 5;
+    for (j=0; j<n && l->error == 0; j++) {
+      x = read_term(l, i);
+      ivector_reset(&l->words);
+      for (k=0; k<nw && l->error == 0; k++) {
+        ivector_push(&l->words, read_u32(l));
+      }
+      if (l->error == 0) {
+        bvpoly_buffer_add_monomial(&l->bvpoly, x, (uint32_t *) l->words.data);
+      }
+    }
+    if (l->error == 0) {
+      normalize_bvpoly_buffer(&l->bvpoly);
+      t = bv_poly_from_buffer(terms, &l->bvpoly);
+    }
+    break;
+
+  default:
+    if (kind >= NUM_TERM_KINDS || kind <= UNINTERPRETED_TERM) goto bad_format;
+    n = read_size(l, YICES_MAX_ARITY);
+    read_term_array(l, i, n);
+    if (l->error == 0) {
+      t = build_composite(l, kind, tau);
+    }
+    break;
+  }
+
+  return t;
+
+ bad_format:
+  set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+  return NULL_TERM;
+}
+
+
+/*
+ * NAMES
+ */
+static void load_names(dump_loader_t *l) {
+  term_table_t *terms;
+  type_table_t *types;
+  ptr_hmap_pair_t *p;
+  uint32_t i, n;
+  char *name;
+  term_t t;
+  type_t tau;
+
+  terms = l->terms;
+  types = l->types;
+
+  // symbol table for terms
+  n = read_u32(l);
+  for (i=0; i<n && l->error == 0; i++) {
+    name = read_string(l);
+    t = read_term(l, l->nterms);
+    if (l->error == 0) {
+      if (name == NULL) goto bad_format;
+      name = clone_string(name);
+      stbl_add(&terms->stbl, name, t);
+      string_incref(name);
+    }
+  }
+
+  // base names
+  n = read_u32(l);
+  for (i=0; i<n && l->error == 0; i++) {
+    t = read_term(l, l->nterms);
+    name = read_string(l);
+    if (l->error == 0) {
+      if (name == NULL) goto bad_format;
+      p = ptr_hmap_get(&terms->ntbl, t);
+      if (p->val == NULL) {
+        p->val = clone_string(name);
+        string_incref(p->val);
+      }
+    }
+  }
+
+  // symbol table for types
+  n = read_u32(l);
+  for (i=0; i<n && l->error == 0; i++) {
+    name = read_string(l);
+    tau = read_type(l, l->ntypes);
+    if (l->error == 0) {
+      if (name == NULL) goto bad_format;
+      name = clone_string(name);
+      stbl_add(&types->stbl, name, tau);
+      string_incref(name);
+    }
+  }
+  return;
+
+ bad_format:
+  set_load_error(l, TERM_DUMP_FORMAT_ERROR);
+}
+
+
+/*
+ * Load everything
+ */
+int32_t load_term_table(FILE *f, term_table_t *table, ivector_t *roots) {
+  dump_loader_t l;
+  uint32_t i, n;
+  term_t t;
+  type_t tau;
+
+  l.f = f;
+  l.error = 0;
+  l.types = table->types;
+  l.terms = table;
+  l.tmap = NULL;
+  l.map = NULL;
+  l.ntypes = 0;
+  l.nterms = 0;
+  init_ivector(&l.args, 10);
+  init_ivector(&l.words, 0);
+  l.sbuffer = NULL;
+  l.sbuffer_size = 0;
+  init_rba_buffer(&l.arith, table->pprods);
+  init_bvpoly_buffer(&l.bvpoly);
+  init_pp_buffer(&l.pp, 8);
+  q_init(&l.q);
+
+  if (read_u32(&l) != TERM_DUMP_MAGIC || read_u32(&l) != TERM_DUMP_VERSION) {
+    set_load_error(&l, TERM_DUMP_FORMAT_ERROR);
+    goto done;
+  }
+
+  // types
+  n = read_size(&l, UINT32_MAX - NUM_PREDEF_TYPES);
+  if (l.error != 0) goto done;
+  l.tmap = (type_t *) safe_malloc((n + NUM_PREDEF_TYPES) * sizeof(type_t));
+  l.tmap[0] = bool_id;
+  l.tmap[1] = int_id;
+  l.tmap[2] = real_id;
+  l.ntypes = NUM_PREDEF_TYPES;
+  for (i=0; i<n; i++) {
+    tau = load_type(&l, l.ntypes);
+    if (l.error != 0) goto done;
+    l.tmap[l.ntypes] = tau;
+    l.ntypes ++;
+  }
+
+  // terms
+  n = read_size(&l, UINT32_MAX - NUM_PREDEF_TERMS);
+  if (l.error != 0) goto done;
+  l.map = (term_t *) safe_malloc((n + NUM_PREDEF_TERMS) * sizeof(term_t));
+  l.map[0] = const_idx;
+  l.map[1] = true_term;
+  l.map[2] = zero_term;
+  l.nterms = NUM_PREDEF_TERMS;
+  for (i=0; i<n; i++) {
+    t = load_term(&l, l.nterms);
+    if (l.error != 0) goto done;
+    l.map[l.nterms] = t;
+    l.nterms ++;
+  }
+
+  load_names(&l);
+
+  // roots
+  n = read_u32(&l);
+  for (i=0; i<n && l.error == 0; i++) {
+    t = read_term(&l, l.nterms);
+    if (roots != NULL && l.error == 0) {
+      ivector_push(roots, t);
+    }
+  }
+
+ done:
+  q_clear(&l.q);
+  delete_pp_buffer(&l.pp);
+  delete_bvpoly_buffer(&l.bvpoly);
+  delete_rba_buffer(&l.arith);
+  safe_free(l.sbuffer);
+  delete_ivector(&l.words);
+  delete_ivector(&l.args);
+  safe_free(l.map);
+  safe_free(l.tmap);
+
+  return l.error;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY DUMP OF THE TERM AND TYPE TABLES
+ *
+ * A dump contains all the live types and terms of a term table
+ * (and its type table), the symbol tables and base names for types
+ * and terms, and an optional list of root terms.
+ *
+ * Types and terms are written in topological order (children before
+ * parents) so they can be rebuilt in a single pass when the dump is
+ * loaded. Each record refers to other types or terms by their rank
+ * in the dump, not by their index in the original tables.
+ *
+ * Loading rebuilds the terms in the target table using the
+ * hash-consing constructors of terms.h. The target table does not
+ * need to be empty: terms that already exist are shared, but
+ * uninterpreted terms, variables, and uninterpreted or scalar types
+ * are always fresh. Names are added on top of existing names.
+ *
+ * Limitations:
+ * - instance types (built from type constructors/macros) are
+ *   saved as uninterpreted types. The macro table is not saved.
+ * - the file must have been produced by dump_term_table:
+ *   the loader checks the format but does not type-check the terms.
+ *
+ * All integers are written in little-endian order so a dump can be
+ * loaded on a different platform.
+ */
+
+#ifndef __TERM_DUMP_H
+#define __TERM_DUMP_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "terms/terms.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Error codes returned by dump and load
+ */
+enum {
+  TERM_DUMP_WRITE_ERROR = -1,  // fwrite failed (errno is set)
+  TERM_DUMP_READ_ERROR = -2,   // fread failed or unexpected end of file
+  TERM_DUMP_FORMAT_ERROR = -3, // not a valid dump
+};
+
+
+/*
+ * Write all terms and types of table to file f
+ * - roots = optional array of n terms (n may be zero)
+ * - the roots are stored in the dump and returned by load_term_table
+ * - return 0 if there's no error or TERM_DUMP_WRITE_ERROR
+ */
+extern int32_t dump_term_table(FILE *f, term_table_t *table, uint32_t n, const term_t *roots);
+
+
+/*
+ * Load a dump from file f into table
+ * - if roots is non-NULL, the roots stored in the dump are added to
+ *   vector roots (translated to terms in table)
+ * - return 0 if there's no error or a negative error code
+ *
+ * If there's an error, the terms and types rebuilt so far remain in
+ * the table (they can be garbage collected). Some names may have
+ * been added too.
+ */
+extern int32_t load_term_table(FILE *f, term_table_t *table, ivector_t *roots);
+
+
+#endif /* __TERM_DUMP_H */
@@ -26,6 +26,16 @@
 
 
 
+/*
+ * Thread-local storage: THREAD_SAFE implies that we HAVE_TLS
+ */
+#ifdef THREAD_SAFE
+#define YICES_THREAD_LOCAL __thread
+#else
+#define YICES_THREAD_LOCAL
+#endif
+
+
 #ifdef THREAD_SAFE
 /*
  *
@@ -48,6 +58,37 @@
        return retval;\
   } while(0)
 
+/*
+ * Same thing for reader/writer locks:
+ * - MT_PROTECT_READ is for entry points that only read the
+ *   protected data (they can run concurrently)
+ * - MT_PROTECT_WRITE/MT_PROTECT_WRITE_VOID get exclusive access
+ */
+#define MT_PROTECT_WRITE_VOID(LOCK,EXPRESSION)\
+  do { yices_rwlock_t *lock = &(LOCK);\
+       get_yices_write_lock(lock);\
+       (EXPRESSION);\
+       release_yices_write_lock(lock);\
+  } while(0)
+
+#define MT_PROTECT_WRITE(TYPE,LOCK,EXPRESSION)\
+  do { yices_rwlock_t *lock = &(LOCK);\
+       TYPE retval;\
+       get_yices_write_lock(lock);\
+       retval = (EXPRESSION);\
+       release_yices_write_lock(lock);\
+       return retval;\
+  } while(0)
+
+#define MT_PROTECT_READ(TYPE,LOCK,EXPRESSION)\
+  do { yices_rwlock_t *lock = &(LOCK);\
+       TYPE retval;\
+       get_yices_read_lock(lock);\
+       retval = (EXPRESSION);\
+       release_yices_read_lock(lock);\
+       return retval;\
+  } while(0)
+
 
 #else
 
@@ -55,6 +96,12 @@
 
 #define MT_PROTECT(TYPE,LOCK,EXPRESSION)  return EXPRESSION
 
+#define MT_PROTECT_WRITE_VOID(LOCK,EXPRESSION)  EXPRESSION
+
+#define MT_PROTECT_WRITE(TYPE,LOCK,EXPRESSION)  return EXPRESSION
+
+#define MT_PROTECT_READ(TYPE,LOCK,EXPRESSION)  return EXPRESSION
+
 #endif
 
 
@@ -19,18 +19,26 @@
 #ifndef __THREADS_H
 #define __THREADS_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 /* the thread main */
 #ifdef MINGW
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0500
+#endif
+#include <windows.h>
 #define YICES_THREAD_ATTR  __stdcall
 typedef unsigned yices_thread_result_t;
 typedef yices_thread_result_t ( YICES_THREAD_ATTR *yices_thread_main_t)(void *);
+typedef HANDLE yices_thread_t;
 #else
+#include <pthread.h>
 #define YICES_THREAD_ATTR
 typedef void* yices_thread_result_t;
 typedef yices_thread_result_t ( YICES_THREAD_ATTR  *yices_thread_main_t)(void *);
+typedef pthread_t yices_thread_t;
 #endif
 
 
@@ -52,6 +60,24 @@ typedef struct thread_data {
  */
 extern void launch_threads(int32_t nthreads, void* extras, size_t extra_sz, const char* test, yices_thread_main_t thread_main, bool verbose);
 
+/*
+ * Start a single thread that runs thread_main(arg)
+ * - the thread's handle is stored in *thread
+ * - returns 0 on success; -1 on failure (and prints an error message)
+ */
+extern int32_t start_yices_thread(yices_thread_t *thread, yices_thread_main_t thread_main, void *arg);
+
+/*
+ * Wait for a thread started by start_yices_thread to terminate
+ * - returns 0 on success; -1 on failure (and prints an error message)
+ */
+extern int32_t join_yices_thread(yices_thread_t *thread);
+
+/*
+ * Number of processors available (at least 1)
+ */
+extern uint32_t yices_num_processors(void);
+
 /* lets the user know what is needed */
 extern void mt_test_usage(int32_t argc, char* argv[]);
 
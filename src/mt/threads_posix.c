@@ -21,6 +21,7 @@
 #include <errno.h>
 #include <string.h>
 #include <pthread.h>
+#include <unistd.h>
 
 void launch_threads(int32_t nthreads, void* extras, size_t extra_sz, const char* test, yices_thread_main_t thread_main, bool verbose){
   int32_t retcode, thread;
@@ -81,6 +82,36 @@ void launch_threads(int32_t nthreads, void* extras, size_t extra_sz, const char*
 
 
 
+int32_t start_yices_thread(yices_thread_t *thread, yices_thread_main_t thread_main, void *arg){
+  int32_t retcode;
+
+  retcode = pthread_create(thread, NULL, thread_main, arg);
+  if(retcode){
+    fprintf(stderr, "pthread_create failed: %s\n", strerror(retcode));
+    return -1;
+  }
+  return 0;
+}
+
+int32_t join_yices_thread(yices_thread_t *thread){
+  int32_t retcode;
+
+  retcode = pthread_join(*thread, NULL);
+  if(retcode){
+    fprintf(stderr, "pthread_join failed: %s\n", strerror(retcode));
+    return -1;
+  }
+  return 0;
+}
+
+uint32_t yices_num_processors(void){
+  long n;
+
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n < 1 ? 1 : (uint32_t) n;
+}
+
+
 yices_thread_result_t yices_thread_exit(void){
   return NULL;
 }
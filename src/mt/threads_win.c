@@ -88,6 +88,33 @@ void launch_threads(int32_t nthreads, void* extras, size_t extra_sz, const char*
 
 }
 
+int32_t start_yices_thread(yices_thread_t *thread, yices_thread_main_t thread_main, void *arg){
+  unsigned tid;
+
+  *thread = (HANDLE)_beginthreadex(NULL, 0, thread_main, arg, 0, &tid);
+  if(*thread == 0){
+    fprintf(stderr, "_beginthreadex: %s\n", strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+int32_t join_yices_thread(yices_thread_t *thread){
+  if(WaitForSingleObject(*thread, INFINITE) == WAIT_FAILED){
+    fprintf(stderr, "WaitForSingleObject failed: %d\n", (int) GetLastError());
+    return -1;
+  }
+  CloseHandle(*thread);
+  return 0;
+}
+
+uint32_t yices_num_processors(void){
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors < 1 ? 1 : (uint32_t) info.dwNumberOfProcessors;
+}
+
 yices_thread_result_t yices_thread_exit(void){
   _endthreadex( 0 );
   return 0;
@@ -31,9 +31,13 @@
 #ifdef MINGW
 #include <synchapi.h>
 typedef CRITICAL_SECTION yices_lock_t;
+typedef SRWLOCK yices_rwlock_t;
+typedef CONDITION_VARIABLE yices_cond_t;
 #else
 #include <pthread.h>
 typedef pthread_mutex_t yices_lock_t;
+typedef pthread_rwlock_t yices_rwlock_t;
+typedef pthread_cond_t yices_cond_t;
 #endif
 
 
@@ -52,6 +56,51 @@ extern int32_t release_yices_lock(yices_lock_t* lock);
 extern void destroy_yices_lock(yices_lock_t* lock);
 
 
+/*
+ * Reader/writer locks: any number of threads can hold the lock in
+ * shared (read) mode, or a single thread can hold it in exclusive
+ * (write) mode. These locks are not recursive.
+ */
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t create_yices_rwlock(yices_rwlock_t* lock);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t get_yices_read_lock(yices_rwlock_t* lock);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t get_yices_write_lock(yices_rwlock_t* lock);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t release_yices_read_lock(yices_rwlock_t* lock);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t release_yices_write_lock(yices_rwlock_t* lock);
+
+extern void destroy_yices_rwlock(yices_rwlock_t* lock);
+
+
+/*
+ * Condition variables: wait_yices_cond must be called with the lock held.
+ * It releases the lock while waiting and gets it back before returning.
+ * Spurious wakeups are possible so the condition must be checked in a loop.
+ */
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t create_yices_cond(yices_cond_t* cond);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t wait_yices_cond(yices_cond_t* cond, yices_lock_t* lock);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t signal_yices_cond(yices_cond_t* cond);
+
+/* returns 0 on success; -1 on failure (and prints an error message) */
+extern int32_t broadcast_yices_cond(yices_cond_t* cond);
+
+extern void destroy_yices_cond(yices_cond_t* cond);
+
+
 #endif
 
 #endif /* __YICES_LOCKS_H */
@@ -87,3 +87,102 @@ void destroy_yices_lock(yices_lock_t* lock){
   }
   assert(retcode == 0);
 }
+
+
+int32_t create_yices_rwlock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_init(lock, NULL);
+  if(retcode){
+    fprintf(stderr, "create_yices_rwlock failed: pthread_rwlock_init returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t get_yices_read_lock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_rdlock(lock);
+  if(retcode){
+    fprintf(stderr, "get_yices_read_lock failed: pthread_rwlock_rdlock returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t get_yices_write_lock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_wrlock(lock);
+  if(retcode){
+    fprintf(stderr, "get_yices_write_lock failed: pthread_rwlock_wrlock returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t release_yices_read_lock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_unlock(lock);
+  if(retcode){
+    fprintf(stderr, "release_yices_read_lock failed: pthread_rwlock_unlock returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t release_yices_write_lock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_unlock(lock);
+  if(retcode){
+    fprintf(stderr, "release_yices_write_lock failed: pthread_rwlock_unlock returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+void destroy_yices_rwlock(yices_rwlock_t* lock){
+  int32_t retcode = pthread_rwlock_destroy(lock);
+  if(retcode){
+    fprintf(stderr, "destroy_yices_rwlock failed: pthread_rwlock_destroy returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+}
+
+
+int32_t create_yices_cond(yices_cond_t* cond){
+  int32_t retcode = pthread_cond_init(cond, NULL);
+  if(retcode){
+    fprintf(stderr, "create_yices_cond failed: pthread_cond_init returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t wait_yices_cond(yices_cond_t* cond, yices_lock_t* lock){
+  int32_t retcode = pthread_cond_wait(cond, lock);
+  if(retcode){
+    fprintf(stderr, "wait_yices_cond failed: pthread_cond_wait returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t signal_yices_cond(yices_cond_t* cond){
+  int32_t retcode = pthread_cond_signal(cond);
+  if(retcode){
+    fprintf(stderr, "signal_yices_cond failed: pthread_cond_signal returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+int32_t broadcast_yices_cond(yices_cond_t* cond){
+  int32_t retcode = pthread_cond_broadcast(cond);
+  if(retcode){
+    fprintf(stderr, "broadcast_yices_cond failed: pthread_cond_broadcast returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+  return retcode;
+}
+
+void destroy_yices_cond(yices_cond_t* cond){
+  int32_t retcode = pthread_cond_destroy(cond);
+  if(retcode){
+    fprintf(stderr, "destroy_yices_cond failed: pthread_cond_destroy returned %d\n", retcode);
+  }
+  assert(retcode == 0);
+}
@@ -16,6 +16,8 @@
  * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
+
 #include "yices_locks.h"
 
 // we need _WIN32_WINNT as 0x0403 or later
@@ -50,3 +52,67 @@ void destroy_yices_lock(yices_lock_t* lock){
   /* void return type */
   DeleteCriticalSection(lock);
 }
+
+
+/*
+ * Slim reader/writer locks (Vista or later)
+ */
+int32_t create_yices_rwlock(yices_rwlock_t* lock){
+  InitializeSRWLock(lock);
+  return 0;
+}
+
+int32_t get_yices_read_lock(yices_rwlock_t* lock){
+  AcquireSRWLockShared(lock);
+  return 0;
+}
+
+int32_t get_yices_write_lock(yices_rwlock_t* lock){
+  AcquireSRWLockExclusive(lock);
+  return 0;
+}
+
+int32_t release_yices_read_lock(yices_rwlock_t* lock){
+  ReleaseSRWLockShared(lock);
+  return 0;
+}
+
+int32_t release_yices_write_lock(yices_rwlock_t* lock){
+  ReleaseSRWLockExclusive(lock);
+  return 0;
+}
+
+void destroy_yices_rwlock(yices_rwlock_t* lock){
+  /* nothing to do for SRW locks */
+}
+
+
+/*
+ * Condition variables (Vista or later)
+ */
+int32_t create_yices_cond(yices_cond_t* cond){
+  InitializeConditionVariable(cond);
+  return 0;
+}
+
+int32_t wait_yices_cond(yices_cond_t* cond, yices_lock_t* lock){
+  if (! SleepConditionVariableCS(cond, lock, INFINITE)) {
+    fprintf(stderr, "wait_yices_cond failed: SleepConditionVariableCS returned an error\n");
+    return -1;
+  }
+  return 0;
+}
+
+int32_t signal_yices_cond(yices_cond_t* cond){
+  WakeConditionVariable(cond);
+  return 0;
+}
+
+int32_t broadcast_yices_cond(yices_cond_t* cond){
+  WakeAllConditionVariable(cond);
+  return 0;
+}
+
+void destroy_yices_cond(yices_cond_t* cond){
+  /* nothing to do for condition variables */
+}
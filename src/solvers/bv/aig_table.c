@@ -0,0 +1,1678 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AND-INVERTER GRAPHS
+ */
+
+#include <assert.h>
+
+#include "solvers/bv/aig_table.h"
+#include "solvers/cdcl/new_sat_solver.h"
+#include "utils/hash_functions.h"
+#include "utils/int_array_sort.h"
+#include "utils/memalloc.h"
+#include "utils/prng.h"
+
+
+/*
+ * Seed for the pseudo-random number generator
+ */
+#define AIG_PRNG_SEED 0x4e2a1c37
+
+
+/*********************
+ *  STRUCTURAL HASH  *
+ ********************/
+
+static void init_aig_htbl(aig_htbl_t *table) {
+  uint32_t i, n;
+  int32_t *tmp;
+
+  n = AIG_HTBL_DEF_SIZE;
+  tmp = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  for (i=0; i<n; i++) {
+    tmp[i] = -1;
+  }
+  table->data = tmp;
+  table->size = n;
+  table->nelems = 0;
+  table->resize_threshold = (uint32_t) (n * AIG_HTBL_RESIZE_RATIO);
+}
+
+static void delete_aig_htbl(aig_htbl_t *table) {
+  safe_free(table->data);
+  table->data = NULL;
+}
+
+static void reset_aig_htbl(aig_htbl_t *table) {
+  uint32_t i, n;
+
+  n = table->size;
+  for (i=0; i<n; i++) {
+    table->data[i] = -1;
+  }
+  table->nelems = 0;
+}
+
+static inline uint32_t hash_and_node(int32_t a, int32_t b) {
+  return jenkins_hash_pair(a, b, 0x2fd31a83);
+}
+
+
+/*
+ * Double the size of the hash table and rehash all the nodes
+ */
+static void extend_aig_htbl(aig_table_t *aig) {
+  aig_htbl_t *table;
+  int32_t *tmp;
+  uint32_t i, j, n, new_size, mask;
+  int32_t k;
+
+  table = &aig->htbl;
+  n = table->size;
+  new_size = n << 1;
+  if (new_size >= UINT32_MAX/sizeof(int32_t)) {
+    out_of_memory();
+  }
+
+  tmp = (int32_t *) safe_malloc(new_size * sizeof(int32_t));
+  for (i=0; i<new_size; i++) {
+    tmp[i] = -1;
+  }
+
+  mask = new_size - 1;
+  for (i=0; i<n; i++) {
+    k = table->data[i];
+    if (k >= 0) {
+      j = hash_and_node(aig->left[k], aig->right[k]) & mask;
+      while (tmp[j] >= 0) {
+        j ++;
+        j &= mask;
+      }
+      tmp[j] = k;
+    }
+  }
+
+  safe_free(table->data);
+  table->data = tmp;
+  table->size = new_size;
+  table->resize_threshold = (uint32_t) (new_size * AIG_HTBL_RESIZE_RATIO);
+}
+
+
+
+/****************
+ *  AIG TABLE   *
+ ***************/
+
+/*
+ * Random 64bit signature
+ */
+static uint64_t random_sig(aig_table_t *aig) {
+  uint64_t x;
+
+  x = random_uint32(&aig->seed);
+  x = (x << 32) | random_uint32(&aig->seed);
+  return x;
+}
+
+static inline uint64_t edge_sig(const aig_table_t *aig, int32_t e) {
+  uint64_t x;
+
+  x = aig->sig[aig_node(e)];
+  return aig_sign(e) ? ~x : x;
+}
+
+
+/*
+ * Add the constant node
+ */
+static void aig_add_const_node(aig_table_t *aig) {
+  assert(aig->nnodes == 0);
+  aig->left[0] = true_literal;
+  aig->right[0] = -1;
+  aig->sig[0] = ~((uint64_t) 0);
+  aig->lit[0] = true_literal;
+  aig->nnodes = 1;
+}
+
+void init_aig_table(aig_table_t *aig, uint32_t n) {
+  if (n == 0) {
+    n = DEF_AIG_TABLE_SIZE;
+  }
+  if (n >= MAX_AIG_TABLE_SIZE) {
+    out_of_memory();
+  }
+
+  aig->nnodes = 0;
+  aig->size = n;
+  aig->left = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  aig->right = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  aig->sig = (uint64_t *) safe_malloc(n * sizeof(uint64_t));
+  aig->lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+
+  init_aig_htbl(&aig->htbl);
+  init_int_hmap(&aig->inputs, 0);
+  init_ivector(&aig->outputs, 0);
+  aig->seed = AIG_PRNG_SEED;
+  init_ivector(&aig->aux, 0);
+
+  aig->stats.num_rewrites = 0;
+  aig->stats.num_checks = 0;
+  aig->stats.num_sat_checks = 0;
+  aig->stats.num_merges = 0;
+  aig->stats.num_cex = 0;
+
+  aig_add_const_node(aig);
+}
+
+void delete_aig_table(aig_table_t *aig) {
+  safe_free(aig->left);
+  safe_free(aig->right);
+  safe_free(aig->sig);
+  safe_free(aig->lit);
+  aig->left = NULL;
+  aig->right = NULL;
+  aig->sig = NULL;
+  aig->lit = NULL;
+
+  delete_aig_htbl(&aig->htbl);
+  delete_int_hmap(&aig->inputs);
+  delete_ivector(&aig->outputs);
+  delete_ivector(&aig->aux);
+}
+
+void reset_aig_table(aig_table_t *aig) {
+  aig->nnodes = 0;
+  reset_aig_htbl(&aig->htbl);
+  int_hmap_reset(&aig->inputs);
+  ivector_reset(&aig->outputs);
+  ivector_reset(&aig->aux);
+  aig_add_const_node(aig);
+}
+
+
+/*
+ * Make room for one more node
+ */
+static void extend_aig_table(aig_table_t *aig) {
+  uint32_t n;
+
+  n = aig->size + 1;
+  n += n >> 1;
+  if (n >= MAX_AIG_TABLE_SIZE) {
+    out_of_memory();
+  }
+  aig->left = (int32_t *) safe_realloc(aig->left, n * sizeof(int32_t));
+  aig->right = (int32_t *) safe_realloc(aig->right, n * sizeof(int32_t));
+  aig->sig = (uint64_t *) safe_realloc(aig->sig, n * sizeof(uint64_t));
+  aig->lit = (literal_t *) safe_realloc(aig->lit, n * sizeof(literal_t));
+  aig->size = n;
+}
+
+static int32_t aig_new_node(aig_table_t *aig, int32_t a, int32_t b, uint64_t sig) {
+  uint32_t i;
+
+  i = aig->nnodes;
+  if (i == aig->size) {
+    extend_aig_table(aig);
+  }
+  assert(i < aig->size);
+  aig->left[i] = a;
+  aig->right[i] = b;
+  aig->sig[i] = sig;
+  aig->lit[i] = null_literal;
+  aig->nnodes = i + 1;
+
+  return i;
+}
+
+
+/*
+ * Input node for literal l
+ */
+int32_t aig_input(aig_table_t *aig, literal_t l) {
+  int_hmap_pair_t *r;
+  bvar_t x;
+
+  assert(l >= 0);
+
+  x = var_of(l);
+  if (x == const_bvar) {
+    // true_literal = aig_true and false_literal = aig_false
+    return l;
+  }
+
+  r = int_hmap_get(&aig->inputs, x);
+  if (r->val < 0) {
+    r->val = aig_new_node(aig, pos_lit(x), -1, random_sig(aig));
+  }
+  return aig_pos_edge(r->val) ^ sign_of_lit(l);
+}
+
+
+/*
+ * Find or create node (and a b) with a < b
+ */
+static int32_t aig_get_and_node(aig_table_t *aig, int32_t a, int32_t b) {
+  aig_htbl_t *table;
+  uint32_t j, mask;
+  int32_t k;
+
+  assert(a < b);
+
+  table = &aig->htbl;
+  mask = table->size - 1;
+  j = hash_and_node(a, b) & mask;
+  for (;;) {
+    k = table->data[j];
+    if (k < 0) break;
+    if (aig->left[k] == a && aig->right[k] == b) {
+      return aig_pos_edge(k);
+    }
+    j ++;
+    j &= mask;
+  }
+
+  k = aig_new_node(aig, a, b, edge_sig(aig, a) & edge_sig(aig, b));
+  table->data[j] = k;
+  table->nelems ++;
+  if (table->nelems > table->resize_threshold) {
+    extend_aig_htbl(aig);
+  }
+
+  return aig_pos_edge(k);
+}
+
+
+/*
+ * Two-level rewrite rules for (and a b) where a is an AND node.
+ * - return -1 if no rule applies
+ * - otherwise return the simplified edge
+ */
+static int32_t aig_rewrite(aig_table_t *aig, int32_t a, int32_t b) {
+  int32_t c0, c1, d0, d1;
+
+  assert(aig_is_and(aig, a));
+
+  c0 = aig->left[aig_node(a)];
+  c1 = aig->right[aig_node(a)];
+
+  if (aig_sign(a) == 0) {
+    // a = (and c0 c1)
+    if (b == aig_not(c0) || b == aig_not(c1)) {
+      return aig_false;  // contradiction
+    }
+    if (b == c0 || b == c1) {
+      return a;  // idempotence
+    }
+    if (aig_is_and(aig, b)) {
+      d0 = aig->left[aig_node(b)];
+      d1 = aig->right[aig_node(b)];
+      if (aig_sign(b) == 0) {
+        // b = (and d0 d1)
+        if (c0 == aig_not(d0) || c0 == aig_not(d1) || c1 == aig_not(d0) || c1 == aig_not(d1)) {
+          return aig_false; // contradiction
+        }
+      } else {
+        // b = (not (and d0 d1))
+        if (c0 == aig_not(d0) || c0 == aig_not(d1) || c1 == aig_not(d0) || c1 == aig_not(d1)) {
+          return a; // subsumption
+        }
+        // substitution: a implies c0 and c1
+        if (d0 == c0 || d0 == c1) {
+          return aig_and(aig, a, aig_not(d1));
+        }
+        if (d1 == c0 || d1 == c1) {
+          return aig_and(aig, a, aig_not(d0));
+        }
+      }
+    }
+
+  } else {
+    // a = (not (and c0 c1))
+    if (b == aig_not(c0) || b == aig_not(c1)) {
+      return b;  // subsumption
+    }
+    if (b == c0) {
+      return aig_and(aig, aig_not(c1), b);  // substitution
+    }
+    if (b == c1) {
+      return aig_and(aig, aig_not(c0), b);
+    }
+    if (aig_is_and(aig, b) && aig_sign(b) == 1) {
+      // b = (not (and d0 d1)): resolution
+      d0 = aig->left[aig_node(b)];
+      d1 = aig->right[aig_node(b)];
+      if ((c0 == d0 && c1 == aig_not(d1)) || (c0 == d1 && c1 == aig_not(d0))) {
+        return aig_not(c0);
+      }
+      if ((c1 == d0 && c0 == aig_not(d1)) || (c1 == d1 && c0 == aig_not(d0))) {
+        return aig_not(c1);
+      }
+    }
+  }
+
+  return -1;
+}
+
+int32_t aig_and(aig_table_t *aig, int32_t a, int32_t b) {
+  int32_t r;
+
+  // level one
+  if (a == aig_false || b == aig_false || a == aig_not(b)) {
+    return aig_false;
+  }
+  if (a == aig_true || a == b) {
+    return b;
+  }
+  if (b == aig_true) {
+    return a;
+  }
+
+  // level two
+  if (aig_is_and(aig, a)) {
+    r = aig_rewrite(aig, a, b);
+    if (r >= 0) goto rewritten;
+  }
+  if (aig_is_and(aig, b)) {
+    r = aig_rewrite(aig, b, a);
+    if (r >= 0) goto rewritten;
+  }
+
+  // normalize then hash
+  if (a > b) {
+    r = a; a = b; b = r;
+  }
+  return aig_get_and_node(aig, a, b);
+
+ rewritten:
+  aig->stats.num_rewrites ++;
+  return r;
+}
+
+int32_t aig_or(aig_table_t *aig, int32_t a, int32_t b) {
+  return aig_not(aig_and(aig, aig_not(a), aig_not(b)));
+}
+
+int32_t aig_xor(aig_table_t *aig, int32_t a, int32_t b) {
+  int32_t p, q;
+
+  p = aig_and(aig, a, b);
+  q = aig_and(aig, aig_not(a), aig_not(b));
+  return aig_and(aig, aig_not(p), aig_not(q));
+}
+
+int32_t aig_mux(aig_table_t *aig, int32_t c, int32_t a, int32_t b) {
+  int32_t p, q;
+
+  if (a == b) return a;
+  if (a == aig_not(b)) return aig_eq(aig, c, a);
+
+  p = aig_and(aig, c, a);
+  q = aig_and(aig, aig_not(c), b);
+  return aig_or(aig, p, q);
+}
+
+int32_t aig_maj3(aig_table_t *aig, int32_t a, int32_t b, int32_t c) {
+  int32_t p, q;
+
+  p = aig_and(aig, a, b);
+  q = aig_and(aig, c, aig_or(aig, a, b));
+  return aig_or(aig, p, q);
+}
+
+int32_t aig_or_array(aig_table_t *aig, uint32_t n, int32_t *a) {
+  uint32_t i;
+  int32_t r;
+
+  r = aig_false;
+  for (i=0; i<n; i++) {
+    r = aig_or(aig, r, a[i]);
+  }
+  return r;
+}
+
+
+
+/*****************************
+ *  BIT-VECTOR CONSTRUCTIONS  *
+ ****************************/
+
+void aig_make_bvmux(aig_table_t *aig, int32_t c, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    u[i] = aig_mux(aig, c, a[i], b[i]);
+  }
+}
+
+/*
+ * u := a + b + c where c is the carry in
+ */
+static void aig_adder(aig_table_t *aig, int32_t *a, int32_t *b, int32_t c, int32_t *u, uint32_t n) {
+  uint32_t i;
+  int32_t s;
+
+  for (i=0; i<n; i++) {
+    s = aig_xor3(aig, a[i], b[i], c);
+    c = aig_maj3(aig, a[i], b[i], c);
+    u[i] = s;
+  }
+}
+
+void aig_make_bvadd(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_adder(aig, a, b, aig_false, u, n);
+}
+
+/*
+ * a - b = a + (bvnot b) + 1
+ */
+void aig_make_bvsub(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  uint32_t i;
+  int32_t s, c;
+
+  c = aig_true;
+  for (i=0; i<n; i++) {
+    s = aig_xor3(aig, a[i], aig_not(b[i]), c);
+    c = aig_maj3(aig, a[i], aig_not(b[i]), c);
+    u[i] = s;
+  }
+}
+
+/*
+ * (bvneg a) = (bvnot a) + 1, using half adders
+ * - u may be equal to a
+ */
+void aig_make_bvneg(aig_table_t *aig, int32_t *a, int32_t *u, uint32_t n) {
+  uint32_t i;
+  int32_t s, c;
+
+  c = aig_true;
+  for (i=0; i<n; i++) {
+    s = aig_xor(aig, aig_not(a[i]), c);
+    c = aig_and(aig, aig_not(a[i]), c);
+    u[i] = s;
+  }
+}
+
+/*
+ * Shift-and-add multiplier
+ */
+void aig_make_bvmul(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  uint32_t i, k;
+  int32_t p, s, c;
+
+  for (i=0; i<n; i++) {
+    u[i] = aig_and(aig, a[i], b[0]);
+  }
+  for (k=1; k<n; k++) {
+    if (b[k] == aig_false) continue;
+    c = aig_false;
+    for (i=k; i<n; i++) {
+      p = aig_and(aig, a[i-k], b[k]);
+      s = aig_xor3(aig, u[i], p, c);
+      c = aig_maj3(aig, u[i], p, c);
+      u[i] = s;
+    }
+  }
+}
+
+
+/*
+ * Subtract (q * b) from a (in place)
+ */
+static void aig_submul(aig_table_t *aig, int32_t *a, int32_t *b, int32_t q, uint32_t n) {
+  uint32_t i;
+  int32_t p, s, c;
+
+  if (q == aig_false) return;
+
+  c = aig_true;
+  for (i=0; i<n; i++) {
+    p = aig_not(aig_and(aig, b[i], q));
+    s = aig_xor3(aig, a[i], p, c);
+    c = aig_maj3(aig, a[i], p, c);
+    a[i] = s;
+  }
+}
+
+/*
+ * Restoring division: same circuit as bit_blaster_make_udivision
+ * - q = either NULL or an array of n edges for the quotient
+ * - r = either NULL or an array of n edges for the remainder
+ */
+static void aig_udivision(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *q, int32_t *r, uint32_t n) {
+  int32_t *aux;
+  int32_t l;
+  uint32_t i;
+
+  aux = (int32_t *) safe_malloc(2 * n * sizeof(int32_t));
+  for (i=0; i<n; i++) {
+    aux[i] = a[i];
+    aux[i + n] = aig_false;
+  }
+
+  i = n;
+  while (i > 0) {
+    i --;
+    l = aig_make_bvuge(aig, aux + i, b, n);
+    aig_submul(aig, aux + i, b, l, n);
+    if (q != NULL) {
+      q[i] = l;
+    }
+  }
+  if (r != NULL) {
+    for (i=0; i<n; i++) {
+      r[i] = aux[i];
+    }
+  }
+
+  safe_free(aux);
+}
+
+void aig_make_bvudiv(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_udivision(aig, a, b, u, NULL, n);
+}
+
+void aig_make_bvurem(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_udivision(aig, a, b, NULL, u, n);
+}
+
+
+/*
+ * u := (ite c a (bvneg a))
+ */
+static void aig_cond_neg(aig_table_t *aig, int32_t c, int32_t *a, int32_t *u, uint32_t n) {
+  int32_t *neg;
+
+  neg = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  aig_make_bvneg(aig, a, neg, n);
+  aig_make_bvmux(aig, c, a, neg, u, n);
+  safe_free(neg);
+}
+
+/*
+ * Signed division: q = (bvsdiv a b) and r = (bvsrem a b)
+ * - the quotient and remainder are computed from the absolute values
+ */
+static void aig_sdivision(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *q, int32_t *r, uint32_t n) {
+  int32_t *abs_a, *abs_b, *aux;
+  int32_t sa, sb;
+
+  assert(n > 0);
+
+  abs_a = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  abs_b = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  aux = (int32_t *) safe_malloc(n * sizeof(int32_t));
+
+  sa = a[n-1];
+  sb = b[n-1];
+  aig_cond_neg(aig, aig_not(sa), a, abs_a, n);
+  aig_cond_neg(aig, aig_not(sb), b, abs_b, n);
+
+  if (q != NULL) {
+    aig_udivision(aig, abs_a, abs_b, aux, NULL, n);
+    aig_cond_neg(aig, aig_eq(aig, sa, sb), aux, q, n);
+  }
+  if (r != NULL) {
+    aig_udivision(aig, abs_a, abs_b, NULL, aux, n);
+    aig_cond_neg(aig, aig_not(sa), aux, r, n);
+  }
+
+  safe_free(abs_a);
+  safe_free(abs_b);
+  safe_free(aux);
+}
+
+void aig_make_bvsdiv(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_sdivision(aig, a, b, u, NULL, n);
+}
+
+void aig_make_bvsrem(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_sdivision(aig, a, b, NULL, u, n);
+}
+
+/*
+ * Floor remainder: same construction as bit_blaster_make_smod
+ * - r2 := if a>=0 then r1 else -r1 where r1 = (bvurem |a| |b|)
+ * - l := (sign of a = sign of b) or (r2 = 0)
+ * - u := if l then r2 else r2 + b
+ */
+void aig_make_bvsmod(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  int32_t *abs_a, *abs_b, *r2, *r3;
+  int32_t sa, sb, l;
+
+  assert(n > 0);
+
+  abs_a = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  abs_b = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  r2 = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  r3 = (int32_t *) safe_malloc(n * sizeof(int32_t));
+
+  sa = a[n-1];
+  sb = b[n-1];
+  aig_cond_neg(aig, aig_not(sa), a, abs_a, n);
+  aig_cond_neg(aig, aig_not(sb), b, abs_b, n);
+  aig_udivision(aig, abs_a, abs_b, NULL, r3, n);
+  aig_cond_neg(aig, aig_not(sa), r3, r2, n);
+
+  l = aig_or(aig, aig_eq(aig, sa, sb), aig_not(aig_or_array(aig, n, r2)));
+  aig_make_bvadd(aig, r2, b, r3, n);
+  aig_make_bvmux(aig, l, r2, r3, u, n);
+
+  safe_free(abs_a);
+  safe_free(abs_b);
+  safe_free(r2);
+  safe_free(r3);
+}
+
+
+/*
+ * SHIFTS
+ *
+ * The control bits are b[0 ... w-1] where 2^(w-1) < n <= 2^w.
+ * Stage j shifts by 2^j if b[j] is true. The result is replaced
+ * by the padding if any of b[w ... n-1] is true.
+ */
+static uint32_t aig_num_control_bits(uint32_t n) {
+  uint32_t w, p;
+
+  assert(n > 0);
+
+  p = 1;
+  w = 0;
+  while (p < n) {
+    w ++;
+    p <<= 1;
+  }
+  return w;
+}
+
+void aig_make_shift_left(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  uint32_t i, j, k, w;
+  int32_t overflow;
+
+  w = aig_num_control_bits(n);
+  for (i=0; i<n; i++) {
+    u[i] = a[i];
+  }
+  for (j=0; j<w; j++) {
+    k = ((uint32_t) 1) << j;
+    assert(k < n);
+    i = n;
+    while (i > 0) {
+      i --;
+      u[i] = aig_mux(aig, b[j], (i >= k) ? u[i-k] : aig_false, u[i]);
+    }
+  }
+  overflow = aig_or_array(aig, n - w, b + w);
+  for (i=0; i<n; i++) {
+    u[i] = aig_and(aig, aig_not(overflow), u[i]);
+  }
+}
+
+static void aig_shift_right(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n, int32_t pad) {
+  uint32_t i, j, k, w;
+  int32_t overflow;
+
+  w = aig_num_control_bits(n);
+  for (i=0; i<n; i++) {
+    u[i] = a[i];
+  }
+  for (j=0; j<w; j++) {
+    k = ((uint32_t) 1) << j;
+    assert(k < n);
+    for (i=0; i<n; i++) {
+      u[i] = aig_mux(aig, b[j], (i + k < n) ? u[i+k] : pad, u[i]);
+    }
+  }
+  overflow = aig_or_array(aig, n - w, b + w);
+  for (i=0; i<n; i++) {
+    u[i] = aig_mux(aig, overflow, pad, u[i]);
+  }
+}
+
+void aig_make_lshift_right(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  aig_shift_right(aig, a, b, u, n, aig_false);
+}
+
+void aig_make_ashift_right(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n) {
+  assert(n > 0);
+  aig_shift_right(aig, a, b, u, n, a[n-1]);
+}
+
+
+/*
+ * COMPARATORS
+ */
+int32_t aig_make_bveq(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n) {
+  uint32_t i;
+  int32_t r;
+
+  r = aig_true;
+  for (i=0; i<n; i++) {
+    r = aig_and(aig, r, aig_eq(aig, a[i], b[i]));
+  }
+  return r;
+}
+
+/*
+ * (a >= b): from the low-order bits up, (a[0..i] >= b[0..i]) is
+ * (maj a[i] (not b[i]) (a[0..i-1] >= b[0..i-1]))
+ */
+int32_t aig_make_bvuge(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n) {
+  uint32_t i;
+  int32_t r;
+
+  r = aig_true;
+  for (i=0; i<n; i++) {
+    r = aig_maj3(aig, a[i], aig_not(b[i]), r);
+  }
+  return r;
+}
+
+/*
+ * For signed comparison, the sign bits are swapped
+ */
+int32_t aig_make_bvsge(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n) {
+  int32_t r;
+
+  assert(n > 0);
+  r = aig_make_bvuge(aig, a, b, n-1);
+  return aig_maj3(aig, b[n-1], aig_not(a[n-1]), r);
+}
+
+
+
+/**************
+ *  OUTPUTS   *
+ *************/
+
+uint32_t aig_add_output(aig_table_t *aig, int32_t e) {
+  uint32_t i;
+
+  assert(0 <= aig_node(e) && aig_node(e) < aig->nnodes);
+  i = aig->outputs.size;
+  ivector_push(&aig->outputs, e);
+  return i;
+}
+
+
+
+/**************
+ *  SWEEPING  *
+ *************/
+
+/*
+ * Sweeper: the new graph is built in 'aig'
+ * - classes maps a hash of the normalized signature to a candidate node
+ * - cand[i] = true if node i is a candidate
+ * - repr[i] = edge that replaces node i (if i has been merged)
+ * - pos[i] = position of node i in the cone during equivalence checks
+ *   (or -1 if i is not in the cone)
+ * - cone = nodes in the cone, in increasing order
+ * - stack = for exploring the cones
+ * - val = values of the cone nodes during exhaustive simulation
+ * - bit = next simulation bit to replace by a counterexample
+ * - checks = number of exact checks so far
+ * - cex = number of counterexamples so far
+ */
+typedef struct aig_sweeper_s {
+  aig_table_t *aig;
+  int_hmap_t classes;
+  uint8_t *cand;
+  int32_t *repr;
+  int32_t *pos;
+  uint32_t size;
+  ivector_t cone;
+  ivector_t stack;
+  uint64_t *val;
+  uint32_t val_size;
+  uint32_t bit;
+  uint32_t checks;
+  uint32_t cex;
+} aig_sweeper_t;
+
+typedef enum aig_check_code {
+  AIG_EQUIV,
+  AIG_DIFFERENT,
+  AIG_UNKNOWN,
+} aig_check_code_t;
+
+
+static void init_aig_sweeper(aig_sweeper_t *sweeper, aig_table_t *aig) {
+  sweeper->aig = aig;
+  init_int_hmap(&sweeper->classes, 0);
+  sweeper->cand = NULL;
+  sweeper->repr = NULL;
+  sweeper->pos = NULL;
+  sweeper->size = 0;
+  init_ivector(&sweeper->cone, 0);
+  init_ivector(&sweeper->stack, 0);
+  sweeper->val = NULL;
+  sweeper->val_size = 0;
+  sweeper->bit = 0;
+  sweeper->checks = 0;
+  sweeper->cex = 0;
+}
+
+static void delete_aig_sweeper(aig_sweeper_t *sweeper) {
+  delete_int_hmap(&sweeper->classes);
+  safe_free(sweeper->cand);
+  safe_free(sweeper->repr);
+  safe_free(sweeper->pos);
+  delete_ivector(&sweeper->cone);
+  delete_ivector(&sweeper->stack);
+  safe_free(sweeper->val);
+}
+
+/*
+ * Make sure the node-indexed arrays are large enough for all nodes
+ */
+static void aig_sweeper_resize(aig_sweeper_t *sweeper) {
+  uint32_t i, n;
+
+  n = sweeper->aig->size;
+  if (n > sweeper->size) {
+    sweeper->cand = (uint8_t *) safe_realloc(sweeper->cand, n * sizeof(uint8_t));
+    sweeper->repr = (int32_t *) safe_realloc(sweeper->repr, n * sizeof(int32_t));
+    sweeper->pos = (int32_t *) safe_realloc(sweeper->pos, n * sizeof(int32_t));
+    for (i=sweeper->size; i<n; i++) {
+      sweeper->cand[i] = false;
+      sweeper->repr[i] = aig_pos_edge(i);
+      sweeper->pos[i] = -1;
+    }
+    sweeper->size = n;
+  }
+}
+
+
+/*
+ * Normalized signature of node i: the low-order bit is 0
+ */
+static inline uint64_t norm_sig(const aig_table_t *aig, int32_t i) {
+  uint64_t x;
+
+  x = aig->sig[i];
+  return (x & 1) ? ~x : x;
+}
+
+static inline int32_t sig_key(uint64_t x) {
+  return (int32_t) (jenkins_hash_uint64(x) >> 1);
+}
+
+
+/*
+ * Register node i as a candidate if there's no candidate with the same key
+ */
+static void aig_sweeper_register(aig_sweeper_t *sweeper, int32_t i) {
+  int_hmap_pair_t *r;
+
+  r = int_hmap_get(&sweeper->classes, sig_key(norm_sig(sweeper->aig, i)));
+  if (r->val < 0) {
+    r->val = i;
+  }
+  sweeper->cand[i] = true;
+}
+
+/*
+ * Recompute all signatures then rebuild the candidate map
+ */
+static void aig_sweeper_resimulate(aig_sweeper_t *sweeper) {
+  aig_table_t *aig;
+  uint32_t i, n;
+
+  aig = sweeper->aig;
+  n = aig->nnodes;
+  for (i=1; i<n; i++) {
+    if (aig->right[i] >= 0) {
+      aig->sig[i] = edge_sig(aig, aig->left[i]) & edge_sig(aig, aig->right[i]);
+    }
+  }
+
+  int_hmap_reset(&sweeper->classes);
+  for (i=0; i<n; i++) {
+    if (sweeper->cand[i]) {
+      aig_sweeper_register(sweeper, i);
+    }
+  }
+}
+
+
+/*
+ * Collect the cones of nodes i and j in sweeper->cone, in increasing order
+ * - set pos[k] for every node k in the cone
+ * - return the number of inputs in the cone (excluding the constant)
+ */
+static uint32_t aig_sweeper_collect_cone(aig_sweeper_t *sweeper, int32_t i, int32_t j) {
+  aig_table_t *aig;
+  ivector_t *stack, *cone;
+  uint32_t k, ninputs;
+  int32_t x;
+
+  aig = sweeper->aig;
+  stack = &sweeper->stack;
+  cone = &sweeper->cone;
+  ivector_reset(stack);
+  ivector_reset(cone);
+
+  ivector_push(stack, i);
+  ivector_push(stack, j);
+  while (stack->size > 0) {
+    x = ivector_pop2(stack);
+    if (sweeper->pos[x] < 0) {
+      sweeper->pos[x] = 0;
+      ivector_push(cone, x);
+      if (aig->right[x] >= 0) {
+        ivector_push(stack, aig_node(aig->left[x]));
+        ivector_push(stack, aig_node(aig->right[x]));
+      }
+    }
+  }
+
+  int_array_sort(cone->data, cone->size);
+  ninputs = 0;
+  for (k=0; k<cone->size; k++) {
+    x = cone->data[k];
+    sweeper->pos[x] = k;
+    if (x > 0 && aig->right[x] < 0) {
+      ninputs ++;
+    }
+  }
+
+  return ninputs;
+}
+
+static void aig_sweeper_clear_cone(aig_sweeper_t *sweeper) {
+  ivector_t *cone;
+  uint32_t k;
+
+  cone = &sweeper->cone;
+  for (k=0; k<cone->size; k++) {
+    sweeper->pos[cone->data[k]] = -1;
+  }
+}
+
+
+/*
+ * Store a counterexample into the signatures of the cone inputs
+ * - val(k) = value of the k-th input in the cone
+ */
+static void aig_sweeper_set_cex_bit(aig_sweeper_t *sweeper, int32_t x, bool value) {
+  uint64_t mask;
+
+  mask = ((uint64_t) 1) << sweeper->bit;
+  if (value) {
+    sweeper->aig->sig[x] |= mask;
+  } else {
+    sweeper->aig->sig[x] &= ~mask;
+  }
+}
+
+static void aig_sweeper_next_cex(aig_sweeper_t *sweeper) {
+  sweeper->bit = (sweeper->bit + 1) & 63;
+  sweeper->cex ++;
+  sweeper->aig->stats.num_cex ++;
+}
+
+
+/*
+ * Value of edge e during exhaustive simulation
+ */
+static inline uint64_t cone_val(aig_sweeper_t *sweeper, int32_t e) {
+  uint64_t x;
+
+  x = sweeper->val[sweeper->pos[aig_node(e)]];
+  return aig_sign(e) ? ~x : x;
+}
+
+static const uint64_t aig_input_masks[6] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL,
+};
+
+static void aig_sweeper_alloc_val(aig_sweeper_t *sweeper) {
+  uint32_t n;
+
+  n = sweeper->cone.size;
+  if (n > sweeper->val_size) {
+    sweeper->val = (uint64_t *) safe_realloc(sweeper->val, n * sizeof(uint64_t));
+    sweeper->val_size = n;
+  }
+}
+
+/*
+ * Index of the lowest bit set in d (d must be non-zero)
+ */
+static uint32_t low_bit_index(uint64_t d) {
+  uint32_t t;
+
+  assert(d != 0);
+  t = 0;
+  while ((d & 1) == 0) {
+    d >>= 1;
+    t ++;
+  }
+  return t;
+}
+
+/*
+ * Simulation of the cone on fresh random patterns: this is cheaper than
+ * a call to the sat solver and catches most non-equivalent pairs.
+ * - return AIG_DIFFERENT if a counterexample is found
+ * - return AIG_UNKNOWN otherwise
+ */
+static aig_check_code_t aig_random_check(aig_sweeper_t *sweeper, int32_t e1, int32_t e2) {
+  aig_table_t *aig;
+  ivector_t *cone;
+  uint32_t r, k, t;
+  uint64_t d;
+  int32_t x;
+
+  aig = sweeper->aig;
+  cone = &sweeper->cone;
+  aig_sweeper_alloc_val(sweeper);
+
+  for (r=0; r<AIG_SWEEP_SIM_ROUNDS; r++) {
+    for (k=0; k<cone->size; k++) {
+      x = cone->data[k];
+      if (x == 0) {
+        sweeper->val[k] = ~((uint64_t) 0);
+      } else if (aig->right[x] < 0) {
+        sweeper->val[k] = random_sig(aig);
+      } else {
+        sweeper->val[k] = cone_val(sweeper, aig->left[x]) & cone_val(sweeper, aig->right[x]);
+      }
+    }
+
+    d = cone_val(sweeper, e1) ^ cone_val(sweeper, e2);
+    if (d != 0) {
+      t = low_bit_index(d);
+      for (k=0; k<cone->size; k++) {
+        x = cone->data[k];
+        if (x > 0 && aig->right[x] < 0) {
+          aig_sweeper_set_cex_bit(sweeper, x, (sweeper->val[k] >> t) & 1);
+        }
+      }
+      aig_sweeper_next_cex(sweeper);
+      return AIG_DIFFERENT;
+    }
+  }
+
+  return AIG_UNKNOWN;
+}
+
+/*
+ * Exhaustive check for (e1 == e2): the cone is collected and has ninputs
+ * inputs.
+ */
+static aig_check_code_t aig_exhaustive_check(aig_sweeper_t *sweeper, int32_t e1, int32_t e2, uint32_t ninputs) {
+  aig_table_t *aig;
+  ivector_t *cone;
+  uint32_t nwords, w, k, j, p, t;
+  uint64_t d;
+  int32_t x;
+
+  aig = sweeper->aig;
+  cone = &sweeper->cone;
+  aig_sweeper_alloc_val(sweeper);
+
+  nwords = (ninputs <= 6) ? 1 : ((uint32_t) 1) << (ninputs - 6);
+  for (w=0; w<nwords; w++) {
+    j = 0;
+    for (k=0; k<cone->size; k++) {
+      x = cone->data[k];
+      if (x == 0) {
+        sweeper->val[k] = ~((uint64_t) 0);
+      } else if (aig->right[x] < 0) {
+        if (j < 6) {
+          sweeper->val[k] = aig_input_masks[j];
+        } else {
+          sweeper->val[k] = ((w >> (j - 6)) & 1) ? ~((uint64_t) 0) : 0;
+        }
+        j ++;
+      } else {
+        sweeper->val[k] = cone_val(sweeper, aig->left[x]) & cone_val(sweeper, aig->right[x]);
+      }
+    }
+
+    d = cone_val(sweeper, e1) ^ cone_val(sweeper, e2);
+    if (d != 0) {
+      // counterexample: pattern p
+      t = low_bit_index(d);
+      p = (w << 6) + t;
+      j = 0;
+      for (k=0; k<cone->size; k++) {
+        x = cone->data[k];
+        if (x > 0 && aig->right[x] < 0) {
+          aig_sweeper_set_cex_bit(sweeper, x, (p >> j) & 1);
+          j ++;
+        }
+      }
+      aig_sweeper_next_cex(sweeper);
+      return AIG_DIFFERENT;
+    }
+  }
+
+  return AIG_EQUIV;
+}
+
+
+/*
+ * Check (e1 == e2) using the sat solver
+ * - cone node at position k is mapped to variable k+1
+ */
+static inline literal_t cone_lit(aig_sweeper_t *sweeper, int32_t e) {
+  return pos_lit(sweeper->pos[aig_node(e)] + 1) ^ aig_sign(e);
+}
+
+static aig_check_code_t aig_sat_check(aig_sweeper_t *sweeper, int32_t e1, int32_t e2) {
+  aig_table_t *aig;
+  ivector_t *cone;
+  sat_solver_t sat;
+  literal_t clause[3];
+  literal_t l;
+  uint32_t k, n;
+  int32_t x;
+  aig_check_code_t code;
+
+  aig = sweeper->aig;
+  cone = &sweeper->cone;
+  n = cone->size;
+
+  aig->stats.num_sat_checks ++;
+
+  init_nsat_solver(&sat, n + 1, false);
+  nsat_solver_add_vars(&sat, n);
+  nsat_set_max_conflicts(&sat, AIG_SWEEP_MAX_CONFLICTS);
+
+  for (k=0; k<n; k++) {
+    x = cone->data[k];
+    l = pos_lit(k + 1);
+    if (x == 0) {
+      clause[0] = l;
+      nsat_solver_simplify_and_add_clause(&sat, 1, clause);
+    } else if (aig->right[x] >= 0) {
+      // l = (and left right)
+      clause[0] = not(l);
+      clause[1] = cone_lit(sweeper, aig->left[x]);
+      nsat_solver_simplify_and_add_clause(&sat, 2, clause);
+      clause[0] = not(l);
+      clause[1] = cone_lit(sweeper, aig->right[x]);
+      nsat_solver_simplify_and_add_clause(&sat, 2, clause);
+      clause[0] = l;
+      clause[1] = not(cone_lit(sweeper, aig->left[x]));
+      clause[2] = not(cone_lit(sweeper, aig->right[x]));
+      nsat_solver_simplify_and_add_clause(&sat, 3, clause);
+    }
+  }
+
+  // miter: e1 != e2
+  clause[0] = cone_lit(sweeper, e1);
+  clause[1] = cone_lit(sweeper, e2);
+  nsat_solver_simplify_and_add_clause(&sat, 2, clause);
+  clause[0] = not(cone_lit(sweeper, e1));
+  clause[1] = not(cone_lit(sweeper, e2));
+  nsat_solver_simplify_and_add_clause(&sat, 2, clause);
+
+  switch (nsat_solve(&sat)) {
+  case STAT_UNSAT:
+    code = AIG_EQUIV;
+    break;
+
+  case STAT_SAT:
+    for (k=0; k<n; k++) {
+      x = cone->data[k];
+      if (x > 0 && aig->right[x] < 0) {
+        aig_sweeper_set_cex_bit(sweeper, x, lit_value(&sat, pos_lit(k + 1)) == VAL_TRUE);
+      }
+    }
+    aig_sweeper_next_cex(sweeper);
+    code = AIG_DIFFERENT;
+    break;
+
+  default:
+    code = AIG_UNKNOWN;
+    break;
+  }
+
+  delete_nsat_solver(&sat);
+
+  return code;
+}
+
+
+/*
+ * Check whether e1 and e2 are equivalent
+ */
+static aig_check_code_t aig_sweeper_check(aig_sweeper_t *sweeper, int32_t e1, int32_t e2) {
+  aig_check_code_t code;
+  uint32_t ninputs;
+
+  sweeper->checks ++;
+  sweeper->aig->stats.num_checks ++;
+
+  ninputs = aig_sweeper_collect_cone(sweeper, aig_node(e1), aig_node(e2));
+  if (ninputs <= AIG_SWEEP_MAX_EXHAUSTIVE) {
+    code = aig_exhaustive_check(sweeper, e1, e2, ninputs);
+  } else if (sweeper->cone.size <= AIG_SWEEP_MAX_CONE) {
+    code = aig_random_check(sweeper, e1, e2);
+    if (code == AIG_UNKNOWN) {
+      code = aig_sat_check(sweeper, e1, e2);
+    }
+  } else {
+    code = AIG_UNKNOWN;
+  }
+  aig_sweeper_clear_cone(sweeper);
+
+  return code;
+}
+
+
+/*
+ * Process a new node i: check whether it's equivalent to an earlier candidate.
+ * - return the edge that represents i
+ */
+static int32_t aig_sweeper_process(aig_sweeper_t *sweeper, int32_t i) {
+  aig_table_t *aig;
+  int_hmap_pair_t *r;
+  uint64_t s;
+  int32_t c, e;
+
+  aig = sweeper->aig;
+  for (;;) {
+    s = norm_sig(aig, i);
+    r = int_hmap_find(&sweeper->classes, sig_key(s));
+    if (r == NULL || norm_sig(aig, r->val) != s) break;
+    if (sweeper->checks >= AIG_SWEEP_MAX_CHECKS) {
+      return aig_pos_edge(i);
+    }
+
+    // e = the edge of c with the same polarity as i
+    c = r->val;
+    e = aig_pos_edge(c) ^ ((aig->sig[c] ^ aig->sig[i]) & 1);
+    switch (aig_sweeper_check(sweeper, aig_pos_edge(i), e)) {
+    case AIG_EQUIV:
+      aig->stats.num_merges ++;
+      sweeper->repr[i] = e;
+      return e;
+
+    case AIG_DIFFERENT:
+      aig_sweeper_resimulate(sweeper);
+      if (sweeper->cex >= AIG_SWEEP_MAX_CEX) {
+        return aig_pos_edge(i);
+      }
+      break;
+
+    case AIG_UNKNOWN:
+      return aig_pos_edge(i);
+    }
+  }
+
+  aig_sweeper_register(sweeper, i);
+  return aig_pos_edge(i);
+}
+
+
+/*
+ * Map edge e of the old graph to the new graph
+ * - the new graph may contain nodes that have been merged but
+ *   they're never used as children of other nodes.
+ */
+static inline int32_t map_edge(int32_t *map, int32_t e) {
+  return map[aig_node(e)] ^ aig_sign(e);
+}
+
+void aig_sweep(aig_table_t *aig) {
+  aig_table_t new;
+  aig_sweeper_t sweeper;
+  int32_t *map;
+  uint32_t i, n, k;
+  int32_t e;
+
+  n = aig->nnodes;
+  init_aig_table(&new, n);
+  new.seed = aig->seed;
+  new.stats = aig->stats;
+  init_aig_sweeper(&sweeper, &new);
+
+  map = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  map[0] = aig_true;
+  aig_sweeper_resize(&sweeper);
+  aig_sweeper_register(&sweeper, 0);
+
+  for (i=1; i<n; i++) {
+    k = new.nnodes;
+    if (aig->right[i] < 0) {
+      e = aig_input(&new, aig->left[i]);
+    } else {
+      e = aig_and(&new, map_edge(map, aig->left[i]), map_edge(map, aig->right[i]));
+    }
+    aig_sweeper_resize(&sweeper);
+    if (aig_node(e) >= k) {
+      // fresh node
+      e = aig_sweeper_process(&sweeper, aig_node(e)) ^ aig_sign(e);
+    } else {
+      // existing node: it may have been merged
+      e = sweeper.repr[aig_node(e)] ^ aig_sign(e);
+    }
+    map[i] = e;
+  }
+
+  for (i=0; i<aig->outputs.size; i++) {
+    ivector_push(&new.outputs, map_edge(map, aig->outputs.data[i]));
+  }
+
+  safe_free(map);
+  delete_aig_sweeper(&sweeper);
+  delete_aig_table(aig);
+  *aig = new;
+}
+
+
+
+/****************************
+ *  CONVERSION TO CLAUSES   *
+ ***************************/
+
+/*
+ * Check whether node i is of the form
+ *   (and (not (and c p)) (not (and (not c) q))) = (not (ite c p q))
+ * - if so, store c, p, q in a[0 .. 2] and return true
+ * - the fanout of the two inner nodes is not checked: if they are
+ *   used elsewhere, they get their own literal
+ */
+static bool aig_match_mux(aig_table_t *aig, int32_t i, int32_t *a) {
+  int32_t x, y, x0, x1, y0, y1;
+
+  x = aig->left[i];
+  y = aig->right[i];
+  if (aig_sign(x) == 0 || aig_sign(y) == 0 || !aig_is_and(aig, x) || !aig_is_and(aig, y)) {
+    return false;
+  }
+
+  x0 = aig->left[aig_node(x)];
+  x1 = aig->right[aig_node(x)];
+  y0 = aig->left[aig_node(y)];
+  y1 = aig->right[aig_node(y)];
+
+  if (x0 == aig_not(y0)) {
+    a[0] = x0; a[1] = x1; a[2] = y1;
+  } else if (x0 == aig_not(y1)) {
+    a[0] = x0; a[1] = x1; a[2] = y0;
+  } else if (x1 == aig_not(y0)) {
+    a[0] = x1; a[1] = x0; a[2] = y1;
+  } else if (x1 == aig_not(y1)) {
+    a[0] = x1; a[1] = x0; a[2] = y0;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Check whether node i is (xor a[0] a[1])
+ */
+static bool aig_match_xor(aig_table_t *aig, int32_t i, int32_t *a) {
+  int32_t b[3];
+
+  if (aig_match_mux(aig, i, b) && b[1] == aig_not(b[2])) {
+    a[0] = b[0];
+    a[1] = b[1];
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Check whether node i is the negation of (majority a b c) as
+ * built by aig_maj3:
+ *   (and (not (and a b)) (not (and c (not (and (not a) (not b))))))
+ * - if so, store a, b, c in m[0 .. 2] and return true
+ */
+static bool aig_match_maj3_aux(aig_table_t *aig, int32_t x, int32_t y, int32_t *m) {
+  int32_t p0, p1, q0, q1, r;
+
+  p0 = aig->left[aig_node(x)];
+  p1 = aig->right[aig_node(x)];
+  q0 = aig->left[aig_node(y)];
+  q1 = aig->right[aig_node(y)];
+
+  // r = one of q0, q1 that's (not (and (not p0) (not p1)))
+  r = aig_not(q1);
+  if (aig_sign(q1) == 1 && aig_is_and(aig, r) &&
+      ((aig->left[aig_node(r)] == aig_not(p0) && aig->right[aig_node(r)] == aig_not(p1)) ||
+       (aig->left[aig_node(r)] == aig_not(p1) && aig->right[aig_node(r)] == aig_not(p0)))) {
+    m[0] = p0; m[1] = p1; m[2] = q0;
+    return true;
+  }
+  r = aig_not(q0);
+  if (aig_sign(q0) == 1 && aig_is_and(aig, r) &&
+      ((aig->left[aig_node(r)] == aig_not(p0) && aig->right[aig_node(r)] == aig_not(p1)) ||
+       (aig->left[aig_node(r)] == aig_not(p1) && aig->right[aig_node(r)] == aig_not(p0)))) {
+    m[0] = p0; m[1] = p1; m[2] = q1;
+    return true;
+  }
+
+  return false;
+}
+
+static bool aig_match_maj3(aig_table_t *aig, int32_t i, int32_t *m) {
+  int32_t x, y;
+
+  x = aig->left[i];
+  y = aig->right[i];
+  if (aig_sign(x) == 0 || aig_sign(y) == 0 || !aig_is_and(aig, x) || !aig_is_and(aig, y)) {
+    return false;
+  }
+  return aig_match_maj3_aux(aig, x, y, m) || aig_match_maj3_aux(aig, y, x, m);
+}
+
+
+/*
+ * Collect the leaves of the AND tree rooted at node i in vector v
+ * - internal nodes are positive AND edges of fanout one
+ */
+static void aig_collect_and_leaves(aig_table_t *aig, uint32_t *nrefs, int32_t i, ivector_t *v) {
+  int32_t e;
+
+  e = aig->left[i];
+  if (aig_sign(e) == 0 && aig_is_and(aig, e) && nrefs[aig_node(e)] == 1) {
+    aig_collect_and_leaves(aig, nrefs, aig_node(e), v);
+  } else {
+    ivector_push(v, e);
+  }
+
+  e = aig->right[i];
+  if (aig_sign(e) == 0 && aig_is_and(aig, e) && nrefs[aig_node(e)] == 1) {
+    aig_collect_and_leaves(aig, nrefs, aig_node(e), v);
+  } else {
+    ivector_push(v, e);
+  }
+}
+
+/*
+ * Collect the leaves of an XOR tree: e is an input of the XOR
+ * - if e is itself an XOR node of fanout one, it's expanded
+ */
+static void aig_collect_xor_leaves(aig_table_t *aig, uint32_t *nrefs, int32_t e, ivector_t *v) {
+  int32_t a[2];
+
+  if (aig_is_and(aig, e) && nrefs[aig_node(e)] == 1 && aig_match_xor(aig, aig_node(e), a)) {
+    aig_collect_xor_leaves(aig, nrefs, a[0] ^ aig_sign(e), v);
+    aig_collect_xor_leaves(aig, nrefs, a[1], v);
+  } else {
+    ivector_push(v, e);
+  }
+}
+
+/*
+ * Cut types
+ */
+typedef enum aig_cut {
+  AIG_XOR_CUT,  // i = (xor v[0] ... v[k-1])
+  AIG_MAJ_CUT,  // i = (not (majority v[0] v[1] v[2]))
+  AIG_MUX_CUT,  // i = (not (ite v[0] v[1] v[2]))
+  AIG_AND_CUT,  // i = (and v[0] ... v[k-1])
+} aig_cut_t;
+
+/*
+ * Compute the cut for AND node i: store its leaves in v
+ */
+static aig_cut_t aig_cut(aig_table_t *aig, uint32_t *nrefs, int32_t i, ivector_t *v) {
+  int32_t a[3];
+
+  ivector_reset(v);
+  if (aig_match_xor(aig, i, a)) {
+    aig_collect_xor_leaves(aig, nrefs, a[0], v);
+    aig_collect_xor_leaves(aig, nrefs, a[1], v);
+    return AIG_XOR_CUT;
+  }
+
+  if (aig_match_maj3(aig, i, a)) {
+    ivector_add(v, a, 3);
+    return AIG_MAJ_CUT;
+  }
+
+  if (aig_match_mux(aig, i, a)) {
+    ivector_add(v, a, 3);
+    return AIG_MUX_CUT;
+  }
+
+  aig_collect_and_leaves(aig, nrefs, i, v);
+  return AIG_AND_CUT;
+}
+
+
+/*
+ * Literal for (majority a b c)
+ */
+static literal_t aig_blast_maj3(bit_blaster_t *blaster, literal_t a, literal_t b, literal_t c) {
+  literal_t l;
+
+  l = bit_blaster_eval_maj3(blaster, a, b, c);
+  if (l == null_literal) {
+    l = bit_blaster_fresh_literal(blaster);
+    bit_blaster_maj3(blaster, a, b, c, l);
+  }
+  return l;
+}
+
+
+void aig_convert(aig_table_t *aig, bit_blaster_t *blaster) {
+  ivector_t *v;
+  uint32_t *nrefs;
+  uint32_t i, k, n;
+  aig_cut_t cut;
+  literal_t l;
+
+  n = aig->nnodes;
+  nrefs = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+  for (i=0; i<n; i++) {
+    nrefs[i] = 0;
+  }
+
+  /*
+   * Fanout count: outputs count twice so that they're never
+   * absorbed into a larger cut.
+   */
+  for (i=0; i<aig->outputs.size; i++) {
+    nrefs[aig_node(aig->outputs.data[i])] += 2;
+  }
+  i = n;
+  while (i > 1) {
+    i --;
+    if (nrefs[i] > 0 && aig->right[i] >= 0) {
+      nrefs[aig_node(aig->left[i])] ++;
+      nrefs[aig_node(aig->right[i])] ++;
+    }
+  }
+
+  /*
+   * Mark the nodes that need a literal: lit[i] = true_literal
+   * for the nodes to convert.
+   */
+  v = &aig->aux;
+  for (i=1; i<n; i++) {
+    aig->lit[i] = null_literal;
+  }
+  for (i=0; i<aig->outputs.size; i++) {
+    aig->lit[aig_node(aig->outputs.data[i])] = true_literal;
+  }
+  i = n;
+  while (i > 1) {
+    i --;
+    if (aig->lit[i] != null_literal && aig->right[i] >= 0) {
+      aig_cut(aig, nrefs, i, v);
+      for (k=0; k<v->size; k++) {
+        aig->lit[aig_node(v->data[k])] = true_literal;
+      }
+    }
+  }
+
+  /*
+   * Convert in topological order
+   */
+  for (i=1; i<n; i++) {
+    if (aig->lit[i] == null_literal) continue;
+
+    if (aig->right[i] < 0) {
+      l = aig->left[i];
+    } else {
+      cut = aig_cut(aig, nrefs, i, v);
+      for (k=0; k<v->size; k++) {
+        v->data[k] = aig_literal(aig, v->data[k]);
+      }
+      switch (cut) {
+      case AIG_XOR_CUT:
+        l = bit_blaster_make_xor(blaster, v->size, v->data);
+        break;
+
+      case AIG_MAJ_CUT:
+        l = not(aig_blast_maj3(blaster, v->data[0], v->data[1], v->data[2]));
+        break;
+
+      case AIG_MUX_CUT:
+        l = not(bit_blaster_make_mux(blaster, v->data[0], v->data[1], v->data[2]));
+        break;
+
+      case AIG_AND_CUT:
+      default:
+        if (v->size == 2) {
+          l = bit_blaster_make_and2(blaster, v->data[0], v->data[1]);
+        } else {
+          for (k=0; k<v->size; k++) {
+            v->data[k] = not(v->data[k]);
+          }
+          l = not(bit_blaster_make_or(blaster, v->size, v->data));
+        }
+        break;
+      }
+    }
+    aig->lit[i] = l;
+  }
+
+  safe_free(nrefs);
+}
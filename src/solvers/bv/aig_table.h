@@ -0,0 +1,351 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AND-INVERTER GRAPHS FOR BIT-BLASTING
+ *
+ * An and-inverter graph (AIG) represents Boolean functions as a DAG
+ * of two-input AND nodes, with optional negation on the edges. The
+ * bv_solver can use an AIG as a staging layer: circuits are built in
+ * the AIG first, simplified as a whole, then converted to clauses.
+ *
+ * Nodes and edges:
+ * - node 0 is the constant true
+ * - an input node stands for a literal of the smt_core
+ * - an AND node has two children (edges)
+ * - an edge is encoded like a literal: edge = 2 * node + sign
+ *   so aig_true = 0 and aig_false = 1.
+ *
+ * Structural hashing: AND nodes are hash-consed on their two children.
+ * Before creating a node, the constructor applies the two-level rewrite
+ * rules of Brummayer & Biere (contradiction, idempotence, subsumption,
+ * substitution, resolution). The children of node i always have an
+ * index smaller than i, so increasing index is a topological order.
+ *
+ * Simulation: every node has a 64-bit signature obtained by evaluating
+ * the graph on 64 random input patterns. Signatures are computed when
+ * nodes are created.
+ *
+ * Sweeping (FRAIG style): the graph is rebuilt in topological order.
+ * Each new node is compared with an earlier node of the same signature
+ * (up to complement). Equivalence is checked exactly: by exhaustive
+ * simulation if the two cones have few inputs, or by a call to the
+ * sat solver with a conflict budget. A counterexample is added to the
+ * simulation patterns. Proven equivalent nodes are merged.
+ *
+ * Conversion to clauses: the nodes reachable from the registered
+ * outputs are encoded using the bit_blaster. A node that matches the
+ * AIG form of an XOR, a majority, or a multiplexer is encoded as that
+ * gate. XOR trees and trees of AND nodes with fanout one are encoded
+ * as a single n-ary gate. Otherwise, a node becomes a binary AND gate.
+ */
+
+#ifndef __AIG_TABLE_H
+#define __AIG_TABLE_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/bv/bit_blaster.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Edge constants
+ */
+enum {
+  aig_true = 0,
+  aig_false = 1,
+};
+
+
+/*
+ * Hash table for structural hashing
+ * - data = array of node indices (or -1 for empty slots)
+ * - size = power of two
+ * - nelems = number of nodes stored
+ * - resize_threshold = size * AIG_HTBL_RESIZE_RATIO
+ */
+typedef struct aig_htbl_s {
+  int32_t *data;
+  uint32_t size;
+  uint32_t nelems;
+  uint32_t resize_threshold;
+} aig_htbl_t;
+
+#define AIG_HTBL_DEF_SIZE 1024
+#define AIG_HTBL_RESIZE_RATIO 0.6
+
+
+/*
+ * Statistics
+ * - num_rewrites = number of and constructions simplified by the rewrite rules
+ * - num_checks = number of exact equivalence checks during sweeping
+ * - num_sat_checks = number of those checks that called the sat solver
+ * - num_merges = number of nodes merged by sweeping
+ * - num_cex = number of counterexamples added to the simulation patterns
+ */
+typedef struct aig_stats_s {
+  uint32_t num_rewrites;
+  uint32_t num_checks;
+  uint32_t num_sat_checks;
+  uint32_t num_merges;
+  uint32_t num_cex;
+} aig_stats_t;
+
+
+/*
+ * AIG table:
+ * - nnodes = number of nodes
+ * - size = size of the node-indexed arrays
+ * - for an AND node i: left[i] and right[i] are the two children
+ *   with left[i] < right[i]
+ * - for an input node i: left[i] = the literal and right[i] = -1
+ * - for node 0: left[0] = true_literal and right[0] = -1
+ * - sig[i] = simulation signature of node i
+ * - lit[i] = literal attached to node i by the conversion to clauses
+ *   (null_literal if none)
+ *
+ * Other components:
+ * - htbl = structural hashing table
+ * - inputs = map from boolean variables to input nodes
+ * - outputs = vector of edges to convert
+ * - seed = for the pseudo-random number generator
+ * - aux = auxiliary vector
+ */
+typedef struct aig_table_s {
+  uint32_t nnodes;
+  uint32_t size;
+  int32_t *left;
+  int32_t *right;
+  uint64_t *sig;
+  literal_t *lit;
+
+  aig_htbl_t htbl;
+  int_hmap_t inputs;
+  ivector_t outputs;
+  uint32_t seed;
+  ivector_t aux;
+
+  aig_stats_t stats;
+} aig_table_t;
+
+#define DEF_AIG_TABLE_SIZE 1024
+#define MAX_AIG_TABLE_SIZE (UINT32_MAX/sizeof(uint64_t))
+
+
+/*
+ * Sweeping parameters:
+ * - AIG_SWEEP_MAX_CHECKS = maximal number of exact equivalence checks
+ * - AIG_SWEEP_MAX_CEX = maximal number of counterexamples (each one
+ *   costs a new simulation of the graph)
+ * - AIG_SWEEP_MAX_EXHAUSTIVE = maximal number of inputs for exhaustive simulation
+ * - AIG_SWEEP_MAX_CONE = maximal number of nodes in the cones of a sat check
+ * - AIG_SWEEP_MAX_CONFLICTS = conflict budget for a sat check
+ * - AIG_SWEEP_SIM_ROUNDS = number of rounds of 64 random patterns
+ *   tried on a cone before calling the sat solver
+ */
+#define AIG_SWEEP_MAX_CHECKS     20000
+#define AIG_SWEEP_MAX_CEX        512
+#define AIG_SWEEP_MAX_EXHAUSTIVE 12
+#define AIG_SWEEP_MAX_CONE       5000
+#define AIG_SWEEP_MAX_CONFLICTS  1000
+#define AIG_SWEEP_SIM_ROUNDS     16
+
+
+
+/*********************
+ *  EDGE OPERATIONS  *
+ ********************/
+
+static inline int32_t aig_node(int32_t e) {
+  return e >> 1;
+}
+
+static inline uint32_t aig_sign(int32_t e) {
+  return ((uint32_t) e) & 1;
+}
+
+static inline int32_t aig_not(int32_t e) {
+  return e ^ 1;
+}
+
+static inline int32_t aig_pos_edge(int32_t i) {
+  return i << 1;
+}
+
+static inline bool aig_is_and(const aig_table_t *aig, int32_t e) {
+  assert(0 <= aig_node(e) && aig_node(e) < aig->nnodes);
+  return aig->right[aig_node(e)] >= 0;
+}
+
+static inline bool aig_is_const(int32_t e) {
+  return aig_node(e) == 0;
+}
+
+static inline uint32_t aig_num_nodes(const aig_table_t *aig) {
+  return aig->nnodes;
+}
+
+
+
+/*********************
+ *  TABLE OPERATIONS  *
+ ********************/
+
+/*
+ * Initialization:
+ * - n = initial size (if n is zero, the default size is used)
+ * - the table contains the constant node
+ */
+extern void init_aig_table(aig_table_t *aig, uint32_t n);
+
+/*
+ * Delete: free memory
+ */
+extern void delete_aig_table(aig_table_t *aig);
+
+/*
+ * Reset: remove all nodes and outputs
+ */
+extern void reset_aig_table(aig_table_t *aig);
+
+/*
+ * Edge that represents literal l
+ * - if l is true_literal or false_literal, this returns the constant edge
+ * - otherwise, an input node is created for var_of(l) if needed
+ */
+extern int32_t aig_input(aig_table_t *aig, literal_t l);
+
+/*
+ * Edge for (and a b)
+ * - a and b must be valid edges
+ * - the result is simplified using the rewrite rules, or is an existing
+ *   node if possible.
+ */
+extern int32_t aig_and(aig_table_t *aig, int32_t a, int32_t b);
+
+/*
+ * Derived gates
+ */
+extern int32_t aig_or(aig_table_t *aig, int32_t a, int32_t b);
+extern int32_t aig_xor(aig_table_t *aig, int32_t a, int32_t b);
+extern int32_t aig_mux(aig_table_t *aig, int32_t c, int32_t a, int32_t b);  // (ite c a b)
+extern int32_t aig_maj3(aig_table_t *aig, int32_t a, int32_t b, int32_t c);
+
+static inline int32_t aig_eq(aig_table_t *aig, int32_t a, int32_t b) {
+  return aig_not(aig_xor(aig, a, b));
+}
+
+static inline int32_t aig_xor3(aig_table_t *aig, int32_t a, int32_t b, int32_t c) {
+  return aig_xor(aig, aig_xor(aig, a, b), c);
+}
+
+/*
+ * (or a[0] ... a[n-1]): return aig_false if n = 0
+ */
+extern int32_t aig_or_array(aig_table_t *aig, uint32_t n, int32_t *a);
+
+
+
+/*****************************
+ *  BIT-VECTOR CONSTRUCTIONS  *
+ ****************************/
+
+/*
+ * All functions below take arrays of n edges as input, with the
+ * least significant bit first. The result is stored in array u
+ * of n edges. For division and shifts, n must be positive.
+ *
+ * The circuits are the same as in the bit_blaster.
+ * Division by zero follows the SMT-LIB conventions:
+ * (bvudiv a 0) = 0b111...1 and (bvurem a 0) = a.
+ */
+extern void aig_make_bvmux(aig_table_t *aig, int32_t c, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvadd(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvsub(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvneg(aig_table_t *aig, int32_t *a, int32_t *u, uint32_t n);
+extern void aig_make_bvmul(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvudiv(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvurem(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvsdiv(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvsrem(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_bvsmod(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_shift_left(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_lshift_right(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+extern void aig_make_ashift_right(aig_table_t *aig, int32_t *a, int32_t *b, int32_t *u, uint32_t n);
+
+/*
+ * Comparators: return an edge
+ * - n may be zero for bveq and bvuge
+ * - n must be positive for bvsge
+ */
+extern int32_t aig_make_bveq(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n);
+extern int32_t aig_make_bvuge(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n);
+extern int32_t aig_make_bvsge(aig_table_t *aig, int32_t *a, int32_t *b, uint32_t n);
+
+
+
+/************************************
+ *  SWEEPING AND CONVERSION TO CNF  *
+ ***********************************/
+
+/*
+ * Register e as an output
+ * - returns the index of e in the output vector
+ * - aig_sweep updates the output vector
+ */
+extern uint32_t aig_add_output(aig_table_t *aig, int32_t e);
+
+/*
+ * Get output of index i
+ */
+static inline int32_t aig_output(const aig_table_t *aig, uint32_t i) {
+  assert(i < aig->outputs.size);
+  return aig->outputs.data[i];
+}
+
+/*
+ * Sweep: rebuild the graph, merging nodes that are proven equivalent.
+ * - the outputs are replaced by the corresponding edges of the new graph
+ * - the statistics are kept
+ */
+extern void aig_sweep(aig_table_t *aig);
+
+/*
+ * Convert the cones of all the outputs to clauses in the blaster's core.
+ * - after this, aig_literal can be used to get the literal of any output
+ */
+extern void aig_convert(aig_table_t *aig, bit_blaster_t *blaster);
+
+/*
+ * Literal for an edge e that's been converted
+ */
+static inline literal_t aig_literal(const aig_table_t *aig, int32_t e) {
+  literal_t l;
+
+  assert(0 <= aig_node(e) && aig_node(e) < aig->nnodes);
+  l = aig->lit[aig_node(e)];
+  assert(l != null_literal);
+  return l ^ aig_sign(e);
+}
+
+
+#endif /* __AIG_TABLE_H */
@@ -2119,6 +2119,21 @@ static literal_t find_mux(bit_blaster_t *s, literal_t c, literal_t a, literal_t
 }
 
 
+/*
+ * (ite c a b): search for the gate first
+ */
+literal_t bit_blaster_make_mux(bit_blaster_t *s, literal_t c, literal_t a, literal_t b) {
+  literal_t l;
+
+  l = find_mux(s, c, a, b);
+  if (l == null_literal) {
+    l = bit_blaster_fresh_literal(s);
+    make_mux(s, c, a, b, l);
+  }
+  return l;
+}
+
+
 /*
  * Search for (s, c) = half_add(a, b): s = sum, c = carry
  * Set s and c to null if the gate is not found
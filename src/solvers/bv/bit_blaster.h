@@ -412,6 +412,12 @@ static inline literal_t bit_blaster_make_and2(bit_blaster_t *blaster, literal_t
 }
 
 
+/*
+ * (ite c a b)
+ */
+extern literal_t bit_blaster_make_mux(bit_blaster_t *blaster, literal_t c, literal_t a, literal_t b);
+
+
 
 
 /***************************
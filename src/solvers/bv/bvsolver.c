@@ -22,6 +22,7 @@
 
 #include <assert.h>
 
+#include "solvers/bv/aig_table.h"
 #include "solvers/bv/bv64_intervals.h"
 #include "solvers/bv/bvsolver.h"
 #include "terms/bv64_constants.h"
@@ -548,6 +549,8 @@ static void init_bv_stats(bv_stats_t *s) {
   s->equiv_conflicts = 0;
   s->half_equiv_lemmas = 0;
   s->interface_lemmas = 0;
+  s->aig_nodes = 0;
+  s->aig_merges = 0;
 }
 
 static inline void reset_bv_stats(bv_stats_t *s) {
@@ -1937,6 +1940,379 @@ static void bv_solver_bitblast_variables(bv_solver_t *solver) {
 
 
 
+/*
+ * AIG STAGING
+ *
+ * If solver->use_aig is true, bv_solver_bitblast builds the circuits
+ * for all variables and atoms in an AIG first. The AIG is then swept
+ * (optionally) and converted to clauses. Variables and atoms created
+ * later on (e.g., on-the-fly atoms) are bitblasted directly.
+ *
+ * The staging data:
+ * - map: maps variable x to the start of its edges in vector edges
+ * - edges: the bits of all staged variables, as AIG edges
+ * - pseudo: pairs (pseudo literal, output index) for the bits of
+ *   variables defined by a circuit
+ * - atoms: pairs (atom literal, output index)
+ */
+typedef struct bv_aig_stage_s {
+  aig_table_t aig;
+  int_hmap_t map;
+  ivector_t edges;
+  ivector_t pseudo;
+  ivector_t atoms;
+} bv_aig_stage_t;
+
+static void init_bv_aig_stage(bv_aig_stage_t *stage) {
+  init_aig_table(&stage->aig, 0);
+  init_int_hmap(&stage->map, 0);
+  init_ivector(&stage->edges, 0);
+  init_ivector(&stage->pseudo, 0);
+  init_ivector(&stage->atoms, 0);
+}
+
+static void delete_bv_aig_stage(bv_aig_stage_t *stage) {
+  delete_aig_table(&stage->aig);
+  delete_int_hmap(&stage->map);
+  delete_ivector(&stage->edges);
+  delete_ivector(&stage->pseudo);
+  delete_ivector(&stage->atoms);
+}
+
+
+/*
+ * Allocate n edges at the end of stage->edges
+ * - return the index of the first one
+ */
+static uint32_t bv_aig_alloc_edges(bv_aig_stage_t *stage, uint32_t n) {
+  uint32_t k;
+
+  k = stage->edges.size;
+  resize_ivector(&stage->edges, k + n);
+  stage->edges.size = k + n;
+  return k;
+}
+
+/*
+ * Leaf: the pseudo map of x gives the literals
+ * - the missing literals are replaced by fresh literals
+ * - return the index of the edges for x
+ */
+static uint32_t bv_aig_stage_leaf(bv_solver_t *solver, bv_aig_stage_t *stage, thvar_t x) {
+  remap_table_t *rmap;
+  literal_t *u;
+  uint32_t i, n, k;
+  literal_t l;
+
+  rmap = solver->remap;
+  u = bvvar_pseudo_map(solver, x);
+  n = bvvar_bitsize(&solver->vtbl, x);
+  k = bv_aig_alloc_edges(stage, n);
+  for (i=0; i<n; i++) {
+    l = remap_table_find(rmap, u[i]);
+    if (l == null_literal) {
+      l = bit_blaster_fresh_literal(solver->blaster);
+      remap_table_assign(rmap, u[i], l);
+    }
+    stage->edges.data[k + i] = aig_input(&stage->aig, l);
+  }
+
+  return k;
+}
+
+/*
+ * Build the AIG for x
+ * - return the index of the edges for x
+ */
+static uint32_t bv_aig_stage_variable(bv_solver_t *solver, bv_aig_stage_t *stage, thvar_t x) {
+  bv_vartable_t *vtbl;
+  aig_table_t *aig;
+  int_hmap_pair_t *r;
+  int32_t *a, *b, *e;
+  bv_ite_t *ite;
+  literal_t *u;
+  uint32_t i, n, j, k, ka, kb;
+  int32_t c;
+  bvvar_tag_t op;
+  thvar_t y, z;
+
+  vtbl = &solver->vtbl;
+  aig = &stage->aig;
+
+  r = int_hmap_find(&stage->map, x);
+  if (r != NULL) {
+    return r->val;
+  }
+
+  if (bvvar_is_bitblasted(vtbl, x) || bvvar_is_marked(vtbl, x)) {
+    /*
+     * Either x is bitblasted already or there's a cycle:
+     * in both cases, x is treated as a leaf.
+     */
+    k = bv_aig_stage_leaf(solver, stage, x);
+    if (bvvar_is_bitblasted(vtbl, x)) {
+      r = int_hmap_get(&stage->map, x);
+      r->val = k;
+      return k;
+    }
+    goto done;
+  }
+
+  u = bvvar_pseudo_map(solver, x);
+  n = bvvar_bitsize(vtbl, x);
+  op = bvvar_tag(vtbl, x);
+
+  bvvar_set_mark(vtbl, x);
+
+  switch (op) {
+  case BVTAG_VAR:
+  case BVTAG_CONST64:
+  case BVTAG_CONST:
+  case BVTAG_BIT_ARRAY:
+    k = bv_aig_stage_leaf(solver, stage, x);
+    break;
+
+  case BVTAG_POLY64:
+  case BVTAG_POLY:
+  case BVTAG_PPROD:
+    // x and y share the same pseudo map
+    y = bvvar_compiles_to(solver->compiler, x);
+    assert(y != null_thvar);
+    k = bv_aig_stage_variable(solver, stage, y);
+    break;
+
+  case BVTAG_ITE:
+    ite = bvvar_ite_def(vtbl, x);
+    c = aig_input(aig, ite->cond);
+    ka = bv_aig_stage_variable(solver, stage, ite->left);
+    kb = bv_aig_stage_variable(solver, stage, ite->right);
+    k = bv_aig_alloc_edges(stage, n);
+    e = stage->edges.data;
+    aig_make_bvmux(aig, c, e + ka, e + kb, e + k, n);
+    goto outputs;
+
+  case BVTAG_NEG:
+    y = vtbl->def[x].op[0];
+    ka = bv_aig_stage_variable(solver, stage, y);
+    k = bv_aig_alloc_edges(stage, n);
+    e = stage->edges.data;
+    aig_make_bvneg(aig, e + ka, e + k, n);
+    goto outputs;
+
+  default:
+    y = vtbl->def[x].op[0];
+    z = vtbl->def[x].op[1];
+    ka = bv_aig_stage_variable(solver, stage, y);
+    kb = bv_aig_stage_variable(solver, stage, z);
+    k = bv_aig_alloc_edges(stage, n);
+    e = stage->edges.data;
+    a = e + ka;
+    b = e + kb;
+    e += k;
+    switch (op) {
+    case BVTAG_UDIV:
+      aig_make_bvudiv(aig, a, b, e, n);
+      break;
+
+    case BVTAG_UREM:
+      aig_make_bvurem(aig, a, b, e, n);
+      break;
+
+    case BVTAG_SDIV:
+      aig_make_bvsdiv(aig, a, b, e, n);
+      break;
+
+    case BVTAG_SREM:
+      aig_make_bvsrem(aig, a, b, e, n);
+      break;
+
+    case BVTAG_SMOD:
+      aig_make_bvsmod(aig, a, b, e, n);
+      break;
+
+    case BVTAG_SHL:
+      aig_make_shift_left(aig, a, b, e, n);
+      break;
+
+    case BVTAG_LSHR:
+      aig_make_lshift_right(aig, a, b, e, n);
+      break;
+
+    case BVTAG_ASHR:
+      aig_make_ashift_right(aig, a, b, e, n);
+      break;
+
+    case BVTAG_ADD:
+      aig_make_bvadd(aig, a, b, e, n);
+      break;
+
+    case BVTAG_SUB:
+      aig_make_bvsub(aig, a, b, e, n);
+      break;
+
+    case BVTAG_MUL:
+      aig_make_bvmul(aig, a, b, e, n);
+      break;
+
+    default:
+      assert(false);
+      abort();
+    }
+    goto outputs;
+  }
+
+  goto store;
+
+ outputs:
+  /*
+   * Bits of x to connect to the pseudo literals after conversion
+   */
+  for (i=0; i<n; i++) {
+    j = aig_add_output(aig, stage->edges.data[k + i]);
+    ivector_push(&stage->pseudo, u[i]);
+    ivector_push(&stage->pseudo, j);
+  }
+
+ store:
+  r = int_hmap_get(&stage->map, x);
+  r->val = k;
+
+ done:
+  // same as in bv_solver_bitblast_variable
+  if (! bvvar_is_bitblasted(vtbl, x)) {
+    bvvar_set_bitblasted(vtbl, x);
+    bvvar_clr_mark(vtbl, x);
+    bv_solver_save_delayed_blasted_var(solver, x);
+  }
+
+  return k;
+}
+
+
+/*
+ * Stage all atoms: same as bv_solver_bitblast_atoms
+ */
+static void bv_aig_stage_atoms(bv_solver_t *solver, bv_aig_stage_t *stage) {
+  bv_atomtable_t *atbl;
+  aig_table_t *aig;
+  uint32_t i, n, m, ka, kb;
+  int32_t *a, *b;
+  int32_t e;
+  thvar_t x, y;
+
+  atbl = &solver->atbl;
+  aig = &stage->aig;
+  n = atbl->natoms;
+
+  for (i=solver->bbptr; i<n; i++) {
+    x = atbl->data[i].left;
+    y = atbl->data[i].right;
+    ka = bv_aig_stage_variable(solver, stage, x);
+    kb = bv_aig_stage_variable(solver, stage, y);
+    a = stage->edges.data + ka;
+    b = stage->edges.data + kb;
+    m = bvvar_bitsize(&solver->vtbl, x);
+    assert(m == bvvar_bitsize(&solver->vtbl, y) && m > 0);
+
+    switch (bvatm_tag(atbl->data + i)) {
+    case BVEQ_ATM:
+      e = aig_make_bveq(aig, a, b, m);
+      break;
+
+    case BVUGE_ATM:
+      e = aig_make_bvuge(aig, a, b, m);
+      break;
+
+    case BVSGE_ATM:
+    default:
+      e = aig_make_bvsge(aig, a, b, m);
+      break;
+    }
+
+    ivector_push(&stage->atoms, atbl->data[i].lit);
+    ivector_push(&stage->atoms, aig_add_output(aig, e));
+  }
+
+  solver->bbptr = n;
+}
+
+/*
+ * Stage all variables: same as bv_solver_bitblast_variables
+ */
+static void bv_aig_stage_variables(bv_solver_t *solver, bv_aig_stage_t *stage) {
+  bv_vartable_t *vtbl;
+  bv_queue_t *squeue;
+  uint32_t i, n;
+  thvar_t x;
+
+  vtbl = &solver->vtbl;
+  n = vtbl->nvars;
+  for (i=1; i<n; i++) {
+    x = mtbl_get_root(&solver->mtbl, i);
+    if (x != i) {
+      (void) bv_aig_stage_variable(solver, stage, x);
+      (void) bv_aig_stage_variable(solver, stage, i);
+    } else if (bvvar_has_eterm(vtbl, i)) {
+      (void) bv_aig_stage_variable(solver, stage, i);
+    }
+  }
+
+  squeue = &solver->select_queue;
+  n = squeue->top;
+  for (i=0; i<n; i++) {
+    (void) bv_aig_stage_variable(solver, stage, squeue->data[i]);
+  }
+}
+
+/*
+ * Bitblast all atoms and variables via the AIG
+ */
+static void bv_solver_aig_bitblast(bv_solver_t *solver) {
+  bv_aig_stage_t stage;
+  remap_table_t *rmap;
+  ivector_t *v;
+  uint32_t i, n;
+  literal_t s, l, f;
+
+  init_bv_aig_stage(&stage);
+  bv_aig_stage_atoms(solver, &stage);
+  bv_aig_stage_variables(solver, &stage);
+
+  if (solver->aig_sweep) {
+    aig_sweep(&stage.aig);
+  }
+  aig_convert(&stage.aig, solver->blaster);
+
+  solver->stats.aig_nodes += aig_num_nodes(&stage.aig);
+  solver->stats.aig_merges += stage.aig.stats.num_merges;
+
+  // connect the pseudo literals: same as assert_pseudo_eq in the blaster
+  rmap = solver->remap;
+  v = &stage.pseudo;
+  n = v->size;
+  for (i=0; i<n; i += 2) {
+    s = v->data[i];
+    l = aig_literal(&stage.aig, aig_output(&stage.aig, v->data[i+1]));
+    f = remap_table_find(rmap, s);
+    if (f == null_literal) {
+      remap_table_assign(rmap, s, l);
+    } else {
+      bit_blaster_eq(solver->blaster, f, l);
+    }
+  }
+
+  // atoms
+  v = &stage.atoms;
+  n = v->size;
+  for (i=0; i<n; i += 2) {
+    l = aig_literal(&stage.aig, aig_output(&stage.aig, v->data[i+1]));
+    bit_blaster_eq(solver->blaster, v->data[i], l);
+  }
+
+  delete_bv_aig_stage(&stage);
+}
+
+
 /*
  * Top-level bit-blasting: exported for testing
  */
@@ -1960,8 +2336,12 @@ bool bv_solver_bitblast(bv_solver_t *solver) {
   bv_solver_dump_state(solver, "after-shared-pmaps.dmp");
 #endif
 
-  bv_solver_bitblast_atoms(solver);
-  bv_solver_bitblast_variables(solver);
+  if (solver->use_aig) {
+    bv_solver_aig_bitblast(solver);
+  } else {
+    bv_solver_bitblast_atoms(solver);
+    bv_solver_bitblast_variables(solver);
+  }
 
 #if DUMP
   bv_solver_dump_state(solver, "before-lemmas.dmp");
@@ -7246,6 +7626,9 @@ void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egraph) {
   solver->blaster = NULL;
   solver->remap = NULL;
 
+  solver->use_aig = false;
+  solver->aig_sweep = false;
+
   init_eassertion_queue(&solver->egraph_queue);
   solver->cache = NULL;
 
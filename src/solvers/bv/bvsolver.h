@@ -200,6 +200,21 @@ extern thvar_t bv_solver_var_compiles_to(bv_solver_t *solver, thvar_t x);
 
 
 
+/*
+ * Bit-blasting options:
+ * - aig true: build the circuits in an and-inverter graph before
+ *   converting them to clauses
+ * - sweep true: merge equivalent AIG nodes before the conversion
+ *   (this has no effect if aig is false)
+ * Both are false by default.
+ */
+static inline void bv_solver_set_aig(bv_solver_t *solver, bool aig, bool sweep) {
+  solver->use_aig = aig;
+  solver->aig_sweep = sweep;
+}
+
+
+
 /****************
  *  STATISTICS  *
  ***************/
@@ -268,6 +283,17 @@ static inline uint32_t bv_solver_interface_lemmas(bv_solver_t *solver) {
   return solver->stats.interface_lemmas;
 }
 
+/*
+ * Bit-blasting statistics: zero unless the AIG is used
+ */
+static inline uint32_t bv_solver_aig_nodes(bv_solver_t *solver) {
+  return solver->stats.aig_nodes;
+}
+
+static inline uint32_t bv_solver_aig_merges(bv_solver_t *solver) {
+  return solver->stats.aig_merges;
+}
+
 
 
 /************************
@@ -272,6 +272,8 @@ typedef struct bv_stats_s {
   uint32_t equiv_conflicts;
   uint32_t half_equiv_lemmas;
   uint32_t interface_lemmas;
+  uint32_t aig_nodes;
+  uint32_t aig_merges;
 } bv_stats_t;
 
 
@@ -300,6 +302,15 @@ typedef struct bv_solver_s {
   bool bitblasted;
   uint32_t bbptr;
 
+  /*
+   * Options for bit-blasting:
+   * - use_aig: build the circuits in an and-inverter graph before
+   *   converting them to clauses
+   * - aig_sweep: merge equivalent AIG nodes before conversion
+   */
+  bool use_aig;
+  bool aig_sweep;
+
   /*
    * Variable + atom tables
    */
@@ -127,13 +127,13 @@ static void dimacs_print_binary_clauses(FILE *f, smt_core_t *core) {
 }
 
 
-static void dimacs_print_clause_vector(FILE *f, clause_t **vector) {
+static void dimacs_print_clause_vector(FILE *f, smt_core_t *core, cidx_t *vector) {
   uint32_t i, n;
 
   if (vector != NULL) {
     n = get_cv_size(vector);
     for (i=0; i<n; i++) {
-      dimacs_print_clause(f, vector[i]);
+      dimacs_print_clause(f, clause_of_idx(core, vector[i]));
     }
   }
 }
@@ -146,13 +146,13 @@ static void dimacs_print_problem_clauses(FILE *f, smt_core_t *core) {
   dimacs_print_unit_clause(f, true_literal);
   dimacs_print_unit_clauses(f, core);
   dimacs_print_binary_clauses(f, core);
-  dimacs_print_clause_vector(f, core->problem_clauses);
+  dimacs_print_clause_vector(f, core, core->problem_clauses);
 }
 
 // all the clauses (including the learned caluses)
 static void dimacs_print_all_clauses(FILE *f, smt_core_t *core) {
   dimacs_print_problem_clauses(f, core);
-  dimacs_print_clause_vector(f, core->learned_clauses);
+  dimacs_print_clause_vector(f, core, core->learned_clauses);
 }
 
 
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * LOCK-FREE CLAUSE EXCHANGE
+ */
+
+#include <assert.h>
+
+#include "solvers/cdcl/clause_exchange.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize for n workers
+ */
+void init_clause_exchange(clause_exchange_t *ex, uint32_t n) {
+  uint32_t i;
+
+  assert(0 < n && n <= MAX_EXCHANGE_WORKERS);
+
+  ex->nworkers = n;
+  ex->winner = -1;
+  ex->buffer = (exchange_buffer_t *) safe_malloc(n * sizeof(exchange_buffer_t));
+  ex->cursor = (uint32_t *) safe_malloc(n * n * sizeof(uint32_t));
+  for (i=0; i<n; i++) {
+    ex->buffer[i].head = 0;
+  }
+  for (i=0; i<n * n; i++) {
+    ex->cursor[i] = 0;
+  }
+}
+
+
+/*
+ * Delete
+ */
+void delete_clause_exchange(clause_exchange_t *ex) {
+  safe_free(ex->buffer);
+  safe_free(ex->cursor);
+  ex->buffer = NULL;
+  ex->cursor = NULL;
+}
+
+
+/*
+ * Publish a[0 ... n-1] in worker i's buffer
+ * - the slot is written first then head is incremented (release)
+ *   so a reader that sees the new head also sees the slot content.
+ */
+void clause_exchange_publish(clause_exchange_t *ex, uint32_t i, uint32_t n, const literal_t *a) {
+  exchange_buffer_t *b;
+  exchange_clause_t *c;
+  uint32_t h, k;
+
+  assert(i < ex->nworkers && 0 < n && n <= EXCHANGE_MAX_CLAUSE_SIZE);
+
+  b = ex->buffer + i;
+  h = b->head; // only worker i writes head
+  c = b->slot + (h & (EXCHANGE_BUFFER_SIZE - 1));
+  c->size = n;
+  for (k=0; k<n; k++) {
+    c->lit[k] = a[k];
+  }
+  __atomic_store_n(&b->head, h + 1, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * Check whether worker i has clauses to import
+ */
+bool clause_exchange_has_pending(clause_exchange_t *ex, uint32_t i) {
+  uint32_t j, n;
+  uint32_t *cursor;
+
+  assert(i < ex->nworkers);
+
+  n = ex->nworkers;
+  cursor = ex->cursor + i * n;
+  for (j=0; j<n; j++) {
+    if (j != i && __atomic_load_n(&ex->buffer[j].head, __ATOMIC_ACQUIRE) != cursor[j]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/*
+ * Try to read clause k from buffer b
+ * - return false if slot k has been overwritten or is being overwritten.
+ * - slot k is overwritten when the producer writes clause k + EXCHANGE_BUFFER_SIZE,
+ *   which starts when head = k + EXCHANGE_BUFFER_SIZE.
+ */
+static bool read_slot(exchange_buffer_t *b, uint32_t k, exchange_clause_t *c) {
+  const exchange_clause_t *s;
+  uint32_t i, n, h;
+
+  s = b->slot + (k & (EXCHANGE_BUFFER_SIZE - 1));
+  n = s->size;
+  if (n == 0 || n > EXCHANGE_MAX_CLAUSE_SIZE) {
+    return false;
+  }
+  c->size = n;
+  for (i=0; i<n; i++) {
+    c->lit[i] = s->lit[i];
+  }
+
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  h = __atomic_load_n(&b->head, __ATOMIC_ACQUIRE);
+
+  return h - k < EXCHANGE_BUFFER_SIZE;
+}
+
+
+/*
+ * Get the next clause for worker i
+ */
+bool clause_exchange_next(clause_exchange_t *ex, uint32_t i, exchange_clause_t *c) {
+  exchange_buffer_t *b;
+  uint32_t j, n, h, k;
+  uint32_t *cursor;
+
+  assert(i < ex->nworkers);
+
+  n = ex->nworkers;
+  cursor = ex->cursor + i * n;
+  for (j=0; j<n; j++) {
+    if (j == i) continue;
+
+    b = ex->buffer + j;
+    h = __atomic_load_n(&b->head, __ATOMIC_ACQUIRE);
+    k = cursor[j];
+    if (h - k > EXCHANGE_BUFFER_SIZE) {
+      // we're too far behind: skip the clauses that have been overwritten
+      k = h - EXCHANGE_BUFFER_SIZE;
+    }
+    while (k != h) {
+      if (read_slot(b, k, c)) {
+        cursor[j] = k + 1;
+        return true;
+      }
+      k ++;
+    }
+    cursor[j] = k;
+  }
+
+  return false;
+}
+
+
+/*
+ * Record that worker i is done
+ */
+bool clause_exchange_set_winner(clause_exchange_t *ex, uint32_t i) {
+  int32_t none;
+
+  assert(i < ex->nworkers);
+
+  none = -1;
+  return __atomic_compare_exchange_n(&ex->winner, &none, (int32_t) i, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CLAUSE EXCHANGE BETWEEN SAT SOLVERS RUNNING IN PARALLEL
+ *
+ * Several instances of the new sat solver can work on the same
+ * problem in different threads (portfolio). Each worker publishes
+ * short learned clauses and periodically imports the clauses
+ * published by the other workers.
+ *
+ * The exchange does not use locks:
+ * - each worker i owns a ring buffer of fixed-size slots. Only
+ *   worker i writes into this buffer.
+ * - head[i] = number of clauses published by worker i so far.
+ *   It is updated with release semantics after the slot is written.
+ * - each worker j keeps a cursor for every peer i: the number of
+ *   clauses of i that j has read. Only worker j uses this cursor.
+ * - if the producer overwrites a slot before the reader copies it,
+ *   the reader detects it (by reading head[i] again) and skips the
+ *   slot. So clauses may be lost but not corrupted.
+ *
+ * The exchange also stores a 'winner' flag: the first worker to
+ * finish sets it and all other workers stop at their next conflict.
+ *
+ * All clauses in the exchange must be implied by the original problem.
+ * The literals are in the sat solver's encoding (cf. smt_core_base_types.h).
+ */
+
+#ifndef __CLAUSE_EXCHANGE_H
+#define __CLAUSE_EXCHANGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/cdcl/smt_core_base_types.h"
+
+
+/*
+ * Clauses of size larger than EXCHANGE_MAX_CLAUSE_SIZE are never shared.
+ * EXCHANGE_BUFFER_SIZE = number of slots per worker (must be a power of 2)
+ */
+#define EXCHANGE_MAX_CLAUSE_SIZE 8
+#define EXCHANGE_BUFFER_SIZE 4096
+
+typedef struct exchange_clause_s {
+  uint32_t size;
+  literal_t lit[EXCHANGE_MAX_CLAUSE_SIZE];
+} exchange_clause_t;
+
+typedef struct exchange_buffer_s {
+  uint32_t head;
+  exchange_clause_t slot[EXCHANGE_BUFFER_SIZE];
+} exchange_buffer_t;
+
+typedef struct clause_exchange_s {
+  uint32_t nworkers;
+  int32_t winner;               // -1 until a worker finishes
+  exchange_buffer_t *buffer;    // buffer[i] = clauses published by worker i
+  uint32_t *cursor;             // cursor[j * nworkers + i] = clauses of i read by j
+} clause_exchange_t;
+
+#define MAX_EXCHANGE_WORKERS (UINT32_MAX/sizeof(exchange_buffer_t))
+
+
+/*
+ * Initialize for n workers (n must be positive)
+ */
+extern void init_clause_exchange(clause_exchange_t *ex, uint32_t n);
+
+/*
+ * Delete: free memory
+ */
+extern void delete_clause_exchange(clause_exchange_t *ex);
+
+/*
+ * Publish clause a[0 ... n-1] from worker i
+ * - n must be positive and no more than EXCHANGE_MAX_CLAUSE_SIZE
+ * - this must be called only from worker i's thread
+ */
+extern void clause_exchange_publish(clause_exchange_t *ex, uint32_t i, uint32_t n, const literal_t *a);
+
+/*
+ * Check whether worker i has clauses to import
+ */
+extern bool clause_exchange_has_pending(clause_exchange_t *ex, uint32_t i);
+
+/*
+ * Get the next clause published by a peer of worker i
+ * - copy the clause into *c and return true
+ * - return false if there's nothing to import
+ * - this must be called only from worker i's thread
+ */
+extern bool clause_exchange_next(clause_exchange_t *ex, uint32_t i, exchange_clause_t *c);
+
+/*
+ * Record that worker i is done:
+ * - return true if i is the first worker to finish (i.e., i is the winner)
+ */
+extern bool clause_exchange_set_winner(clause_exchange_t *ex, uint32_t i);
+
+/*
+ * Check whether some worker has finished
+ */
+static inline bool clause_exchange_done(clause_exchange_t *ex) {
+  return __atomic_load_n(&ex->winner, __ATOMIC_RELAXED) >= 0;
+}
+
+
+#endif /* __CLAUSE_EXCHANGE_H */
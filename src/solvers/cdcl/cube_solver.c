@@ -0,0 +1,317 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CUBE-AND-CONQUER
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "solvers/cdcl/cube_solver.h"
+#include "utils/memalloc.h"
+
+#ifdef THREAD_SAFE
+#include "mt/threads.h"
+#include "mt/yices_locks.h"
+#endif
+
+
+/*
+ * Initialize
+ */
+void init_cube_solver(cube_solver_t *cs, sat_solver_t *source, bool pp) {
+  cs->source = source;
+  init_ivector(&cs->cubes, 0);
+  cs->model = NULL;
+  cs->status = STAT_UNKNOWN;
+  cs->preprocess = pp;
+  cs->verbosity = 0;
+  cs->num_cubes = 0;
+  cs->solved_cubes = 0;
+}
+
+
+/*
+ * Delete
+ */
+void delete_cube_solver(cube_solver_t *cs) {
+  delete_ivector(&cs->cubes);
+  if (cs->model != NULL) {
+    delete_nsat_solver(cs->model);
+    safe_free(cs->model);
+    cs->model = NULL;
+  }
+}
+
+
+/*
+ * Default depth: smallest d such that 2^d >= 8 * nthreads
+ */
+uint32_t cube_solver_default_depth(uint32_t nthreads) {
+  uint32_t d;
+
+  assert(0 < nthreads && nthreads <= MAX_CUBE_THREADS);
+
+  d = 3;
+  while ((((uint32_t) 1) << d) < 8 * nthreads) {
+    d ++;
+  }
+  return d;
+}
+
+
+
+/*
+ * WORKERS
+ */
+
+typedef struct cube_pool_s cube_pool_t;
+
+/*
+ * Each worker solves one cube at a time
+ * - solver = the solver for the current cube (NULL if the worker is
+ *   not searching)
+ */
+typedef struct cube_worker_s {
+  cube_pool_t *pool;
+  sat_solver_t *solver;
+} cube_worker_t;
+
+/*
+ * Shared state:
+ * - lock protects all the fields (and the worker's solver pointers)
+ * - next = index of the next cube to solve in cs->cubes
+ * - done = true once a model has been found
+ */
+struct cube_pool_s {
+#ifdef THREAD_SAFE
+  yices_lock_t lock;
+#endif
+  cube_solver_t *cs;
+  uint32_t next;
+  bool done;
+  uint32_t nworkers;
+  cube_worker_t *worker;
+};
+
+
+#ifdef THREAD_SAFE
+static inline void cube_pool_lock(cube_pool_t *p) {
+  get_yices_lock(&p->lock);
+}
+
+static inline void cube_pool_unlock(cube_pool_t *p) {
+  release_yices_lock(&p->lock);
+}
+#else
+static inline void cube_pool_lock(cube_pool_t *p) {
+}
+
+static inline void cube_pool_unlock(cube_pool_t *p) {
+}
+#endif
+
+
+/*
+ * Construct a solver for the cube a[0 ... n-1]: copy of the source + unit clauses
+ */
+static sat_solver_t *cube_problem(cube_solver_t *cs, uint32_t n, const int32_t *a) {
+  sat_solver_t *s;
+  uint32_t i;
+  literal_t l;
+
+  s = (sat_solver_t *) safe_malloc(sizeof(sat_solver_t));
+  nsat_copy_problem(s, cs->source, cs->preprocess);
+  for (i=0; i<n; i++) {
+    l = a[i];
+    nsat_solver_simplify_and_add_clause(s, 1, &l);
+  }
+  return s;
+}
+
+static void delete_cube_problem(sat_solver_t *s) {
+  delete_nsat_solver(s);
+  safe_free(s);
+}
+
+
+/*
+ * Solve cubes until all cubes are solved or a model is found.
+ * The first worker to find a model stops all the others.
+ */
+static void cube_worker_run(cube_worker_t *w) {
+  cube_pool_t *p;
+  cube_solver_t *cs;
+  sat_solver_t *s;
+  solver_status_t stat;
+  uint32_t i, k, n;
+  bool stop;
+
+  p = w->pool;
+  cs = p->cs;
+
+  for (;;) {
+    // get the next cube
+    cube_pool_lock(p);
+    stop = p->done || p->next >= cs->cubes.size;
+    k = p->next;
+    if (! stop) {
+      p->next += cs->cubes.data[k] + 1;
+    }
+    cube_pool_unlock(p);
+    if (stop) break;
+
+    n = cs->cubes.data[k];
+    s = cube_problem(cs, n, cs->cubes.data + k + 1);
+
+    cube_pool_lock(p);
+    stop = p->done;
+    if (! stop) {
+      w->solver = s;
+    }
+    cube_pool_unlock(p);
+
+    stat = stop ? STAT_UNKNOWN : nsat_solve(s);
+
+    cube_pool_lock(p);
+    w->solver = NULL;
+    if (stat != STAT_UNKNOWN) {
+      cs->solved_cubes ++;
+    }
+    if (stat == STAT_SAT && !p->done) {
+      p->done = true;
+      cs->model = s;
+      s = NULL;
+      for (i=0; i<p->nworkers; i++) {
+	if (p->worker[i].solver != NULL) {
+	  nsat_stop_search(p->worker[i].solver);
+	}
+      }
+    }
+    cube_pool_unlock(p);
+
+    if (s != NULL) {
+      delete_cube_problem(s);
+    }
+  }
+}
+
+
+#ifdef THREAD_SAFE
+
+static yices_thread_result_t YICES_THREAD_ATTR cube_worker_main(void *arg) {
+  cube_worker_run(arg);
+  return yices_thread_exit();
+}
+
+/*
+ * Run the workers in parallel
+ * - if a thread can't be created, we continue with the workers already
+ *   started (or run worker 0 in this thread if none started)
+ */
+static void cube_pool_run(cube_pool_t *p) {
+  yices_thread_t *tids;
+  uint32_t i, started;
+
+  tids = (yices_thread_t *) safe_malloc(p->nworkers * sizeof(yices_thread_t));
+  started = 0;
+  while (started < p->nworkers) {
+    if (start_yices_thread(tids + started, cube_worker_main, p->worker + started) < 0) break;
+    started ++;
+  }
+  if (started == 0) {
+    cube_worker_run(p->worker);
+  }
+  for (i=0; i<started; i++) {
+    join_yices_thread(tids + i);
+  }
+  safe_free(tids);
+}
+
+#else
+
+/*
+ * Sequential version
+ */
+static void cube_pool_run(cube_pool_t *p) {
+  cube_worker_run(p->worker);
+}
+
+#endif
+
+
+/*
+ * Main function
+ */
+solver_status_t cube_solver_solve(cube_solver_t *cs, uint32_t depth, uint32_t nthreads) {
+  cube_pool_t pool;
+  uint32_t i;
+
+  assert(depth <= MAX_CUBE_DEPTH && 0 < nthreads && nthreads <= MAX_CUBE_THREADS);
+  assert(cs->model == NULL);
+
+  cs->status = nsat_generate_cubes(cs->source, depth, &cs->cubes);
+  if (cs->status == STAT_UNSAT) goto done;
+
+  cs->num_cubes = 0;
+  for (i=0; i<cs->cubes.size; i += cs->cubes.data[i] + 1) {
+    cs->num_cubes ++;
+  }
+  if (nthreads > cs->num_cubes) {
+    nthreads = cs->num_cubes;
+  }
+
+#ifdef THREAD_SAFE
+  create_yices_lock(&pool.lock);
+#endif
+  pool.cs = cs;
+  pool.next = 0;
+  pool.done = false;
+  pool.nworkers = nthreads;
+  pool.worker = (cube_worker_t *) safe_malloc(nthreads * sizeof(cube_worker_t));
+  for (i=0; i<nthreads; i++) {
+    pool.worker[i].pool = &pool;
+    pool.worker[i].solver = NULL;
+  }
+
+  cube_pool_run(&pool);
+
+  safe_free(pool.worker);
+#ifdef THREAD_SAFE
+  destroy_yices_lock(&pool.lock);
+#endif
+
+  if (pool.done) {
+    cs->status = STAT_SAT;
+  } else {
+    // all cubes are unsat
+    assert(cs->solved_cubes == cs->num_cubes);
+    nsat_solver_simplify_and_add_clause(cs->source, 0, NULL);
+    cs->status = STAT_UNSAT;
+  }
+
+  if (cs->verbosity >= 1) {
+    fprintf(stderr, "c cube-and-conquer: %"PRIu32" cubes, %"PRIu32" solved, %"PRIu32" threads\n",
+	    cs->num_cubes, cs->solved_cubes, nthreads);
+  }
+
+ done:
+  return cs->status;
+}
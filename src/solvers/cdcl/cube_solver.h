@@ -0,0 +1,108 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CUBE-AND-CONQUER USING THE NEW SAT SOLVER
+ *
+ * The problem is given as a sat solver (the source) that contains
+ * the problem clauses. We split the problem into cubes by lookahead
+ * on the source (cf. nsat_generate_cubes), then we solve the cubes
+ * with a pool of threads:
+ * - each thread takes the next unsolved cube c, makes a copy of the
+ *   source, adds the literals of c as unit clauses, and calls nsat_solve.
+ * - the first cube found satisfiable stops all the other threads.
+ * - the problem is unsat if all the cubes are unsat.
+ *
+ * Threads are used only if Yices is compiled in THREAD_SAFE mode.
+ * Otherwise, the cubes are solved one after the other.
+ */
+
+#ifndef __CUBE_SOLVER_H
+#define __CUBE_SOLVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/cdcl/new_sat_solver.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Maximal number of threads and maximal split depth
+ */
+#define MAX_CUBE_THREADS 64
+#define MAX_CUBE_DEPTH 20
+
+/*
+ * Cube solver:
+ * - source = the problem (must be constructed without preprocessing)
+ * - cubes = cubes produced by nsat_generate_cubes
+ * - model = a copy of source that contains a model if the problem is sat
+ *   (NULL otherwise)
+ * - preprocess = whether to use preprocessing when solving each cube
+ * - verbosity = verbosity level (0 means quiet)
+ * - statistics: number of cubes and number of cubes solved
+ */
+typedef struct cube_solver_s {
+  sat_solver_t *source;
+  ivector_t cubes;
+  sat_solver_t *model;
+  solver_status_t status;
+  bool preprocess;
+  uint32_t verbosity;
+  uint32_t num_cubes;
+  uint32_t solved_cubes;
+} cube_solver_t;
+
+
+/*
+ * Initialize for the given source
+ * - pp = preprocessing flag for each cube
+ */
+extern void init_cube_solver(cube_solver_t *cs, sat_solver_t *source, bool pp);
+
+/*
+ * Delete: free memory (the source is not deleted)
+ */
+extern void delete_cube_solver(cube_solver_t *cs);
+
+/*
+ * Set the verbosity level
+ */
+static inline void cube_solver_set_verbosity(cube_solver_t *cs, uint32_t level) {
+  cs->verbosity = level;
+}
+
+/*
+ * Check satisfiability
+ * - depth = maximal number of branching literals per cube (at most MAX_CUBE_DEPTH)
+ * - nthreads = number of threads (between 1 and MAX_CUBE_THREADS)
+ *
+ * The result is either STAT_SAT or STAT_UNSAT.
+ * - if it's STAT_SAT, cs->model is a solver that contains a model
+ * - if it's STAT_UNSAT, the empty clause is added to the source
+ */
+extern solver_status_t cube_solver_solve(cube_solver_t *cs, uint32_t depth, uint32_t nthreads);
+
+/*
+ * Default depth for nthreads: about 8 cubes per thread
+ */
+extern uint32_t cube_solver_default_depth(uint32_t nthreads);
+
+
+#endif /* __CUBE_SOLVER_H */
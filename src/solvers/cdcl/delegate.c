@@ -32,10 +32,15 @@
 #include "kissat.h"
 #endif
 
+#include "solvers/cdcl/cube_solver.h"
 #include "solvers/cdcl/delegate.h"
 #include "solvers/cdcl/new_sat_solver.h"
 #include "utils/memalloc.h"
 
+#ifdef THREAD_SAFE
+#include "mt/threads.h"
+#endif
+
 
 
 /*
@@ -164,6 +169,93 @@ static void ysat_as_delegate(delegate_t *d, uint32_t nvars) {
 }
 
 
+/*
+ * CUBE-AND-CONQUER USING THE YICES SAT SOLVER
+ * - the problem is stored in solver (built without preprocessing)
+ * - the cubes are solved with preprocessing, using one thread per processor
+ * - solver is the first field so that the ysat_add_... functions can be used
+ */
+typedef struct ysat_cubes_s {
+  sat_solver_t solver;
+  cube_solver_t cubes;
+  uint32_t nthreads;
+} ysat_cubes_t;
+
+static smt_status_t ysat_cubes_check(void *solver) {
+  ysat_cubes_t *yc;
+
+  yc = solver;
+  switch (cube_solver_solve(&yc->cubes, cube_solver_default_depth(yc->nthreads), yc->nthreads)) {
+  case STAT_SAT: return STATUS_SAT;
+  case STAT_UNSAT: return STATUS_UNSAT;
+  default: return STATUS_UNKNOWN;
+  }
+}
+
+static bval_t ysat_cubes_get_value(void *solver, bvar_t x) {
+  ysat_cubes_t *yc;
+
+  yc = solver;
+  return yc->cubes.model != NULL ? var_value(yc->cubes.model, x) : var_value(&yc->solver, x);
+}
+
+static void ysat_cubes_set_verbosity(void *solver, uint32_t level) {
+  ysat_cubes_t *yc;
+
+  yc = solver;
+  nsat_set_verbosity(&yc->solver, level);
+  cube_solver_set_verbosity(&yc->cubes, level);
+}
+
+static void ysat_cubes_delete(void *solver) {
+  ysat_cubes_t *yc;
+
+  yc = solver;
+  delete_cube_solver(&yc->cubes);
+  delete_nsat_solver(&yc->solver);
+  safe_free(yc);
+}
+
+static void ysat_cubes_as_delegate(delegate_t *d, uint32_t nvars) {
+  ysat_cubes_t *yc;
+
+  yc = (ysat_cubes_t *) safe_malloc(sizeof(ysat_cubes_t));
+  init_nsat_solver(&yc->solver, nvars, false); // no preprocessing: required for lookahead
+  nsat_set_randomness(&yc->solver, 0.01);
+  nsat_set_reduce_fraction(&yc->solver, 12);
+  nsat_set_res_clause_limit(&yc->solver, 300);
+  nsat_set_res_extra(&yc->solver, 20);
+  nsat_set_simplify_subst_delta(&yc->solver, 30);
+  nsat_solver_add_vars(&yc->solver, nvars);
+  init_cube_solver(&yc->cubes, &yc->solver, true);
+#ifdef THREAD_SAFE
+  yc->nthreads = yices_num_processors();
+  if (yc->nthreads > MAX_CUBE_THREADS) {
+    yc->nthreads = MAX_CUBE_THREADS;
+  }
+#else
+  yc->nthreads = 1;
+#endif
+
+  d->solver = yc;
+  init_ivector(&d->buffer, 0);
+  d->add_empty_clause = ysat_add_empty_clause;
+  d->add_unit_clause = ysat_add_unit_clause;
+  d->add_binary_clause = ysat_add_binary_clause;
+  d->add_ternary_clause = ysat_add_ternary_clause;
+  d->add_clause = ysat_add_clause;
+  d->check = ysat_cubes_check;
+  d->get_value = ysat_cubes_get_value;
+  d->set_verbosity = ysat_cubes_set_verbosity;
+  d->delete = ysat_cubes_delete;
+  d->keep_var = NULL;
+  d->var_def2 = NULL;
+  d->var_def3 = NULL;
+  d->preprocess = NULL;
+  d->export = NULL;
+}
+
+
 #if HAVE_CADICAL || HAVE_KISSAT
 /*
  * Conversion from literal_t to dimacs:
@@ -515,6 +607,9 @@ bool init_delegate(delegate_t *d, const char *solver_name, uint32_t nvars) {
   if (strcmp("y2sat", solver_name) == 0) {
     ysat_as_delegate(d, nvars);
     return true;
+  } else if (strcmp("y2sat-cubes", solver_name) == 0) {
+    ysat_cubes_as_delegate(d, nvars);
+    return true;
 #if HAVE_CADICAL
   } else if (strcmp("cadical", solver_name) == 0) {
     cadical_as_delegate(d, nvars);
@@ -546,7 +641,7 @@ bool init_delegate(delegate_t *d, const char *solver_name, uint32_t nvars) {
  *   if we have optional support (but not compiled), *unknown is set to fasle.
  */
 bool supported_delegate(const char *solver_name, bool *unknown) {
-  if (strcmp("y2sat", solver_name) == 0) {
+  if (strcmp("y2sat", solver_name) == 0 || strcmp("y2sat-cubes", solver_name) == 0) {
     *unknown = false;
     return true;
   }
@@ -667,13 +762,13 @@ static void copy_clause(delegate_t *d, const clause_t *c) {
 /*
  * Copy the clauses from a vector
  */
-static void copy_clause_vector(delegate_t *d, clause_t **vector) {
+static void copy_clause_vector(delegate_t *d, smt_core_t *core, cidx_t *vector) {
   uint32_t i, n;
 
   if (vector != NULL) {
     n = get_cv_size(vector);
     for (i=0; i<n; i++) {
-      copy_clause(d, vector[i]);
+      copy_clause(d, clause_of_idx(core, vector[i]));
     }
   }
 }
@@ -687,7 +782,7 @@ static void copy_problem_clauses(delegate_t *d, smt_core_t *core) {
   }
   copy_unit_clauses(d, core);
   copy_binary_clauses(d, core);
-  copy_clause_vector(d, core->problem_clauses);
+  copy_clause_vector(d, core, core->problem_clauses);
 }
 
 
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY DRAT OUTPUT
+ */
+
+#include <assert.h>
+
+#include "solvers/cdcl/drat_writer.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Open the file and allocate the buffer
+ */
+bool open_drat_writer(drat_writer_t *w, const char *name) {
+  FILE *f;
+
+  f = fopen(name, "wb");
+  if (f == NULL) return false;
+
+  w->file = f;
+  w->buffer = (uint8_t *) safe_malloc(DRAT_BUFFER_SIZE);
+  w->size = 0;
+  w->error = false;
+  w->additions = 0;
+  w->deletions = 0;
+
+  return true;
+}
+
+
+/*
+ * Write the buffer content
+ * - on error, we report it once and drop the rest of the proof
+ */
+void flush_drat_writer(drat_writer_t *w) {
+  if (w->size > 0 && !w->error) {
+    if (fwrite(w->buffer, 1, w->size, w->file) != w->size) {
+      perror("drat proof");
+      w->error = true;
+    }
+  }
+  w->size = 0;
+}
+
+
+/*
+ * Flush and close
+ */
+void close_drat_writer(drat_writer_t *w) {
+  flush_drat_writer(w);
+  if (fclose(w->file) != 0 && !w->error) {
+    perror("drat proof");
+  }
+  safe_free(w->buffer);
+  w->file = NULL;
+  w->buffer = NULL;
+}
+
+
+/*
+ * Store byte c: the buffer must not be full
+ */
+static inline void drat_put_byte(drat_writer_t *w, uint8_t c) {
+  assert(w->size < DRAT_BUFFER_SIZE);
+  w->buffer[w->size] = c;
+  w->size ++;
+}
+
+/*
+ * Store literal l in variable-length encoding (at most 5 bytes)
+ */
+static void drat_put_literal(drat_writer_t *w, literal_t l) {
+  uint32_t u;
+
+  assert(l >= 2);
+
+  if (w->size + 5 > DRAT_BUFFER_SIZE) {
+    flush_drat_writer(w);
+  }
+
+  u = (uint32_t) l;
+  while (u >= 0x80) {
+    drat_put_byte(w, (uint8_t) (u | 0x80));
+    u >>= 7;
+  }
+  drat_put_byte(w, (uint8_t) u);
+}
+
+/*
+ * Clause record: tag = 'a' or 'd'
+ */
+static void drat_put_clause(drat_writer_t *w, uint8_t tag, uint32_t n, const literal_t *a) {
+  uint32_t i;
+
+  if (w->size + 1 > DRAT_BUFFER_SIZE) {
+    flush_drat_writer(w);
+  }
+  drat_put_byte(w, tag);
+  for (i=0; i<n; i++) {
+    drat_put_literal(w, a[i]);
+  }
+  if (w->size + 1 > DRAT_BUFFER_SIZE) {
+    flush_drat_writer(w);
+  }
+  drat_put_byte(w, 0);
+}
+
+
+void drat_add_clause(drat_writer_t *w, uint32_t n, const literal_t *a) {
+  drat_put_clause(w, 'a', n, a);
+  w->additions ++;
+}
+
+void drat_delete_clause(drat_writer_t *w, uint32_t n, const literal_t *a) {
+  assert(n > 0);
+  drat_put_clause(w, 'd', n, a);
+  w->deletions ++;
+}
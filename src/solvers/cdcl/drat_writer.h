@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BUFFERED WRITER FOR PROOFS IN BINARY DRAT FORMAT
+ *
+ * A DRAT proof is a sequence of clause additions and deletions.
+ * In the binary format:
+ * - an addition is the byte 'a' followed by the clause literals then 0
+ * - a deletion is the byte 'd' followed by the clause literals then 0
+ * - a DIMACS literal l is mapped to the unsigned integer u = 2 * |l| + (l < 0)
+ *   and u is written in variable-length encoding: 7 bits per byte, least
+ *   significant group first, with the high-order bit set on all bytes
+ *   except the last.
+ *
+ * The sat solver's literals are 2 * x + sign, where x is the DIMACS
+ * variable and sign is 1 for negative literals, so they are written
+ * without conversion. The reserved variable 0 must not occur in the proof.
+ *
+ * This format is accepted by standard checkers such as drat-trim.
+ */
+
+#ifndef __DRAT_WRITER_H
+#define __DRAT_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "solvers/cdcl/smt_core_base_types.h"
+
+
+/*
+ * Writer:
+ * - file = output file
+ * - buffer = bytes not written yet
+ * - size = number of bytes in the buffer
+ * - error = true if a write failed (all further output is dropped)
+ * - additions/deletions = number of clauses written
+ */
+typedef struct drat_writer_s {
+  FILE *file;
+  uint8_t *buffer;
+  uint32_t size;
+  bool error;
+  uint64_t additions;
+  uint64_t deletions;
+} drat_writer_t;
+
+#define DRAT_BUFFER_SIZE 65536
+
+
+/*
+ * Open file 'name' and initialize w
+ * - return false if the file can't be created (w is not initialized then)
+ */
+extern bool open_drat_writer(drat_writer_t *w, const char *name);
+
+/*
+ * Flush the buffer, close the file, and free memory
+ */
+extern void close_drat_writer(drat_writer_t *w);
+
+/*
+ * Write the buffer content to the file
+ */
+extern void flush_drat_writer(drat_writer_t *w);
+
+/*
+ * Record addition/deletion of clause a[0 ... n-1]
+ * - n = 0 is allowed for drat_add_clause (empty clause)
+ */
+extern void drat_add_clause(drat_writer_t *w, uint32_t n, const literal_t *a);
+extern void drat_delete_clause(drat_writer_t *w, uint32_t n, const literal_t *a);
+
+
+#endif /* __DRAT_WRITER_H */
@@ -23,6 +23,7 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include <float.h>
 
@@ -313,7 +314,7 @@ static inline void export_last_conflict(sat_solver_t *solver) { }
 
 
 /*
- * Experimental: stabilization
+ * Stable/focused modes
  * - stab_interval = number of conflicts before switching to the next stabilization
  *   period
  * - stab_factor = growth factor
@@ -331,6 +332,17 @@ static inline void export_last_conflict(sat_solver_t *solver) { }
 #define STAB_INTERVAL 1000
 #define STAB_FACTOR 2
 
+/*
+ * Restarts in stable mode: the k-th restart interval is luby(k) * LUBY_UNIT
+ */
+#define LUBY_UNIT 1024
+
+/*
+ * Rephasing: the k-th call to rephase is done after k * REPHASE_INTERVAL
+ * conflicts since the previous one.
+ */
+#define REPHASE_INTERVAL 1000
+
 
 /*
  * Parameters to control preprocessing
@@ -376,6 +388,14 @@ static inline void export_last_conflict(sat_solver_t *solver) { }
 #define PROBING_MAX_BUDGET 1000000
 #define PROBING_RATIO 0.02
 
+/*
+ * To control inprocessing
+ */
+#define INPROCESS_INTERVAL 20000
+#define VIVIFY_MIN_BUDGET 20000
+#define VIVIFY_MAX_BUDGET 2000000
+#define VIVIFY_RATIO 0.05
+
 
 
 /**********
@@ -2735,6 +2755,123 @@ static uint32_t bvar_get_gate(const descriptors_t *table, bvar_t x) {
 
 
 
+/*******************
+ *  PROOF OUTPUT   *
+ ******************/
+
+/*
+ * When solver->proof is not NULL, every clause added to the solver
+ * after the input clauses is written to the proof (in DRAT format).
+ * The clauses deleted by the solver are also written, except
+ * when they may be needed to check later steps (e.g., the binary
+ * clauses that justify a variable substitution).
+ *
+ * All the steps must be checkable by unit propagation (RUP). This requires:
+ * - a new clause is written before the clauses it's derived from are deleted
+ * - the literals assigned at level 0 are written as unit clauses before
+ *   their antecedents are deleted (cf. proof_add_level0_units)
+ * - a clause modified in place is copied in solver->proof_clause first,
+ *   then the new clause is added and the copy is deleted.
+ */
+bool nsat_open_proof_file(sat_solver_t *solver, const char *name) {
+  drat_writer_t *w;
+
+  assert(solver->proof == NULL);
+
+  w = (drat_writer_t *) safe_malloc(sizeof(drat_writer_t));
+  if (! open_drat_writer(w, name)) {
+    safe_free(w);
+    return false;
+  }
+  solver->proof = w;
+  solver->proof_units = solver->stack.top;
+
+  return true;
+}
+
+static void close_proof_file(sat_solver_t *solver) {
+  if (solver->proof != NULL) {
+    close_drat_writer(solver->proof);
+    safe_free(solver->proof);
+    solver->proof = NULL;
+  }
+}
+
+static inline void proof_add_clause(sat_solver_t *solver, uint32_t n, const literal_t *a) {
+  if (solver->proof != NULL) {
+    drat_add_clause(solver->proof, n, a);
+  }
+}
+
+static inline void proof_delete_clause(sat_solver_t *solver, uint32_t n, const literal_t *a) {
+  if (solver->proof != NULL) {
+    drat_delete_clause(solver->proof, n, a);
+  }
+}
+
+static inline void proof_add_unit_clause(sat_solver_t *solver, literal_t l) {
+  proof_add_clause(solver, 1, &l);
+}
+
+static void proof_add_binary_clause(sat_solver_t *solver, literal_t l0, literal_t l1) {
+  literal_t a[2];
+
+  a[0] = l0;
+  a[1] = l1;
+  proof_add_clause(solver, 2, a);
+}
+
+static void proof_delete_binary_clause(sat_solver_t *solver, literal_t l0, literal_t l1) {
+  literal_t a[2];
+
+  a[0] = l0;
+  a[1] = l1;
+  proof_delete_clause(solver, 2, a);
+}
+
+/*
+ * Copy clause a[0 ... n-1] into solver->proof_clause (if proofs are enabled)
+ */
+static void proof_save_clause(sat_solver_t *solver, uint32_t n, const literal_t *a) {
+  uint32_t i;
+
+  if (solver->proof != NULL) {
+    reset_vector(&solver->proof_clause);
+    for (i=0; i<n; i++) {
+      vector_push(&solver->proof_clause, a[i]);
+    }
+  }
+}
+
+/*
+ * Delete the clause saved by proof_save_clause
+ */
+static void proof_delete_saved_clause(sat_solver_t *solver) {
+  if (solver->proof != NULL) {
+    drat_delete_clause(solver->proof, solver->proof_clause.size, (literal_t *) solver->proof_clause.data);
+  }
+}
+
+/*
+ * Write all the literals assigned at level 0 (not written yet) as unit clauses
+ */
+static void proof_add_level0_units(sat_solver_t *solver) {
+  uint32_t i, n;
+
+  if (solver->proof != NULL) {
+    n = solver->stack.top;
+    if (solver->decision_level > 0) {
+      n = solver->stack.level_index[1];
+    }
+    for (i=solver->proof_units; i<n; i++) {
+      drat_add_clause(solver->proof, 1, solver->stack.lit + i);
+    }
+    solver->proof_units = n;
+  }
+}
+
+
+
 /********************************
  *  SAT SOLVER INITIALIZATION   *
  *******************************/
@@ -2751,15 +2888,19 @@ static void init_stats(solver_stats_t *stat) {
   stat->prob_clauses_deleted = 0;
   stat->learned_clauses_deleted = 0;
   stat->subsumed_literals = 0;
+  stat->exported_clauses = 0;
+  stat->imported_clauses = 0;
 
   stat->starts = 0;
   stat->stabilizations = 0;
+  stat->rephases = 0;
   stat->simplify_calls = 0;
   stat->reduce_calls = 0;
   stat->scc_calls = 0;
   stat->try_equiv_calls = 0;
   stat->subst_calls = 0;
   stat->probe_calls = 0;
+  stat->inprocess_calls = 0;
 
   stat->subst_vars = 0;
   stat->subst_units = 0;
@@ -2769,6 +2910,10 @@ static void init_stats(solver_stats_t *stat) {
   stat->probing_propagations = 0;
   stat->failed_literals = 0;
 
+  stat->vivified_clauses = 0;
+  stat->vivified_literals = 0;
+  stat->inprocess_elims = 0;
+
   stat->pp_pure_lits = 0;
   stat->pp_unit_lits = 0;
   stat->pp_subst_vars = 0;
@@ -2796,6 +2941,9 @@ static void init_params(solver_param_t *params) {
   params->reduce_interval = REDUCE_INTERVAL;
   params->reduce_delta = REDUCE_DELTA;
   params->restart_interval = RESTART_INTERVAL;
+  params->luby_unit = LUBY_UNIT;
+  params->rephase_interval = REPHASE_INTERVAL;
+  params->max_conflicts = 0;
 
   params->var_elim_skip = VAR_ELIM_SKIP;
   params->subsume_skip = SUBSUME_SKIP;
@@ -2810,6 +2958,11 @@ static void init_params(solver_param_t *params) {
   params->probing_min_budget = PROBING_MIN_BUDGET;
   params->probing_max_budget = PROBING_MAX_BUDGET;
   params->probing_ratio = PROBING_RATIO;
+
+  params->inprocess_interval = INPROCESS_INTERVAL;
+  params->vivify_min_budget = VIVIFY_MIN_BUDGET;
+  params->vivify_max_budget = VIVIFY_MAX_BUDGET;
+  params->vivify_ratio = VIVIFY_RATIO;
 }
 
 /*
@@ -2887,6 +3040,9 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
 
   solver->saved_values = NULL;
   solver->cidx_array = NULL;
+  solver->target_phase = NULL;
+  solver->best_phase = NULL;
+  solver->elim_occ = NULL;
 
   init_vector(&solver->buffer);
   init_vector(&solver->aux);
@@ -2913,6 +3069,15 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
   init_bgate_array(&solver->gates);
 
   solver->data = NULL;
+
+  solver->proof = NULL;
+  solver->proof_units = 0;
+  init_vector(&solver->proof_clause);
+
+  solver->exchange = NULL;
+  solver->exchange_id = 0;
+
+  solver->interrupted = false;
 }
 
 
@@ -2955,6 +3120,12 @@ void delete_nsat_solver(sat_solver_t *solver) {
   solver->saved_values = NULL;
   safe_free(solver->cidx_array);
   solver->cidx_array = NULL;
+  safe_free(solver->target_phase);
+  solver->target_phase = NULL;
+  safe_free(solver->best_phase);
+  solver->best_phase = NULL;
+  safe_free(solver->elim_occ);
+  solver->elim_occ = NULL;
 
   delete_vector(&solver->buffer);
   delete_vector(&solver->aux);
@@ -2984,6 +3155,8 @@ void delete_nsat_solver(sat_solver_t *solver) {
   delete_bgate_array(&solver->gates);
 
   close_datafile(solver);
+  close_proof_file(solver);
+  delete_vector(&solver->proof_clause);
 }
 
 
@@ -3017,6 +3190,12 @@ void reset_nsat_solver(sat_solver_t *solver) {
   solver->saved_values = NULL;
   safe_free(solver->cidx_array);
   solver->cidx_array = NULL;
+  safe_free(solver->target_phase);
+  solver->target_phase = NULL;
+  safe_free(solver->best_phase);
+  solver->best_phase = NULL;
+  safe_free(solver->elim_occ);
+  solver->elim_occ = NULL;
 
   reset_vector(&solver->buffer);
   reset_vector(&solver->aux);
@@ -3046,6 +3225,8 @@ void reset_nsat_solver(sat_solver_t *solver) {
   reset_bgate_array(&solver->gates);
 
   reset_datafile(solver);
+  close_proof_file(solver);
+  solver->proof_units = 0;
 }
 
 
@@ -3127,6 +3308,34 @@ void nsat_set_restart_interval(sat_solver_t *solver, uint32_t n) {
   solver->params.restart_interval = n;
 }
 
+/*
+ * Restart interval unit in stable mode
+ */
+void nsat_set_luby_unit(sat_solver_t *solver, uint32_t n) {
+  solver->params.luby_unit = n;
+}
+
+/*
+ * Base interval between two rephasing
+ */
+void nsat_set_rephase_interval(sat_solver_t *solver, uint32_t n) {
+  solver->params.rephase_interval = n;
+}
+
+/*
+ * Base interval between two inprocessing rounds
+ */
+void nsat_set_inprocess_interval(sat_solver_t *solver, uint32_t n) {
+  solver->params.inprocess_interval = n;
+}
+
+/*
+ * Conflict budget for nsat_solve (0 means no limit)
+ */
+void nsat_set_max_conflicts(sat_solver_t *solver, uint64_t n) {
+  solver->params.max_conflicts = n;
+}
+
 /*
  * Stack clause threshold: learned clauses of LBD greater than threshold are
  * treated as temporary clauses (not stored in the clause database).
@@ -3192,6 +3401,16 @@ void nsat_set_simplify_subst_delta(sat_solver_t *solver, uint32_t d) {
 }
 
 
+/*
+ * CLAUSE SHARING
+ */
+void nsat_set_clause_exchange(sat_solver_t *solver, clause_exchange_t *ex, uint32_t i) {
+  assert(i < ex->nworkers);
+  solver->exchange = ex;
+  solver->exchange_id = i;
+}
+
+
 
 /********************
  *  ADD VARIABLES   *
@@ -3682,6 +3901,7 @@ static void increase_occurrence_counts(sat_solver_t *solver, uint32_t n, const l
  * Add the empty clause
  */
 static void add_empty_clause(sat_solver_t *solver) {
+  proof_add_clause(solver, 0, NULL);
   solver->has_empty_clause = true;
   solver->status = STAT_UNSAT;
 }
@@ -4444,7 +4664,9 @@ static void nsat_reduce_learned_clause_set(sat_solver_t *solver) {
   // a contains the clauses that can be deleted
   // less useful clauses (i.e., low-activity clauses) occur first
   n0 = solver->params.reduce_fraction * (n/32);
+  proof_add_level0_units(solver);
   for (i=0; i<n0; i++) {
+    proof_delete_clause(solver, clause_length(&solver->pool, a[i]), clause_literals(&solver->pool, a[i]));
     clause_pool_delete_clause(&solver->pool, a[i]);
     solver->stats.learned_clauses_deleted ++;
   }
@@ -4503,6 +4725,32 @@ static void cleanup_watch_vector(sat_solver_t *solver, watch_t *w) {
 }
 
 
+/*
+ * Proof output: record the deletion of the binary clauses in watch[l]
+ * - l is assigned at level 0 and w = solver->watch[l]
+ * - a clause { l, l1 } with l1 assigned is also in watch[l1] so we
+ *   write it only if l < l1.
+ */
+static void proof_delete_binary_clauses(sat_solver_t *solver, literal_t l, const watch_t *w) {
+  uint32_t i, n, k;
+  literal_t l1;
+
+  n = w->size;
+  i = 0;
+  while (i < n) {
+    k = w->data[i];
+    if (idx_is_clause(k)) {
+      i += 2;
+    } else {
+      l1 = idx2lit(k);
+      if (lit_is_unassigned(solver, l1) || l < l1) {
+        proof_delete_binary_clause(solver, l, l1);
+      }
+      i ++;
+    }
+  }
+}
+
 /*
  * Simplify the binary clauses:
  * - if l is assigned at level 0, delete its watched vector
@@ -4528,6 +4776,9 @@ static void simplify_binary_clauses(sat_solver_t *solver) {
 
       case VAL_TRUE:
       case VAL_FALSE:
+        if (solver->proof != NULL) {
+          proof_delete_binary_clauses(solver, i, w);
+        }
         safe_free(w);
         solver->watch[i] = NULL;
         break;
@@ -4596,6 +4847,7 @@ static bool simplify_clause(sat_solver_t *solver, cidx_t cidx) {
 
   n = clause_length(&solver->pool, cidx);
   a = clause_literals(&solver->pool, cidx);
+  proof_save_clause(solver, n, a);
 
   j = 0;
   for (i=0; i<n; i++) {
@@ -4612,6 +4864,7 @@ static bool simplify_clause(sat_solver_t *solver, cidx_t cidx) {
 
     case VAL_TRUE:
       // the clause is true
+      proof_delete_saved_clause(solver);
       clause_pool_delete_clause(&solver->pool, cidx);
       return true;
     }
@@ -4621,6 +4874,8 @@ static bool simplify_clause(sat_solver_t *solver, cidx_t cidx) {
 
   if (j == 2) {
     // convert to a binary clause
+    proof_add_binary_clause(solver, a[0], a[1]);
+    proof_delete_saved_clause(solver);
     add_binary_clause(solver, a[0], a[1]); // must be done first
     clause_pool_delete_clause(&solver->pool, cidx);
     solver->simplify_new_bins ++;
@@ -4628,6 +4883,8 @@ static bool simplify_clause(sat_solver_t *solver, cidx_t cidx) {
   }
 
   if (j < n) {
+    proof_add_clause(solver, j, a);
+    proof_delete_saved_clause(solver);
     clause_pool_shrink_clause(&solver->pool, cidx, j);
   }
   return false;
@@ -4675,6 +4932,7 @@ static void simplify_clause_database(sat_solver_t *solver) {
             solver->pool.num_learned_clauses, solver->pool.num_learned_literals);
   }
 
+  proof_add_level0_units(solver);
   simplify_binary_clauses(solver);
 
   d = 0; // count deleted clauses
@@ -4863,6 +5121,7 @@ static void process_scc(sat_solver_t *solver, literal_t l) {
 	// both l0 and not(l0) are in the SCC
 	assert(base_subst(solver, l0) == not(rep));
 	unsat = true;
+	proof_add_unit_clause(solver, rep);
 	add_empty_clause(solver);
 	break;
       }
@@ -5113,6 +5372,7 @@ static bool subst_and_simplify_clause(sat_solver_t *solver, cidx_t cidx) {
 
   n = clause_length(&solver->pool, cidx);
   a = clause_literals(&solver->pool, cidx);
+  proof_save_clause(solver, n, a);
 
   j = 0;
   for (i=0; i<n; i++) {
@@ -5144,10 +5404,16 @@ static bool subst_and_simplify_clause(sat_solver_t *solver, cidx_t cidx) {
   clear_false_lits(solver, j, a);
 
   if (i < n) { // true clause
+    proof_delete_saved_clause(solver);
     clause_pool_delete_clause(&solver->pool, cidx);
     return true;
   }
 
+  if (j > 0) {
+    proof_add_clause(solver, j, a);
+    proof_delete_saved_clause(solver);
+  }
+
   if (j <= 2) {
     // reduced to a small clause
     if (j == 0) {
@@ -5204,6 +5470,7 @@ static void subst_and_simplify_binary_clause(sat_solver_t *solver, literal_t l0,
 
   } else if (j == 1) {
     assert(lit_is_unassigned(solver, a[0]));
+    proof_add_unit_clause(solver, a[0]);
     add_unit_clause(solver, a[0]);
 
   } else {
@@ -5211,8 +5478,10 @@ static void subst_and_simplify_binary_clause(sat_solver_t *solver, literal_t l0,
     assert(lit_is_unassigned(solver, a[1]));
 
     if (a[0] == a[1]) {
+      proof_add_unit_clause(solver, a[0]);
       add_unit_clause(solver, a[0]);
     } else if (a[0] != not(a[1])) {
+      proof_add_binary_clause(solver, a[0], a[1]);
       add_binary_clause(solver, a[0], a[1]);
     }
   }
@@ -5875,6 +6144,7 @@ static inline void pp_push_pure_literal(sat_solver_t *solver, literal_t l) {
 }
 
 static inline void pp_push_unit_literal(sat_solver_t *solver, literal_t l) {
+  proof_add_unit_clause(solver, l);
   pp_push_literal(solver, l, ATAG_UNIT);
   solver->stats.pp_unit_lits ++;
 }
@@ -5945,6 +6215,7 @@ static void pp_remove_clause(sat_solver_t *solver, cidx_t cidx) {
   n = clause_length(&solver->pool, cidx);
   a = clause_literals(&solver->pool, cidx);
   pp_decrement_occ_counts(solver, a, n);
+  proof_delete_clause(solver, n, a);
   clause_pool_delete_clause(&solver->pool, cidx);
   solver->stats.pp_clauses_deleted ++;
 }
@@ -5966,6 +6237,7 @@ static void pp_visit_clause(sat_solver_t *solver, cidx_t cidx) {
 
   n = clause_length(&solver->pool, cidx);
   a = clause_literals(&solver->pool, cidx);
+  proof_save_clause(solver, n, a);
   true_clause = false;
 
   j = 0;
@@ -5988,6 +6260,7 @@ static void pp_visit_clause(sat_solver_t *solver, cidx_t cidx) {
 
   if (true_clause) {
     pp_decrement_occ_counts(solver, a, j);
+    proof_delete_saved_clause(solver);
     clause_pool_delete_clause(&solver->pool, cidx);
     solver->stats.pp_clauses_deleted ++;
   } else if (j == 0) {
@@ -5995,8 +6268,11 @@ static void pp_visit_clause(sat_solver_t *solver, cidx_t cidx) {
     clause_pool_delete_clause(&solver->pool, cidx);
   } else if (j == 1) {
     pp_push_unit_literal(solver, a[0]);
+    proof_delete_saved_clause(solver);
     clause_pool_delete_clause(&solver->pool, cidx);
   } else {
+    proof_add_clause(solver, j, a);
+    proof_delete_saved_clause(solver);
     clause_pool_shrink_clause(&solver->pool, cidx, j);
     set_clause_signature(&solver->pool, cidx);
     clause_queue_push(solver, cidx);
@@ -6948,6 +7224,8 @@ static void pp_decrement_occ_counts_after_subst(sat_solver_t *solver, literal_t
 
 /*
  * Delete clause cidx after substitution
+ * - the deletion is not written to the proof: the binary clauses that
+ *   justify the substitution must be kept
  */
 static void pp_remove_clause_after_subst(sat_solver_t *solver, cidx_t cidx) {
   literal_t *a;
@@ -7031,6 +7309,7 @@ static void pp_apply_subst_to_clause(sat_solver_t *solver, cidx_t cidx) {
     assert(n >= 2);
 
     uint_array_sort(b->data, n); // keep the clause sorted
+    proof_add_clause(solver, n, (literal_t *) b->data);
     new_cidx = clause_pool_add_problem_clause(&solver->pool, n, (literal_t *) b->data);
     add_clause_all_watch(solver, n, (literal_t *) b->data, new_cidx);
     set_clause_signature(&solver->pool, new_cidx);
@@ -7150,7 +7429,8 @@ static bool pp_scc_simplification(sat_solver_t *solver) {
     if (solver->verbosity >= 3) {
       fprintf(stderr, "c  scc %"PRIu32" variable substitutions\n", n);
     }
-    for (;;) {
+    // equivalence detection is not supported in proof mode
+    while (solver->proof == NULL) {
       try_equivalent_vars(solver, 2);
       if (n == v->size || solver->has_empty_clause) break;
       n = v->size;
@@ -7365,6 +7645,7 @@ static bool try_subsumption(sat_solver_t *solver, uint32_t n, const literal_t *a
   if (k < m) {
     // strengthening: remove literal b[k] form clause cidx
     l = b[k];
+    proof_save_clause(solver, m, b);
     pp_decrement_occ(solver, l);
     pp_remove_literal(m, k, b);
     pp_remove_clause_from_watch(solver, l, cidx);
@@ -7372,9 +7653,12 @@ static bool try_subsumption(sat_solver_t *solver, uint32_t n, const literal_t *a
     m --;
     if (m == 1) {
       pp_push_unit_literal(solver, b[0]);
+      proof_delete_saved_clause(solver);
       clause_pool_delete_clause(&solver->pool, cidx);
       solver->stats.pp_unit_strengthenings ++;
     } else {
+      proof_add_clause(solver, m, b);
+      proof_delete_saved_clause(solver);
       clause_pool_shrink_clause(&solver->pool, cidx, m);
       set_clause_signature(&solver->pool, cidx);
       clause_queue_push(solver, cidx);
@@ -7383,6 +7667,7 @@ static bool try_subsumption(sat_solver_t *solver, uint32_t n, const literal_t *a
   } else {
     // subsumption: remove clause cidx
     pp_decrement_occ_counts(solver, b, m);
+    proof_delete_clause(solver, m, b);
     clause_pool_delete_clause(&solver->pool, cidx);
     solver->stats.pp_subsumptions ++;
   }
@@ -7839,6 +8124,7 @@ static void pp_add_unit_resolvent(sat_solver_t *solver, literal_t l) {
     break;
 
   case VAL_FALSE:
+    proof_add_unit_clause(solver, l);
     add_empty_clause(solver);
     break;
 
@@ -7864,6 +8150,7 @@ static void pp_add_resolvent(sat_solver_t *solver, uint32_t c1, uint32_t c2, lit
     if (n == 1) {
       pp_add_unit_resolvent(solver, b->data[0]);
     } else {
+      proof_add_clause(solver, n, (literal_t *) b->data);
       cidx = clause_pool_add_problem_clause(&solver->pool, n, (literal_t *) b->data);
       add_clause_all_watch(solver, n, (literal_t *) b->data, cidx);
       set_clause_signature(&solver->pool, cidx);
@@ -8268,6 +8555,7 @@ static void prepare_for_search(sat_solver_t *solver) {
   solver->units = 0;
   solver->binaries = 0;
   reset_stack(&solver->stack);
+  solver->proof_units = 0;
   pp_reset_watch_vectors(solver);
   pp_rebuild_watch_vectors(solver);
   shrink_watch_vectors(solver);
@@ -9636,6 +9924,7 @@ static void delete_subsumed_clause(sat_solver_t *solver, cidx_t cidx) {
   l1 = second_literal_of_clause(&solver->pool, cidx);
   remove_clause_watch(solver, l1, cidx);
 
+  proof_delete_clause(solver, clause_length(&solver->pool, cidx), clause_literals(&solver->pool, cidx));
   clause_pool_delete_clause(&solver->pool, cidx);
   solver->stats.learned_clauses_deleted ++;
 }
@@ -9675,6 +9964,20 @@ static void check_subsumes_last_learned(sat_solver_t *solver) {
 }
 
 
+/*
+ * Publish learned clause a[0 ... n-1] of LBD d in the clause exchange
+ * - we share units, binary clauses, and short clauses of LBD <= keep_lbd
+ */
+static void export_learned_clause(sat_solver_t *solver, uint32_t n, const literal_t *a, uint32_t d) {
+  assert(solver->exchange != NULL);
+
+  if (n <= 2 || (n <= EXCHANGE_MAX_CLAUSE_SIZE && d <= solver->params.keep_lbd)) {
+    clause_exchange_publish(solver->exchange, solver->exchange_id, n, a);
+    solver->stats.exported_clauses ++;
+  }
+}
+
+
 /*
  * Resolve a conflict and add a learned clause
  * - solver->decision_level must be positive
@@ -9704,6 +10007,11 @@ static void resolve_conflict(sat_solver_t *solver) {
   d = clause_lbd(solver, n, (literal_t *) solver->buffer.data);
   update_emas(solver, d);
 
+  if (solver->exchange != NULL) {
+    export_learned_clause(solver, n, (literal_t *) solver->buffer.data, d);
+  }
+  proof_add_clause(solver, n, (literal_t *) solver->buffer.data);
+
   // Collect data if compiled with DATA=1
   export_conflict_data(solver, d);
 
@@ -9782,6 +10090,7 @@ static void try_scc_simplification(sat_solver_t *solver) {
   solver->stats.scc_calls ++;
   units = solver->units;
 
+  proof_add_level0_units(solver);
   compute_sccs(solver);
   if (solver->has_empty_clause) {
     if (solver->verbosity >= 1) {
@@ -9799,7 +10108,7 @@ static void try_scc_simplification(sat_solver_t *solver) {
     if (solver->verbosity >= 3) {
       fprintf(stderr, "c  scc %"PRIu32" variable substitutions\n", n0);
     }
-    if (solver->stats.subst_vars >= solver->simplify_subst_next) {
+    if (solver->stats.subst_vars >= solver->simplify_subst_next && solver->proof == NULL) {
       try_equivalent_vars(solver, 2);
       solver->simplify_subst_next = solver->stats.subst_vars + solver->params.simplify_subst_delta;
     }
@@ -9956,6 +10265,146 @@ static void extend_assignment(sat_solver_t *solver) {
 }
 
 
+/*
+ * Decision literal for variable x:
+ * - in stable mode, use the target phase of x if it has one
+ * - otherwise, use the saved phase
+ */
+static literal_t decision_literal(const sat_solver_t *solver, bvar_t x) {
+  uint8_t phase;
+
+  if (solver->stabilizing) {
+    phase = solver->target_phase[x];
+    if (phase != 0) {
+      assert(phase == VAL_FALSE || phase == VAL_TRUE);
+      return pos_lit(x) ^ 1 ^ (phase & 1);
+    }
+  }
+  return preferred_literal(solver, x);
+}
+
+
+/*
+ * Allocate and clear the target and best phase arrays
+ * - all variables have no target/best phase
+ */
+static void init_phases(sat_solver_t *solver) {
+  uint32_t n;
+
+  n = solver->nvars;
+  solver->target_phase = (uint8_t *) safe_realloc(solver->target_phase, n * sizeof(uint8_t));
+  solver->best_phase = (uint8_t *) safe_realloc(solver->best_phase, n * sizeof(uint8_t));
+  memset(solver->target_phase, 0, n * sizeof(uint8_t));
+  memset(solver->best_phase, 0, n * sizeof(uint8_t));
+  solver->target_assigned = 0;
+  solver->best_assigned = 0;
+}
+
+
+/*
+ * Copy the values of the n first literals of the stack into phase
+ */
+static void copy_phases(const sat_solver_t *solver, uint8_t *phase, uint32_t n) {
+  uint32_t i;
+  bvar_t x;
+
+  assert(n <= solver->stack.top);
+
+  for (i=0; i<n; i++) {
+    x = var_of(solver->stack.lit[i]);
+    phase[x] = var_value(solver, x);
+  }
+}
+
+
+/*
+ * Update the target and best phases
+ * - n = size of a conflict-free prefix of the assignment stack
+ * - the target phase is updated only in stable mode
+ */
+static void update_target_and_best(sat_solver_t *solver, uint32_t n) {
+  if (solver->stabilizing && n > solver->target_assigned) {
+    copy_phases(solver, solver->target_phase, n);
+    solver->target_assigned = n;
+  }
+  if (n > solver->best_assigned) {
+    copy_phases(solver, solver->best_phase, n);
+    solver->best_assigned = n;
+  }
+}
+
+
+/*
+ * Rephasing (based on Cadical): periodically reset the saved phase of
+ * all unassigned variables. We cycle through the following phases:
+ * - best phase
+ * - original phase (all false)
+ * - best phase
+ * - inverted phase (all true)
+ * - best phase
+ * - flipped phase (opposite of the saved phase)
+ * The target and best phases are cleared.
+ *
+ * This should be called after a full restart.
+ */
+typedef enum rephase_kind {
+  REPHASE_BEST,
+  REPHASE_ORIGINAL,
+  REPHASE_INVERTED,
+  REPHASE_FLIPPED,
+} rephase_kind_t;
+
+static const rephase_kind_t rephase_cycle[6] = {
+  REPHASE_BEST, REPHASE_ORIGINAL, REPHASE_BEST, REPHASE_INVERTED, REPHASE_BEST, REPHASE_FLIPPED,
+};
+
+static void rephase(sat_solver_t *solver) {
+  rephase_kind_t kind;
+  uint32_t i, n;
+  uint8_t val;
+
+  assert(solver->decision_level == 0);
+
+  kind = rephase_cycle[solver->rephase_count % 6];
+  n = solver->nvars;
+  for (i=1; i<n; i++) {
+    if (var_is_active(solver, i)) {
+      val = var_value(solver, i);
+      switch (kind) {
+      case REPHASE_BEST:
+        if (solver->best_phase[i] != 0) {
+          val = solver->best_phase[i] & 1;
+        }
+        break;
+
+      case REPHASE_ORIGINAL:
+        val = VAL_UNDEF_FALSE;
+        break;
+
+      case REPHASE_INVERTED:
+        val = VAL_UNDEF_TRUE;
+        break;
+
+      case REPHASE_FLIPPED:
+        val ^= 1;
+        break;
+      }
+      assert(bval_is_undef(val));
+      solver->value[pos_lit(i)] = val;
+      solver->value[neg_lit(i)] = opposite_val(val);
+    }
+  }
+
+  memset(solver->target_phase, 0, n * sizeof(uint8_t));
+  memset(solver->best_phase, 0, n * sizeof(uint8_t));
+  solver->target_assigned = 0;
+  solver->best_assigned = 0;
+
+  solver->rephase_count ++;
+  solver->stats.rephases ++;
+}
+
+
 
 /****************
  *  EXPERIMENT  *
@@ -10199,67 +10648,520 @@ static void failed_literal_probing(sat_solver_t *solver) {
 }
 
 
-/*
- * MORE EXPERIMENT
- */
-
-/*
- * Check whether w is an empty watch vector
- */
-static inline bool empty_watch(const watch_t *w) {
-  return w == NULL || w->size == 0;
-}
+/*******************
+ *  INPROCESSING   *
+ ******************/
 
 /*
- * Test literal l:
- * - l must be unassigned
- * - assign l then propagate, backtrack if that causes a conflict.
- * - return true if l there's no conflict, false otherwise
+ * Between restarts, we periodically run:
+ * - failed-literal probing
+ * - vivification of learned and problem clauses
+ * - variable elimination restricted to the variables whose number
+ *   of occurrences decreased since the last elimination round.
+ * The budgets for probing and vivification are proportional to the
+ * number of propagations done by the search since the previous round.
  */
-static bool test_literal(sat_solver_t *solver, literal_t l) {
-  assert(lit_is_unassigned(solver, l));
-
-  nsat_decide_literal(solver, l);
-  nsat_boolean_propagation(solver);
-  if (solver->conflict_tag != CTAG_NONE) {
-    backtrack_one_level(solver);
-    solver->conflict_tag = CTAG_NONE;
-    return false;
-  }
-
-  return true;
-}
 
 /*
- * Assign literals without creating a conflict
+ * Vivification of clause cidx:
+ * - we assign the negation of the clause literals one by one and propagate
+ * - a literal that's false after propagation can be removed from the clause
+ * - if we get a conflict or a literal is true, the literals decided so far
+ *   (plus the true literal) form a subclause that's implied.
+ * The new clause is built in solver->buffer. If it's shorter than cidx,
+ * it replaces cidx.
+ *
+ * - the decision level must be 0 and cidx must not be locked.
  */
-static void build_assignment(sat_solver_t *solver) {
-  uint32_t i, n;
+static void vivify_clause(sat_solver_t *solver, cidx_t cidx) {
+  vector_t *b;
+  literal_t *lit;
+  uint32_t i, n, m;
   literal_t l;
 
-  n = solver->nvars;
-  for (i=1; i<n; i++) {
-    if (var_is_active(solver, i)) {
-      l = preferred_literal(solver, i);
-      if (empty_watch(solver->watch[not(l)])) {
-	nsat_decide_literal(solver, l);
-	nsat_boolean_propagation(solver);
-	assert(solver->conflict_tag == CTAG_NONE);
-	continue;
-      }
-      if (empty_watch(solver->watch[l])) {
-	nsat_decide_literal(solver, not(l));
-	nsat_boolean_propagation(solver);
-	assert(solver->conflict_tag == CTAG_NONE);
-      }
-    }
-  }
+  assert(solver->decision_level == 0 && good_clause_idx(&solver->pool, cidx));
 
-  printf("c base assignment: level = %"PRIu32", top = %"PRIu32"\n", solver->decision_level, solver->stack.top);
+  n = clause_length(&solver->pool, cidx);
+  lit = clause_literals(&solver->pool, cidx);
 
-  solver->probing = true;
+  // skip the clause if it's true at level 0 (simplify will remove it)
+  for (i=0; i<n; i++) {
+    if (lit_is_true(solver, lit[i])) return;
+  }
 
-  save_assignment(solver);
+  // propagation may reorder the literals so we copy them into aux
+  assert(solver->aux.size == 0);
+  for (i=0; i<n; i++) {
+    vector_push(&solver->aux, lit[i]);
+  }
+
+  b = &solver->buffer;
+  reset_vector(b);
+  for (i=0; i<n; i++) {
+    l = solver->aux.data[i];
+    switch (lit_value(solver, l)) {
+    case VAL_FALSE:
+      break;
+
+    case VAL_TRUE:
+      vector_push(b, l);
+      goto done;
+
+    default:
+      vector_push(b, l);
+      nsat_decide_literal(solver, not(l));
+      nsat_boolean_propagation(solver);
+      if (solver->conflict_tag != CTAG_NONE) goto done;
+      break;
+    }
+  }
+
+ done:
+  if (solver->decision_level > 0) {
+    backtrack(solver, 0);
+  }
+  solver->conflict_tag = CTAG_NONE;
+
+  m = b->size;
+  if (m > 0 && m < n) {
+    proof_add_clause(solver, m, (literal_t *) b->data);
+    proof_delete_clause(solver, n, (literal_t *) solver->aux.data);
+  }
+  reset_vector(&solver->aux);
+  if (m == n) return;
+
+  solver->stats.vivified_clauses ++;
+  solver->stats.vivified_literals += n - m;
+
+  // lit[0] and lit[1] are the current watch literals
+  remove_clause_watch(solver, lit[0], cidx);
+  remove_clause_watch(solver, lit[1], cidx);
+
+  if (m >= 3) {
+    for (i=0; i<m; i++) {
+      lit[i] = b->data[i];
+    }
+    clause_pool_shrink_clause(&solver->pool, cidx, m);
+    add_clause_watch(solver, lit[0], cidx, lit[1]);
+    add_clause_watch(solver, lit[1], cidx, lit[0]);
+  } else {
+    clause_pool_delete_clause(&solver->pool, cidx);
+    if (m == 2) {
+      add_binary_clause(solver, b->data[0], b->data[1]);
+    } else if (m == 1) {
+      add_unit_clause(solver, b->data[0]);
+      level0_propagation(solver);
+    } else {
+      add_empty_clause(solver);
+    }
+  }
+}
+
+/*
+ * Vivify learned clauses (most active first) then problem clauses.
+ * - problem clauses are visited in a round-robin fashion: vivify_skip
+ *   is the number of problem clauses to skip (already visited).
+ * - stops when the budget is exhausted
+ */
+static void vivify_clauses(sat_solver_t *solver) {
+  uint64_t props_before, decisions_before, limit;
+  uint64_t vivified_before;
+  uint32_t i, n, k;
+  cidx_t cidx, end;
+
+  assert(solver->decision_level == 0);
+  assert(solver->vivify_last <= solver->stats.propagations);
+
+  props_before = solver->stats.propagations;
+  decisions_before = solver->stats.decisions;
+  vivified_before = solver->stats.vivified_clauses;
+
+  limit = (props_before - solver->vivify_last) * solver->params.vivify_ratio;
+  if (limit < solver->params.vivify_min_budget) {
+    limit = solver->params.vivify_min_budget;
+  } else if (limit > solver->params.vivify_max_budget) {
+    limit = solver->params.vivify_max_budget;
+  }
+  limit += props_before;
+
+  // save assignment to later restore the preferred values
+  save_assignment(solver);
+
+  n = solver->pool.num_learned_clauses;
+  if (n > 0) {
+    alloc_cidx_array(solver, n);
+    end = solver->pool.size;
+    i = 0;
+    cidx = clause_pool_first_learned_clause(&solver->pool);
+    while (cidx < end) {
+      assert(i < n);
+      solver->cidx_array[i] = cidx;
+      i ++;
+      cidx = clause_pool_next_clause(&solver->pool, cidx);
+    }
+    assert(i == n);
+    sort_learned_clauses(solver, n);
+
+    while (i > 0 && solver->stats.propagations <= limit) {
+      i --;
+      cidx = solver->cidx_array[i];
+      if (! clause_is_locked(solver, cidx)) {
+        vivify_clause(solver, cidx);
+        if (solver->has_empty_clause) break;
+      }
+    }
+    free_cidx_array(solver);
+  }
+
+  if (!solver->has_empty_clause && solver->stats.propagations <= limit) {
+    // skip the problem clauses visited in previous rounds
+    k = 0;
+    cidx = clause_pool_first_clause(&solver->pool);
+    while (cidx < solver->pool.learned && k < solver->vivify_skip) {
+      k ++;
+      cidx = clause_pool_next_clause(&solver->pool, cidx);
+    }
+    if (cidx >= solver->pool.learned) {
+      k = 0;
+      cidx = clause_pool_first_clause(&solver->pool);
+    }
+    // Note: cidx may be deleted within the loop
+    while (cidx < solver->pool.learned && solver->stats.propagations <= limit) {
+      if (! clause_is_locked(solver, cidx)) {
+        vivify_clause(solver, cidx);
+        if (solver->has_empty_clause) break;
+      }
+      k ++;
+      cidx = clause_pool_next_clause(&solver->pool, cidx);
+    }
+    solver->vivify_skip = (cidx < solver->pool.learned) ? k : 0;
+  }
+
+  // restore the preferred values
+  restore_assignment(solver);
+
+  solver->stats.propagations = props_before;
+  solver->stats.decisions = decisions_before;
+  solver->vivify_last = props_before;
+  solver->last_learned = 1;
+
+  if (solver->verbosity >= 3) {
+    fprintf(stderr, "c vivify: %"PRIu64" clauses strengthened\n", solver->stats.vivified_clauses - vivified_before);
+  }
+}
+
+
+/*
+ * Convert the clause database to the preprocessing format:
+ * - all binary clauses are moved to the pool (as problem clauses)
+ * - all clauses are sorted and have a signature
+ * - watch[l] contains all the clauses that contain l
+ * - occ[l] = number of occurrences of l
+ * - the learned clauses must be removed first
+ */
+static void inprocess_prepare_occurrences(sat_solver_t *solver) {
+  clause_pool_t *pool;
+  vector_t bins;
+  literal_t a[2];
+  literal_t *lit;
+  uint32_t i, n;
+  cidx_t cidx;
+
+  pool = &solver->pool;
+  assert(pool->learned == pool->size && pool->padding == 0);
+
+  init_vector(&bins);
+  collect_binary_clauses_and_reset_watches(solver, &bins);
+
+  solver->occ = (uint32_t *) safe_malloc(solver->nliterals * sizeof(uint32_t));
+  memset(solver->occ, 0, solver->nliterals * sizeof(uint32_t));
+
+  cidx = clause_pool_first_clause(pool);
+  while (cidx < pool->size) {
+    n = clause_length(pool, cidx);
+    lit = clause_literals(pool, cidx);
+    int_array_sort(lit, n);
+    set_clause_signature(pool, cidx);
+    add_clause_all_watch(solver, n, lit, cidx);
+    increase_occurrence_counts(solver, n, lit);
+    cidx = clause_pool_next_clause(pool, cidx);
+  }
+
+  for (i=0; i<bins.size; i += 2) {
+    a[0] = bins.data[i];
+    a[1] = bins.data[i+1];
+    assert(a[0] < a[1]);
+    cidx = clause_pool_add_problem_clause(pool, 2, a);
+    set_clause_signature(pool, cidx);
+    add_clause_all_watch(solver, 2, a, cidx);
+    increase_occurrence_counts(solver, 2, a);
+  }
+
+  delete_vector(&bins);
+}
+
+
+/*
+ * Add a learned clause saved before variable elimination
+ * - a = array of n literals, act = the clause activity
+ * - the clause is dropped if it contains an eliminated variable or if it's
+ *   true at level 0. False literals are removed.
+ */
+static void inprocess_restore_learned_clause(sat_solver_t *solver, uint32_t n, literal_t *a, float act) {
+  uint32_t i, j;
+  literal_t l;
+  cidx_t cidx;
+
+  assert(solver->decision_level == 0);
+
+  proof_save_clause(solver, n, a);
+
+  j = 0;
+  for (i=0; i<n; i++) {
+    l = a[i];
+    if (lit_is_eliminated(solver, l)) goto drop;
+    switch (lit_value(solver, l)) {
+    case VAL_FALSE:
+      break;
+
+    case VAL_TRUE:
+      goto drop;
+
+    default:
+      a[j] = l;
+      j ++;
+      break;
+    }
+  }
+
+  if (j > 0 && j < n) {
+    proof_add_clause(solver, j, a);
+    proof_delete_saved_clause(solver);
+  }
+
+  if (j == 0) {
+    add_empty_clause(solver);
+  } else if (j == 1) {
+    add_unit_clause(solver, a[0]);
+  } else if (j == 2) {
+    add_binary_clause(solver, a[0], a[1]);
+  } else {
+    cidx = clause_pool_add_learned_clause(&solver->pool, j, a);
+    set_learned_clause_activity(&solver->pool, cidx, act);
+    add_clause_watch(solver, a[0], cidx, a[1]);
+    add_clause_watch(solver, a[1], cidx, a[0]);
+  }
+  return;
+
+ drop:
+  proof_delete_saved_clause(solver);
+}
+
+
+/*
+ * Variable elimination during search
+ * - the learned clauses are saved then removed from the pool
+ * - we run one elimination round on the variables that have fewer
+ *   occurrences than after the previous round (cf. solver->elim_occ)
+ * - then we rebuild the watch vectors and restore the learned clauses
+ *   that don't contain eliminated variables.
+ */
+static void inprocess_elimination(sat_solver_t *solver) {
+  clause_pool_t *pool;
+  vector_t saved;
+  union { float f; uint32_t u; } act;
+  uint32_t i, n, nvars, elims_before;
+  cidx_t cidx;
+  bvar_t x;
+
+  assert(solver->decision_level == 0 && solver->exchange == NULL);
+
+  simplify_clause_database(solver);
+  if (solver->has_empty_clause) return;
+
+  pool = &solver->pool;
+  elims_before = solver->stats.pp_cheap_elims + solver->stats.pp_var_elims;
+
+  /*
+   * Save the learned clauses: length, activity, literals.
+   * The pool is compact after simplify_clause_database.
+   */
+  init_vector(&saved);
+  cidx = clause_pool_first_learned_clause(pool);
+  while (cidx < pool->size) {
+    n = clause_length(pool, cidx);
+    act.f = get_learned_clause_activity(pool, cidx);
+    vector_push(&saved, n);
+    vector_push(&saved, act.u);
+    for (i=0; i<n; i++) {
+      vector_push(&saved, clause_literals(pool, cidx)[i]);
+    }
+    cidx = clause_pool_next_clause(pool, cidx);
+  }
+  pool->size = pool->learned;
+  pool->available = pool->capacity - pool->size;
+  pool->num_learned_clauses = 0;
+  pool->num_learned_literals = 0;
+  assert(clause_pool_invariant(pool));
+
+  inprocess_prepare_occurrences(solver);
+
+  /*
+   * Pure literals, then elimination
+   */
+  nvars = solver->nvars;
+  for (x=1; x<nvars; x++) {
+    if (var_is_active(solver, x)) {
+      if (solver->occ[pos_lit(x)] == 0) {
+        pp_push_pure_literal(solver, neg_lit(x));
+      } else if (solver->occ[neg_lit(x)] == 0) {
+        pp_push_pure_literal(solver, pos_lit(x));
+      }
+    }
+  }
+  if (pp_empty_queue(solver)) {
+    prepare_elim_heap(&solver->elim, nvars);
+    for (x=1; x<nvars; x++) {
+      if (var_is_active(solver, x) && pp_elim_candidate(solver, x) &&
+          (solver->elim_occ[x] == 0 || var_occs(solver, x) < solver->elim_occ[x])) {
+        elim_heap_insert_var(solver, x);
+      }
+    }
+    elimination_round(solver, 0);
+  }
+
+  reset_clause_queue(solver);
+  reset_elim_heap(&solver->elim);
+  if (solver->has_empty_clause) goto done;
+
+  for (x=1; x<nvars; x++) {
+    solver->elim_occ[x] = var_occs(solver, x);
+  }
+  solver->elim_active = num_active_vars(solver);
+  solver->stats.inprocess_elims += solver->stats.pp_cheap_elims + solver->stats.pp_var_elims - elims_before;
+
+  prepare_for_search(solver);
+
+  /*
+   * Restore the learned clauses
+   */
+  i = 0;
+  while (i < saved.size && !solver->has_empty_clause) {
+    n = saved.data[i];
+    act.u = saved.data[i+1];
+    inprocess_restore_learned_clause(solver, n, (literal_t *) saved.data + i + 2, act.f);
+    i += n + 2;
+  }
+  if (solver->has_empty_clause) goto done;
+
+  level0_propagation(solver);
+
+  solver->simplify_assigned = 0;
+  solver->simplify_binaries = solver->binaries;
+  solver->target_assigned = 0;
+  solver->best_assigned = 0;
+  solver->last_learned = 1;
+
+ done:
+  if (solver->occ != NULL) {
+    safe_free(solver->occ);
+    solver->occ = NULL;
+  }
+  delete_vector(&saved);
+}
+
+
+/*
+ * Inprocessing round: must be called at decision level 0
+ * - variable elimination is done only if some variables were
+ *   removed since the last elimination round.
+ * - it's skipped if clauses are shared with other solvers (the
+ *   other solvers may still use the eliminated variables).
+ */
+static void nsat_inprocess(sat_solver_t *solver) {
+  assert(solver->decision_level == 0);
+
+  solver->stats.inprocess_calls ++;
+  proof_add_level0_units(solver);
+
+  if (solver->stats.conflicts >= solver->probing_next) {
+    failed_literal_probing(solver);
+    if (solver->has_empty_clause) return;
+  }
+
+  vivify_clauses(solver);
+  if (solver->has_empty_clause) return;
+
+  if (solver->exchange == NULL && num_active_vars(solver) < solver->elim_active) {
+    inprocess_elimination(solver);
+    if (solver->has_empty_clause) return;
+  }
+
+  report(solver, "inp");
+}
+
+
+/*
+ * MORE EXPERIMENT
+ */
+
+/*
+ * Check whether w is an empty watch vector
+ */
+static inline bool empty_watch(const watch_t *w) {
+  return w == NULL || w->size == 0;
+}
+
+/*
+ * Test literal l:
+ * - l must be unassigned
+ * - assign l then propagate, backtrack if that causes a conflict.
+ * - return true if l there's no conflict, false otherwise
+ */
+static bool test_literal(sat_solver_t *solver, literal_t l) {
+  assert(lit_is_unassigned(solver, l));
+
+  nsat_decide_literal(solver, l);
+  nsat_boolean_propagation(solver);
+  if (solver->conflict_tag != CTAG_NONE) {
+    backtrack_one_level(solver);
+    solver->conflict_tag = CTAG_NONE;
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Assign literals without creating a conflict
+ */
+static void build_assignment(sat_solver_t *solver) {
+  uint32_t i, n;
+  literal_t l;
+
+  n = solver->nvars;
+  for (i=1; i<n; i++) {
+    if (var_is_active(solver, i)) {
+      l = preferred_literal(solver, i);
+      if (empty_watch(solver->watch[not(l)])) {
+	nsat_decide_literal(solver, l);
+	nsat_boolean_propagation(solver);
+	assert(solver->conflict_tag == CTAG_NONE);
+	continue;
+      }
+      if (empty_watch(solver->watch[l])) {
+	nsat_decide_literal(solver, not(l));
+	nsat_boolean_propagation(solver);
+	assert(solver->conflict_tag == CTAG_NONE);
+      }
+    }
+  }
+
+  printf("c base assignment: level = %"PRIu32", top = %"PRIu32"\n", solver->decision_level, solver->stack.top);
+
+  solver->probing = true;
+
+  save_assignment(solver);
 
   for (i=1; i<n; i++) {
     if (var_is_active(solver, i)) {
@@ -10831,6 +11733,36 @@ static uint32_t prop_level(const sat_solver_t *solver) {
  */
 
 
+/*
+ * In stable mode, we use the Luby sequence to control restarts.
+ * We compute it using Knuth's reluctant doubling:
+ * - (u, v) is initially (1, 1)
+ * - the next pair is (u+1, 1) if (u & -u) == v, (u, 2v) otherwise.
+ * The successive values of v form the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+ */
+static void init_luby(sat_solver_t *solver) {
+  solver->luby_u = 1;
+  solver->luby_v = 1;
+  solver->luby_next = solver->stats.conflicts + solver->params.luby_unit;
+}
+
+static void next_luby(sat_solver_t *solver) {
+  uint32_t u, v;
+
+  u = solver->luby_u;
+  v = solver->luby_v;
+  if ((u & -u) == v) {
+    u ++;
+    v = 1;
+  } else {
+    v <<= 1;
+  }
+  solver->luby_u = u;
+  solver->luby_v = v;
+  solver->luby_next = solver->stats.conflicts + (uint64_t) v * solver->params.luby_unit;
+}
+
+
 /*
  * Initialize the restart counters
  */
@@ -10841,15 +11773,15 @@ static void init_restart(sat_solver_t *solver) {
   solver->restart_next = solver->params.restart_interval;
   solver->fast_count = 0;
 
-  // experimental
   solver->stabilizing = false;
   solver->stab_next = solver->stats.conflicts + STAB_INTERVAL;
   solver->stab_length = STAB_INTERVAL;
+  init_luby(solver);
 }
 
 
 /*
- * Stabilizing mode
+ * Switch between stable and focused mode
  */
 static bool stabilizing(sat_solver_t *solver) {
   if (solver->stats.conflicts >= solver->stab_next) {
@@ -10859,6 +11791,8 @@ static bool stabilizing(sat_solver_t *solver) {
       solver->stats.stabilizations ++;
       solver->try_assignment = false;
       solver->try_naive_search = false;
+      solver->target_assigned = 0;
+      init_luby(solver);
     } else {
       solver->stabilizing = false;
       solver->stab_next += 2 * solver->stab_length;
@@ -10877,9 +11811,8 @@ static bool stabilizing(sat_solver_t *solver) {
 static bool need_restart(sat_solver_t *solver) {
   uint64_t aux;
 
-  // optional
   if (stabilizing(solver)) {
-    return false;
+    return solver->stats.conflicts >= solver->luby_next;
   }
 
   if (solver->stats.conflicts >= solver->restart_next &&
@@ -10891,117 +11824,519 @@ static bool need_restart(sat_solver_t *solver) {
       return true;
     }
   }
-
-  return false;
+
+  return false;
+}
+
+static void done_restart(sat_solver_t *solver) {
+  solver->restart_next = solver->stats.conflicts + solver->params.restart_interval;
+  if (solver->stabilizing) {
+    next_luby(solver);
+    solver->target_assigned = 0;
+  }
+}
+
+
+/*
+ * WHEN TO REPHASE
+ */
+static void init_rephase(sat_solver_t *solver) {
+  solver->rephase_count = 0;
+  solver->rephase_next = solver->stats.conflicts + solver->params.rephase_interval;
+}
+
+static inline bool need_rephase(const sat_solver_t *solver) {
+  return solver->stats.conflicts >= solver->rephase_next;
+}
+
+static void done_rephase(sat_solver_t *solver) {
+  solver->rephase_next = solver->stats.conflicts +
+    (uint64_t) (solver->rephase_count + 1) * solver->params.rephase_interval;
+}
+
+
+/*
+ * WHEN TO INPROCESS
+ */
+static void init_inprocess(sat_solver_t *solver) {
+  uint32_t n;
+
+  n = solver->nvars;
+  solver->elim_occ = (uint32_t *) safe_realloc(solver->elim_occ, n * sizeof(uint32_t));
+  memset(solver->elim_occ, 0, n * sizeof(uint32_t));
+  solver->elim_active = UINT32_MAX;
+  solver->vivify_last = 0;
+  solver->vivify_skip = 0;
+  solver->inprocess_next = solver->stats.conflicts + solver->params.inprocess_interval;
+}
+
+static inline bool need_inprocess(const sat_solver_t *solver) {
+  return solver->params.inprocess_interval > 0 && solver->stats.conflicts >= solver->inprocess_next;
+}
+
+static void done_inprocess(sat_solver_t *solver) {
+  solver->inprocess_next = solver->stats.conflicts +
+    (uint64_t) (solver->stats.inprocess_calls + 1) * solver->params.inprocess_interval;
+}
+
+
+
+/*
+ * WHEN TO REDUCE
+ */
+
+/*
+ * Heuristic similar to Cadical:
+ * - we keep three counters:
+ *    reduce_next
+ *    reduce_inc
+ *    reduce_inc2
+ * - when the number of conflicts is bigger than reduce_next
+ *   we call reduce
+ * - after reduce, we update the counters:
+ *    reduce_inc = reduce_inc + reduce_inc2
+ *    reduce_next = reduce_next + reduce_inc
+ *    reduce_inc2 = max(0, reduce_inc2 - 1)
+ */
+
+/*
+ * Initialize the reduce counters
+ */
+static void init_reduce(sat_solver_t *solver) {
+  solver->reduce_next = solver->params.reduce_interval;
+  solver->reduce_inc = solver->params.reduce_interval;
+  solver->reduce_inc2 = solver->params.reduce_delta;
+}
+
+/*
+ * Check to trigger call to reduce_learned_clause_set
+ */
+static inline bool need_reduce(const sat_solver_t *solver) {
+  return solver->stats.conflicts >= solver->reduce_next &&
+    solver->pool.num_learned_clauses >= solver->params.reduce_interval;
+}
+
+/*
+ * Update counters after a call to reduce
+ */
+static void done_reduce(sat_solver_t *solver) {
+  solver->reduce_inc += solver->reduce_inc2;
+  solver->reduce_next = solver->stats.conflicts + solver->reduce_inc;
+  if (solver->reduce_inc2 > 0) {
+    solver->reduce_inc2 --;
+  }
+}
+
+
+/*
+ * WHEN TO SIMPLIFY
+ */
+
+/*
+ * Initialize counters
+ */
+static void init_simplify(sat_solver_t *solver) {
+  solver->simplify_assigned = 0;
+  solver->simplify_binaries = 0;
+  solver->simplify_subst_next = 0;
+  solver->simplify_next = 0;
+
+  //  solver->probing_next = 0;
+  solver->probing_next = 25 * solver->params.probing_interval;
+  solver->probing_budget = 0;
+  solver->probing_last = 0;
+  solver->probing_inc = solver->params.probing_interval;
+
+  solver->probing = false;
+}
+
+/*
+ * Heuristic to trigger a call to simplify_clause_database:
+ * - we call simplify when there's more literals assigned at level 0
+ *   (or more binary clauses)
+ */
+static bool need_simplify(const sat_solver_t *solver) {
+  return (level0_literals(solver) > solver->simplify_assigned ||
+	  solver->binaries > solver->simplify_binaries + solver->params.simplify_bin_delta ||
+	  (solver->binaries > solver->simplify_binaries && solver->stats.conflicts >= solver->simplify_next + 100000))
+    && solver->stats.conflicts >= solver->simplify_next;
+}
+
+
+/*
+ * Update counters after simplify
+ */
+static void done_simplify(sat_solver_t *solver) {
+  /*
+   * new_bins = number of binary clauses produced in this
+   *            simplification round
+   * these clauses have not been seen by the SCC construction.
+   * Some of the new bin clauses may have been deleted.
+   */
+  if (solver->simplify_new_bins > solver->binaries) {
+    solver->simplify_binaries = solver->binaries;
+  } else {
+    solver->simplify_binaries = solver->binaries - solver->simplify_new_bins;
+  }
+  solver->simplify_assigned = solver->stack.top;
+  solver->simplify_next = solver->stats.conflicts + solver->params.simplify_interval;
+}
+
+
+
+
+/*********************************
+ *  IMPORT OF SHARED CLAUSES     *
+ ********************************/
+
+/*
+ * Simplify clause c received from another solver and store the result in solver->aux
+ * - solver->aux must be reset after this call
+ * - substituted variables are replaced by their representative
+ * - false literals and duplicates are removed
+ * - return false if the clause is true, or if it contains an eliminated variable,
+ *   or if it contains complementary literals. The clause must be ignored in
+ *   all these cases.
+ */
+static bool simplify_imported_clause(sat_solver_t *solver, const exchange_clause_t *c) {
+  vector_t *v;
+  uint32_t i, j, n;
+  literal_t l;
+
+  assert(solver->decision_level == 0);
+
+  v = &solver->aux;
+  reset_vector(v);
+  for (i=0; i<c->size; i++) {
+    l = c->lit[i];
+    if (l >= solver->nliterals) return false;
+    l = full_lit_subst(solver, l);
+    if (lit_is_eliminated(solver, l)) return false;
+    switch (lit_value(solver, l)) {
+    case VAL_FALSE:
+      break;
+    case VAL_UNDEF_FALSE:
+    case VAL_UNDEF_TRUE:
+      vector_push(v, l);
+      break;
+    default:
+      return false; // true clause
+    }
+  }
+
+  n = v->size;
+  if (n > 1) {
+    int_array_sort((int32_t *) v->data, n);
+    l = v->data[0];
+    j = 1;
+    for (i=1; i<n; i++) {
+      if (v->data[i] != l) {
+        if (v->data[i] == not(l)) return false;
+        l = v->data[i];
+        v->data[j] = l;
+        j ++;
+      }
+    }
+    v->size = j;
+  }
+
+  return true;
+}
+
+
+/*
+ * Add the clause stored in solver->aux
+ * - all its literals are unassigned
+ * - long clauses are added as learned clauses
+ */
+static void add_imported_clause(sat_solver_t *solver) {
+  literal_t *a;
+  uint32_t i, n;
+
+  a = (literal_t *) solver->aux.data;
+  n = solver->aux.size;
+  if (n == 0) {
+    add_empty_clause(solver);
+  } else if (n == 1) {
+    add_unit_clause(solver, a[0]);
+  } else if (n == 2) {
+    add_binary_clause(solver, a[0], a[1]);
+  } else {
+    // clause_lbd requires all decision levels to be set
+    for (i=0; i<n; i++) {
+      if (solver->level[var_of(a[i])] == UINT32_MAX) {
+        solver->level[var_of(a[i])] = 0;
+      }
+    }
+    (void) add_learned_clause(solver, n, a);
+  }
+  solver->stats.imported_clauses ++;
+}
+
+
+/*
+ * Import all pending clauses from the exchange
+ * - must be called at decision level 0
+ * - sets solver->has_empty_clause if a conflict is detected
+ */
+static void import_shared_clauses(sat_solver_t *solver) {
+  exchange_clause_t c;
+
+  assert(solver->exchange != NULL && solver->decision_level == 0);
+
+  while (clause_exchange_next(solver->exchange, solver->exchange_id, &c)) {
+    if (simplify_imported_clause(solver, &c)) {
+      add_imported_clause(solver);
+      if (solver->has_empty_clause) break;
+    }
+  }
+  reset_vector(&solver->aux);
 }
 
-static void done_restart(sat_solver_t *solver) {
-  solver->restart_next = solver->stats.conflicts + solver->params.restart_interval;
+
+/*
+ * Check whether there are clauses to import
+ */
+static inline bool need_import(const sat_solver_t *solver) {
+  return solver->exchange != NULL &&
+    clause_exchange_has_pending(solver->exchange, solver->exchange_id);
 }
 
 
+/*
+ * Check whether the search must stop: either nsat_stop_search was called
+ * or another solver has finished
+ */
+static inline bool search_cancelled(const sat_solver_t *solver) {
+  return __atomic_load_n(&solver->interrupted, __ATOMIC_RELAXED) ||
+    (solver->exchange != NULL && clause_exchange_done(solver->exchange));
+}
 
 /*
- * WHEN TO REDUCE
+ * Check whether the conflict budget is exhausted
  */
+static inline bool search_budget_exhausted(const sat_solver_t *solver) {
+  return solver->params.max_conflicts > 0 && solver->stats.conflicts >= solver->params.max_conflicts;
+}
+
+
+
+/**********************
+ *  CUBE GENERATION   *
+ *********************/
 
 /*
- * Heuristic similar to Cadical:
- * - we keep three counters:
- *    reduce_next
- *    reduce_inc
- *    reduce_inc2
- * - when the number of conflicts is bigger than reduce_next
- *   we call reduce
- * - after reduce, we update the counters:
- *    reduce_inc = reduce_inc + reduce_inc2
- *    reduce_next = reduce_next + reduce_inc
- *    reduce_inc2 = max(0, reduce_inc2 - 1)
+ * Number of candidate variables for lookahead at each node
  */
+#define LOOKAHEAD_CANDIDATES 32
 
 /*
- * Initialize the reduce counters
+ * Estimate of the number of clauses that contain literal l
+ * - binary clauses use one element in the watch vector, other clauses use two
  */
-static void init_reduce(sat_solver_t *solver) {
-  solver->reduce_next = solver->params.reduce_interval;
-  solver->reduce_inc = solver->params.reduce_interval;
-  solver->reduce_inc2 = solver->params.reduce_delta;
+static inline uint32_t lookahead_occs(const sat_solver_t *solver, literal_t l) {
+  const watch_t *w;
+
+  w = solver->watch[l];
+  return (w == NULL) ? 0 : w->size;
 }
 
 /*
- * Check to trigger call to reduce_learned_clause_set
+ * Select candidate variables for lookahead:
+ * - we keep the active variables with the highest product of occurrences
+ *   (positive and negative).
+ * - the candidates are stored in a[0 ... n-1], in decreasing score order
+ * - a must be large enough to store LOOKAHEAD_CANDIDATES variables
+ * - return n
  */
-static inline bool need_reduce(const sat_solver_t *solver) {
-  return solver->stats.conflicts >= solver->reduce_next &&
-    solver->pool.num_learned_clauses >= solver->params.reduce_interval;
+static uint32_t lookahead_candidates(const sat_solver_t *solver, bvar_t *a) {
+  uint64_t score[LOOKAHEAD_CANDIDATES];
+  uint64_t s;
+  uint32_t j, n;
+  bvar_t x;
+
+  n = 0;
+  for (x=1; x<solver->nvars; x++) {
+    if (var_is_active(solver, x)) {
+      s = (uint64_t) (lookahead_occs(solver, pos_lit(x)) + 1) * (lookahead_occs(solver, neg_lit(x)) + 1);
+      if (n < LOOKAHEAD_CANDIDATES) {
+	n ++;
+      } else if (s <= score[n-1]) {
+	continue;
+      }
+      // insert x in a[0 ... n-1]
+      j = n - 1;
+      while (j > 0 && score[j-1] < s) {
+	score[j] = score[j-1];
+	a[j] = a[j-1];
+	j --;
+      }
+      score[j] = s;
+      a[j] = x;
+    }
+  }
+
+  return n;
 }
 
 /*
- * Update counters after a call to reduce
+ * Lookahead on literal l:
+ * - l must be unassigned
+ * - assign l, propagate, then backtrack
+ * - return the number of literals assigned by this propagation (including l)
+ * - return -1 if the propagation causes a conflict
  */
-static void done_reduce(sat_solver_t *solver) {
-  solver->reduce_inc += solver->reduce_inc2;
-  solver->reduce_next = solver->stats.conflicts + solver->reduce_inc;
-  if (solver->reduce_inc2 > 0) {
-    solver->reduce_inc2 --;
+static int32_t lookahead_literal(sat_solver_t *solver, literal_t l) {
+  uint32_t top;
+  int32_t n;
+
+  assert(lit_is_unassigned(solver, l));
+
+  top = solver->stack.top;
+  nsat_decide_literal(solver, l);
+  nsat_boolean_propagation(solver);
+  if (solver->conflict_tag != CTAG_NONE) {
+    solver->conflict_tag = CTAG_NONE;
+    n = -1;
+  } else {
+    n = solver->stack.top - top;
   }
-}
+  backtrack_one_level(solver);
 
+  return n;
+}
 
 /*
- * WHEN TO SIMPLIFY
+ * Assign literal l and propagate
+ * - return false if that causes a conflict. The decision is undone in this case.
  */
+static bool lookahead_assign(sat_solver_t *solver, literal_t l) {
+  assert(lit_is_unassigned(solver, l));
+
+  nsat_decide_literal(solver, l);
+  nsat_boolean_propagation(solver);
+  if (solver->conflict_tag != CTAG_NONE) {
+    solver->conflict_tag = CTAG_NONE;
+    backtrack_one_level(solver);
+    return false;
+  }
+  return true;
+}
 
 /*
- * Initialize counters
+ * Lookahead at the current node:
+ * - if one literal of a candidate variable causes a conflict, its negation
+ *   is assigned (as a new decision).
+ * - return false if the current node is refuted (i.e., both literals of a
+ *   candidate cause a conflict)
+ * - otherwise, store the best branching literal in *branch and return true.
+ *   *branch is null_literal if there's no candidate.
+ * - the caller must undo the extra decisions if any.
  */
-static void init_simplify(sat_solver_t *solver) {
-  solver->simplify_assigned = 0;
-  solver->simplify_binaries = 0;
-  solver->simplify_subst_next = 0;
-  solver->simplify_next = 0;
+static bool lookahead(sat_solver_t *solver, literal_t *branch) {
+  bvar_t cand[LOOKAHEAD_CANDIDATES];
+  uint64_t s, best_score;
+  uint32_t i, n;
+  int32_t pos, neg;
+  literal_t best;
+  bvar_t x;
 
-  //  solver->probing_next = 0;
-  solver->probing_next = 25 * solver->params.probing_interval;
-  solver->probing_budget = 0;
-  solver->probing_last = 0;
-  solver->probing_inc = solver->params.probing_interval;
+  n = lookahead_candidates(solver, cand);
 
-  solver->probing = false;
+  best = null_literal;
+  best_score = 0;
+  for (i=0; i<n; i++) {
+    x = cand[i];
+    if (var_is_assigned(solver, x)) continue; // implied by a previous candidate
+
+    pos = lookahead_literal(solver, pos_lit(x));
+    neg = lookahead_literal(solver, neg_lit(x));
+    if (pos < 0 && neg < 0) {
+      return false;
+    }
+    if (pos < 0 || neg < 0) {
+      // failed literal: assert the other one
+      if (! lookahead_assign(solver, pos < 0 ? neg_lit(x) : pos_lit(x))) {
+	return false;
+      }
+      continue;
+    }
+
+    // score of x: as in march
+    s = (uint64_t) pos * neg + pos + neg;
+    if (s > best_score) {
+      best_score = s;
+      best = (pos >= neg) ? pos_lit(x) : neg_lit(x);
+    }
+  }
+
+  // a previous failed literal may have assigned best
+  if (best != null_literal && lit_is_assigned(solver, best)) {
+    best = null_literal;
+  }
+  *branch = best;
+
+  return true;
 }
 
 /*
- * Heuristic to trigger a call to simplify_clause_database:
- * - we call simplify when there's more literals assigned at level 0
- *   (or more binary clauses)
+ * Add the decision literals of the current node as a cube
  */
-static bool need_simplify(const sat_solver_t *solver) {
-  return (level0_literals(solver) > solver->simplify_assigned ||
-	  solver->binaries > solver->simplify_binaries + solver->params.simplify_bin_delta ||
-	  (solver->binaries > solver->simplify_binaries && solver->stats.conflicts >= solver->simplify_next + 100000))
-    && solver->stats.conflicts >= solver->simplify_next;
-}
+static void add_cube(const sat_solver_t *solver, ivector_t *cubes) {
+  uint32_t k, n;
 
+  n = solver->decision_level;
+  ivector_push(cubes, n);
+  for (k=1; k<=n; k++) {
+    ivector_push(cubes, solver->stack.lit[solver->stack.level_index[k]]);
+  }
+}
 
 /*
- * Update counters after simplify
+ * Number of cubes in vector cubes
  */
-static void done_simplify(sat_solver_t *solver) {
-  /*
-   * new_bins = number of binary clauses produced in this
-   *            simplification round
-   * these clauses have not been seen by the SCC construction.
-   * Some of the new bin clauses may have been deleted.
-   */
-  if (solver->simplify_new_bins > solver->binaries) {
-    solver->simplify_binaries = solver->binaries;
-  } else {
-    solver->simplify_binaries = solver->binaries - solver->simplify_new_bins;
+static uint32_t num_cubes(const ivector_t *cubes) {
+  uint32_t i, n;
+
+  n = 0;
+  for (i=0; i<cubes->size; i += cubes->data[i] + 1) {
+    n ++;
   }
-  solver->simplify_assigned = solver->stack.top;
-  solver->simplify_next = solver->stats.conflicts + solver->params.simplify_interval;
+  return n;
 }
 
+/*
+ * Split the current node to depth d
+ */
+static void lookahead_split(sat_solver_t *solver, uint32_t d, ivector_t *cubes) {
+  uint32_t level;
+  literal_t l;
+
+  if (d == 0) {
+    add_cube(solver, cubes);
+    return;
+  }
+
+  level = solver->decision_level;
+  if (lookahead(solver, &l)) {
+    if (l == null_literal) {
+      add_cube(solver, cubes);
+    } else {
+      if (lookahead_assign(solver, l)) {
+	lookahead_split(solver, d - 1, cubes);
+	backtrack_one_level(solver);
+      }
+      if (lit_is_unassigned(solver, not(l)) && lookahead_assign(solver, not(l))) {
+	lookahead_split(solver, d - 1, cubes);
+	backtrack_one_level(solver);
+      }
+    }
+  }
+
+  while (solver->decision_level > level) {
+    backtrack_one_level(solver);
+  }
+}
 
 
 
@@ -11132,11 +12467,124 @@ solver_status_t nsat_apply_preprocessing(sat_solver_t *solver) {
     extend_assignment(solver);
   }
 
+ done:
+  if (solver->proof != NULL) {
+    flush_drat_writer(solver->proof);
+  }
+  return solver->status;
+}
+
+
+/*
+ * Cube generation
+ */
+solver_status_t nsat_generate_cubes(sat_solver_t *solver, uint32_t depth, ivector_t *cubes) {
+  uint32_t n;
+
+  assert(! solver->preprocess);
+
+  ivector_reset(cubes);
+  if (solver->has_empty_clause) goto done;
+
+  level0_propagation(solver);
+  if (solver->has_empty_clause) goto done;
+
+  n = solver->stats.decisions;
+  lookahead_split(solver, depth, cubes);
+  solver->stats.decisions = n;
+  assert(solver->decision_level == 0);
+
+  if (cubes->size == 0) {
+    // all cubes refuted
+    add_empty_clause(solver);
+  }
+
+  if (solver->verbosity >= 1) {
+    fprintf(stderr, "c lookahead: %"PRIu32" cubes (depth %"PRIu32")\n", num_cubes(cubes), depth);
+  }
+
  done:
   return solver->status;
 }
 
 
+/*
+ * Copy src's problem into dst
+ * - we copy the level-0 literals, then the binary clauses (stored in
+ *   the watch vectors), then the problem clauses from the pool.
+ */
+void nsat_copy_problem(sat_solver_t *dst, const sat_solver_t *src, bool pp) {
+  const clause_pool_t *pool;
+  const watch_t *w;
+  vector_t v;
+  uint32_t i, n, k;
+  literal_t l, l0;
+  cidx_t cidx;
+
+  assert(! src->preprocess && src->decision_level == 0);
+
+  init_nsat_solver(dst, src->nvars, pp);
+  nsat_solver_add_vars(dst, src->nvars - 1);
+  dst->params = src->params;
+
+  if (src->has_empty_clause) {
+    add_empty_clause(dst);
+    return;
+  }
+
+  init_vector(&v);
+
+  for (i=0; i<src->stack.top; i++) {
+    reset_vector(&v);
+    vector_push(&v, src->stack.lit[i]);
+    nsat_solver_simplify_and_add_clause(dst, 1, (literal_t *) v.data);
+  }
+
+  for (l0=0; l0<src->nliterals; l0++) {
+    w = src->watch[l0];
+    if (w == NULL) continue;
+    i = 0;
+    while (i < w->size) {
+      k = w->data[i];
+      if (idx_is_literal(k)) {
+	l = idx2lit(k);
+	if (l0 < l) {
+	  reset_vector(&v);
+	  vector_push(&v, l0);
+	  vector_push(&v, l);
+	  nsat_solver_simplify_and_add_clause(dst, 2, (literal_t *) v.data);
+	}
+	i ++;
+      } else {
+	i += 2; // skip the clause index and the blocker
+      }
+    }
+  }
+
+  pool = &src->pool;
+  cidx = clause_pool_first_clause(pool);
+  while (cidx < pool->learned) {
+    n = clause_length(pool, cidx);
+    reset_vector(&v);
+    for (i=0; i<n; i++) {
+      vector_push(&v, clause_literals(pool, cidx)[i]);
+    }
+    nsat_solver_simplify_and_add_clause(dst, n, (literal_t *) v.data);
+    cidx = clause_pool_next_clause(pool, cidx);
+  }
+
+  delete_vector(&v);
+}
+
+
+/*
+ * Stop the search
+ */
+void nsat_stop_search(sat_solver_t *solver) {
+  __atomic_store_n(&solver->interrupted, true, __ATOMIC_RELAXED);
+}
+
+
 /*
  * Solving procedure
  */
@@ -11154,6 +12602,7 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
   init_restart(solver);
   init_reduce(solver);
   init_simplify(solver);
+  init_phases(solver);
 
   if (solver->preprocess) {
     // preprocess + one round of simplification
@@ -11172,15 +12621,22 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
   done_simplify(solver);
   if (solver->has_empty_clause) goto done;
 
-  failed_literal_probing(solver);
-  if (solver->has_empty_clause) goto done;
-
-  try_naive_search(solver);
+  /*
+   * Probing and the naive search do not count conflicts: skip them
+   * if there's a conflict budget.
+   */
+  if (solver->params.max_conflicts == 0) {
+    failed_literal_probing(solver);
+    if (solver->has_empty_clause) goto done;
+    try_naive_search(solver);
+  }
   solver->stats.conflicts = 0;
   solver->stats.decisions = 0;
   solver->stats.starts = 1;
   solver->try_assignment = false;
   solver->try_naive_search = true;
+  init_rephase(solver);
+  init_inprocess(solver);
 
   report(solver, "");
 
@@ -11197,14 +12653,21 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
       // conflict
       if (solver->decision_level == 0) {
 	export_last_conflict(solver);
+	proof_add_clause(solver, 0, NULL);
 	solver->status = STAT_UNSAT;
 	break;
       }
+      // the assignment is conflict-free up to the current decision level
+      update_target_and_best(solver, solver->stack.level_index[solver->decision_level]);
       resolve_conflict(solver);
       check_watch_vectors(solver);
       if (! solver->stabilizing) {
 	decay_clause_activities(solver);
       }
+      if (search_cancelled(solver) || search_budget_exhausted(solver)) {
+	solver->status = STAT_UNKNOWN;
+	break;
+      }
 
     } else {
       // no conflict
@@ -11216,9 +12679,36 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
 	nsat_simplify(solver);
 	done_simplify(solver);
 	if (solver->has_empty_clause) break;
+	if (solver->exchange != NULL) {
+	  import_shared_clauses(solver);
+	  if (solver->has_empty_clause) break;
+	}
+      } else if (need_inprocess(solver)) {
+	update_target_and_best(solver, solver->stack.top);
+	full_restart(solver);
+	done_restart(solver);
+	nsat_inprocess(solver);
+	done_inprocess(solver);
+	if (solver->has_empty_clause) break;
+
+      } else if (need_rephase(solver)) {
+	update_target_and_best(solver, solver->stack.top);
+	full_restart(solver);
+	done_restart(solver);
+	rephase(solver);
+	done_rephase(solver);
+
       } else if (need_restart(solver)) {
-	partial_restart(solver);
+	update_target_and_best(solver, solver->stack.top);
+	if (need_import(solver)) {
+	  // imported clauses are added at level 0
+	  full_restart(solver);
+	  import_shared_clauses(solver);
+	} else {
+	  partial_restart(solver);
+	}
 	done_restart(solver);
+	if (solver->has_empty_clause) break;
 
       } else if (need_reduce(solver)) {
 	nsat_reduce_learned_clause_set(solver);
@@ -11234,7 +12724,7 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
 	  solver->status = STAT_SAT;
 	  break;
 	}
-	nsat_decide_literal(solver, preferred_literal(solver, x));
+	nsat_decide_literal(solver, decision_literal(solver, x));
       }
     }
   }
@@ -11242,12 +12732,17 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
   report(solver, "end");
 
  done:
-  assert(solver->status == STAT_UNSAT || solver->status == STAT_SAT);
+  assert(solver->status == STAT_UNSAT || solver->status == STAT_SAT ||
+	 (solver->status == STAT_UNKNOWN && (search_cancelled(solver) || search_budget_exhausted(solver))));
 
   if (solver->status == STAT_SAT) {
     extend_assignment(solver);
   }
 
+  if (solver->proof != NULL) {
+    flush_drat_writer(solver->proof);
+  }
+
   if (solver->verbosity >= 2) {
     nsat_show_statistics(stderr, solver);
   }
@@ -11284,11 +12779,23 @@ void nsat_show_statistics(FILE *f, const sat_solver_t *solver) {
   fprintf(f, "c  probed literals         : %"PRIu64"\n", stat->probed_literals);
   fprintf(f, "c  failed literals         : %"PRIu32"\n", stat->failed_literals);
   fprintf(f, "c  probing progatations    : %"PRIu64"\n", stat->probing_propagations);
+  fprintf(f, "c  inprocessings           : %"PRIu32"\n", stat->inprocess_calls);
+  fprintf(f, "c  vivified clauses        : %"PRIu64"\n", stat->vivified_clauses);
+  fprintf(f, "c  vivified literals       : %"PRIu64"\n", stat->vivified_literals);
+  fprintf(f, "c  inprocess elims         : %"PRIu32"\n", stat->inprocess_elims);
+  if (solver->proof != NULL) {
+    fprintf(f, "c  proof additions         : %"PRIu64"\n", solver->proof->additions);
+    fprintf(f, "c  proof deletions         : %"PRIu64"\n", solver->proof->deletions);
+  }
   fprintf(f, "c  lits in pb. clauses     : %"PRIu32"\n", solver->pool.num_prob_literals);
   fprintf(f, "c  lits in learned clauses : %"PRIu32"\n", solver->pool.num_learned_literals);
   fprintf(f, "c  subsumed lits.          : %"PRIu64"\n", stat->subsumed_literals);
   fprintf(f, "c  deleted pb. clauses     : %"PRIu64"\n", stat->prob_clauses_deleted);
   fprintf(f, "c  deleted learned clauses : %"PRIu64"\n", stat->learned_clauses_deleted);
+  if (solver->exchange != NULL) {
+    fprintf(f, "c  exported clauses        : %"PRIu64"\n", stat->exported_clauses);
+    fprintf(f, "c  imported clauses        : %"PRIu64"\n", stat->imported_clauses);
+  }
   fprintf(f, "c\n");
 }
 
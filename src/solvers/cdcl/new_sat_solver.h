@@ -35,7 +35,10 @@
 #include <assert.h>
 
 #include "solvers/cdcl/smt_core_base_types.h"
+#include "solvers/cdcl/clause_exchange.h"
+#include "solvers/cdcl/drat_writer.h"
 #include "solvers/cdcl/new_gates.h"
+#include "utils/int_vectors.h"
 #include "utils/tag_map.h"
 
 
@@ -571,15 +574,19 @@ typedef struct solver_stats_s {
   uint64_t prob_clauses_deleted;     // number of problem clauses deleted
   uint64_t learned_clauses_deleted;  // number of learned clauses deleted
   uint64_t subsumed_literals;        // removed from learned clause (cf. simplify_learned_clause)
+  uint64_t exported_clauses;         // number of learned clauses sent to other solvers
+  uint64_t imported_clauses;         // number of clauses received from other solvers
 
   uint32_t starts;                   // 1 + number of restarts
   uint32_t stabilizations;           // number of stabilization intervals
+  uint32_t rephases;                 // number of calls to rephase
   uint32_t simplify_calls;           // number of calls to simplify_clause_database
   uint32_t reduce_calls;             // number of calls to reduce_learned_clause_set
   uint32_t scc_calls;                // number of calls to try_scc_simplification
   uint32_t try_equiv_calls;          // number of calls to try_equivalent_vars (includes preprocessing)
   uint32_t subst_calls;              // number of calls to apply_substitution
   uint32_t probe_calls;              // number of calls to failed_literal_probing
+  uint32_t inprocess_calls;          // number of calls to nsat_inprocess
 
   // Substitutions
   uint32_t subst_vars;               // number of variables eliminated by substitution
@@ -591,6 +598,11 @@ typedef struct solver_stats_s {
   uint64_t probing_propagations;     // propagations during probing
   uint32_t failed_literals;          // failed literals
 
+  // Inprocessing
+  uint64_t vivified_clauses;         // number of clauses strengthened by vivification
+  uint64_t vivified_literals;        // number of literals removed by vivification
+  uint32_t inprocess_elims;          // variables eliminated during search (also counted in pp_xxx_elims)
+
   // Preprocessing statistics
   uint32_t pp_pure_lits;             // number of pure literals removed
   uint32_t pp_unit_lits;             // number of unit literals removed
@@ -625,6 +637,9 @@ typedef struct solver_param_s {
   uint32_t reduce_interval;    // Number of conflicts between two calls to reduce
   uint32_t reduce_delta;       // Adjustment to reduce_interval
   uint32_t restart_interval;   // Minimal number of conflicts between two restarts
+  uint32_t luby_unit;          // Restart interval unit in stable mode (Luby sequence)
+  uint32_t rephase_interval;   // Base number of conflicts between two calls to rephase
+  uint64_t max_conflicts;      // Search budget: stop after that many conflicts (0 means no limit)
 
   /*
    * Heuristics/parameters for preprocessing
@@ -664,6 +679,15 @@ typedef struct solver_param_s {
   uint64_t probing_max_budget;  // Maximal budget (number of propagations_
   double probing_ratio;         // Fraction of propagations for probing (relative to search).
 
+  /*
+   * Inprocessing: vivification + variable elimination + probing between restarts
+   * - inprocess_interval = 0 disables inprocessing
+   */
+  uint32_t inprocess_interval;  // Base number of conflicts between two calls to inprocess
+  uint64_t vivify_min_budget;   // Minimal budget for vivification (number of propagations)
+  uint64_t vivify_max_budget;   // Maximal budget for vivification
+  double vivify_ratio;          // Fraction of propagations for vivification (relative to search)
+
 } solver_param_t;
 
 
@@ -922,6 +946,22 @@ typedef struct sat_solver_s {
   uint64_t probing_last;       // NUmber of propagations since the last probe
   uint64_t probing_inc;        // Increment to probing next
 
+  /*
+   * Inprocessing:
+   * - inprocess_next = number of conflicts before the next call to inprocess
+   * - vivify_last = number of propagations at the end of the last vivification
+   * - vivify_skip = number of problem clauses already vivified
+   *   (we continue from there in the next round)
+   * - elim_occ[x] = number of occurrences of x after the last elimination round
+   *   (we only try to eliminate x again if this number decreases).
+   * - elim_active = number of active variables after the last elimination round
+   */
+  uint64_t inprocess_next;
+  uint64_t vivify_last;
+  uint32_t vivify_skip;
+  uint32_t *elim_occ;
+  uint32_t elim_active;
+
   /*
    * Exponential moving averages for restarts
    * (based on "Evaluating CDCL Restart Schemes" by Biere & Froehlich, 2015).
@@ -938,12 +978,40 @@ typedef struct sat_solver_s {
   uint64_t level_ema;
 
   /*
-   * Experimental: "stabilizing" periods
-   * (based on Cadical). During a stabilizing period, we don't restart.
+   * Stable and focused modes (based on Cadical):
+   * - stabilizing is true in stable mode
+   * - the mode changes when the number of conflicts reaches stab_next
+   * - in focused mode, restarts are controlled by the EMAs above
+   * - in stable mode, the restart intervals follow the Luby sequence
+   *   (computed by reluctant doubling): luby_u and luby_v are the
+   *   state of the sequence, luby_next is the number of conflicts
+   *   before the next restart. Decisions use the target phase.
    */
   bool stabilizing;
   uint64_t stab_next;
   uint64_t stab_length;
+  uint32_t luby_u;
+  uint32_t luby_v;
+  uint64_t luby_next;
+
+  /*
+   * Target and best phases:
+   * - target_phase[x] = value of x in the longest conflict-free
+   *   assignment found since the last restart (in stable mode)
+   * - best_phase[x] = value of x in the longest conflict-free
+   *   assignment found since the last rephase
+   * - the value is either VAL_FALSE or VAL_TRUE, or 0 if x has
+   *   no target/best phase.
+   * - target_assigned, best_assigned = size of these assignments
+   * - rephase_next = number of conflicts before the next rephase
+   * - rephase_count = number of calls to rephase so far
+   */
+  uint8_t *target_phase;
+  uint8_t *best_phase;
+  uint32_t target_assigned;
+  uint32_t best_assigned;
+  uint64_t rephase_next;
+  uint32_t rephase_count;
 
   /*
    * Probing flag
@@ -1019,6 +1087,30 @@ typedef struct sat_solver_s {
    */
   FILE *data;
 
+  /*
+   * Proof output (DRAT)
+   * - proof = NULL if proofs are disabled
+   * - proof_units = number of level-0 literals of the stack already
+   *   written as unit clauses
+   * - proof_clause = copy of a clause before it's modified in place
+   */
+  drat_writer_t *proof;
+  uint32_t proof_units;
+  vector_t proof_clause;
+
+  /*
+   * Clause sharing with other solvers (portfolio)
+   * - exchange = NULL if sharing is disabled
+   * - exchange_id = index of this solver in the exchange
+   */
+  clause_exchange_t *exchange;
+  uint32_t exchange_id;
+
+  /*
+   * Flag set by nsat_stop_search (possibly from another thread)
+   */
+  bool interrupted;
+
 } sat_solver_t;
 
 
@@ -1177,6 +1269,30 @@ extern void nsat_set_reduce_delta(sat_solver_t *solver, uint32_t d);
  */
 extern void nsat_set_restart_interval(sat_solver_t *solver, uint32_t n);
 
+/*
+ * Restart interval unit in stable mode: the k-th restart
+ * happens after luby(k) * n conflicts
+ */
+extern void nsat_set_luby_unit(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Base interval between two rephasing: the k-th rephase
+ * happens after k * n more conflicts
+ */
+extern void nsat_set_rephase_interval(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Base interval between two inprocessing rounds: the k-th round
+ * happens after k * n more conflicts. n = 0 disables inprocessing.
+ */
+extern void nsat_set_inprocess_interval(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Conflict budget: nsat_solve returns STAT_UNKNOWN after n conflicts
+ * in the main search. n = 0 means no limit (this is the default).
+ */
+extern void nsat_set_max_conflicts(sat_solver_t *solver, uint64_t n);
+
 
 
 /*
@@ -1228,6 +1344,21 @@ extern void nsat_set_simplify_bin_delta(sat_solver_t *solver, uint32_t d);
  */
 extern void nsat_set_simplify_subst_delta(sat_solver_t *solver, uint32_t d);
 
+/*
+ * Enable clause sharing:
+ * - ex = exchange shared with other solvers working on the same problem
+ * - i = index of this solver in ex (must be less than ex->nworkers)
+ *
+ * The solver then exports learned units, binary clauses, and short learned
+ * clauses of LBD <= keep_lbd. It imports the clauses published by the other
+ * solvers at restarts. It also stops the search (with status STAT_UNKNOWN) as
+ * soon as another solver has finished (cf. clause_exchange_set_winner).
+ *
+ * All the solvers sharing ex must be constructed from the same clauses and
+ * the same variables.
+ */
+extern void nsat_set_clause_exchange(sat_solver_t *solver, clause_exchange_t *ex, uint32_t i);
+
 
 /*********************
  *  CLAUSE ADDITION  *
@@ -1255,9 +1386,20 @@ extern void nsat_solver_simplify_and_add_clause(sat_solver_t *solver, uint32_t n
 /*
  * Check satisfiability of the set of clauses
  * - result = either STAT_SAT or STAT_UNSAT
+ * - the result can also be STAT_UNKNOWN if the search was stopped by
+ *   nsat_stop_search, or if clause sharing is enabled and another solver
+ *   finished first.
  */
 extern solver_status_t nsat_solve(sat_solver_t *solver);
 
+/*
+ * Stop the search:
+ * - nsat_solve returns STAT_UNKNOWN at the next conflict
+ * - this can be called from another thread. It has an effect even if
+ *   nsat_solve has not started yet.
+ */
+extern void nsat_stop_search(sat_solver_t *solver);
+
 
 /*
  * Read the status
@@ -1277,6 +1419,41 @@ static inline solver_status_t nsat_status(sat_solver_t *solver) {
  */
 extern solver_status_t nsat_apply_preprocessing(sat_solver_t *solver);
 
+/*
+ * Split the problem into cubes (for cube-and-conquer)
+ * - this must be called after clause addition, on a solver constructed
+ *   without preprocessing (i.e., solver->preprocess must be false)
+ * - depth = maximal number of branching literals per cube
+ * - on exit, the solver is back to decision level 0. It may have new
+ *   level-0 literals but no learned clauses.
+ *
+ * The cubes are built by lookahead: at each node, we assign the two
+ * literals of a few candidate variables and propagate (like in failed-literal
+ * probing). We branch on the variable whose two literals imply the most
+ * literals. Cubes that lead to a conflict are dropped.
+ *
+ * Each cube is a conjunction of literals and is stored in vector cubes as
+ * its size n followed by its n literals. The disjunction of all the cubes
+ * is implied by the problem. The cubes may include literals implied by the
+ * other literals of the cube.
+ *
+ * Result:
+ * - STAT_UNSAT if the problem is unsat (no cubes are produced)
+ * - STAT_UNKNOWN otherwise
+ */
+extern solver_status_t nsat_generate_cubes(sat_solver_t *solver, uint32_t depth, ivector_t *cubes);
+
+/*
+ * Initialize dst as a copy of src's problem
+ * - dst gets the same variables, problem clauses, and search parameters as src
+ * - pp = preprocessing flag for dst (cf. init_nsat_solver)
+ * - src must be at decision level 0 and constructed without preprocessing
+ *   (e.g., after clause addition or after nsat_generate_cubes)
+ * - src is not modified so several threads can copy the same src in parallel
+ * - learned clauses and gate definitions are not copied
+ */
+extern void nsat_copy_problem(sat_solver_t *dst, const sat_solver_t *src, bool pp);
+
 
 /********************
  * EXPORT TO DIMACS *
@@ -1397,6 +1574,22 @@ extern void nsat_show_statistics(FILE *f, const sat_solver_t *solver);
  */
 extern void nsat_open_datafile(sat_solver_t *solver, const char *name);
 
+/*
+ * Produce a proof of unsatisfiability in binary DRAT format
+ * - name = name of the proof file
+ * - return false if the file can't be created
+ *
+ * This must be called before nsat_solve (or nsat_apply_preprocessing).
+ * All the clauses learned, strengthened, or deleted by the solver are then
+ * written to the file, relative to the clauses added before the call.
+ * If the problem is unsat, the proof ends with the empty clause.
+ *
+ * When proofs are enabled, the solver doesn't use gate-based equivalence
+ * detection (these steps can't be checked by unit propagation).
+ * Proofs are not supported with clause exchange or cube generation.
+ */
+extern bool nsat_open_proof_file(sat_solver_t *solver, const char *name);
+
 
 
 #endif /* __NEW_SAT_SOLVER_H */
@@ -22,6 +22,7 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 #include <float.h>
 
 #include "solvers/cdcl/smt_core.h"
@@ -104,6 +105,60 @@ static inline uint32_t random_uint(smt_core_t *s, uint32_t n) {
 
 
 
+/*******************
+ *  CLAUSE ARENA   *
+ ******************/
+
+/*
+ * Initialize arena a: initial capacity = DEF_CLAUSE_ARENA_SIZE
+ */
+static void init_clause_arena(clause_arena_t *a) {
+  a->data = (uint32_t *) safe_malloc(DEF_CLAUSE_ARENA_SIZE * sizeof(uint32_t));
+  a->size = 0;
+  a->capacity = DEF_CLAUSE_ARENA_SIZE;
+  a->wasted = 0;
+}
+
+/*
+ * Free memory
+ */
+static void delete_clause_arena(clause_arena_t *a) {
+  safe_free(a->data);
+  a->data = NULL;
+}
+
+/*
+ * Empty the arena
+ */
+static void reset_clause_arena(clause_arena_t *a) {
+  a->size = 0;
+  a->wasted = 0;
+}
+
+/*
+ * Make the arena large enough for n more elements
+ */
+static void extend_clause_arena(clause_arena_t *a, uint32_t n) {
+  uint32_t cap;
+
+  if (n > MAX_CLAUSE_ARENA_SIZE - a->size) {
+    out_of_memory();
+  }
+  n += a->size;
+  cap = a->capacity;
+  while (cap < n) {
+    cap += cap >> 1; // 50% larger
+    if (cap > MAX_CLAUSE_ARENA_SIZE) {
+      cap = MAX_CLAUSE_ARENA_SIZE;
+    }
+  }
+  a->data = (uint32_t *) safe_realloc(a->data, cap * sizeof(uint32_t));
+  a->capacity = cap;
+}
+
+
+
+
 /********************************
  * CLAUSES AND LEARNED CLAUSES  *
  *******************************/
@@ -122,41 +177,48 @@ static inline literal_t get_second_watch(clause_t *cl) {
   return cl->cl[1];
 }
 
-/*
- * Get watched literal of index (1 - i) in cl.
- * - i = 0 or 1
- */
-static inline literal_t get_other_watch(clause_t *cl, uint32_t i) {
-  // flip low-order bit of i
-  return cl->cl[1 - i];
-}
-
-/*
- * Get pointer to learned_clause in which clause cl is embedded.
- */
-static inline learned_clause_t *learned(const clause_t *cl) {
-  return (learned_clause_t *)(((char *)cl) - offsetof(learned_clause_t, clause));
-}
-
 /*
  * Activity of a learned clause
  */
 static inline float get_activity(const clause_t *cl) {
-  return learned(cl)->activity;
+  return cl->aux.activity;
 }
 
 /*
  * Increase the activity of a learned clause by delta
  */
 static inline void increase_activity(clause_t *cl, float delta) {
-  learned(cl)->activity += delta;
+  cl->aux.activity += delta;
 }
 
 /*
  * Multiply activity by scale
  */
 static inline void multiply_activity(clause_t *cl, float scale) {
-  learned(cl)->activity *= scale;
+  cl->aux.activity *= scale;
+}
+
+/*
+ * Set the lbd of a learned clause and update its tier
+ * - the tier can only decrease (i.e., the clause is promoted)
+ */
+static inline void set_clause_lbd(clause_t *cl, uint32_t lbd) {
+  clause_tier_t tier;
+
+  if (lbd > MAX_CLAUSE_LBD) {
+    lbd = MAX_CLAUSE_LBD;
+  }
+  cl->lbd = lbd;
+
+  tier = LOCAL_TIER;
+  if (lbd <= CORE_LBD) {
+    tier = CORE_TIER;
+  } else if (lbd <= MID_LBD) {
+    tier = MID_TIER;
+  }
+  if (tier < cl->tier) {
+    cl->tier = tier;
+  }
 }
 
 /*
@@ -195,65 +257,72 @@ static uint32_t clause_length(clause_t *cl) {
 }
 
 /*
- * Allocate and initialize a new clause (not a learned clause)
- * \param len = number of literals
- * \param lit = array of len literals
- * The watched pointers are not initialized
+ * Allocate a clause in s's arena and initialize it
+ * - len = number of literals
+ * - lit = array of len literals
+ * - end = end marker (end_clause or end_learned)
+ * The activity and lbd are initialized to 0, the tier to LOCAL_TIER
+ *
+ * If the arena is reallocated, and there's a conflict clause,
+ * s->conflict is updated to point to the new copy.
  */
-static clause_t *new_clause(uint32_t len, literal_t *lit) {
-  clause_t *result;
+static cidx_t alloc_clause(smt_core_t *s, uint32_t len, literal_t *lit, literal_t end) {
+  clause_arena_t *arena;
+  clause_t *cl;
+  cidx_t cidx;
   uint32_t i;
 
-  result = (clause_t *) safe_malloc(sizeof(clause_t) + sizeof(literal_t) +
-                                    len * sizeof(literal_t));
+  arena = &s->arena;
+  if (clause_arena_size(len) > arena->capacity - arena->size) {
+    extend_clause_arena(arena, clause_arena_size(len));
+    if (s->inconsistent && s->false_clause != null_cidx) {
+      s->conflict = clause_of_idx(s, s->false_clause)->cl;
+    }
+  }
+
+  cidx = arena->size;
+  arena->size += clause_arena_size(len);
 
+  cl = clause_of_idx(s, cidx);
+  cl->lbd = 0;
+  cl->tier = LOCAL_TIER;
+  cl->used = false;
+  cl->aux.activity = 0.0F;
   for (i=0; i<len; i++) {
-    result->cl[i] = lit[i];
+    cl->cl[i] = lit[i];
   }
-  result->cl[i] = end_clause; // end marker: not a learned clause
+  cl->cl[i] = end;
 
-  return result;
+  return cidx;
 }
 
 /*
- * Delete clause cl
- * cl must be a non-learned clause, allocated via the previous function.
+ * Allocate and initialize a new clause (not a learned clause)
+ * \param len = number of literals
+ * \param lit = array of len literals
+ * The watch vectors are not updated
  */
-static inline void delete_clause(clause_t *cl) {
-  safe_free(cl);
+static inline cidx_t new_clause(smt_core_t *s, uint32_t len, literal_t *lit) {
+  return alloc_clause(s, len, lit, end_clause);
 }
 
 /*
  * Allocate and initialize a new learned clause
  * \param len = number of literals
  * \param lit = array of len literals
- * The watched pointers are not initialized.
+ * The watch vectors are not updated.
  * The activity is initialized to 0.0
  */
-static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
-  learned_clause_t *tmp;
-  clause_t *result;
-  uint32_t i;
-
-  tmp = (learned_clause_t *) safe_malloc(sizeof(learned_clause_t) + sizeof(literal_t) +
-                                         len * sizeof(literal_t));
-  tmp->activity = 0.0;
-  result = &(tmp->clause);
-
-  for (i=0; i<len; i++) {
-    result->cl[i] = lit[i];
-  }
-  result->cl[i] = end_learned; // end marker: learned clause
-
-  return result;
+static inline cidx_t new_learned_clause(smt_core_t *s, uint32_t len, literal_t *lit) {
+  return alloc_clause(s, len, lit, end_learned);
 }
 
 /*
- * Delete learned clause cl
- * cl must have been allocated via the new_learned_clause function
+ * Delete clause cidx: its space is reclaimed by the next
+ * garbage collection.
  */
-static inline void delete_learned_clause(clause_t *cl) {
-  safe_free(learned(cl));
+static inline void delete_clause(smt_core_t *s, cidx_t cidx) {
+  s->arena.wasted += clause_arena_size(clause_length(clause_of_idx(s, cidx)));
 }
 
 
@@ -265,10 +334,10 @@ static inline void delete_learned_clause(clause_t *cl) {
 /*
  * Create a clause vector of capacity n.
  */
-static clause_t **new_clause_vector(uint32_t n) {
+static cidx_t *new_clause_vector(uint32_t n) {
   clause_vector_t *tmp;
 
-  tmp = (clause_vector_t *) safe_malloc(sizeof(clause_vector_t) + n * sizeof(clause_t *));
+  tmp = (clause_vector_t *) safe_malloc(sizeof(clause_vector_t) + n * sizeof(cidx_t));
   tmp->capacity = n;
   tmp->size = 0;
 
@@ -278,16 +347,16 @@ static clause_t **new_clause_vector(uint32_t n) {
 /*
  * Clean up: free memory used by v
  */
-static void delete_clause_vector(clause_t **v) {
+static void delete_clause_vector(cidx_t *v) {
   safe_free(cv_header(v));
 }
 
 /*
- * Add clause cl at the end of vector *v. Assumes *v has been initialized.
+ * Add clause index cidx at the end of vector *v. Assumes *v has been initialized.
  */
-static void add_clause_to_vector(clause_t ***v, clause_t *cl) {
+static void add_clause_to_vector(cidx_t **v, cidx_t cidx) {
   clause_vector_t *vector;
-  clause_t **d;
+  cidx_t *d;
   uint32_t i, n;
 
   d = *v;
@@ -300,12 +369,12 @@ static void add_clause_to_vector(clause_t ***v, clause_t *cl) {
       out_of_memory();
     }
     vector = (clause_vector_t *)
-      safe_realloc(vector, sizeof(clause_vector_t) + n * sizeof(clause_t *));
+      safe_realloc(vector, sizeof(clause_vector_t) + n * sizeof(cidx_t));
     vector->capacity = n;
     d = vector->data;
     *v = d;
   }
-  d[i] = cl;
+  d[i] = cidx;
   vector->size = i+1;
 }
 
@@ -313,13 +382,104 @@ static void add_clause_to_vector(clause_t ***v, clause_t *cl) {
 /*
  * Reset clause vector v: set its size to 0
  */
-static inline void reset_clause_vector(clause_t **v) {
+static inline void reset_clause_vector(cidx_t *v) {
   set_cv_size(v, 0);
 }
 
 
 
 
+/*******************
+ *  WATCH VECTORS  *
+ ******************/
+
+/*
+ * Watch vectors are initially NULL. Memory is allocated on the
+ * first addition.
+ */
+
+/*
+ * Add the pair [cidx, blocker] at the end of vector *v
+ * - allocate a fresh vector if *v == NULL
+ * - resize *v if *v is full.
+ */
+static void add_clause_watch(clause_watch_t **v, cidx_t cidx, literal_t blocker) {
+  watch_vector_t *vector;
+  clause_watch_t *d;
+  uint32_t i, n;
+
+  d = *v;
+  if (d == NULL) {
+    i = 0;
+    n = DEF_WATCH_VECTOR_SIZE;
+    vector = (watch_vector_t *)
+      safe_malloc(sizeof(watch_vector_t) + n * sizeof(clause_watch_t));
+    vector->capacity = n;
+    d = vector->data;
+    *v = d;
+  } else {
+    vector = wv_header(d);
+    i = vector->size;
+    n = vector->capacity;
+    if (i == n) {
+      n ++;
+      n += n>>1; // new cap = 50% more than old capacity
+      if (n > MAX_WATCH_VECTOR_SIZE) {
+        out_of_memory();
+      }
+      vector = (watch_vector_t *)
+        safe_realloc(vector, sizeof(watch_vector_t) + n * sizeof(clause_watch_t));
+      vector->capacity = n;
+      d = vector->data;
+      *v = d;
+    }
+  }
+
+  assert(i < vector->capacity);
+
+  d[i].cidx = cidx;
+  d[i].blocker = blocker;
+  vector->size = i+1;
+}
+
+
+/*
+ * Delete watch vector v
+ */
+static void delete_watch_vector(clause_watch_t *v) {
+  if (v != NULL) {
+    safe_free(wv_header(v));
+  }
+}
+
+
+/*
+ * Empty watch vector v
+ */
+static inline void reset_watch_vector(clause_watch_t *v) {
+  if (v != NULL) {
+    set_wv_size(v, 0);
+  }
+}
+
+
+/*
+ * Add clause cidx to the watch vectors of its two watched literals
+ * - cl = the clause (its first two literals are the watched literals)
+ * - each watched literal is the other's blocker
+ */
+static void watch_clause(smt_core_t *s, cidx_t cidx, clause_t *cl) {
+  literal_t l0, l1;
+
+  l0 = get_first_watch(cl);
+  l1 = get_second_watch(cl);
+  add_clause_watch(s->watch + l0, cidx, l1);
+  add_clause_watch(s->watch + l1, cidx, l0);
+}
+
+
+
+
 /**********************
  *  LITERAL VECTORS   *
  *********************/
@@ -1279,6 +1439,7 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->random_decisions = 0;
   stat->propagations = 0;
   stat->conflicts = 0;
+  stat->chrono_backtracks = 0;
   stat->th_props = 0;
   stat->th_prop_lemmas = 0;
   stat->th_conflicts = 0;
@@ -1519,16 +1680,19 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->th_cache_enabled = false;
   s->th_cache_cl_size = 0;
 
+  s->chrono_threshold = CHRONO_THRESHOLD;
+
   // conflict data: no need to initialize conflict_buffer
   s->inconsistent = false;
   s->theory_conflict = false;
   s->conflict = NULL;
-  s->false_clause = NULL;
+  s->false_clause = null_cidx;
 
   // auxiliary buffers
   init_ivector(&s->buffer, DEF_LBUFFER_SIZE);
   init_ivector(&s->buffer2, DEF_LBUFFER_SIZE);
   init_ivector(&s->explanation, DEF_LBUFFER_SIZE);
+  init_tag_map(&s->level_map, 0);
 
   // assumptions
   s->has_assumptions = false;
@@ -1538,6 +1702,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->bad_assumption = null_literal;
 
   // clause database: all empty
+  init_clause_arena(&s->arena);
   s->problem_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   s->learned_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   init_ivector(&s->binary_clauses, 0);
@@ -1561,7 +1726,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
    * Literal-indexed arrays
    */
   s->bin = (literal_t **) safe_malloc(lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_malloc(lsize * sizeof(link_t));
+  s->watch = (clause_watch_t **) safe_malloc(lsize * sizeof(clause_watch_t *));
 
   /*
    * Initialize data structures for true_literal and false_literal
@@ -1575,8 +1740,8 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
 
   s->bin[true_literal] = NULL;
   s->bin[false_literal] = NULL;
-  s->watch[true_literal] = NULL_LINK;
-  s->watch[false_literal] = NULL_LINK;
+  s->watch[true_literal] = NULL;
+  s->watch[false_literal] = NULL;
 
   init_stack(&s->stack, n);
   init_heap(&s->heap, n);
@@ -1613,26 +1778,16 @@ void smt_core_reset_thsolver(smt_core_t *s, void *th, th_ctrl_interface_t *ctrl,
  */
 void delete_smt_core(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **cl;
 
   delete_ivector(&s->buffer);
   delete_ivector(&s->buffer2);
   delete_ivector(&s->explanation);
+  delete_tag_map(&s->level_map);
 
   // Delete all the clauses
-  cl = s->problem_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_clause(cl[i]);
-  }
-  delete_clause_vector(cl);
-
-  cl = s->learned_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_learned_clause(cl[i]);
-  }
-  delete_clause_vector(cl);
+  delete_clause_vector(s->problem_clauses);
+  delete_clause_vector(s->learned_clauses);
+  delete_clause_arena(&s->arena);
 
   delete_ivector(&s->binary_clauses);
 
@@ -1646,6 +1801,7 @@ void delete_smt_core(smt_core_t *s) {
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch[i]);
   }
   safe_free(s->bin);
   safe_free(s->watch);
@@ -1670,7 +1826,6 @@ void delete_smt_core(smt_core_t *s) {
  */
 void reset_smt_core(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **cl;
 
   s->status = STATUS_IDLE;
 
@@ -1678,6 +1833,7 @@ void reset_smt_core(smt_core_t *s) {
   ivector_reset(&s->buffer);
   ivector_reset(&s->buffer2);
   ivector_reset(&s->explanation);
+  clear_tag_map(&s->level_map);
 
   // assumptions
   s->has_assumptions = false;
@@ -1687,26 +1843,18 @@ void reset_smt_core(smt_core_t *s) {
   s->bad_assumption = null_literal;
 
   // delete the clauses
-  cl = s->problem_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_clause(cl[i]);
-  }
-  reset_clause_vector(cl);
-
-  cl = s->learned_clauses;
-  n = get_cv_size(cl);
-  for (i=0; i<n; i++) {
-    delete_learned_clause(cl[i]);
-  }
-  reset_clause_vector(cl);
+  reset_clause_vector(s->problem_clauses);
+  reset_clause_vector(s->learned_clauses);
+  reset_clause_arena(&s->arena);
 
   ivector_reset(&s->binary_clauses);
 
-  // delete binary-watched literal vectors
+  // delete binary-watched literal vectors and watch vectors
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch[i]);
+    s->watch[i] = NULL;
   }
 
   reset_stack(&s->stack);
@@ -1742,7 +1890,7 @@ void reset_smt_core(smt_core_t *s) {
   s->inconsistent = false;
   s->theory_conflict = false;
   s->conflict = NULL;
-  s->false_clause = NULL;
+  s->false_clause = null_cidx;
 
   // reset the theory solver
   s->th_ctrl.reset(s->th_solver);
@@ -1778,7 +1926,7 @@ static void extend_smt_core(smt_core_t *s, uint32_t n) {
   s->mark = extend_bitvector(s->mark, n);
 
   s->bin = (literal_t **) safe_realloc(s->bin, lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_realloc(s->watch, lsize * sizeof(link_t));
+  s->watch = (clause_watch_t **) safe_realloc(s->watch, lsize * sizeof(clause_watch_t *));
 
   extend_heap(&s->heap, n);
   extend_stack(&s->stack, n);
@@ -1878,8 +2026,8 @@ static void init_variable(smt_core_t *s, bvar_t x) {
   l1 = neg_lit(x);
   s->bin[l0] = NULL;
   s->bin[l1] = NULL;
-  s->watch[l0] = NULL_LINK;
-  s->watch[l1] = NULL_LINK;
+  s->watch[l0] = NULL;
+  s->watch[l1] = NULL;
 }
 
 /*
@@ -2114,6 +2262,59 @@ void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
 }
 
 
+/*
+ * Assign literal l to true with antecedent a, out of order:
+ * - k = assignment level for l
+ * - k must be larger than the base level and smaller than the decision level
+ * - all the literals in a must be false and of level <= k
+ * This is used after chronological backtracking.
+ */
+static void implied_literal_at_level(smt_core_t *s, literal_t l, antecedent_t a, uint32_t k) {
+  bvar_t v;
+
+#if TRACE_LIGHT
+  printf("---> DPLL:   Implied literal ");
+  print_literal(stdout, l);
+  printf(", level = %"PRIu32", decision level = %"PRIu32"\n", k, s->decision_level);
+  fflush(stdout);
+#endif
+
+  assert(literal_is_unassigned(s, l));
+  assert(s->base_level < k && k < s->decision_level);
+
+  s->stats.propagations ++;
+
+  push_literal(&s->stack, l);
+
+  v = var_of(l);
+  s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
+  s->level[v] = k;
+  s->antecedent[v] = a;
+
+  assert(literal_value(s, l) == VAL_TRUE && literal_value(s, not(l)) == VAL_FALSE);
+}
+
+
+/*
+ * Assign literal l to true with antecedent a when chronological
+ * backtracking is enabled:
+ * - k = highest assignment level among the other literals of the antecedent
+ * - l is assigned at level k if k is below the decision level,
+ *   otherwise it's assigned at the decision level as usual.
+ * Literals implied at the base level are assigned at base_level + 1.
+ */
+static void implied_literal_chrono(smt_core_t *s, literal_t l, antecedent_t a, uint32_t k) {
+  if (k <= s->base_level) {
+    k = s->base_level + 1;
+  }
+  if (k < s->decision_level) {
+    implied_literal_at_level(s, l, a, k);
+  } else {
+    implied_literal(s, l, a);
+  }
+}
+
+
 void propagate_literal(smt_core_t *s, literal_t l, void *expl) {
   bvar_t v;
 
@@ -2309,21 +2510,24 @@ static void increase_bvar_activity(smt_core_t *s, bvar_t x) {
  */
 static void rescale_clause_activities(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **v;
+  cidx_t *v;
 
   s->cla_inc *= INV_CLAUSE_ACTIVITY_THRESHOLD;
   v = s->learned_clauses;
   n = get_cv_size(v);
   for (i=0; i<n; i++) {
-    multiply_activity(v[i], INV_CLAUSE_ACTIVITY_THRESHOLD);
+    multiply_activity(clause_of_idx(s, v[i]), INV_CLAUSE_ACTIVITY_THRESHOLD);
   }
 }
 
 
 /*
- * Increase activity of learned clause cl
+ * Increase activity of learned clause cidx
  */
-static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
+static void increase_clause_activity(smt_core_t *s, cidx_t cidx) {
+  clause_t *cl;
+
+  cl = clause_of_idx(s, cidx);
   increase_activity(cl, s->cla_inc);
   if (get_activity(cl) > CLAUSE_ACTIVITY_THRESHOLD) {
     rescale_clause_activities(s);
@@ -2343,10 +2547,16 @@ static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
  * - requires decision_level > back_level >= base_level
  * Also clear conflict data and sets cp_flag if deletion of atoms is enabled
  *
+ * Literals assigned out of order (after chronological backtracking)
+ * may be above level_index[back_level + 1] and have level <= back_level.
+ * They stay assigned: they are moved down the stack (in the same order)
+ * and put back in the propagation queues, since the theory solver
+ * forgets them when it backtracks.
+ *
  * NOTE: this function does not force the theory solver to backtrack.
  */
 static void backtrack(smt_core_t *s, uint32_t back_level) {
-  uint32_t i, k;
+  uint32_t i, j, k, n;
   literal_t *u, l;
   bvar_t x;
 
@@ -2359,25 +2569,41 @@ static void backtrack(smt_core_t *s, uint32_t back_level) {
 
   u = s->stack.lit;
   k = s->stack.level_index[back_level + 1];
+  n = 0; // number of literals kept
   i = s->stack.top;
   while (i > k) {
     i --;
     l = u[i];
+    x = var_of(l);
 
     assert(literal_value(s, l) == VAL_TRUE);
-    assert(s->level[var_of(l)] > back_level);
 
-    // clear assignment of x, keep polarity bit
-    x = var_of(l);
-    s->value[x] &= 1;
-    heap_insert(&s->heap, x);
+    if (s->level[x] <= back_level) {
+      n ++;
+    } else {
+      // clear assignment of x, keep polarity bit
+      s->value[x] &= 1;
+      heap_insert(&s->heap, x);
+      assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+    }
+  }
 
-    assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+  j = k;
+  if (n > 0) {
+    // move the literals kept to u[k ... k+n-1]
+    for (i=k; i<s->stack.top; i++) {
+      l = u[i];
+      if (literal_value(s, l) == VAL_TRUE) {
+        u[j] = l;
+        j ++;
+      }
+    }
+    assert(j == k + n);
   }
 
-  s->stack.top = i;
-  s->stack.prop_ptr = i;
-  s->stack.theory_ptr = i;
+  s->stack.top = j;
+  s->stack.prop_ptr = k;
+  s->stack.theory_ptr = k;
   s->decision_level = back_level;
 
   // Update the cp_flag: the deletion of atoms is enabled if there's a checkpoint
@@ -2433,13 +2659,18 @@ static void record_binary_conflict(smt_core_t *s, literal_t l0, literal_t l1) {
   s->conflict_buffer[1] = l1;
   s->conflict_buffer[2] = end_clause;
   s->conflict = s->conflict_buffer;
+  s->false_clause = null_cidx;
 }
 
 
 /*
- * Record cl as a conflict clause
+ * Record clause cidx as a conflict clause
  */
-static void record_clause_conflict(smt_core_t *s, clause_t *cl) {
+static void record_clause_conflict(smt_core_t *s, cidx_t cidx) {
+  clause_t *cl;
+
+  cl = clause_of_idx(s, cidx);
+
 #if TRACE_LIGHT
   uint32_t i;
   literal_t ll;
@@ -2463,7 +2694,7 @@ static void record_clause_conflict(smt_core_t *s, clause_t *cl) {
   assert(! s->theory_conflict);
 
   s->inconsistent = true;
-  s->false_clause = cl;
+  s->false_clause = cidx;
   s->conflict = cl->cl;
 }
 
@@ -2513,7 +2744,7 @@ void record_theory_conflict(smt_core_t *s, literal_t *a) {
     s->stats.th_conflicts ++;
     s->inconsistent = true;
     s->theory_conflict = true;
-    s->false_clause = NULL;
+    s->false_clause = null_cidx;
     s->conflict = a;
   }
 }
@@ -2562,6 +2793,25 @@ static inline bval_t lit_val(uint8_t *v, literal_t l) {
   return v[var_of(l)] ^ sign_of_lit(l);
 }
 
+/*
+ * Highest assignment level of the literals b[1], b[2], ... of a clause
+ * - all these literals must be false
+ */
+static uint32_t clause_level(smt_core_t *s, literal_t *b) {
+  uint32_t k, q;
+  literal_t l;
+
+  k = 0;
+  b ++;
+  while ((l = *b) >= 0) {
+    assert(literal_value(s, l) == VAL_FALSE);
+    q = s->level[var_of(l)];
+    if (q > k) k = q;
+    b ++;
+  }
+  return k;
+}
+
 /*
  * Propagation via binary clauses:
  * - val = literal value array (must be s->value)
@@ -2589,7 +2839,11 @@ static bool propagation_via_bin_vector(smt_core_t *s, uint8_t *val, literal_t l0
     if (l1 < 0) break; // end_marker
 
     if (bval_is_undef(v1)) {
-      implied_literal(s, l1, mk_literal_antecedent(l0));
+      if (s->chrono_threshold > 0) {
+        implied_literal_chrono(s, l1, mk_literal_antecedent(l0), s->level[var_of(l0)]);
+      } else {
+        implied_literal(s, l1, mk_literal_antecedent(l0));
+      }
     } else {
       record_binary_conflict(s, l0, l1);
       return false;
@@ -2602,90 +2856,126 @@ static bool propagation_via_bin_vector(smt_core_t *s, uint8_t *val, literal_t l0
 
 
 /*
- * Propagation via the watched lists of a literal l0.
+ * Propagation via the watch vector of a literal l0.
  * - val = literal value array (must be s->value)
+ * - l0 must be false in the current assignment
+ *
+ * For each element [cidx, blocker] of watch[l0]:
+ * - if the blocker is true, the clause is skipped
+ * - otherwise, we visit the clause and search for a new watched literal.
+ *   If one is found, the clause moves to that literal's watch vector.
+ *
+ * The vector is scanned from the end, so the most recent watches
+ * (e.g., learned clauses) are visited first. The kept watches are
+ * moved to the end of the vector then shifted back to the start.
  *
  * Return true if there's no conflict, false otherwise
  */
-static bool propagation_via_watched_list(smt_core_t *s, uint8_t *val, literal_t l0) {
+static bool propagation_via_watch_vector(smt_core_t *s, uint8_t *val, literal_t l0) {
+  clause_watch_t *w;
   clause_t *cl;
-  link_t *list;
-  link_t link;
   bval_t v1;
-  uint32_t k, i;
+  uint32_t i, j, k, n;
+  cidx_t cidx;
   literal_t l1, l, *b;
 
   assert(s->value == val);
 
-  list = &s->watch[l0];
-  link = *list;
-  while (link != NULL_LINK) {
-    cl = clause_of(link);
-    i = idx_of(link);
-    l1 = get_other_watch(cl, i);
-    v1 = lit_val(val, l1);
+  w = s->watch[l0];
+  if (w == NULL) return true;
 
-    assert(next_of(link) == cl->link[i]);
-    assert(cdr_ptr(link) == cl->link + i);
+  n = get_wv_size(w);
+  j = n;
+  i = n;
+  while (i > 0) {
+    i --;
+    if (lit_val(val, w[i].blocker) == VAL_TRUE) {
+      // skip the clause: keep the watch
+      j --;
+      w[j] = w[i];
+      continue;
+    }
+
+    cidx = w[i].cidx;
+    cl = clause_of_idx(s, cidx);
+    b = cl->cl;
 
+    // l1 = other watched literal
+    l1 = b[0] ^ b[1] ^ l0;
+    assert(b[0] == l0 || b[1] == l0);
+
+    v1 = lit_val(val, l1);
     if (v1 == VAL_TRUE) {
+      // clause is true: update the blocker
+      j --;
+      w[j].cidx = cidx;
+      w[j].blocker = l1;
+      continue;
+    }
+
+    /*
+     * make sure b[0] = l1 and b[1] = l0
+     * (this is safe since cl can't be the antecedent of a true literal)
+     */
+    b[0] = l1;
+    b[1] = l0;
+
+    /*
+     * Search for a new watched literal in cl.
+     * The loop terminates since cl->cl terminates with an end marked
+     * and val[end_marker] == VAL_UNDEF.
+     */
+    k = 1;
+    do {
+      k ++;
+      l = b[k];
+    } while (lit_val(val, l) == VAL_FALSE);
+
+    if (l >= 0) {
       /*
-       * Skip clause cl: it's already true
+       * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
+       * make l the new second watched literal:
+       * - swap b[1] and b[k]
+       * - add cl to l's watch vector (with blocker l1)
        */
-      *list = link;
-      list = cl->link + i;
-      link = cl->link[i];
+      b[k] = l0;
+      b[1] = l;
+      add_clause_watch(s->watch + l, cidx, l1);
 
     } else {
+      // keep the watch
+      j --;
+      w[j].cidx = cidx;
+      w[j].blocker = l1;
+
       /*
-       * Search for a new watched literal in cl.
-       * The loop terminates since cl->cl terminates with an end marked
-       * and val[end_marker] == VAL_UNDEF.
+       * All literals of cl, except possibly l1, are false
        */
-      k = 1;
-      b = cl->cl;
-      do {
-        k ++;
-        l = b[k];
-      } while (lit_val(val, l) == VAL_FALSE);
-
-      if (l >= 0) {
-        /*
-         * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
-         * make l a new watched literal
-         * - swap b[i] and b[k]
-         * - insert cl into l's watched list (link[i])
-         */
-        b[k] = b[i];
-        b[i] = l;
-
-        // insert cl in watch[l] list and move to the next clause
-        link = cl->link[i];
-        s->watch[l] = cons(i, cl, s->watch[l]);
-      } else {
-        /*
-         * All literals of cl, except possibly l1, are false
-         */
-	if (bval_is_undef(v1)) {
-          // l1 is implied
-          implied_literal(s, l1, mk_clause_antecedent(cl, i^1));
-
-          // move to the next clause
-          *list = link;
-          list = cl->link + i;
-          link = cl->link[i];
-
+      if (bval_is_undef(v1)) {
+        // l1 is implied
+        if (s->chrono_threshold > 0) {
+          implied_literal_chrono(s, l1, mk_clause0_antecedent(cidx), clause_level(s, b));
         } else {
-          // v1 == VAL_FALSE: conflict found
-          record_clause_conflict(s, cl);
-          *list = link;
-          return false;
+          implied_literal(s, l1, mk_clause0_antecedent(cidx));
+        }
+      } else {
+        // v1 == VAL_FALSE: conflict found
+        // keep the rest of the vector
+        while (i > 0) {
+          i --;
+          j --;
+          w[j] = w[i];
         }
+        memmove(w, w + j, (n - j) * sizeof(clause_watch_t));
+        set_wv_size(w, n - j);
+        record_clause_conflict(s, cidx);
+        return false;
       }
     }
   }
 
-  *list = NULL_LINK;
+  memmove(w, w + j, (n - j) * sizeof(clause_watch_t));
+  set_wv_size(w, n - j);
 
   return true;
 }
@@ -2713,7 +3003,7 @@ static bool boolean_propagation(smt_core_t *s) {
       return false;
     }
 
-    if (! propagation_via_watched_list(s, val, l)) {
+    if (! propagation_via_watch_vector(s, val, l)) {
       return false;
     }
   }
@@ -2867,6 +3157,57 @@ static inline uint32_t d_level(smt_core_t *s, literal_t l) {
 
 
 
+/****************
+ *  CLAUSE LBD  *
+ ***************/
+
+/*
+ * LBD of a clause = number of distinct decision levels among its literals.
+ * - a = array of literals terminated by a negative end marker
+ * - all literals in a must be assigned
+ */
+static uint32_t clause_lbd(smt_core_t *s, const literal_t *a) {
+  tag_map_t *map;
+  uint32_t r;
+  literal_t l;
+
+  map = &s->level_map;
+  l = *a;
+  while (l >= 0) {
+    tag_map_write(map, d_level(s, l), 1);
+    a ++;
+    l = *a;
+  }
+  r = tag_map_size(map);
+  clear_tag_map(map);
+
+  return r;
+}
+
+
+/*
+ * Learned clause cidx is used in conflict resolution:
+ * - increase its activity and mark it as used
+ * - recompute its lbd (unless it's in the core tier): if the lbd
+ *   is smaller than before, the clause may move to a better tier
+ */
+static void bump_learned_clause(smt_core_t *s, cidx_t cidx) {
+  clause_t *cl;
+  uint32_t lbd;
+
+  increase_clause_activity(s, cidx);
+  cl = clause_of_idx(s, cidx);
+  cl->used = true;
+  if (cl->tier != CORE_TIER) {
+    lbd = clause_lbd(s, cl->cl);
+    if (lbd < cl->lbd) {
+      set_clause_lbd(cl, lbd);
+    }
+  }
+}
+
+
+
 /*********************
  *  LEARNED CLAUSES  *
  ********************/
@@ -2898,6 +3239,34 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
 }
 
 
+/*
+ * Backtrack then assert the implied literal of a learned clause
+ * - l = implied literal
+ * - a = its antecedent
+ * - k = level where l is implied (all other literals of the
+ *   learned clause have level <= k)
+ *
+ * If k is far below the current decision level, we backtrack to
+ * decision_level - 1 and assign l out of order, at level k.
+ * Otherwise we backtrack to level k.
+ */
+static void backtrack_and_assert(smt_core_t *s, literal_t l, antecedent_t a, uint32_t k) {
+  uint32_t d;
+
+  d = s->decision_level;
+  assert(k < d);
+
+  if (s->chrono_threshold > 0 && d - k > s->chrono_threshold && k > s->base_level) {
+    s->stats.chrono_backtracks ++;
+    backtrack_to_level(s, d - 1);
+    implied_literal_at_level(s, l, a, k);
+  } else {
+    backtrack_to_level(s, k);
+    implied_literal(s, l, a);
+  }
+}
+
+
 /*
  * Add an array of literals a as a new learned clause, after conflict resolution.
  * - n must be at least 1
@@ -2905,9 +3274,11 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
  * - a[0] must be the implied literal: all other literals must have
  *   a lower assignment level than a[0].
  * - backtrack to the decision_level where a[0] is implied, then
- *   add a[0] to the propagation queue
+ *   add a[0] to the propagation queue (or backtrack chronologically,
+ *   see backtrack_and_assert)
  */
 static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+  cidx_t cidx;
   clause_t *cl;
   uint32_t i, j, k, q;
   literal_t l0, l1;
@@ -2931,6 +3302,7 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
       // conflict (the whole thing is unsat)
       s->inconsistent = true;
       s->conflict = s->conflict_buffer;
+      s->false_clause = null_cidx;
       s->conflict_buffer[0] = l0;
       s->conflict_buffer[1] = end_clause;
     } else {
@@ -2951,8 +3323,7 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     assert(k < s->level[var_of(l0)]);
 
     direct_binary_clause(s, l0, l1);
-    backtrack_to_level(s, k);
-    implied_literal(s, l0, mk_literal_antecedent(l1));
+    backtrack_and_assert(s, l0, mk_literal_antecedent(l1), k);
 
   } else {
 
@@ -2976,22 +3347,22 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     l1 = a[j]; a[j] = a[1]; a[1] = l1;
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
-    add_clause_to_vector(&s->learned_clauses, cl);
-    increase_clause_activity(s, cl);
+    cidx = new_learned_clause(s, n, a);
+    cl = clause_of_idx(s, cidx);
+    set_clause_lbd(cl, clause_lbd(s, cl->cl));
+    add_clause_to_vector(&s->learned_clauses, cidx);
+    increase_clause_activity(s, cidx);
 
-    // add cl at the start of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add the clause to watch[l0] and watch[l1]
+    add_clause_watch(s->watch + l0, cidx, l1);
+    add_clause_watch(s->watch + l1, cidx, l0);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
 
     // backtrack and assert l0
     assert(k < s->level[var_of(l0)]);
-    backtrack_to_level(s, k);
-
-    implied_literal(s, l0, mk_clause0_antecedent(cl));
+    backtrack_and_assert(s, l0, mk_clause0_antecedent(cidx), k);
   }
 }
 
@@ -3004,6 +3375,7 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
  * Return true if the clause was added/false otherwise
  */
 static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+  cidx_t cidx;
   clause_t *cl;
   uint32_t i, j, d;
   literal_t l, l0, l1;
@@ -3069,13 +3441,15 @@ static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 #endif
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
-    add_clause_to_vector(&s->learned_clauses, cl);
-    increase_clause_activity(s, cl);
+    cidx = new_learned_clause(s, n, a);
+    cl = clause_of_idx(s, cidx);
+    set_clause_lbd(cl, clause_lbd(s, cl->cl));
+    add_clause_to_vector(&s->learned_clauses, cidx);
+    increase_clause_activity(s, cidx);
 
-    // insert cl at the head of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add the clause to watch[l0] and watch[l1]
+    add_clause_watch(s->watch + l0, cidx, l1);
+    add_clause_watch(s->watch + l1, cidx, l0);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
@@ -3243,7 +3617,7 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
   switch (antecedent_tag(a)) {
   case clause0_tag:
   case clause1_tag:
-    c = clause_antecedent(a)->cl;
+    c = clause_of_idx(s, clause_antecedent(a))->cl;
     i = clause_index(a);
     assert(c[i] == not(l));
     // other watched literal
@@ -3414,7 +3788,9 @@ static void simplify_learned_clause(smt_core_t *s) {
  *
  * Note: computing conflict level is necessary for theory conflicts.
  * For conflicts detected by boolean propagation, the conflict_level
- * is the same as the current decision_level
+ * is the same as the current decision_level, unless some literals
+ * were assigned out of order (i.e., if chronological backtracking
+ * is enabled).
  */
 static uint32_t get_conflict_level(smt_core_t *s, literal_t *a) {
   uint32_t k, q, i;
@@ -3473,11 +3849,12 @@ static void resolve_conflict(smt_core_t *s) {
   bvar_t x;
   literal_t *c,  *stack;
   antecedent_t a;
-  clause_t *cl;
+  cidx_t cidx;
   ivector_t *buffer;
 
   assert(s->inconsistent);
-  assert(s->theory_conflict || get_conflict_level(s, s->conflict) == s->decision_level);
+  assert(s->theory_conflict || s->chrono_threshold > 0 ||
+         get_conflict_level(s, s->conflict) == s->decision_level);
   assert(s->base_level <= s->decision_level);
 
   s->stats.conflicts ++;
@@ -3487,16 +3864,17 @@ static void resolve_conflict(smt_core_t *s) {
 
   /*
    * adjust conflict_level and backtrack to that level if the conflict
-   * was reported by the theory solver.
+   * was reported by the theory solver or if literals may have been
+   * assigned out of order.
    */
-  if (s->theory_conflict) {
+  if (s->theory_conflict || s->chrono_threshold > 0) {
     conflict_level = get_conflict_level(s, c);
     assert(s->base_level <= conflict_level && conflict_level <= s->decision_level);
     backtrack_to_level(s, conflict_level);
     assert(s->decision_level == conflict_level);
 
     // Cache as a clause
-    if (s->th_cache_enabled) {
+    if (s->theory_conflict && s->th_cache_enabled) {
       try_cache_theory_conflict(s, s->th_conflict_size, c);
     }
   }
@@ -3537,9 +3915,10 @@ static void resolve_conflict(smt_core_t *s) {
 
   /*
    * If the conflict is a learned clause, increase its activity
+   * and update its lbd
    */
   if (l == end_learned) {
-    increase_clause_activity(s, s->false_clause);
+    bump_learned_clause(s, s->false_clause);
   }
 
   assert(unresolved > 0);
@@ -3548,6 +3927,8 @@ static void resolve_conflict(smt_core_t *s) {
    * Scan the assignment stack from top to bottom and process the
    * antecedent of all marked literals:
    * - all the literals processed have decision_level == conflict_level
+   * - literals of lower levels may be interleaved with them if they
+   *   were assigned out of order: they are skipped
    * - the code works if unresolved == 1 (which may happen for theory conflicts)
    */
   stack = s->stack.lit;
@@ -3555,8 +3936,8 @@ static void resolve_conflict(smt_core_t *s) {
   for (;;) {
     j --;
     b = stack[j];
-    assert(d_level(s, b) == conflict_level);
-    if (is_lit_marked(s, b)) {
+    assert(d_level(s, b) <= conflict_level);
+    if (is_lit_marked(s, b) && d_level(s, b) == conflict_level) {
       if (unresolved == 1) {
         // not b is the implied literal; we're done.
         buffer->data[0] = not(b);
@@ -3572,9 +3953,9 @@ static void resolve_conflict(smt_core_t *s) {
         switch (antecedent_tag(a)) {
         case clause0_tag:
         case clause1_tag:
-          cl = clause_antecedent(a);
+          cidx = clause_antecedent(a);
           i = clause_index(a);
-          c = cl->cl;
+          c = clause_of_idx(s, cidx)->cl;
           assert(c[i] == b);
           // process other watched literal
           l = c[i^1];
@@ -3588,7 +3969,7 @@ static void resolve_conflict(smt_core_t *s) {
             l = *c;
           }
           if (l == end_learned) {
-            increase_clause_activity(s, cl);
+            bump_learned_clause(s, cidx);
           }
           break;
 
@@ -3740,11 +4121,11 @@ static void unsat_core_visit_literal(smt_core_t *s, int_hset_t *set, int_queue_t
  * c[1] ... c[n] are all false in the current assignment
  * so the antecedents of l are (not c[0]) ... (not c[n])
  */
-static void unsat_core_visit_clause(smt_core_t *s, int_hset_t *set, int_queue_t *queue, clause_t *cl) {
+static void unsat_core_visit_clause(smt_core_t *s, int_hset_t *set, int_queue_t *queue, cidx_t cidx) {
   literal_t *c;
   literal_t l;
 
-  c = cl->cl;
+  c = clause_of_idx(s, cidx)->cl;
   l = *c;
   while (l >= 0) {
     unsat_core_visit_literal(s, set, queue, not(l));
@@ -3912,11 +4293,10 @@ void build_unsat_core(smt_core_t *s, ivector_t *v) {
  * - a must not contain duplicate literals
  * - a must not be trivially true at the base level
  * - a[0] and a[1] must be valid watched literals
- * - return the new clause
+ * - return the new clause's index
  */
-static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
-  clause_t *cl;
-  literal_t l;
+static cidx_t new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+  cidx_t cidx;
 
 #if TRACE
   uint32_t i;
@@ -3929,21 +4309,18 @@ static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   fflush(stdout);
 #endif
 
-  cl = new_clause(n, a);
-  add_clause_to_vector(&s->problem_clauses, cl);
-
-  // add cl at the start of watch lists
-  l = a[0];
-  s->watch[l] = cons(0, cl, s->watch[l]);
+  cidx = new_clause(s, n, a);
+  add_clause_to_vector(&s->problem_clauses, cidx);
 
-  l = a[1];
-  s->watch[l] = cons(1, cl, s->watch[l]);
+  // add the clause to the watch vectors of a[0] and a[1]
+  add_clause_watch(s->watch + a[0], cidx, a[1]);
+  add_clause_watch(s->watch + a[1], cidx, a[0]);
 
   s->nb_prob_clauses ++;
   s->nb_clauses ++;
   s->stats.prob_literals += n;
 
-  return cl;
+  return cidx;
 }
 
 
@@ -4069,7 +4446,7 @@ static void add_simplified_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   uint32_t i, k0, k1, k;
   bval_t v0, v1, v;
   literal_t l;
-  clause_t *cl;
+  cidx_t cidx;
 
   assert(n >= 3);
 
@@ -4113,7 +4490,7 @@ static void add_simplified_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   check_watched_literals(s, n, a);
 #endif
 
-  cl = new_problem_clause(s, n, a);
+  cidx = new_problem_clause(s, n, a);
 
   if (bval_is_undef(v0)) k0 = UINT32_MAX;
   if (bval_is_undef(v1)) k1 = UINT32_MAX;
@@ -4124,7 +4501,7 @@ static void add_simplified_clause(smt_core_t *s, uint32_t n, literal_t *a) {
       backtrack_to_level(s, k0);
       s->inconsistent = false; // clear conflict if any
     }
-    implied_literal(s, a[1], mk_clause1_antecedent(cl));
+    implied_literal(s, a[1], mk_clause1_antecedent(cidx));
 
   } else if (v1 == VAL_FALSE && k1 < k0) {
     // a[0] implied at level k1
@@ -4132,12 +4509,12 @@ static void add_simplified_clause(smt_core_t *s, uint32_t n, literal_t *a) {
       backtrack_to_level(s, k1);
       s->inconsistent = false; // clear conflict if any
     }
-    implied_literal(s, a[0], mk_clause0_antecedent(cl));
+    implied_literal(s, a[0], mk_clause0_antecedent(cidx));
 
   } else if (v0 == VAL_FALSE && v1 == VAL_FALSE) {
     assert(k0 == k1);
     backtrack_to_level(s, k0);
-    record_clause_conflict(s, cl);
+    record_clause_conflict(s, cidx);
   }
 
 }
@@ -4237,6 +4614,7 @@ void record_empty_conflict(smt_core_t *s) {
   s->inconsistent = true;
   s->conflict_buffer[0] = end_clause;
   s->conflict = s->conflict_buffer;
+  s->false_clause = null_cidx;
 }
 
 
@@ -4281,6 +4659,7 @@ void add_unit_clause(smt_core_t *s, literal_t l) {
     // conflict (the whole thing is unsat)
     s->inconsistent = true;
     s->conflict = s->conflict_buffer;
+    s->false_clause = null_cidx;
     s->conflict_buffer[0] = l;
     s->conflict_buffer[1] = end_clause;
 
@@ -4625,6 +5004,144 @@ uint32_t add_all_quant_lemmas(smt_core_t *s, literal_t l, ivector_t *units) {
 
 
 
+/*************************
+ *  GARBAGE COLLECTION   *
+ ************************/
+
+/*
+ * Copy clause cl into arena to
+ * - store the new index in cl->aux.forward
+ * - return the new index
+ * - to must be large enough
+ */
+static cidx_t gc_move_clause(clause_arena_t *to, clause_t *cl) {
+  uint32_t n;
+  cidx_t cidx;
+
+  n = clause_arena_size(clause_length(cl)); // header + literals + end marker
+  cidx = to->size;
+  assert(n <= to->capacity - cidx);
+  memcpy(to->data + cidx, cl, n * sizeof(uint32_t));
+  to->size = cidx + n;
+  cl->aux.forward = cidx;
+
+  return cidx;
+}
+
+/*
+ * Move all clauses of vector v into arena to and update v
+ */
+static void gc_move_clause_vector(smt_core_t *s, clause_arena_t *to, cidx_t *v) {
+  uint32_t i, n;
+
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    v[i] = gc_move_clause(to, clause_of_idx(s, v[i]));
+  }
+}
+
+/*
+ * New index of clause cidx after it's been moved
+ */
+static inline cidx_t gc_forward(smt_core_t *s, cidx_t cidx) {
+  return clause_of_idx(s, cidx)->aux.forward;
+}
+
+/*
+ * Compact the clause arena:
+ * - the problem clauses then the learned clauses are copied into a
+ *   fresh array, in the order in which they occur in problem_clauses
+ *   and learned_clauses. This removes the deleted clauses.
+ * - then the watch vectors, the clause antecedents, and false_clause
+ *   are updated using the forward indices stored in the old array.
+ *
+ * All clauses in the watch vectors must be in problem_clauses or
+ * learned_clauses (i.e., the deleted clauses must have been removed
+ * from the watch vectors).
+ */
+static void collect_garbage(smt_core_t *s) {
+  clause_arena_t to;
+  clause_watch_t *w;
+  antecedent_t a;
+  uint32_t i, j, n, cap;
+  literal_t *u;
+  bvar_t x;
+
+  n = s->arena.size - s->arena.wasted; // upper bound on the size of the live clauses
+  cap = DEF_CLAUSE_ARENA_SIZE;
+  while (cap < n) {
+    cap += cap >> 1;
+    if (cap > MAX_CLAUSE_ARENA_SIZE) {
+      cap = MAX_CLAUSE_ARENA_SIZE;
+    }
+  }
+  to.data = (uint32_t *) safe_malloc(cap * sizeof(uint32_t));
+  to.size = 0;
+  to.capacity = cap;
+  to.wasted = 0;
+
+  gc_move_clause_vector(s, &to, s->problem_clauses);
+  gc_move_clause_vector(s, &to, s->learned_clauses);
+
+  // watch vectors
+  n = s->nlits;
+  for (i=0; i<n; i++) {
+    w = s->watch[i];
+    if (w != NULL) {
+      for (j=0; j<get_wv_size(w); j++) {
+        w[j].cidx = gc_forward(s, w[j].cidx);
+      }
+    }
+  }
+
+  /*
+   * antecedents of the assigned literals:
+   * - the antecedents of literals assigned at the base level are never
+   *   used, and their clause may have been deleted (by smt_pop), so
+   *   we clear them (as for unit clauses)
+   */
+  u = s->stack.lit;
+  n = s->stack.top;
+  for (i=0; i<n; i++) {
+    x = var_of(u[i]);
+    a = s->antecedent[x];
+    if (antecedent_tag(a) <= clause1_tag) {
+      if (s->level[x] <= s->base_level) {
+        s->antecedent[x] = mk_literal_antecedent(null_literal);
+      } else {
+        s->antecedent[x] = mk_clause_antecedent(gc_forward(s, clause_antecedent(a)), clause_index(a));
+      }
+    }
+  }
+
+  // conflict clause
+  if (s->inconsistent && s->false_clause != null_cidx) {
+    s->false_clause = gc_forward(s, s->false_clause);
+  } else {
+    s->false_clause = null_cidx;
+  }
+
+  safe_free(s->arena.data);
+  s->arena = to;
+
+  if (s->false_clause != null_cidx) {
+    s->conflict = clause_of_idx(s, s->false_clause)->cl;
+  }
+}
+
+
+/*
+ * Collect garbage if more than a quarter of the arena is wasted
+ */
+static void try_collect_garbage(smt_core_t *s) {
+  if (s->arena.wasted > (s->arena.size >> 2)) {
+    collect_garbage(s);
+  }
+}
+
+
+
+
 /*********************************
  *  DELETION OF LEARNED CLAUSES  *
  ********************************/
@@ -4636,10 +5153,10 @@ uint32_t add_all_quant_lemmas(smt_core_t *s, literal_t l, ivector_t *units) {
  * - the clauses of lowest activities are in a[half ... high-1],
  * where half = (low + high) / 2.
  */
-static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
+static void quick_split(smt_core_t *s, cidx_t *a, uint32_t low, uint32_t high) {
   uint32_t i, j, half;
   float pivot;
-  clause_t *aux;
+  cidx_t aux;
 
   if (high <= low + 1) return;
 
@@ -4648,10 +5165,10 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   do {
     i = low;
     j = high;
-    pivot = get_activity(a[i]);
+    pivot = get_activity(clause_of_idx(s, a[i]));
 
-    do { j --; } while (get_activity(a[j]) < pivot);
-    do { i ++; } while (i <= j && get_activity(a[i]) > pivot);
+    do { j --; } while (get_activity(clause_of_idx(s, a[j])) < pivot);
+    do { i ++; } while (i <= j && get_activity(clause_of_idx(s, a[i])) > pivot);
 
     while (i < j) {
       // a[i].act <= pivot and a[j].act >= pivot: swap a[i] and a[j]
@@ -4659,8 +5176,8 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
       a[i] = a[j];
       a[j] = aux;
 
-      do { j--; } while (get_activity(a[j]) < pivot);
-      do { i++; } while (get_activity(a[i]) > pivot);
+      do { j--; } while (get_activity(clause_of_idx(s, a[j])) < pivot);
+      do { i++; } while (get_activity(clause_of_idx(s, a[i])) > pivot);
     }
 
     // a[j].act >= pivot, a[low].act = pivot: swap a[low] and a[i]
@@ -4686,59 +5203,54 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
 
 
 /*
- * Apply this to a vector v of learned_clauses
+ * Auxiliary function: scan the watch vector of l0
+ * Remove all clauses marked for removal
  */
-static void reorder_clause_vector(clause_t **v) {
-  quick_split(v, 0, get_cv_size(v));
-}
+static void cleanup_watch_vector(smt_core_t *s, literal_t l0) {
+  clause_watch_t *w;
+  uint32_t i, j, n;
 
+  w = s->watch[l0];
+  if (w == NULL) return;
 
-/*
- * Auxiliary function: follow clause list of l0
- * Remove all clauses marked for removal
- */
-static void cleanup_watch_list(smt_core_t *s, literal_t l0) {
-  link_t lnk;
-  clause_t *cl;
-  link_t *list;
-
-  list = s->watch + l0;
-  for (lnk = *list; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    cl = clause_of(lnk);
-    if (! is_clause_to_be_removed(cl)) {
-      *list = lnk;
-      list = cdr_ptr(lnk);
+  n = get_wv_size(w);
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (! is_clause_to_be_removed(clause_of_idx(s, w[i].cidx))) {
+      w[j] = w[i];
+      j ++;
     }
   }
-
-  *list = NULL_LINK; // end of list
+  set_wv_size(w, j);
 }
 
 
 /*
- * Update all watch lists: remove all clauses marked for deletion.
+ * Update all watch vectors: remove all clauses marked for deletion.
  */
 static void cleanup_watch_lists(smt_core_t *s) {
   uint32_t i, n;
 
   n = s->nlits;
   for (i=0; i<n; i ++) {
-    cleanup_watch_list(s, i);
+    cleanup_watch_vector(s, i);
   }
 }
 
 
 /*
- * Check whether cl is an antecedent clause
+ * Check whether clause cidx is an antecedent clause
  */
-static bool clause_is_locked(smt_core_t *s, clause_t *cl) {
+static bool clause_is_locked(smt_core_t *s, cidx_t cidx) {
+  clause_t *cl;
   bvar_t x0, x1;
 
+  cl = clause_of_idx(s, cidx);
   x0 = var_of(get_first_watch(cl));
   x1 = var_of(get_second_watch(cl));
 
-  return (bval_is_def(s->value[x0]) && s->antecedent[x0] == mk_clause0_antecedent(cl))
-    || (bval_is_def(s->value[x1]) && s->antecedent[x1] == mk_clause1_antecedent(cl));
+  return (bval_is_def(s->value[x0]) && s->antecedent[x0] == mk_clause0_antecedent(cidx))
+    || (bval_is_def(s->value[x1]) && s->antecedent[x1] == mk_clause1_antecedent(cidx));
 }
 
 
@@ -4747,12 +5259,13 @@ static bool clause_is_locked(smt_core_t *s, clause_t *cl) {
  */
 static void delete_learned_clauses(smt_core_t *s) {
   uint32_t i, j, n;
-  clause_t **v;
+  cidx_t *v;
+  clause_t *cl;
 
   v = s->learned_clauses;
   n = get_cv_size(v);
 
-  // clean up all the watch-literal lists
+  // clean up all the watch vectors
   cleanup_watch_lists(s);
 
   // do the real deletion
@@ -4760,10 +5273,11 @@ static void delete_learned_clauses(smt_core_t *s) {
 
   j = 0;
   for (i = 0; i<n; i++) {
-    if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
+    cl = clause_of_idx(s, v[i]);
+    if (is_clause_to_be_removed(cl)) {
+      delete_clause(s, v[i]);
     } else {
-      s->stats.learned_literals += clause_length(v[i]);
+      s->stats.learned_literals += clause_length(cl);
       v[j] = v[i];
       j ++;
     }
@@ -4778,39 +5292,92 @@ static void delete_learned_clauses(smt_core_t *s) {
 
 
 /*
- * Delete half the learned clauses, minus the locked ones (Minisat style).
- * This is expensive: the function scans and reconstructs the
- * watched lists.
+ * Select the learned clauses that are candidates for deletion
+ * - the clauses to keep are moved to v[0 ... k-1] and the candidates
+ *   to v[k ... n-1] where n = size of v
+ * - return k
+ * - also clear the used flags and move the mid-tier clauses
+ *   that were not used since the last reduction to the local tier
+ */
+static uint32_t split_learned_clauses(smt_core_t *s, cidx_t *v) {
+  uint32_t i, k, n;
+  clause_t *cl;
+  cidx_t aux;
+  bool keep;
+
+  n = get_cv_size(v);
+  k = 0;
+  for (i=0; i<n; i++) {
+    cl = clause_of_idx(s, v[i]);
+    switch (cl->tier) {
+    case CORE_TIER:
+      keep = true;
+      break;
+
+    case MID_TIER:
+      keep = true;
+      if (! cl->used) {
+        cl->tier = LOCAL_TIER;
+      }
+      break;
+
+    default:
+      keep = cl->used;
+      break;
+    }
+    cl->used = false;
+
+    if (keep) {
+      aux = v[k];
+      v[k] = v[i];
+      v[i] = aux;
+      k ++;
+    }
+  }
+
+  return k;
+}
+
+
+/*
+ * Delete half the learned clauses that are candidates for deletion,
+ * minus the locked ones (Minisat style). This is expensive: the function
+ * scans and reconstructs the watch vectors, then compacts the clause arena.
  */
 void reduce_clause_database(smt_core_t *s) {
-  uint32_t i, n;
-  clause_t **v;
+  uint32_t i, k, n, half;
+  cidx_t *v;
   float act_threshold;
 
   v = s->learned_clauses;
   n = get_cv_size(v);
   if (n == 0) return;
 
-  // put the clauses with lowest activity in the upper
-  // half of the learned clause vector.
-  reorder_clause_vector(v);
+  // clauses to keep in v[0 ... k-1], candidates in v[k ... n-1]
+  k = split_learned_clauses(s, v);
+
+  // put the candidates with lowest activity in the upper
+  // half of v[k ... n-1]
+  quick_split(s, v, k, n);
 
   act_threshold = s->cla_inc/n;
+  half = (k + n)/2;
 
-  // prepare for deletion: all non-locked clauses, with activity less
+  // prepare for deletion: all non-locked candidates with activity less
   // than activity_threshold are marked for deletion.
-  for (i=0; i<n/2; i++) {
-    if (get_activity(v[i]) <= act_threshold && ! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
+  for (i=k; i<half; i++) {
+    if (get_activity(clause_of_idx(s, v[i])) <= act_threshold && ! clause_is_locked(s, v[i])) {
+      mark_for_removal(clause_of_idx(s, v[i]));
     }
   }
-  for (i = n/2; i<n; i++) {
+  for (i=half; i<n; i++) {
     if (! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
+      mark_for_removal(clause_of_idx(s, v[i]));
     }
   }
 
   delete_learned_clauses(s);
+  collect_garbage(s);
   s->stats.reduce_calls ++;
 }
 
@@ -4847,9 +5414,10 @@ static uint32_t unassigned_literals(smt_core_t *s, clause_t *cl) {
  * - split the set of learned clauses into two parts: old-clauses and young-clauses
  * - if there are n learned clauses in total, then the n/young_ratio most recent are young,
  *   the rest are old. (young_ratio is 16)
+ * - clauses in the core tier are kept
  */
 void remove_irrelevant_learned_clauses(smt_core_t *s) {
-  clause_t **v;
+  cidx_t *v;
   clause_t *cl;
   uint32_t i, n, p, relevance;
   float coeff;
@@ -4862,8 +5430,8 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
   coeff = (float) (HEAD_ACTIVITY - TAIL_ACTIVITY)/n;
 
   for (i=0; i<n; i++) {
-    cl = v[i];
-    if (! clause_is_locked(s, cl)) {
+    cl = clause_of_idx(s, v[i]);
+    if (cl->tier != CORE_TIER && ! clause_is_locked(s, v[i])) {
       relevance = i < p ? HEAD_RELEVANCE : TAIL_RELEVANCE;
       if (get_activity(cl) < HEAD_ACTIVITY - coeff * i &&
           unassigned_literals(s, cl) > relevance) {
@@ -4873,6 +5441,7 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
   }
 
   delete_learned_clauses(s);
+  try_collect_garbage(s);
   s->stats.remove_calls ++;
 }
 
@@ -4979,7 +5548,7 @@ static void mark_true_clause(smt_core_t *s, clause_t *cl) {
  */
 static void simplify_clause_set(smt_core_t *s) {
   uint32_t i, j, n;
-  clause_t **v;
+  cidx_t *v;
 
   assert(s->decision_level == s->base_level);
 
@@ -4993,9 +5562,9 @@ static void simplify_clause_set(smt_core_t *s) {
     v = s->problem_clauses;
     n = get_cv_size(v);
     for (i=0; i<n; i++) {
-      if (! is_clause_to_be_removed(v[i]) &&
+      if (! is_clause_to_be_removed(clause_of_idx(s, v[i])) &&
           ! clause_is_locked(s, v[i])) {
-        simplify_clause(s, v[i]);
+        simplify_clause(s, clause_of_idx(s, v[i]));
       }
     }
     s->stats.prob_literals = s->aux_literals;
@@ -5007,9 +5576,9 @@ static void simplify_clause_set(smt_core_t *s) {
     v = s->learned_clauses;
     n = get_cv_size(v);
     for (i=0; i<n; i++) {
-      assert(! is_clause_to_be_removed(v[i]));
+      assert(! is_clause_to_be_removed(clause_of_idx(s, v[i])));
       if (! clause_is_locked(s, v[i])) {
-        simplify_clause(s, v[i]);
+        simplify_clause(s, clause_of_idx(s, v[i]));
       }
     }
     s->stats.learned_literals = s->aux_literals;
@@ -5024,9 +5593,9 @@ static void simplify_clause_set(smt_core_t *s) {
     v = s->problem_clauses;
     n = get_cv_size(v);
     for (i=0; i<n; i++) {
-      if (! is_clause_to_be_removed(v[i]) &&
+      if (! is_clause_to_be_removed(clause_of_idx(s, v[i])) &&
           ! clause_is_locked(s, v[i])) {
-        mark_true_clause(s, v[i]);
+        mark_true_clause(s, clause_of_idx(s, v[i]));
       }
     }
     s->stats.prob_literals = s->aux_literals;
@@ -5037,9 +5606,9 @@ static void simplify_clause_set(smt_core_t *s) {
     v = s->learned_clauses;
     n = get_cv_size(v);
     for (i=0; i<n; i++) {
-      assert(! is_clause_to_be_removed(v[i]));
+      assert(! is_clause_to_be_removed(clause_of_idx(s, v[i])));
       if (! clause_is_locked(s, v[i])) {
-        mark_true_clause(s, v[i]);
+        mark_true_clause(s, clause_of_idx(s, v[i]));
       }
     }
     s->stats.learned_literals = s->aux_literals;
@@ -5061,8 +5630,8 @@ static void simplify_clause_set(smt_core_t *s) {
     n = get_cv_size(v);
     j = 0;
     for (i=0; i<n; i++) {
-      if (is_clause_to_be_removed(v[i])) {
-        delete_clause(v[i]);
+      if (is_clause_to_be_removed(clause_of_idx(s, v[i]))) {
+        delete_clause(s, v[i]);
       } else {
         v[j] = v[i];
         j ++;
@@ -5081,8 +5650,8 @@ static void simplify_clause_set(smt_core_t *s) {
   n = get_cv_size(v);
   j = 0;
   for (i=0; i<n; i++) {
-    if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
+    if (is_clause_to_be_removed(clause_of_idx(s, v[i]))) {
+      delete_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j ++;
@@ -5091,6 +5660,8 @@ static void simplify_clause_set(smt_core_t *s) {
   set_cv_size(v, j);
   s->nb_clauses -= n - j;
   s->stats.learned_clauses_deleted += n - j;
+
+  try_collect_garbage(s);
 }
 
 
@@ -5276,50 +5847,46 @@ void smt_push(smt_core_t *s) {
 
 
 /*
- * Mark all learned clauses for removal
+ * Delete all learned clauses
  */
 static void remove_all_learned_clauses(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **v;
+  cidx_t *v;
 
   v = s->learned_clauses;
   n = get_cv_size(v);
-
   for (i=0; i<n; i++) {
-    mark_for_removal(v[i]);
+    delete_clause(s, v[i]);
   }
+  reset_clause_vector(v);
 }
 
 
 /*
- * Mark problem clauses (at indices n, n+1, ...)
+ * Delete problem clauses (at indices n, n+1, ...)
  */
 static void remove_problem_clauses(smt_core_t *s, uint32_t n) {
-  uint32_t m;
-  clause_t **v;
-  clause_t *cl;
+  uint32_t i, m;
+  cidx_t *v;
 
   v = s->problem_clauses;
   m = get_cv_size(v);
-  while (n < m) {
-    cl = v[n];
-    if (! is_clause_to_be_removed(cl)) {
-      mark_for_removal(cl);
-    }
-    n ++;
+  for (i=n; i<m; i++) {
+    delete_clause(s, v[i]);
   }
+  set_cv_size(v, n);
 }
 
 
 /*
- * Reset the watch lists (to empty lists)
+ * Reset the watch vectors (to empty vectors)
  */
 static void reset_watch_lists(smt_core_t *s) {
   uint32_t i, n;
 
   n = s->nlits;
   for (i=0; i<n; i++) {
-    s->watch[i] = NULL_LINK;
+    reset_watch_vector(s->watch[i]);
   }
 }
 
@@ -5330,59 +5897,42 @@ static void reset_watch_lists(smt_core_t *s) {
  * - n = number of problem clauses at the start of the current base level
  */
 static void restore_clauses(smt_core_t *s, uint32_t n) {
-  uint32_t i, m, nlits;
-  clause_t **v;
+  uint32_t i, nlits;
+  cidx_t *v;
   clause_t *cl;
-  literal_t l;
 
-  // mark clauses for removal
+  // the conflict clause (if any) may be deleted: forget it
+  s->false_clause = null_cidx;
+
+  // delete the learned clauses and the recent problem clauses
   remove_all_learned_clauses(s);
   remove_problem_clauses(s, n);
 
-  // empty the watch lists
+  // empty the watch vectors
   reset_watch_lists(s);
 
-  // do the real deletion
-  v = s->learned_clauses;
-  m = get_cv_size(v);
-  for (i=0; i<m; i++) {
-    delete_learned_clause(v[i]);
-  }
-  reset_clause_vector(v);
-
-  v = s->problem_clauses;
-  m = get_cv_size(v);
-  for (i=n; i<m; i++) {
-    delete_clause(v[i]);
-  }
-  set_cv_size(v, n);
-
   /*
-   * put all problem clauses back into the watch lists
+   * put all problem clauses back into the watch vectors
    * and restore the marked problem clauses in v[0 ... n-1]
    */
+  v = s->problem_clauses;
   nlits = 0;   // to count the total number of literals
   for (i=0; i<n; i++) {
-    cl = v[i];
+    cl = clause_of_idx(s, v[i]);
     if (is_clause_to_be_removed(cl)) {
       restore_removed_clause(cl);
       assert(cl->cl[0] >= 0 && cl->cl[1] >= 0);
     }
     nlits += clause_length(cl);
-
-    // add cl at the start of its watch lists
-    l = cl->cl[0];
-    s->watch[l] = cons(0, cl, s->watch[l]);
-
-    l = cl->cl[1];
-    s->watch[l] = cons(1, cl, s->watch[l]);
+    watch_clause(s, v[i], cl);
   }
 
-
   s->nb_clauses = n;
   s->nb_prob_clauses = n;
   s->stats.prob_literals = nlits;
   s->stats.learned_literals = 0;
+
+  try_collect_garbage(s);
 }
 
 
@@ -5442,8 +5992,10 @@ static void restore_variables(smt_core_t *s, uint32_t n) {
     delete_literal_vector(s->bin[l1]);
     s->bin[l0] = NULL;
     s->bin[l1] = NULL;
-    s->watch[l0] = NULL_LINK;
-    s->watch[l1] = NULL_LINK;
+    delete_watch_vector(s->watch[l0]);
+    delete_watch_vector(s->watch[l1]);
+    s->watch[l0] = NULL;
+    s->watch[l1] = NULL;
   }
 
   s->nvars = n;
@@ -5756,8 +6308,9 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
       delete_literal_vector(v0);
       s->bin[l0] = NULL;
       s->aux_literals += n;
-      s->watch[l0] = NULL_LINK; // not strictly necessary
     }
+    delete_watch_vector(s->watch[l0]);
+    s->watch[l0] = NULL;
   }
 
   // update the statistics
@@ -5773,15 +6326,17 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
  * If it does, mark it for deletion.
  * Use s->aux_literals to count the number of literals kept
  */
-static void mark_clause_to_remove(smt_core_t *s, clause_t *cl, literal_t max) {
+static void mark_clause_to_remove(smt_core_t *s, cidx_t cidx, literal_t max) {
+  clause_t *cl;
   uint32_t i;
   literal_t l;
 
+  cl = clause_of_idx(s, cidx);
   i = 0;
   l = cl->cl[i];
   while (l >= 0) {
     if (l >= max) {
-      assert(! clause_is_locked(s, cl));
+      assert(! clause_is_locked(s, cidx));
       mark_for_removal(cl);
       return;
     }
@@ -5799,7 +6354,7 @@ static void mark_clause_to_remove(smt_core_t *s, clause_t *cl, literal_t max) {
 static void remove_garbage_clauses(smt_core_t *s) {
   literal_t max;
   uint32_t i, j, n;
-  clause_t **v;
+  cidx_t *v;
 
   max = pos_lit(s->nvars); // all literals of index >= max are dead
 
@@ -5828,8 +6383,8 @@ static void remove_garbage_clauses(smt_core_t *s) {
   n = get_cv_size(v);
   j = 0;
   for (i=0; i<n; i++) {
-    if (is_clause_to_be_removed(v[i])) {
-      delete_clause(v[i]);
+    if (is_clause_to_be_removed(clause_of_idx(s, v[i]))) {
+      delete_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j++;
@@ -5844,8 +6399,8 @@ static void remove_garbage_clauses(smt_core_t *s) {
   n = get_cv_size(v);
   j = 0;
   for (i=0; i<n; i++) {
-    if (is_clause_to_be_removed(v[i])) {
-      delete_learned_clause(v[i]);
+    if (is_clause_to_be_removed(clause_of_idx(s, v[i]))) {
+      delete_clause(s, v[i]);
     } else {
       v[j] = v[i];
       j ++;
@@ -5889,6 +6444,7 @@ static void delete_irrelevant_variables(smt_core_t *s) {
     s->th_smt.end_atom_deletion(s->th_solver);
     remove_garbage_clauses(s);
     remove_garbage_bin_clauses(s, old_nvars);
+    try_collect_garbage(s);
   }
 }
 
@@ -5965,7 +6521,7 @@ void internalization_start(smt_core_t *s) {
   s->inconsistent = false;
   s->theory_conflict = false;
   s->conflict = NULL;
-  s->false_clause = NULL;
+  s->false_clause = null_cidx;
   s->th_ctrl.start_internalization(s->th_solver);
 }
 
@@ -6036,7 +6592,7 @@ void start_search(smt_core_t *s, uint32_t n, const literal_t *a) {
   s->inconsistent = false;
   s->theory_conflict = false;
   s->conflict = NULL;
-  s->false_clause = NULL;
+  s->false_clause = null_cidx;
 
   s->stats.restarts = 0;
   s->stats.simplify_calls = 0;
@@ -6044,6 +6600,7 @@ void start_search(smt_core_t *s, uint32_t n, const literal_t *a) {
   s->stats.decisions = 0;
   s->stats.random_decisions = 0;
   s->stats.conflicts = 0;
+  s->stats.chrono_backtracks = 0;
   s->simplify_bottom = 0;
   s->simplify_props = 0;
   s->simplify_threshold = 0;
@@ -6290,7 +6847,7 @@ static bool level_has_lower_activity(smt_core_t *s, double ax, uint32_t k) {
 
   while (i < n) {
     x = var_of(stack->lit[i]);
-    assert(bvar_is_assigned(s, x) && s->level[x] == k);
+    assert(bvar_is_assigned(s, x) && s->level[x] <= k);
     if (s->heap.activity[x] >= ax) {
       return false;
     }
@@ -6489,12 +7046,12 @@ static bool clause_is_true(smt_core_t *s, clause_t *cl) {
  */
 static bool all_problem_clauses_are_true(smt_core_t *s) {
   uint32_t i, n;
-  clause_t **v;
+  cidx_t *v;
 
   v = s->problem_clauses;
   n = get_cv_size(v);
   for (i=0; i<n; i++) {
-    if (! clause_is_true(s, v[i])) return false;
+    if (! clause_is_true(s, clause_of_idx(s, v[i]))) return false;
   }
 
   return true;
@@ -6668,12 +7225,12 @@ static void collect_vars_in_clause(free_bool_vars_t *fv, const clause_t *cl) {
  */
 static void collect_vars_in_problem_clauses(free_bool_vars_t *fv, const smt_core_t *s) {
   uint32_t i, n;
-  clause_t **v;
+  cidx_t *v;
 
   v = s->problem_clauses;
   n = get_cv_size(v);
   for (i=0; i<n; i++) {
-    collect_vars_in_clause(fv, v[i]);
+    collect_vars_in_clause(fv, clause_of_idx(s, v[i]));
   }
 }
 
@@ -6787,26 +7344,33 @@ static inline int32_t indicator(bval_t v, bval_t c) {
   return (v == c) ? 1 : 0;
 }
 
-static void check_watch_list(smt_core_t *s, literal_t l, clause_t *cl) {
-  link_t lnk;
+static void check_watch_list(smt_core_t *s, literal_t l, cidx_t cidx) {
+  clause_watch_t *w;
+  uint32_t i, n;
 
-  for (lnk = s->watch[l]; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    if (clause_of(lnk) == cl) {
-      return;
+  w = s->watch[l];
+  if (w != NULL) {
+    n = get_wv_size(w);
+    for (i=0; i<n; i++) {
+      if (w[i].cidx == cidx) {
+        return;
+      }
     }
   }
 
-  printf("ERROR: missing watch, literal = %"PRId32", clause = %p\n", l, clause_of(lnk));
+  printf("ERROR: missing watch, literal = %"PRId32", clause = %"PRIu32"\n", l, cidx);
 }
 
 
-static void check_propagation_clause(smt_core_t *s, clause_t *cl) {
+static void check_propagation_clause(smt_core_t *s, cidx_t cidx) {
+  clause_t *cl;
   literal_t l0, l1, l;
   literal_t *d;
   int32_t nf, nt, nu;
   uint32_t i;
   bval_t v;
 
+  cl = clause_of_idx(s, cidx);
   nf = 0;
   nt = 0;
   nu = 0;
@@ -6845,7 +7409,7 @@ static void check_propagation_clause(smt_core_t *s, clause_t *cl) {
       i ++;
       l = d[i];
     }
-    printf("} (addr = %p)\n", cl);
+    printf("} (idx = %"PRIu32")\n", cidx);
   }
 
   if (nt == 0 && nu == 1) {
@@ -6857,17 +7421,17 @@ static void check_propagation_clause(smt_core_t *s, clause_t *cl) {
       i ++;
       l = d[i];
     }
-    printf("} (addr = %p)\n", cl);
+    printf("} (idx = %"PRIu32")\n", cidx);
   }
 
-  check_watch_list(s, l0, cl);
-  check_watch_list(s, l1, cl);
+  check_watch_list(s, l0, cidx);
+  check_watch_list(s, l1, cidx);
 }
 
 static void check_propagation(smt_core_t *s) {
   literal_t l0;
   uint32_t i, n;
-  clause_t **v;
+  cidx_t *v;
 
   for (l0=0; l0<s->nlits; l0++) {
     check_propagation_bin(s, l0);
@@ -6876,7 +7440,7 @@ static void check_propagation(smt_core_t *s) {
   v = s->problem_clauses;
   n = get_cv_size(v);
   for (i=0; i<n; i++) {
-    if (! is_clause_to_be_removed(v[i])) {
+    if (! is_clause_to_be_removed(clause_of_idx(s, v[i]))) {
       check_propagation_clause(s, v[i]);
     }
   }
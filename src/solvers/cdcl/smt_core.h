@@ -58,6 +58,7 @@
 #include "solvers/cdcl/gates_hash_table.h"
 #include "utils/bitvectors.h"
 #include "utils/int_vectors.h"
+#include "utils/tag_map.h"
 
 #include "yices_types.h"
 
@@ -71,22 +72,28 @@
  **********/
 
 /*
- * Clauses structure
- * - two pointers to form lists of clauses for the watched literals
+ * Clauses with at least three literals are stored in a clause arena:
+ * a single array of 32bit integers. A clause is identified by its
+ * index in this array (cidx_t).
+ *
+ * Clause structure:
+ * - lbd, tier, used: used by the clause-deletion heuristic
+ *   (for learned clauses only, see below)
+ * - aux = auxiliary data
+ *   for learned clauses, aux.activity is used by the clause-deletion
+ *   heuristic. During garbage collection, aux.forward stores the
+ *   new index of the clause.
  * - a clause is an array of literals terminated by an end marker
  *   (a negative number).
  * - the first two literals stored in cl[0] and cl[1]
  *   are the watched literals.
- * Learned clauses have the same components as a clause
- * and an activity, i.e., a float used by the clause-deletion
- * heuristic. (Because of alignment and padding, this wastes 32bits
- * on a 64bit machine....)
  *
- * Linked lists:
- * - a link lnk is a pointer to a clause cl
- *   the low-order bits of lnk encode whether the next link is
- *   in cl->link[0] or cl->link[1]
- * - this is compatible with the tagged pointers used as antecedents.
+ * A clause of n literals uses n+3 elements in the arena (two for the
+ * header and one for the end marker). Clauses are never moved except by the
+ * garbage collector so a clause index remains valid until the clause
+ * is deleted or the arena is compacted. A pointer to a clause is
+ * valid only until the next clause is allocated (the arena may be
+ * reallocated).
  *
  * SPECIAL CODING: to distinguish between learned clauses and problem
  * clauses, the end marker is different.
@@ -97,6 +104,20 @@
  * - value[-1] = VAL_UNDEF_FALSE
  *   value[-2] = VAL_UNDEF_FALSE
  *
+ * LEARNED CLAUSE TIERS:
+ * - lbd = literal-block distance of the clause (number of distinct
+ *   decision levels among its literals), computed when the clause is
+ *   learned and updated when it's used in conflict analysis.
+ * - tier = one of CORE_TIER, MID_TIER, LOCAL_TIER
+ *   clauses of lbd <= CORE_LBD are in the core tier: they are never deleted
+ *   clauses of lbd <= MID_LBD are in the mid tier: they are kept as long
+ *   as they are used between two reductions of the clause database.
+ *   Otherwise, they are moved to the local tier.
+ *   other clauses are in the local tier: they are deleted based on activity
+ *   unless they were used since the last reduction.
+ * - used = true if the clause was used in conflict analysis since the
+ *   last reduction.
+ *
  * CLAUSE DELETION AND SIMPLIFICATION:
  * - to mark a clause for deletion or to removed it from the watched lists,
  *   both cl[0] and cl[1] are replaced by their opposite (turned into negative numbers).
@@ -107,66 +128,72 @@ enum {
   end_learned = -2, // end of learned clause
 };
 
-typedef struct clause_s clause_t;
+typedef uint32_t cidx_t;
 
-typedef uintptr_t link_t;
+typedef enum clause_tier {
+  CORE_TIER,
+  MID_TIER,
+  LOCAL_TIER,
+} clause_tier_t;
 
-struct clause_s {
-  link_t link[2];
-  literal_t cl[0];
-};
+#define CORE_LBD 2
+#define MID_LBD 4
 
-typedef struct learned_clause_s {
-  float activity;
-  clause_t clause;
-} learned_clause_t;
+// lbd is stored on 16 bits
+#define MAX_CLAUSE_LBD UINT16_MAX
+
+// number of arena elements used by a clause of n literals
+#define clause_arena_size(n) ((n) + 3)
+
+typedef struct clause_s {
+  uint16_t lbd;
+  uint8_t tier;
+  uint8_t used;
+  union {
+    float activity;
+    cidx_t forward;
+  } aux;
+  literal_t cl[0];
+} clause_t;
 
 
 /*
- * Tagging/untagging of link pointers
+ * Clause arena:
+ * - data = array of capacity elements
+ * - size = number of elements used: new clauses are allocated
+ *   in data[size ... capacity - 1]
+ * - wasted = number of elements in data[0 ... size-1] used by deleted clauses
  */
-#define LINK_TAG ((uintptr_t) 0x1)
-#define NULL_LINK ((link_t) 0)
+typedef struct clause_arena_s {
+  uint32_t *data;
+  uint32_t size;
+  uint32_t capacity;
+  uint32_t wasted;
+} clause_arena_t;
 
-static inline link_t mk_link(clause_t *c, uint32_t i) {
-  assert((i & ~LINK_TAG) == 0 && (((uintptr_t) c) & LINK_TAG) == 0);
-  return (link_t)(((uintptr_t) c) | ((uintptr_t) i));
-}
+#define DEF_CLAUSE_ARENA_SIZE 16384
+#define MAX_CLAUSE_ARENA_SIZE (UINT32_MAX/16)
 
-static inline clause_t *clause_of(link_t lnk) {
-  return (clause_t *)(lnk & ~LINK_TAG);
-}
+// index used to mark the absence of clause (larger than any valid index)
+#define null_cidx UINT32_MAX
 
-static inline uint32_t idx_of(link_t lnk) {
-  return (uint32_t)(lnk & LINK_TAG);
-}
-
-static inline link_t next_of(link_t lnk) {
-  return clause_of(lnk)->link[idx_of(lnk)];
-}
 
 
-/*
- * return a new link lnk0 such that
- * - clause_of(lnk0) = c
- * - idx_of(lnk0) = i
- * - next_of(lnk0) = lnk
- */
-static inline link_t cons(uint32_t i, clause_t *c, link_t lnk) {
-  assert(i <= 1);
-  c->link[i] = lnk;
-  return mk_link(c, i);
-}
+/*******************
+ *  WATCH VECTORS  *
+ ******************/
 
 /*
- * If lnk points to a clause cl, then return
- * a pointer to either cl->link[0] or cl->link[1], depending on
- * the lower order bit of lnk.
+ * For a literal l, watch[l] stores the clauses in which l is a
+ * watched literal (i.e., the clauses where l occurs in cl[0] or cl[1]).
+ * Each element of watch[l] is a pair [cidx, blocker] where blocker
+ * is a literal of clause cidx other than l. If the blocker is true,
+ * propagation skips the clause without reading it.
  */
-static inline link_t *cdr_ptr(link_t lnk) {
-  return clause_of(lnk)->link + idx_of(lnk);
-}
-
+typedef struct clause_watch_s {
+  cidx_t cidx;
+  literal_t blocker;
+} clause_watch_t;
 
 
 
@@ -184,7 +211,7 @@ static inline link_t *cdr_ptr(link_t lnk) {
 typedef struct clause_vector_s {
   uint32_t capacity;
   uint32_t size;
-  clause_t *data[0];
+  cidx_t data[0];
 } clause_vector_t;
 
 typedef struct literal_vector_s {
@@ -193,23 +220,29 @@ typedef struct literal_vector_s {
   literal_t data[0];
 } literal_vector_t;
 
+typedef struct watch_vector_s {
+  uint32_t capacity;
+  uint32_t size;
+  clause_watch_t data[0];
+} watch_vector_t;
+
 
 /*
  * Access to header of clause vector v
  */
-static inline clause_vector_t *cv_header(clause_t **v) {
+static inline clause_vector_t *cv_header(cidx_t *v) {
   return (clause_vector_t *)(((char *)v) - offsetof(clause_vector_t, data));
 }
 
-static inline uint32_t get_cv_size(clause_t **v) {
+static inline uint32_t get_cv_size(cidx_t *v) {
   return cv_header(v)->size;
 }
 
-static inline void set_cv_size(clause_t **v, uint32_t sz) {
+static inline void set_cv_size(cidx_t *v, uint32_t sz) {
   cv_header(v)->size = sz;
 }
 
-static inline uint32_t get_cv_capacity(clause_t **v) {
+static inline uint32_t get_cv_capacity(cidx_t *v) {
   return cv_header(v)->capacity;
 }
 
@@ -234,17 +267,36 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
 }
 
 
+/*
+ * Header, size and capacity of a watch vector v
+ */
+static inline watch_vector_t *wv_header(clause_watch_t *v) {
+  return (watch_vector_t *)(((char *) v) - offsetof(watch_vector_t, data));
+}
+
+static inline uint32_t get_wv_size(clause_watch_t *v) {
+  return wv_header(v)->size;
+}
+
+static inline void set_wv_size(clause_watch_t *v, uint32_t sz) {
+  wv_header(v)->size = sz;
+}
+
+
 
 /*
  * Default sizes and max sizes of vectors
  */
 #define DEF_CLAUSE_VECTOR_SIZE 100
-#define MAX_CLAUSE_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(clause_vector_t)))/8)
+#define MAX_CLAUSE_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(clause_vector_t)))/4)
 
 #define DEF_LITERAL_VECTOR_SIZE 10
 #define DEF_LITERAL_BUFFER_SIZE 100
 #define MAX_LITERAL_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(literal_vector_t)))/4)
 
+#define DEF_WATCH_VECTOR_SIZE 6
+#define MAX_WATCH_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(watch_vector_t)))/8)
+
 
 
 /**********************************
@@ -263,6 +315,9 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
  * - for each decision level, an index into the stack points
  *   to the literal decided or assigned at that level (for backtracking)
  * - for level 0, level_index[0] = 0 = index of the first literal assigned
+ * - with chronological backtracking, the literals of level k are all
+ *   after level_index[k] but the stack may contain literals of lower
+ *   levels after that (i.e., literals assigned out of order)
  */
 typedef struct {
   literal_t *lit;
@@ -289,12 +344,13 @@ typedef struct {
 /*
  * Antecedent = reason for an implied literal.
  * It's either a clause or a literal or a generic explanation.
- * Antecedents are represented as tagged pointers with tag in the
+ * Antecedents are represented as tagged integers/pointers with tag in the
  * two low-order bits
  * - tag = 00: clause with implied literal as cl[0]
  * - tag = 01: clause with implied literal as cl[1]
  * - tag = 10: literal
  * - tag = 11: generic explanation from a theory solver
+ * For a clause antecedent, the rest of the word is the clause index.
  */
 typedef uintptr_t antecedent_t;
 
@@ -313,8 +369,8 @@ static inline literal_t literal_antecedent(antecedent_t a) {
   return (literal_t) (((int32_t) a) >>2);
 }
 
-static inline clause_t *clause_antecedent(antecedent_t a) {
-  return (clause_t *) (a & ~((uintptr_t) 0x3));
+static inline cidx_t clause_antecedent(antecedent_t a) {
+  return (cidx_t) (a >> 2);
 }
 
 // clause index: 0 or 1, low order bit of a
@@ -330,19 +386,16 @@ static inline antecedent_t mk_literal_antecedent(literal_t l) {
   return (((uintptr_t) l) << 2) | literal_tag;
 }
 
-static inline antecedent_t mk_clause0_antecedent(clause_t *cl) {
-  assert((((uintptr_t) cl) & 0x3) == 0);
-  return ((uintptr_t) cl) | clause0_tag;
+static inline antecedent_t mk_clause0_antecedent(cidx_t cidx) {
+  return (((uintptr_t) cidx) << 2) | clause0_tag;
 }
 
-static inline antecedent_t mk_clause1_antecedent(clause_t *cl) {
-  assert((((uintptr_t) cl) & 0x3) == 0);
-  return ((uintptr_t) cl) | clause1_tag;
+static inline antecedent_t mk_clause1_antecedent(cidx_t cidx) {
+  return (((uintptr_t) cidx) << 2) | clause1_tag;
 }
 
-static inline antecedent_t mk_clause_antecedent(clause_t *cl, int32_t idx) {
-  assert((((uintptr_t) cl) & 0x3) == 0);
-  return ((uintptr_t) cl) | (idx & 1);
+static inline antecedent_t mk_clause_antecedent(cidx_t cidx, int32_t idx) {
+  return (((uintptr_t) cidx) << 2) | (idx & 1);
 }
 
 static inline antecedent_t mk_generic_antecedent(void *g) {
@@ -785,6 +838,7 @@ typedef struct dpll_stats_s {
   uint64_t random_decisions; // number of random decisions
   uint64_t propagations;     // number of boolean propagations
   uint64_t conflicts;        // number of conflicts/backtrackings
+  uint64_t chrono_backtracks; // number of chronological backtrackings
 
   uint32_t th_props;         // number of theory propagation
   uint32_t th_prop_lemmas;   // number of propagation/explanation turned into clauses
@@ -868,6 +922,7 @@ typedef enum smt_mode {
  * The clause database is divided into:
  *  - a vector of problem clauses
  *  - a vector of learned clauses
+ * both vectors contain indices of clauses stored in the clause arena.
  * unit and binary clauses are stored implicitly:
  * - unit clauses are just literals in the assignment stack
  * - binary clauses are stored in the binary watch vectors
@@ -876,10 +931,8 @@ typedef enum smt_mode {
  *
  * Propagation structures: for every literal l
  * - bin[l] = literal vector for binary clauses
- * - watch[l] = list of clauses where l is a watched literal
- *   (i.e., clauses where l occurs in position 0 or 1)
- * - optional: end_watch[l] = pointer to the last element in the watch list of l
- *   end_watch is used if USE_END_WATCH is set a compilation time
+ * - watch[l] = watch vector: clauses where l is a watched literal
+ *   (i.e., clauses where l occurs in position 0 or 1) and their blockers
  *
  * For every variable x between 0 and nb_vars - 1
  * - antecedent[x]: antecedent type and value
@@ -906,15 +959,16 @@ typedef enum smt_mode {
  *      l1, l2, end_clause are copied into the auxiliary array conflict_buffer
  *      conflict points to conflict_buffer
  *      theory_conflict is false
- *      false_clause is NULL
+ *      false_clause is null_cidx
  * - for a non-binary clause conflict cl
  *      conflict points to cl->cl
  *      theory_conflict is false
- *      false_clause is set to cl
+ *      false_clause is set to cl's index
+ *   (conflict is updated if the arena is reallocated)
  * - for a theory conflict a:
  *      conflict is set to a
  *      theory_conflict is true
- *      false_clause is NULL
+ *      false_clause is null_cidx
  *
  * Theory-clause caching heuristics:
  * - optionally, small theory conflicts and theory explanations can be turned
@@ -987,12 +1041,15 @@ typedef struct smt_core_s {
   bool th_cache_enabled;      // true means caching enabled
   uint32_t th_cache_cl_size;  // max. size of cached clauses
 
+  /* Chronological backtracking threshold (0 means disabled) */
+  uint32_t chrono_threshold;
+
   /* Conflict data */
   bool inconsistent;
   bool theory_conflict;
   literal_t conflict_buffer[4];
   literal_t *conflict;
-  clause_t *false_clause;
+  cidx_t false_clause;
   uint32_t th_conflict_size;  // number of literals in theory conflicts
 
   /* Assumptions */
@@ -1006,12 +1063,16 @@ typedef struct smt_core_s {
   ivector_t buffer;
   ivector_t buffer2;
 
+  /* Set of decision levels for computing clause lbd */
+  tag_map_t level_map;
+
   /* Buffer for expanding theory explanations */
   ivector_t explanation;
 
   /* Clause database */
-  clause_t **problem_clauses;
-  clause_t **learned_clauses;
+  clause_arena_t arena;
+  cidx_t *problem_clauses;
+  cidx_t *learned_clauses;
 
   ivector_t binary_clauses;  // Keeps a copy of binary clauses added at base_levels>0
 
@@ -1023,7 +1084,7 @@ typedef struct smt_core_s {
 
   /* Literal-indexed arrays (of size lsize) */
   literal_t **bin;   // array of literal vectors
-  link_t *watch;     // array of watch lists
+  clause_watch_t **watch;  // array of watch vectors
 
   /* Stack/propagation queue */
   prop_stack_t stack;
@@ -1060,6 +1121,16 @@ typedef struct smt_core_s {
 } smt_core_t;
 
 
+/*
+ * Clause of index cidx
+ * - the pointer is valid until the next clause allocation or garbage collection
+ */
+static inline clause_t *clause_of_idx(const smt_core_t *s, cidx_t cidx) {
+  assert(cidx < s->arena.size);
+  return (clause_t *) (s->arena.data + cidx);
+}
+
+
 /*
  * Initial size of buffer, buffer2, and explanation vectors
  */
@@ -1106,11 +1177,22 @@ typedef struct smt_core_s {
  */
 #define VAR_RANDOM_FACTOR 0.02F
 
+
 // mask to extract 24 bits out of an unsigned 32bit integer
 #define VAR_RANDOM_MASK  ((uint32_t)0xFFFFFF)
 #define VAR_RANDOM_SCALE (VAR_RANDOM_MASK+1)
 
 
+/*
+ * Chronological backtracking: if the implied literal of a learned
+ * clause would cause a backjump of more than CHRONO_THRESHOLD levels,
+ * we backtrack by one level only (cf. Nadel & Ryvchin, SAT 2018).
+ * The theory solver then undoes much less state.
+ * - 0 means that chronological backtracking is disabled (default)
+ */
+#define CHRONO_THRESHOLD 0
+
+
 
 
 /************************
@@ -1246,6 +1328,15 @@ static inline void disable_theory_cache(smt_core_t *s) {
 }
 
 
+/*
+ * Set the chronological backtracking threshold
+ * - 0 disables chronological backtracking
+ */
+static inline void set_chrono_threshold(smt_core_t *s, uint32_t threshold) {
+  s->chrono_threshold = threshold;
+}
+
+
 /*
  * Read the current decision level
  */
@@ -1319,6 +1410,10 @@ static inline uint64_t num_conflicts(smt_core_t *s) {
   return s->stats.conflicts;
 }
 
+static inline uint64_t num_chrono_backtracks(smt_core_t *s) {
+  return s->stats.chrono_backtracks;
+}
+
 static inline uint32_t num_theory_conflicts(smt_core_t *s) {
   return s->stats.th_conflicts;
 }
@@ -1765,8 +1860,13 @@ extern void smt_partial_restart_var(smt_core_t *s);
 
 
 /*
- * Reduce the clause database by removing half the learned clauses
- * (the ones with lowest activities)
+ * Reduce the clause database:
+ * - learned clauses in the core tier are kept
+ * - learned clauses in the mid tier are kept if they were used since
+ *   the last reduction, otherwise they are moved to the local tier
+ * - the local clauses that were not used since the last reduction are
+ *   candidates for deletion: half of them (the ones with lowest
+ *   activities) are removed
  */
 extern void reduce_clause_database(smt_core_t *s);
 
@@ -247,24 +247,24 @@ void print_binary_clauses(FILE *f, smt_core_t *core) {
   }
 }
 
-static void print_clause_vector(FILE *f, clause_t **vector) {
+static void print_clause_vector(FILE *f, smt_core_t *core, cidx_t *vector) {
   uint32_t i, n;
 
   if (vector != NULL) {
     n = get_cv_size(vector);
     for (i=0; i<n; i++) {
-      print_clause(f, vector[i]);
+      print_clause(f, clause_of_idx(core, vector[i]));
       fputc('\n', f);
     }
   }
 }
 
 void print_problem_clauses(FILE *f, smt_core_t *core) {
-  print_clause_vector(f, core->problem_clauses);
+  print_clause_vector(f, core, core->problem_clauses);
 }
 
 void print_learned_clauses(FILE *f, smt_core_t *core) {
-  print_clause_vector(f, core->learned_clauses);
+  print_clause_vector(f, core, core->learned_clauses);
 }
 
 void print_clauses(FILE *f, smt_core_t *core) {
@@ -374,7 +374,7 @@ void print_conflict(FILE *f, smt_core_t *core) {
 /*
  * Size of a clause vector (deal with the case v == NULL)
  */
-static inline uint32_t cv_size(clause_t **v) {
+static inline uint32_t cv_size(cidx_t *v) {
   return v == NULL ? 0 : get_cv_size(v);
 }
 
@@ -6322,7 +6322,7 @@ fcheck_code_t _o_egraph_final_check(egraph_t *egraph) {
 }
 
 fcheck_code_t egraph_final_check(egraph_t *egraph) {
-  MT_PROTECT(fcheck_code_t, __yices_globals.lock, _o_egraph_final_check(egraph));
+  MT_PROTECT_WRITE(fcheck_code_t, __yices_globals.lock, _o_egraph_final_check(egraph));
 }
 
 
@@ -0,0 +1,341 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * FLOATING-POINT SIMPLEX
+ */
+
+#include "solvers/simplex/float_simplex.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialization
+ */
+void init_float_simplex(float_simplex_t *fs, uint32_t nrows, uint32_t ncols) {
+  uint32_t i;
+
+  assert((uint64_t) nrows * ncols <= FSIMPLEX_MAX_SIZE);
+
+  fs->nrows = nrows;
+  fs->ncols = ncols;
+  fs->a = (double *) safe_malloc((size_t) nrows * ncols * sizeof(double));
+  fs->basic = (int32_t *) safe_malloc(nrows * sizeof(int32_t));
+  fs->row_of = (int32_t *) safe_malloc(ncols * sizeof(int32_t));
+  fs->lb = (double *) safe_malloc(ncols * sizeof(double));
+  fs->ub = (double *) safe_malloc(ncols * sizeof(double));
+  fs->val = (double *) safe_malloc(ncols * sizeof(double));
+  fs->aux = (uint32_t *) safe_malloc(ncols * sizeof(uint32_t));
+  fs->pivots = 0;
+
+  for (i=0; i<nrows * ncols; i++) {
+    fs->a[i] = 0.0;
+  }
+  for (i=0; i<nrows; i++) {
+    fs->basic[i] = -1;
+  }
+  for (i=0; i<ncols; i++) {
+    fs->row_of[i] = -1;
+    fs->lb[i] = -HUGE_VAL;
+    fs->ub[i] = HUGE_VAL;
+    fs->val[i] = 0.0;
+  }
+}
+
+
+/*
+ * Free memory
+ */
+void delete_float_simplex(float_simplex_t *fs) {
+  safe_free(fs->a);
+  safe_free(fs->basic);
+  safe_free(fs->row_of);
+  safe_free(fs->lb);
+  safe_free(fs->ub);
+  safe_free(fs->val);
+  safe_free(fs->aux);
+  fs->a = NULL;
+  fs->basic = NULL;
+  fs->row_of = NULL;
+  fs->lb = NULL;
+  fs->ub = NULL;
+  fs->val = NULL;
+  fs->aux = NULL;
+}
+
+
+/*
+ * Basic variable of row r
+ */
+void float_simplex_set_basic_var(float_simplex_t *fs, uint32_t r, int32_t x) {
+  assert(r < fs->nrows && 0 <= x && x < fs->ncols && fs->row_of[x] < 0);
+
+  fs->basic[r] = x;
+  fs->row_of[x] = r;
+}
+
+
+/*
+ * Pointer to row r
+ */
+static inline double *fs_row(float_simplex_t *fs, uint32_t r) {
+  assert(r < fs->nrows);
+  return fs->a + (uint64_t) r * fs->ncols;
+}
+
+
+/*
+ * Compute the value of the basic variable in row r
+ */
+static void fs_set_basic_value(float_simplex_t *fs, uint32_t r) {
+  double *row;
+  double v;
+  uint32_t j, n;
+  int32_t x;
+
+  row = fs_row(fs, r);
+  x = fs->basic[r];
+  n = fs->ncols;
+  v = 0.0;
+  for (j=0; j<n; j++) {
+    if (row[j] != 0.0 && j != (uint32_t) x) {
+      v -= row[j] * fs->val[j];
+    }
+  }
+  fs->val[x] = v;
+}
+
+void float_simplex_init_basic_values(float_simplex_t *fs) {
+  uint32_t r;
+
+  for (r=0; r<fs->nrows; r++) {
+    fs_set_basic_value(fs, r);
+  }
+}
+
+
+/*
+ * Check whether x is below its lower bound or above its upper bound
+ */
+static inline bool fs_below_lower_bound(float_simplex_t *fs, int32_t x) {
+  return fs->val[x] < fs->lb[x] && !float_simplex_close(fs->val[x], fs->lb[x]);
+}
+
+static inline bool fs_above_upper_bound(float_simplex_t *fs, int32_t x) {
+  return fs->val[x] > fs->ub[x] && !float_simplex_close(fs->val[x], fs->ub[x]);
+}
+
+
+/*
+ * Violation: distance between x's value and its bounds
+ */
+static double fs_violation(float_simplex_t *fs, int32_t x) {
+  if (fs_below_lower_bound(fs, x)) {
+    return fs->lb[x] - fs->val[x];
+  }
+  if (fs_above_upper_bound(fs, x)) {
+    return fs->val[x] - fs->ub[x];
+  }
+  return 0.0;
+}
+
+
+/*
+ * Leaving variable
+ * - bland: if true, pick the smallest infeasible basic variable,
+ *   otherwise pick the basic variable with the largest violation.
+ * - return -1 if all basic variables are within their bounds
+ */
+static int32_t fs_leaving_var(float_simplex_t *fs, bool bland) {
+  double d, best_d;
+  uint32_t r;
+  int32_t x, best;
+
+  best = -1;
+  best_d = 0.0;
+  for (r=0; r<fs->nrows; r++) {
+    x = fs->basic[r];
+    d = fs_violation(fs, x);
+    if (d > 0.0) {
+      if (bland) {
+        if (best < 0 || x < best) best = x;
+      } else if (d > best_d) {
+        best_d = d;
+        best = x;
+      }
+    }
+  }
+  return best;
+}
+
+
+/*
+ * Check whether y can increase or decrease
+ */
+static inline bool fs_can_increase(float_simplex_t *fs, int32_t y) {
+  return ! float_simplex_at_upper_bound(fs, y) && fs->val[y] < fs->ub[y];
+}
+
+static inline bool fs_can_decrease(float_simplex_t *fs, int32_t y) {
+  return ! float_simplex_at_lower_bound(fs, y) && fs->val[y] > fs->lb[y];
+}
+
+
+/*
+ * Entering variable in the row of x
+ * - increase: true if x must increase, false if it must decrease
+ * - bland: if true use Bland's rule (smallest variable), otherwise
+ *   pick the variable with the largest coefficient.
+ * - return -1 if there's no entering variable
+ */
+static int32_t fs_entering_var(float_simplex_t *fs, int32_t x, bool increase, bool bland) {
+  double *row;
+  double c, best_c;
+  uint32_t j, n;
+  int32_t y, best;
+  bool ok;
+
+  row = fs_row(fs, fs->row_of[x]);
+  n = fs->ncols;
+  best = -1;
+  best_c = 0.0;
+
+  for (j=0; j<n; j++) {
+    y = j;
+    c = row[y];
+    if (fabs(c) >= FSIMPLEX_PIVOT_TOL && fs->row_of[y] < 0) {
+      // x = - c.y - ... so x increases if c>0 and y decreases
+      if (increase == (c > 0.0)) {
+        ok = fs_can_decrease(fs, y);
+      } else {
+        ok = fs_can_increase(fs, y);
+      }
+      if (ok) {
+        if (bland) return y;
+        if (fabs(c) > best_c) {
+          best_c = fabs(c);
+          best = y;
+        }
+      }
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Pivot: make y basic in the row of x and set x to value v
+ */
+static void fs_pivot(float_simplex_t *fs, int32_t x, int32_t y, double v) {
+  double *row, *row0;
+  double p, c, dy;
+  uint32_t r0, r, j, k, n;
+
+  r0 = fs->row_of[x];
+  row0 = fs_row(fs, r0);
+  p = row0[y];
+  assert(p != 0.0);
+
+  // update the assignment: x changes by (v - val[x]), y by dy
+  dy = (fs->val[x] - v)/p;
+  fs->val[y] += dy;
+  for (r=0; r<fs->nrows; r++) {
+    if (r != r0) {
+      c = fs_row(fs, r)[y];
+      if (c != 0.0) {
+        fs->val[fs->basic[r]] -= c * dy;
+      }
+    }
+  }
+  fs->val[x] = v;
+
+  // scale row0 and collect its non-zero coefficients
+  n = fs->ncols;
+  k = 0;
+  for (j=0; j<n; j++) {
+    if (row0[j] != 0.0) {
+      row0[j] /= p;
+      fs->aux[k] = j;
+      k ++;
+    }
+  }
+  row0[y] = 1.0;
+
+  // eliminate y from the other rows
+  for (r=0; r<fs->nrows; r++) {
+    if (r != r0) {
+      row = fs_row(fs, r);
+      c = row[y];
+      if (c != 0.0) {
+        for (j=0; j<k; j++) {
+          row[fs->aux[j]] -= c * row0[fs->aux[j]];
+          if (fabs(row[fs->aux[j]]) < FSIMPLEX_ZERO_TOL) {
+            row[fs->aux[j]] = 0.0;
+          }
+        }
+        row[y] = 0.0;
+      }
+    }
+  }
+
+  fs->basic[r0] = y;
+  fs->row_of[y] = r0;
+  fs->row_of[x] = -1;
+  fs->pivots ++;
+}
+
+
+/*
+ * Search for a feasible basis
+ * - for the first pivots, the leaving variable is the one with
+ *   the largest violation and the entering variable is the one with
+ *   the largest coefficient. After FSIMPLEX_BLAND_THRESHOLD * nrows pivots,
+ *   we switch to Bland's rule to avoid cycling.
+ * - the basic values are recomputed from scratch before we declare
+ *   the tableau feasible (to correct rounding errors)
+ */
+fsimplex_status_t float_simplex_solve(float_simplex_t *fs, uint32_t max_pivots) {
+  int32_t x, y;
+  uint32_t bthreshold;
+  bool increase, fresh, bland;
+
+  fs->pivots = 0;
+  fresh = false;
+  bthreshold = FSIMPLEX_BLAND_THRESHOLD * fs->nrows;
+
+  for (;;) {
+    bland = fs->pivots >= bthreshold;
+    x = fs_leaving_var(fs, bland);
+    if (x < 0) {
+      if (fresh) return FSIMPLEX_FEASIBLE;
+      float_simplex_init_basic_values(fs);
+      fresh = true;
+      continue;
+    }
+
+    if (fs->pivots >= max_pivots) return FSIMPLEX_UNKNOWN;
+
+    increase = fs_below_lower_bound(fs, x);
+    y = fs_entering_var(fs, x, increase, bland);
+    if (y < 0) return FSIMPLEX_INFEASIBLE;
+
+    fs_pivot(fs, x, y, increase ? fs->lb[x] : fs->ub[x]);
+    fresh = false;
+  }
+}
@@ -0,0 +1,193 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * FLOATING-POINT SIMPLEX
+ *
+ * This is an approximate version of the simplex check_feasibility
+ * procedure that works on a dense copy of the tableau, using doubles.
+ * It's used by the exact simplex solver to find a candidate basis
+ * quickly. The result is not trusted: the exact solver installs the
+ * basis found here (by exact pivoting), then runs its own feasibility
+ * check to repair it if needed.
+ *
+ * The tableau has the same form as in the exact solver:
+ * - nrows equations a_1 x_1 + ... + a_n x_n = 0,
+ * - each row has a basic variable, whose coefficient is 1 in that row
+ *   and 0 in all other rows.
+ * - ncols is the total number of variables.
+ *
+ * Each variable x has a lower bound lb[x] and an upper bound ub[x]
+ * (-HUGE_VAL/+HUGE_VAL if x has no lower/upper bound) and a current
+ * value val[x].
+ */
+
+#ifndef __FLOAT_SIMPLEX_H
+#define __FLOAT_SIMPLEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <math.h>
+
+
+/*
+ * Tableau:
+ * - a = dense matrix of nrows * ncols coefficients (stored by rows)
+ * - basic[r] = basic variable of row r
+ * - row_of[x] = row where x is basic or -1 if x is not basic
+ * - lb, ub, val: bounds and values for all the variables
+ * - aux = buffer to store the non-zero coefficients of the pivot row
+ * - pivots = number of pivoting steps done by the last call to solve
+ */
+typedef struct float_simplex_s {
+  uint32_t nrows;
+  uint32_t ncols;
+  double *a;
+  int32_t *basic;
+  int32_t *row_of;
+  double *lb;
+  double *ub;
+  double *val;
+  uint32_t *aux;
+  uint32_t pivots;
+} float_simplex_t;
+
+
+/*
+ * Result of solve:
+ * - FEASIBLE: all basic variables are within their bounds (up to the tolerance)
+ * - INFEASIBLE: a row with no possible entering variable was found
+ * - UNKNOWN: the pivot limit was reached
+ */
+typedef enum fsimplex_status {
+  FSIMPLEX_FEASIBLE,
+  FSIMPLEX_INFEASIBLE,
+  FSIMPLEX_UNKNOWN,
+} fsimplex_status_t;
+
+
+/*
+ * Maximal size of the dense tableau (number of coefficients)
+ */
+#define FSIMPLEX_MAX_SIZE (1u<<22)
+
+/*
+ * Tolerances:
+ * - a value v is within the bound b if it's no more than
+ *   FSIMPLEX_FEAS_TOL * (1 + |b|) away from b
+ * - coefficients of absolute value less than FSIMPLEX_ZERO_TOL are
+ *   treated as zero
+ * - the entering variable must have a coefficient of absolute value
+ *   at least FSIMPLEX_PIVOT_TOL in the pivot row
+ */
+#define FSIMPLEX_FEAS_TOL  1e-9
+#define FSIMPLEX_ZERO_TOL  1e-12
+#define FSIMPLEX_PIVOT_TOL 1e-9
+
+/*
+ * Switch to Bland's rule after FSIMPLEX_BLAND_THRESHOLD * nrows pivots
+ */
+#define FSIMPLEX_BLAND_THRESHOLD 4
+
+
+/*
+ * Initialize fs for a tableau of the given size
+ * - nrows * ncols must be no more than FSIMPLEX_MAX_SIZE
+ * - all coefficients are zero, all variables are non-basic
+ *   with no bounds and value 0.
+ */
+extern void init_float_simplex(float_simplex_t *fs, uint32_t nrows, uint32_t ncols);
+
+/*
+ * Delete: free memory
+ */
+extern void delete_float_simplex(float_simplex_t *fs);
+
+/*
+ * Make x the basic variable of row r
+ * - this just records the basic variable; the coefficient of x
+ *   must be set to 1 in row r (and 0 in all other rows)
+ */
+extern void float_simplex_set_basic_var(float_simplex_t *fs, uint32_t r, int32_t x);
+
+/*
+ * Compute the values of the basic variables from the non-basic ones
+ */
+extern void float_simplex_init_basic_values(float_simplex_t *fs);
+
+/*
+ * Search for a feasible basis
+ * - max_pivots = bound on the number of pivoting steps
+ */
+extern fsimplex_status_t float_simplex_solve(float_simplex_t *fs, uint32_t max_pivots);
+
+
+/*
+ * Set coefficient of x in row r
+ */
+static inline void float_simplex_set_coeff(float_simplex_t *fs, uint32_t r, int32_t x, double c) {
+  assert(r < fs->nrows && 0 <= x && x < fs->ncols);
+  fs->a[(uint64_t) r * fs->ncols + x] = c;
+}
+
+/*
+ * Set bounds and value of x
+ */
+static inline void float_simplex_set_lower_bound(float_simplex_t *fs, int32_t x, double b) {
+  assert(0 <= x && x < fs->ncols);
+  fs->lb[x] = b;
+}
+
+static inline void float_simplex_set_upper_bound(float_simplex_t *fs, int32_t x, double b) {
+  assert(0 <= x && x < fs->ncols);
+  fs->ub[x] = b;
+}
+
+static inline void float_simplex_set_value(float_simplex_t *fs, int32_t x, double v) {
+  assert(0 <= x && x < fs->ncols);
+  fs->val[x] = v;
+}
+
+/*
+ * Check whether x is basic
+ */
+static inline bool float_simplex_is_basic_var(float_simplex_t *fs, int32_t x) {
+  assert(0 <= x && x < fs->ncols);
+  return fs->row_of[x] >= 0;
+}
+
+/*
+ * Check whether the value of x is at its lower/upper bound (up to the tolerance)
+ */
+static inline bool float_simplex_close(double v, double b) {
+  return fabs(v - b) <= FSIMPLEX_FEAS_TOL * (1.0 + fabs(b));
+}
+
+static inline bool float_simplex_at_lower_bound(float_simplex_t *fs, int32_t x) {
+  assert(0 <= x && x < fs->ncols);
+  return fs->lb[x] > -HUGE_VAL && float_simplex_close(fs->val[x], fs->lb[x]);
+}
+
+static inline bool float_simplex_at_upper_bound(float_simplex_t *fs, int32_t x) {
+  assert(0 <= x && x < fs->ncols);
+  return fs->ub[x] < HUGE_VAL && float_simplex_close(fs->val[x], fs->ub[x]);
+}
+
+
+#endif /* __FLOAT_SIMPLEX_H */
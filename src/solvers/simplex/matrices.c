@@ -295,6 +295,92 @@ static void delete_row(row_t *v) {
 
 
 
+/*
+ * PACKED ROWS
+ */
+
+/*
+ * Initialize a packed row of default capacity
+ */
+static void init_packed_row(packed_row_t *p) {
+  uint32_t n;
+
+  n = DEF_PACKED_ROW_SIZE;
+  p->size = 0;
+  p->capacity = n;
+  p->integral = false;
+  p->var = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  p->coeff = (rational_t **) safe_malloc(n * sizeof(rational_t *));
+  p->icoeff = (int64_t *) safe_malloc(n * sizeof(int64_t));
+}
+
+
+/*
+ * Make p large enough to store n elements
+ */
+static void resize_packed_row(packed_row_t *p, uint32_t n) {
+  if (n > p->capacity) {
+    if (n >= MAX_PACKED_ROW_SIZE) {
+      out_of_memory();
+    }
+    p->capacity = n;
+    p->var = (int32_t *) safe_realloc(p->var, n * sizeof(int32_t));
+    p->coeff = (rational_t **) safe_realloc(p->coeff, n * sizeof(rational_t *));
+    p->icoeff = (int64_t *) safe_realloc(p->icoeff, n * sizeof(int64_t));
+  }
+}
+
+
+/*
+ * Delete p
+ */
+static void delete_packed_row(packed_row_t *p) {
+  safe_free(p->var);
+  safe_free(p->coeff);
+  safe_free(p->icoeff);
+  p->var = NULL;
+  p->coeff = NULL;
+  p->icoeff = NULL;
+}
+
+
+/*
+ * Store row r into p
+ * - p keeps pointers to the coefficients of r, so r must not
+ *   be modified as long as p is in use
+ */
+static void pack_row(packed_row_t *p, row_t *r) {
+  uint32_t i, j, n;
+  int32_t x;
+  bool integral;
+
+  resize_packed_row(p, r->nelems);
+
+  integral = true;
+  j = 0;
+  n = r->size;
+  for (i=0; i<n; i++) {
+    x = r->data[i].c_idx;
+    if (x >= 0) {
+      p->var[j] = x;
+      p->coeff[j] = &r->data[i].coeff;
+      if (integral && q_is_smallint(&r->data[i].coeff)) {
+        p->icoeff[j] = q_get_smallint(&r->data[i].coeff);
+      } else {
+        integral = false;
+      }
+      j ++;
+    }
+  }
+  assert(j == r->nelems);
+  p->size = j;
+  p->integral = integral;
+}
+
+
+
+
+
 /*
  * MATRIX
  */
@@ -325,6 +411,7 @@ void init_matrix(matrix_t *matrix, uint32_t n, uint32_t m) {
   matrix->index = (int32_t *) safe_malloc(m * sizeof(int32_t));
 
   q_init(&matrix->factor);
+  init_packed_row(&matrix->pivot_row);
 
   // marks: one bit per row
   matrix->marks = allocate_bitvector(n);
@@ -359,6 +446,7 @@ void delete_matrix(matrix_t *matrix) {
   delete_bitvector(matrix->marks);
 
   q_clear(&matrix->factor);
+  delete_packed_row(&matrix->pivot_row);
 
   matrix->row = NULL;
   matrix->column = NULL;
@@ -1832,6 +1920,142 @@ void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
 
 
 
+/*
+ * Variant of matrix_submul_row where row0 is given as a packed row
+ * - r and k are as in matrix_submul_row
+ * - p = packed copy of a row where x has coefficient 1 (distinct from row r)
+ *
+ * If p is integral and the coefficient of x in row r is a small integer,
+ * then all products fit in 64 bits: we skip the generic rational operations
+ * when the target coefficient is also a small integer.
+ */
+static void matrix_submul_packed_row(matrix_t *matrix, uint32_t r, uint32_t k, packed_row_t *p) {
+  row_t *row;
+  row_elem_t *e;
+  rational_t *a, *c;
+  int32_t *index;
+  uint32_t i, n;
+  int32_t j, x;
+  int64_t ai;
+
+  assert(r < matrix->nrows);
+  row = matrix->row[r];
+
+  // for every variable x, index[x] = element where x occurs in row r or -1
+  index = matrix->index;
+  n = row->size;
+  e = row->data;
+  for (i=0; i<n; i++) {
+    x = e[i].c_idx;
+    if (x >= 0) index[x] = i;
+  }
+
+  // coefficient: a = row[k].coeff
+  a = &matrix->factor;
+  q_set(a, &row->data[k].coeff);
+
+  n = p->size;
+  if (p->integral && q_is_smallint(a)) {
+    /*
+     * small integers: all absolute values are less than 2^30
+     */
+    ai = q_get_smallint(a);
+    for (i=0; i<n; i++) {
+      x = p->var[i];
+      j = index[x];
+      if (j < 0) {
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set64(&row->data[j].coeff, - ai * p->icoeff[i]);
+      } else {
+        c = &row->data[j].coeff;
+        if (q_is_smallint(c)) {
+          q_set64(c, q_get_smallint(c) - ai * p->icoeff[i]);
+        } else {
+          q_submul(c, a, p->coeff[i]);
+        }
+      }
+    }
+
+  } else if (q_is_one(a)) {
+    // subtract row0 from row
+    for (i=0; i<n; i++) {
+      x = p->var[i];
+      j = index[x];
+      if (j < 0) {
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set_neg(&row->data[j].coeff, p->coeff[i]);
+      } else {
+        q_sub(&row->data[j].coeff, p->coeff[i]);
+      }
+    }
+
+  } else if (q_is_minus_one(a)) {
+    // add row0 to row
+    for (i=0; i<n; i++) {
+      x = p->var[i];
+      j = index[x];
+      if (j < 0) {
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set(&row->data[j].coeff, p->coeff[i]);
+      } else {
+        q_add(&row->data[j].coeff, p->coeff[i]);
+      }
+    }
+
+  } else {
+    // general case: subtract a * row0 from row
+    for (i=0; i<n; i++) {
+      x = p->var[i];
+      j = index[x];
+      if (j < 0) {
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set_neg(&row->data[j].coeff, a);
+        q_mul(&row->data[j].coeff, p->coeff[i]);
+      } else {
+        q_submul(&row->data[j].coeff, a, p->coeff[i]);
+      }
+    }
+  }
+
+  assert(q_is_zero(&row->data[k].coeff));
+
+  /*
+   * row must be copied back since alloc_row_elem may change it
+   */
+  matrix->row[r] = row;
+
+  /*
+   * Cleanup: reset the indices to -1
+   * and remove the zero elements
+   */
+  index = matrix->index;
+  n = row->size;
+  e = row->data;
+  for (i=0; i<n; i++) {
+    x = e[i].c_idx;
+    if (x >= 0) {
+      index[x] = -1;
+      if (q_is_zero(&e[i].coeff)) {
+        remove_row_elem(matrix, r, i);
+      }
+    }
+  }
+
+  if (row->nelems * 2 < row->size) {
+    matrix_compact_row(matrix, r);
+  }
+}
+
+
+
 /*
  * Pivoting step: make x basic in r0
  * - k identifies the variable: k must be the index of the element where
@@ -1854,13 +2078,15 @@ void matrix_pivot(matrix_t *matrix, uint32_t r0, uint32_t k) {
   matrix_scale_row(row0, k);
 
   // eliminate x from the other rows
+  // (row0 is not modified in this loop so we pack it once)
+  pack_row(&matrix->pivot_row, row0);
   col = matrix->column[x];
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_submul_packed_row(matrix, r, j, &matrix->pivot_row);
       assert(matrix->column[x] == col); // column[x] should not change
     }
   }
@@ -2046,13 +2272,15 @@ static void matrix_pivot_and_update(matrix_t *matrix, markowitz_t *d, uint32_t r
   matrix_scale_row(row0, k);
 
   // eliminate x from the other rows
+  // (row0 is not modified in this loop so we pack it once)
+  pack_row(&matrix->pivot_row, row0);
   col = matrix->column[x];
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_submul_packed_row(matrix, r, j, &matrix->pivot_row);
       assert(matrix->column[x] == col); // column[x] should not change
 
       // update the heap for row r
@@ -126,6 +126,30 @@ typedef struct column_s {
 
 
 
+/*
+ * Packed row: copy of a row in structure-of-arrays form
+ * - this is used during pivoting: the pivot row is packed once
+ *   then subtracted from all the rows that contain the entering variable.
+ * - var[i] = variable of the i-th element (there are no dead elements)
+ * - coeff[i] = pointer to its coefficient in the original row
+ * - if all coefficients are small integers, then integral is true
+ *   and icoeff[i] = coefficient of var[i] as an int64
+ * - size = number of elements
+ * - capacity = size of arrays var, coeff, icoeff
+ */
+typedef struct packed_row_s {
+  uint32_t size;
+  uint32_t capacity;
+  bool integral;
+  int32_t *var;
+  rational_t **coeff;
+  int64_t *icoeff;
+} packed_row_t;
+
+#define DEF_PACKED_ROW_SIZE 50
+#define MAX_PACKED_ROW_SIZE (UINT32_MAX/sizeof(int64_t))
+
+
 /*
  * Matrix
  * - two arrays: one for rows, one for columns
@@ -144,6 +168,8 @@ typedef struct column_s {
  * - one bit per row: 1 means the row is marked, 0 means it's not marked.
  * - this is used by external code to construct sets of rows (e.g., for propagation)
  *
+ * Pivot row: packed copy of the pivot row (used by matrix_pivot)
+ *
  * Constant array: built on demand
  * - constant: for each row i, constant[i] = index of the
  *   constant in row i. If constant[i] = k >= 0, then row[i][k] is
@@ -163,6 +189,7 @@ typedef struct matrix_s {
   // auxiliary data structures
   int32_t *index;
   rational_t factor;    // pivot coefficient
+  packed_row_t pivot_row;
 
   // marks
   byte_t *marks;
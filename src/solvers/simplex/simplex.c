@@ -26,6 +26,7 @@
 
 #include "io/tracer.h"
 #include "solvers/egraph/theory_explanations.h"
+#include "solvers/simplex/float_simplex.h"
 #include "solvers/simplex/integrality_constraints.h"
 #include "solvers/simplex/simplex.h"
 #include "terms/rational_hash_maps.h"
@@ -625,6 +626,9 @@ static void init_simplex_statistics(simplex_stats_t *stat) {
   stat->num_make_feasible = 0;
   stat->num_pivots = 0;
   stat->num_blands = 0;
+  stat->num_float_presolve = 0;
+  stat->num_float_pivots = 0;
+  stat->num_float_install = 0;
   stat->num_conflicts = 0;
 
   stat->num_make_intfeasible = 0;
@@ -1640,6 +1644,7 @@ void init_simplex_solver(simplex_solver_t *solver, smt_core_t *core, gate_manage
   init_ivector(&solver->aux_vector, 10);
   init_ivector(&solver->aux_vector2, 10);
   init_ivector(&solver->rows_to_process, DEF_PROCESS_ROW_VECTOR_SIZE);
+  init_ivector(&solver->opt_vars, 0);
 
   init_arena(&solver->arena);
 
@@ -3324,6 +3329,12 @@ static void simplex_simplify_matrix(simplex_solver_t *solver) {
 	set_bit(keep, i);
       }
     }
+    // objective variables (skip those removed by pop)
+    for (i=0; i<solver->opt_vars.size; i++) {
+      if ((uint32_t) solver->opt_vars.data[i] < n) {
+        set_bit(keep, solver->opt_vars.data[i]);
+      }
+    }
   }
 
   /*
@@ -4718,6 +4729,197 @@ static void simplex_expand_th_explanation(simplex_solver_t *solver, thvar_t x1,
 }
 
 
+/*****************************
+ *  FLOATING-POINT PRESOLVE  *
+ ****************************/
+
+/*
+ * Approximate value of an extended rational q = main + delta.epsilon
+ * - epsilon is replaced by a small positive constant so that strict
+ *   bounds are slightly tighter than non-strict bounds
+ */
+#define FLOAT_EPSILON 1e-7
+
+static double xq_approx_value(xrational_t *q) {
+  double d;
+
+  d = q_get_double(&q->main);
+  if (q_is_nonzero(&q->delta)) {
+    d += FLOAT_EPSILON * q_get_double(&q->delta);
+  }
+  return d;
+}
+
+
+/*
+ * Copy the tableau, bounds, and assignment into fs
+ * - fs must be initialized with nrows = matrix->nrows and ncols = vtbl->nvars
+ */
+static void simplex_copy_to_float_simplex(simplex_solver_t *solver, float_simplex_t *fs) {
+  matrix_t *matrix;
+  arith_vartable_t *vtbl;
+  row_t *row;
+  uint32_t i, n, r, nrows;
+  int32_t k;
+  thvar_t x;
+
+  matrix = &solver->matrix;
+  vtbl = &solver->vtbl;
+
+  nrows = matrix->nrows;
+  for (r=0; r<nrows; r++) {
+    row = matrix_row(matrix, r);
+    n = row->size;
+    for (i=0; i<n; i++) {
+      x = row->data[i].c_idx;
+      if (x >= 0) {
+        float_simplex_set_coeff(fs, r, x, q_get_double(&row->data[i].coeff));
+      }
+    }
+    float_simplex_set_basic_var(fs, r, matrix_basic_var(matrix, r));
+  }
+
+  n = vtbl->nvars;
+  for (x=0; x<n; x++) {
+    k = arith_var_lower_index(vtbl, x);
+    if (k >= 0) {
+      float_simplex_set_lower_bound(fs, x, xq_approx_value(solver->bstack.bound + k));
+    }
+    k = arith_var_upper_index(vtbl, x);
+    if (k >= 0) {
+      float_simplex_set_upper_bound(fs, x, xq_approx_value(solver->bstack.bound + k));
+    }
+    float_simplex_set_value(fs, x, xq_approx_value(arith_var_value(vtbl, x)));
+  }
+
+  // the constant is fixed
+  float_simplex_set_lower_bound(fs, const_idx, 1.0);
+  float_simplex_set_upper_bound(fs, const_idx, 1.0);
+  float_simplex_set_value(fs, const_idx, 1.0);
+}
+
+
+/*
+ * Make x basic in the exact tableau, if x is basic in fs but not in the matrix
+ * - we search for a row r where x occurs, and whose basic variable
+ *   is not basic in fs, then pivot.
+ * - if there's no such row, x remains non-basic
+ */
+static void simplex_install_float_basic_var(simplex_solver_t *solver, float_simplex_t *fs, thvar_t x) {
+  matrix_t *matrix;
+  column_t *col;
+  uint32_t i, n;
+  int32_t r;
+
+  matrix = &solver->matrix;
+  col = matrix->column[x];
+  if (col != NULL) {
+    n = col->size;
+    for (i=0; i<n; i++) {
+      r = col->data[i].r_idx;
+      if (r >= 0 && !float_simplex_is_basic_var(fs, matrix_basic_var(matrix, r))) {
+        matrix_pivot(matrix, r, col->data[i].r_ptr);
+        solver->stats.num_float_install ++;
+        return;
+      }
+    }
+  }
+}
+
+
+/*
+ * Move the non-basic variables to the bounds selected by fs,
+ * or to their closest bound if their value is out of bounds.
+ * Then rebuild the heap of infeasible variables.
+ */
+static void simplex_fix_assignment_after_presolve(simplex_solver_t *solver, float_simplex_t *fs) {
+  matrix_t *matrix;
+  uint32_t i, n;
+  thvar_t x;
+
+  matrix = &solver->matrix;
+
+  n = solver->vtbl.nvars;
+  for (x=1; x<n; x++) {
+    if (matrix_is_nonbasic_var(matrix, x)) {
+      if (float_simplex_at_lower_bound(fs, x) && !variable_at_lower_bound(solver, x)) {
+        update_to_lower_bound(solver, x);
+      } else if (float_simplex_at_upper_bound(fs, x) && !variable_at_upper_bound(solver, x)) {
+        update_to_upper_bound(solver, x);
+      } else if (! value_satisfies_lower_bound(solver, x)) {
+        update_to_lower_bound(solver, x);
+      } else if (! value_satisfies_upper_bound(solver, x)) {
+        update_to_upper_bound(solver, x);
+      } else {
+        simplex_set_bound_flags(solver, x);
+      }
+    }
+  }
+
+  reset_int_heap(&solver->infeasible_vars);
+  n = matrix->nrows;
+  for (i=0; i<n; i++) {
+    x = matrix_basic_var(matrix, i);
+    if (! value_satisfies_bounds(solver, x)) {
+      int_heap_add(&solver->infeasible_vars, x);
+    }
+  }
+}
+
+
+/*
+ * Search for a candidate basis using the floating-point simplex:
+ * - this is done if option FLOAT_PRESOLVE is enabled, we're at the
+ *   base level, there are many infeasible variables, and the tableau
+ *   is small enough to be copied into a dense matrix. (At higher decision
+ *   levels, few bounds change between two checks and the exact simplex
+ *   is cheap from the current basis.)
+ * - if the floating-point simplex terminates (with a feasible
+ *   or infeasible basis), we install the basis it found in the exact
+ *   tableau. Then simplex_check_feasibility repairs it if needed and
+ *   builds the conflict explanations.
+ *
+ * Preconditions and postconditions: same invariants as simplex_check_feasibility.
+ */
+static void simplex_float_presolve(simplex_solver_t *solver) {
+  float_simplex_t fs;
+  matrix_t *matrix;
+  fsimplex_status_t status;
+  uint32_t n, nrows;
+  thvar_t x;
+
+  matrix = &solver->matrix;
+  nrows = matrix->nrows;
+  n = solver->vtbl.nvars;
+
+  if (solver->decision_level > solver->base_level ||
+      int_heap_nelems(&solver->infeasible_vars) < SIMPLEX_FLOAT_PRESOLVE_THRESHOLD ||
+      (uint64_t) nrows * n > FSIMPLEX_MAX_SIZE) {
+    return;
+  }
+
+  solver->stats.num_float_presolve ++;
+
+  init_float_simplex(&fs, nrows, n);
+  simplex_copy_to_float_simplex(solver, &fs);
+  status = float_simplex_solve(&fs, 10 * (nrows + n));
+  solver->stats.num_float_pivots += fs.pivots;
+
+  trace_printf(solver->core->trace, 15, "(float presolve: %"PRIu32" pivots, status = %d)\n", fs.pivots, (int) status);
+
+  if (status != FSIMPLEX_UNKNOWN) {
+    for (x=1; x<n; x++) {
+      if (float_simplex_is_basic_var(&fs, x) && matrix_is_nonbasic_var(matrix, x)) {
+        simplex_install_float_basic_var(solver, &fs, x);
+      }
+    }
+    simplex_fix_assignment_after_presolve(solver, &fs);
+  }
+
+  delete_float_simplex(&fs);
+}
+
+
 
 
 /*********************************
@@ -4744,6 +4946,9 @@ static bool simplex_make_feasible(simplex_solver_t *solver) {
 #endif
 
   solver->stats.num_make_feasible ++;
+  if (simplex_option_enabled(solver, SIMPLEX_FLOAT_PRESOLVE)) {
+    simplex_float_presolve(solver);
+  }
   feasible = simplex_check_feasibility(solver);
   if (!feasible) {
     simplex_report_conflict(solver);
@@ -6433,8 +6638,9 @@ static bool non_integer_vars_are_basic(simplex_solver_t *solver) {
  * Prepare for integer solving:
  * - make sure all non-basic integer variables have an integer value
  * - so all the integer-infeasible variables are in the basis
+ * - return false if the search was interrupted (via simplex_stop_search)
  */
-static void prepare_for_integer_solving(simplex_solver_t *solver) {
+static bool prepare_for_integer_solving(simplex_solver_t *solver) {
   // move non-integer variables to the basis
   if (simplex_is_mixed_system(solver)) {
     make_integer_vars_nonbasic(solver);
@@ -6452,6 +6658,7 @@ static void prepare_for_integer_solving(simplex_solver_t *solver) {
 
   // assign an integer value to all non-basic variables
   if (! assign_integers_to_nonbasic_vars(solver)) {
+    if (solver->interrupted) return false;
     abort();
   }
 
@@ -6471,6 +6678,8 @@ static void prepare_for_integer_solving(simplex_solver_t *solver) {
   check_assignment(solver);
   check_vartags(solver);
 #endif
+
+  return true;
 }
 
 
@@ -8949,7 +9158,9 @@ static bool intfeas_wrapper(simplex_solver_t *solver, const char *name, bool (*f
       }
 
       // Since pivoting may have occurred we need to prepare for the next step
-      prepare_for_integer_solving(solver);
+      if (! prepare_for_integer_solving(solver)) {
+        return false;
+      }
     } else {
       /*
        * There may be strengthened bounds but everything is still feasible
@@ -9038,7 +9249,9 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   fflush(stdout);
 #endif
 
-  prepare_for_integer_solving(solver);
+  if (! prepare_for_integer_solving(solver)) {
+    return false;
+  }
 
   /*
    * Try bound strengthening + integrality test + diophantine check
@@ -10663,6 +10876,7 @@ void simplex_reset(simplex_solver_t *solver) {
   ivector_reset(&solver->aux_vector);
   ivector_reset(&solver->aux_vector2);
   ivector_reset(&solver->rows_to_process);
+  ivector_reset(&solver->opt_vars);
 
   // empty arena
   arena_reset(&solver->arena);
@@ -10901,6 +11115,7 @@ void delete_simplex_solver(simplex_solver_t *solver) {
   delete_ivector(&solver->aux_vector);
   delete_ivector(&solver->aux_vector2);
   delete_ivector(&solver->rows_to_process);
+  delete_ivector(&solver->opt_vars);
 
   delete_arena(&solver->arena);
 }
@@ -12674,6 +12889,321 @@ bool simplex_var_is_integer(simplex_solver_t *solver, int32_t x) {
 
 
 
+/******************
+ *  OPTIMIZATION  *
+ *****************/
+
+/*
+ * Mark x as an objective variable
+ * - x must not be eliminated when the matrix is simplified
+ *   (otherwise simplex_minimize_var can't optimize it).
+ * - this must be called before the next call to start_search
+ */
+void simplex_keep_var(simplex_solver_t *solver, thvar_t x) {
+  assert(0 < x && x < solver->vtbl.nvars);
+  ivector_push(&solver->opt_vars, x);
+}
+
+
+/*
+ * Check whether x was eliminated by simplex_simplify_matrix
+ */
+static bool simplex_eliminated_var(simplex_solver_t *solver, thvar_t x) {
+  uint32_t i, n;
+
+  n = solver->elim.nrows;
+  for (i=0; i<n; i++) {
+    if (elim_matrix_base_var(&solver->elim, i) == x) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/*
+ * Ratio test: non-basic variable y is to be increased (if inc is true)
+ * or decreased (if inc is false).
+ * - compute the largest step theta such that y and all the basic
+ *   variables that depend on y stay within their bounds
+ * - return -2 if there's no limit (the step is unbounded)
+ * - return -1 if the limit is y's own bound
+ * - otherwise, return the row r of the leaving variable, store the
+ *   index of y in row r in *ptr, and set *at_lb to true if the leaving
+ *   variable reaches its lower bound (false if it reaches its upper bound).
+ * - ties are broken by picking the leaving variable of smallest index
+ *   (Bland's rule).
+ */
+static int32_t simplex_ratio_test(simplex_solver_t *solver, thvar_t y, bool inc, xrational_t *theta,
+                                  int32_t *ptr, bool *at_lb) {
+  arith_vartable_t *vtbl;
+  matrix_t *matrix;
+  column_t *col;
+  xrational_t *aux;
+  rational_t *a;
+  uint32_t i, n;
+  int32_t best, r, k;
+  thvar_t z, best_var;
+  bool down;
+
+  vtbl = &solver->vtbl;
+  matrix = &solver->matrix;
+  aux = &solver->xq0;
+
+  best = -2;
+  best_var = null_thvar;
+
+  // y's own bound
+  k = inc ? arith_var_upper_index(vtbl, y) : arith_var_lower_index(vtbl, y);
+  if (k >= 0) {
+    xq_set(theta, solver->bstack.bound + k);
+    xq_sub(theta, arith_var_value(vtbl, y));
+    if (! inc) xq_neg(theta);
+    best = -1;
+  }
+
+  col = matrix->column[y];
+  if (col != NULL) {
+    n = col->size;
+    for (i=0; i<n; i++) {
+      r = col->data[i].r_idx;
+      if (r < 0) continue;
+
+      /*
+       * z = basic variable in row r, a = coefficient of y in row r
+       * z changes by -a * (change of y) so z decreases if a and
+       * the change of y have the same sign
+       */
+      z = matrix_basic_var(matrix, r);
+      a = matrix_coeff(matrix, r, col->data[i].r_ptr);
+      down = (q_is_pos(a) == inc);
+      k = down ? arith_var_lower_index(vtbl, z) : arith_var_upper_index(vtbl, z);
+      if (k < 0) continue;
+
+      // aux := |value[z] - bound| / |a|
+      xq_set(aux, arith_var_value(vtbl, z));
+      xq_sub(aux, solver->bstack.bound + k);
+      xq_div(aux, a);
+      if (xq_sgn(aux) < 0) xq_neg(aux);
+
+      if (best == -2 || xq_lt(aux, theta) || (best >= 0 && xq_eq(aux, theta) && z < best_var)) {
+        xq_set(theta, aux);
+        best = r;
+        best_var = z;
+        *ptr = col->data[i].r_ptr;
+        *at_lb = down;
+      }
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Move x to its minimum (if minimize is true) or to its maximum
+ * (if minimize is false) in the polytope defined by the current bounds.
+ * - x must be a variable of the tableau
+ * - the current assignment must be feasible
+ * - this is a primal simplex with Bland's rule: the entering variables
+ *   are selected as in make_feasible, and the leaving variable by a
+ *   ratio test so that the assignment stays feasible
+ * - the optimal value is left in the assignment
+ */
+static simplex_opt_code_t simplex_optimize_in_tableau(simplex_solver_t *solver, thvar_t x, bool minimize) {
+  matrix_t *matrix;
+  row_t *row;
+  xrational_t theta;
+  simplex_opt_code_t result;
+  int32_t r, k, ptr;
+  thvar_t y, z;
+  bool inc, at_lb, save_bland;
+
+  matrix = &solver->matrix;
+
+  save_bland = solver->use_blands_rule;
+  solver->use_blands_rule = true;
+  xq_init(&theta);
+  ptr = -1;     // stop GCC warning
+  at_lb = false;
+
+  for (;;) {
+    if (solver->interrupted) {
+      result = SIMPLEX_OPT_UNAVAILABLE;
+      break;
+    }
+
+    if (matrix_is_nonbasic_var(matrix, x)) {
+      // x can move on its own unless it's already at its bound
+      if (minimize ? variable_at_lower_bound(solver, x) : variable_at_upper_bound(solver, x)) {
+        result = SIMPLEX_OPT_FOUND;
+        break;
+      }
+      y = x;
+      inc = ! minimize;
+    } else {
+      r = matrix_basic_row(matrix, x);
+      row = matrix_row(matrix, r);
+      if (minimize) {
+        k = find_entering_var_for_decrease(solver, row, x);
+      } else {
+        k = find_entering_var_for_increase(solver, row, x);
+      }
+      if (k < 0) {
+        // x can't move: optimum found
+        result = SIMPLEX_OPT_FOUND;
+        break;
+      }
+      // x = - sum of a.y for the other variables in the row
+      y = row->data[k].c_idx;
+      inc = (q_is_pos(&row->data[k].coeff) == minimize);
+    }
+
+    r = simplex_ratio_test(solver, y, inc, &theta, &ptr, &at_lb);
+    if (r == -2) {
+      result = SIMPLEX_OPT_UNBOUNDED;
+      break;
+    }
+
+    if (r == -1) {
+      // y reaches its bound
+      if (inc) {
+        update_to_upper_bound(solver, y);
+      } else {
+        update_to_lower_bound(solver, y);
+      }
+    } else {
+      // z leaves the basis and reaches its bound
+      z = matrix_basic_var(matrix, r);
+      matrix_pivot(matrix, r, ptr);
+      if (at_lb) {
+        update_to_lower_bound(solver, z);
+      } else {
+        update_to_upper_bound(solver, z);
+      }
+      solver->stats.num_pivots ++;
+    }
+
+    assert(int_heap_is_empty(&solver->infeasible_vars));
+  }
+
+  xq_clear(&theta);
+  solver->use_blands_rule = save_bland;
+
+  return result;
+}
+
+
+/*
+ * Optimize x then restore the assignment
+ * - the optimal value is returned in *v (if the result is FOUND)
+ * - if x is a trivial variable (x = a.y + b) we optimize y instead
+ */
+static simplex_opt_code_t simplex_optimize_var(simplex_solver_t *solver, thvar_t x, bool minimize, xrational_t *v) {
+  arith_vartable_t *vtbl;
+  polynomial_t *p;
+  xrational_t *saved;
+  simplex_opt_code_t result;
+  rational_t *a;
+  uint32_t i, n;
+  thvar_t y;
+
+  vtbl = &solver->vtbl;
+
+  if (x == const_idx) {
+    xq_set_one(v);
+    return SIMPLEX_OPT_FOUND;
+  }
+
+  if ((arith_var_kind(vtbl, x) == AVAR_FREE || arith_var_kind(vtbl, x) == AVAR_POLY) &&
+      trivial_variable(vtbl, x)) {
+    // x := b or x := a.y or x := b + a.y
+    p = arith_var_poly_def(vtbl, x);
+    assert(p->nterms <= 2);
+    if (p->nterms == 0) {
+      xq_clear(v); // v := 0
+      return SIMPLEX_OPT_FOUND;
+    }
+    if (p->nterms == 1 && p->mono[0].var == const_idx) {
+      xq_set_q(v, &p->mono[0].coeff);
+      return SIMPLEX_OPT_FOUND;
+    }
+    i = p->nterms - 1;
+    y = p->mono[i].var;
+    a = &p->mono[i].coeff;
+    result = simplex_optimize_var(solver, y, (q_is_pos(a) == minimize), v);
+    if (result == SIMPLEX_OPT_FOUND) {
+      xq_mul(v, a);
+      if (i > 0) {
+        assert(p->mono[0].var == const_idx);
+        xq_add_q(v, &p->mono[0].coeff);
+      }
+    }
+    return result;
+  }
+
+  if (! solver->tableau_ready || simplex_eliminated_var(solver, x)) {
+    return SIMPLEX_OPT_UNAVAILABLE;
+  }
+
+  assert(int_heap_is_empty(&solver->infeasible_vars));
+
+  // save the assignment
+  n = vtbl->nvars;
+  saved = (xrational_t *) safe_malloc(n * sizeof(xrational_t));
+  for (i=0; i<n; i++) {
+    xq_init(saved + i);
+    xq_set(saved + i, arith_var_value(vtbl, i));
+  }
+
+  result = simplex_optimize_in_tableau(solver, x, minimize);
+  if (result == SIMPLEX_OPT_FOUND) {
+    xq_set(v, arith_var_value(vtbl, x));
+  }
+
+  /*
+   * Restore the assignment: the basis may have changed but the
+   * old values still satisfy all the rows. The tags of the non-basic
+   * variables must be recomputed.
+   */
+  for (i=0; i<n; i++) {
+    xq_set(arith_var_value(vtbl, i), saved + i);
+    xq_clear(saved + i);
+    if (matrix_is_nonbasic_var(&solver->matrix, i)) {
+      if (variable_at_lower_bound(solver, i)) {
+        set_arith_var_lb(vtbl, i);
+      } else {
+        clear_arith_var_lb(vtbl, i);
+      }
+      if (variable_at_upper_bound(solver, i)) {
+        set_arith_var_ub(vtbl, i);
+      } else {
+        clear_arith_var_ub(vtbl, i);
+      }
+    }
+  }
+  safe_free(saved);
+  reset_int_heap(&solver->infeasible_vars);
+
+  return result;
+}
+
+
+/*
+ * Minimum of x in the current polytope
+ * - the polytope is defined by all the bounds asserted so far
+ *   (including the bounds at the current decision level)
+ * - this must be called after a satisfiable check, when the
+ *   assignment is feasible
+ * - the assignment is left unchanged
+ */
+simplex_opt_code_t simplex_minimize_var(simplex_solver_t *solver, thvar_t x, xrational_t *v) {
+  assert(0 <= x && x < solver->vtbl.nvars);
+  return simplex_optimize_var(solver, x, true, v);
+}
+
+
+
 /****************
  *  STATISTICS  *
  ***************/
@@ -183,6 +183,14 @@ static inline void simplex_disable_adjust_model(simplex_solver_t *solver) {
   simplex_disable_options(solver, SIMPLEX_ADJUST_MODEL);
 }
 
+static inline void simplex_enable_float_presolve(simplex_solver_t *solver) {
+  simplex_enable_options(solver, SIMPLEX_FLOAT_PRESOLVE);
+}
+
+static inline void simplex_disable_float_presolve(simplex_solver_t *solver) {
+  simplex_disable_options(solver, SIMPLEX_FLOAT_PRESOLVE);
+}
+
 
 /*
  * Enable/disable the equality propagator
@@ -400,6 +408,32 @@ extern void simplex_free_model(simplex_solver_t *solver);
 
 
 
+/*******************
+ *  OPTIMIZATION   *
+ ******************/
+
+/*
+ * Mark x as an objective variable: this prevents x from being
+ * eliminated when the matrix is simplified.
+ * - must be called before start_search
+ */
+extern void simplex_keep_var(simplex_solver_t *solver, thvar_t x);
+
+/*
+ * Compute the minimum of x in the polytope defined by the current bounds
+ * - this must be called when the current assignment is feasible
+ *   (i.e., after a satisfiable check)
+ * - the minimum is stored in *v if the result is SIMPLEX_OPT_FOUND
+ *   (v must be initialized)
+ * - the assignment is not modified
+ *
+ * The current bounds include those asserted at the current decision
+ * level, so the minimum is local to the current branch of the search.
+ */
+extern simplex_opt_code_t simplex_minimize_var(simplex_solver_t *solver, thvar_t x, xrational_t *v);
+
+
+
 /*********************
  *  GET STATISTICS   *
  ********************/
@@ -456,6 +490,14 @@ static inline uint32_t simplex_num_make_feasible(simplex_solver_t *solver) {
   return solver->stats.num_make_feasible;
 }
 
+static inline uint32_t simplex_num_float_presolve(simplex_solver_t *solver) {
+  return solver->stats.num_float_presolve;
+}
+
+static inline uint32_t simplex_num_float_pivots(simplex_solver_t *solver) {
+  return solver->stats.num_float_pivots;
+}
+
 static inline uint32_t simplex_num_conflicts(simplex_solver_t *solver) {
   return solver->stats.num_conflicts;
 }
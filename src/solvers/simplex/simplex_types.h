@@ -637,6 +637,9 @@ typedef struct simplex_stats_s {
   uint32_t num_make_feasible;  // calls to make_feasible
   uint32_t num_pivots;         // pivoting steps
   uint32_t num_blands;         // number of activations of bland's rule
+  uint32_t num_float_presolve; // calls to the floating-point simplex
+  uint32_t num_float_pivots;   // pivoting steps in the floating-point simplex
+  uint32_t num_float_install;  // exact pivots to install the floating-point basis
   uint32_t num_conflicts;
 
   // stats on integer arithmetic solver
@@ -820,6 +823,12 @@ typedef struct simplex_solver_s {
   elim_matrix_t elim;
   fvar_vector_t fvars;
 
+  /*
+   * Objective variables: they must not be eliminated by
+   * simplex_simplify_matrix (cf. simplex_keep_var)
+   */
+  ivector_t opt_vars;
+
   /*
    * Auxiliary buffers and data structures
    */
@@ -888,6 +897,9 @@ typedef struct simplex_solver_s {
  * - ADJUST_MODEL: attempt to modify the variable assignment to
  *   make the simplex model consistent with the egraph (as much as possible).
  * - EQPROP: enable propagation of equalities to the egraph
+ * - FLOAT_PRESOLVE: before an exact feasibility check with many
+ *   infeasible variables, search for a candidate basis using a
+ *   floating-point simplex (see float_simplex.h)
  *
  * Bland's rule threshold: based on the count of repeat
  * leaving variable. The counter is incremented whenever
@@ -902,6 +914,7 @@ typedef struct simplex_solver_s {
 #define SIMPLEX_ICHECK              0x4
 #define SIMPLEX_ADJUST_MODEL        0x8
 #define SIMPLEX_EQPROP              0x10
+#define SIMPLEX_FLOAT_PRESOLVE      0x20
 
 #define SIMPLEX_DISABLE_ALL_OPTIONS 0x0
 
@@ -909,8 +922,29 @@ typedef struct simplex_solver_s {
 #define SIMPLEX_DEFAULT_PROP_ROW_SIZE        30
 #define SIMPLEX_DEFAULT_CHECK_PERIOD   99999999
 
+/*
+ * Float presolve is tried only if the number of infeasible
+ * variables is at least SIMPLEX_FLOAT_PRESOLVE_THRESHOLD.
+ */
+#define SIMPLEX_FLOAT_PRESOLVE_THRESHOLD 20
+
 // default options
 #define SIMPLEX_DEFAULT_OPTIONS (SIMPLEX_DISABLE_ALL_OPTIONS)
 
 
+/*
+ * Result of simplex_minimize_var:
+ * - FOUND: the minimum is known
+ * - UNBOUNDED: the variable has no lower bound in the current
+ *   polytope
+ * - UNAVAILABLE: the minimum could not be computed (the variable
+ *   was eliminated or the search was interrupted)
+ */
+typedef enum simplex_opt_code {
+  SIMPLEX_OPT_FOUND,
+  SIMPLEX_OPT_UNBOUNDED,
+  SIMPLEX_OPT_UNAVAILABLE,
+} simplex_opt_code_t;
+
+
 #endif /* __SIMPLEX_TYPES_H */
@@ -154,5 +154,12 @@ extern void pprod_table_set_gc_mark(pprod_table_t *table, pprod_t *p);
  */
 extern void pprod_table_gc(pprod_table_t *table);
 
+/*
+ * Clear all the marks without collecting anything
+ */
+static inline void pprod_table_clear_gc_marks(pprod_table_t *table) {
+  clear_bitvector(table->mark, table->size);
+}
+
 
 #endif /* __PPROD_TABLE_H */
@@ -153,6 +153,8 @@ static void term_table_init(term_table_t *table, uint32_t n, type_table_t *ttbl,
   init_ivector(&table->ibuffer, 20);
   init_pvector(&table->pbuffer, 20);
 
+  init_ivector(&table->young, 0);
+
 }
 
 
@@ -203,6 +205,7 @@ static int32_t allocate_term_id(term_table_t *table) {
   }
   clr_bit(table->mark, i);
   table->live_terms ++;
+  ivector_push(&table->young, i);
 
   return i;
 }
@@ -1889,6 +1892,7 @@ void delete_term_table(term_table_t *table) {
 
   delete_ivector(&table->ibuffer);
   delete_pvector(&table->pbuffer);
+  delete_ivector(&table->young);
 
   safe_free(table->kind);
   safe_free(table->type);
@@ -1937,6 +1941,7 @@ void reset_term_table(term_table_t *table) {
 
   ivector_reset(&table->ibuffer);
   pvector_reset(&table->pbuffer);
+  ivector_reset(&table->young);
 
   table->nelems = 0;
   table->free_idx = -1;
@@ -3718,4 +3723,67 @@ void term_table_gc(term_table_t *table, bool keep_named) {
 
   // clear the marks
   clear_bitvector(table->mark, table->size);
+
+  // all survivors are old
+  ivector_reset(&table->young);
+}
+
+
+/*
+ * Young-generation collector
+ */
+void term_table_young_gc(term_table_t *table, bool keep_named) {
+  ivector_t dead;
+  uint32_t k, n;
+  int32_t i;
+
+  if (keep_named) {
+    stbl_iterate(&table->stbl, table, mark_symbol);
+  }
+
+  /*
+   * Propagate the marks: a term is created after its subterms so
+   * we visit the young terms from the most recent to the oldest.
+   * With ptr = 0, mark_reachable_terms marks the children of i
+   * without exploring them.
+   */
+  n = table->young.size;
+  k = n;
+  while (k > 0) {
+    k --;
+    i = table->young.data[k];
+    if (term_idx_is_marked(table, i)) {
+      mark_reachable_terms(table, 0, i);
+    }
+  }
+
+  // collect the dead young terms
+  init_ivector(&dead, 0);
+  for (k=0; k<n; k++) {
+    i = table->young.data[k];
+    if (! term_idx_is_marked(table, i) && i > zero_const) {
+      ivector_push(&dead, i);
+    }
+  }
+
+  // from now on: marked means live
+  set_bitvector(table->mark, table->size);
+  for (k=0; k<dead.size; k++) {
+    clr_bit(table->mark, dead.data[k]);
+  }
+  if (!keep_named) {
+    stbl_remove_records(&table->stbl, table, dead_term_symbol);
+  }
+
+  for (k=0; k<dead.size; k++) {
+    delete_term(table, dead.data[k]);
+  }
+  delete_ivector(&dead);
+
+  // clear the marks (including the marks set on types and power products)
+  clear_bitvector(table->mark, table->size);
+  type_table_clear_gc_marks(table->types);
+  pprod_table_clear_gc_marks(table->pprods);
+
+  ivector_reset(&table->young);
 }
@@ -485,6 +485,10 @@ typedef void (*special_finalizer_t)(special_term_t *spec, term_kind_t tag);
  * Auxiliary vectors
  * - ibuffer: to store an array of integers
  * - pbuffer: to store an array of pprods
+ *
+ * Generational garbage collection:
+ * - young: indices of all the terms created since the last garbage
+ *   collection, in creation order
  */
 typedef struct term_table_s {
   uint8_t *kind;
@@ -508,6 +512,8 @@ typedef struct term_table_s {
 
   ivector_t ibuffer;
   pvector_t pbuffer;
+
+  ivector_t young;
 } term_table_t;
 
 
@@ -1744,4 +1750,31 @@ static inline bool term_idx_is_marked(const term_table_t *table, int32_t i) {
 extern void term_table_gc(term_table_t *table, bool keep_named);
 
 
+/*
+ * Young-generation collection: cheaper variant of term_table_gc that
+ * can only delete the young terms (i.e., the terms created since the
+ * last collection).
+ * - a term is created after all its subterms, so an old term can't
+ *   refer to a young term: all old terms are preserved and the marks
+ *   are propagated through young terms only.
+ * - the roots are marked as for term_table_gc
+ * - the type and power-product tables are not collected
+ * - if keep_named is false, references to dead young terms are removed
+ *   from the symbol table
+ * - all marks in the term, type, and power-product tables are cleared.
+ * - the survivors become old.
+ *
+ * The cost is proportional to the number of young terms (plus the
+ * size of the mark vectors and of the symbol table).
+ */
+extern void term_table_young_gc(term_table_t *table, bool keep_named);
+
+/*
+ * Number of young terms
+ */
+static inline uint32_t term_table_num_young_terms(const term_table_t *table) {
+  return table->young.size;
+}
+
+
 #endif /* __TERMS_H */
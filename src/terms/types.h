@@ -1179,6 +1179,11 @@ static inline bool type_is_marked(type_table_t *tbl, type_t i) {
  */
 extern void type_table_gc(type_table_t *tbl, bool keep_named);
 
+/*
+ * Clear all the marks without collecting anything
+ */
+extern void type_table_clear_gc_marks(type_table_t *tbl);
+
 
 
 #endif /* __TYPES_H */
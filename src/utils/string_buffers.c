@@ -137,6 +137,13 @@ void string_buffer_append_buffer(string_buffer_t *s, string_buffer_t *s1) {
   s->index += n;
 }
 
+// copy n characters a[0 ... n-1] (a doesn't need to be null-terminated)
+void string_buffer_append_chars(string_buffer_t *s, const char *a, uint32_t n) {
+  string_buffer_extend(s, n);
+  memcpy(s->data + s->index, a, n);
+  s->index += n;
+}
+
 
 void string_buffer_append_int32(string_buffer_t *s, int32_t x) {
   int32_t n;
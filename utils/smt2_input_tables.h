@@ -78,6 +78,8 @@ enum actions {
   reset_next_goto_r0,
   reset_assertions_next_goto_r0,
   check_sat_assuming_model_next_goto_c17,
+  minimize_next_push_r0_goto_t0,
+  maximize_next_push_r0_goto_t0,
 
   // arguments to the commands
   numeral_next_goto_r0,
@@ -258,6 +260,8 @@ static triple_t triples[] = {
   { c1, SMT2_TK_RESET, "reset_next_goto_r0" },
   { c1, SMT2_TK_RESET_ASSERTIONS, "reset_assertions_next_goto_r0" },
   { c1, SMT2_TK_CHECK_SAT_ASSUMING_MODEL, "check_sat_assuming_model_next_goto_c17" },
+  { c1, SMT2_TK_MINIMIZE, "minimize_next_push_r0_goto_t0" },
+  { c1, SMT2_TK_MAXIMIZE, "maximize_next_push_r0_goto_t0" },
   { c1, DEFAULT_TOKEN, "error_command_expected" },  
 
   { c3, SMT2_TK_NUMERAL, "numeral_next_goto_r0" },